@@ -0,0 +1,266 @@
+//! Policy stage benchmark over synthetic designs.
+//!
+//! The designs mirror `internal/synth` (the Go generator behind the
+//! pipeline benchmarks): entities in a hierarchy where each non-leaf
+//! architecture instantiates the next level, clocked processes, nested
+//! for-generates and package fan-in. Results are reported under the
+//! `policy` stage name of timing.jsonl, so they line up with
+//! `go test ./internal/indexer -bench Pipeline`:
+//!
+//!     cargo bench --bench policy
+//!     VHDL_BENCH_INPUT=input.json cargo bench --bench policy
+//!
+//! `VHDL_BENCH_INPUT` names policy input JSON files (comma separated) to
+//! time instead of the synthetic designs. The large design needs several
+//! GiB and only runs with `VHDL_BENCH_LARGE=1`.
+
+use std::hint::black_box;
+use std::time::{Duration, Instant};
+
+use serde_json::{json, Value};
+
+use vhdl_compiler::policy::engine;
+use vhdl_compiler::policy::input::Input;
+
+struct Params {
+    name: &'static str,
+    entities: usize,
+    depth: usize,
+    children: usize,
+    processes: usize,
+    generate_nesting: usize,
+    packages: usize,
+    package_fan_in: usize,
+}
+
+const SIZES: &[Params] = &[
+    Params {
+        name: "small",
+        entities: 16,
+        depth: 3,
+        children: 2,
+        processes: 2,
+        generate_nesting: 2,
+        packages: 4,
+        package_fan_in: 2,
+    },
+    Params {
+        name: "medium",
+        entities: 200,
+        depth: 6,
+        children: 2,
+        processes: 4,
+        generate_nesting: 2,
+        packages: 16,
+        package_fan_in: 4,
+    },
+    Params {
+        name: "large",
+        entities: 2000,
+        depth: 8,
+        children: 3,
+        processes: 6,
+        generate_nesting: 3,
+        packages: 64,
+        package_fan_in: 8,
+    },
+];
+
+fn main() {
+    let inputs: Vec<(String, Input)> = match std::env::var("VHDL_BENCH_INPUT") {
+        Ok(paths) => paths
+            .split(',')
+            .filter(|p| !p.is_empty())
+            .map(|path| {
+                let data = std::fs::read(path).unwrap_or_else(|e| panic!("read {path}: {e}"));
+                let input: Input =
+                    serde_json::from_slice(&data).unwrap_or_else(|e| panic!("parse {path}: {e}"));
+                (path.to_string(), input)
+            })
+            .collect(),
+        Err(_) => SIZES
+            .iter()
+            .filter(|p| p.name != "large" || std::env::var_os("VHDL_BENCH_LARGE").is_some())
+            .map(|p| {
+                let input: Input =
+                    serde_json::from_value(synthetic_input(p)).expect("synthetic input");
+                (p.name.to_string(), input)
+            })
+            .collect(),
+    };
+
+    for (name, input) in &inputs {
+        let (iterations, mean, min) = measure(input);
+        println!(
+            "policy/{name}: {iterations} iterations, policy-ms/op {:.3} (min {:.3})",
+            ms(mean),
+            ms(min)
+        );
+    }
+}
+
+/// Runs evaluate for at least a second (and at least 3 times) after one
+/// warm-up run; returns iterations, mean and fastest run.
+fn measure(input: &Input) -> (u32, Duration, Duration) {
+    black_box(engine::evaluate(input));
+    let budget = Duration::from_secs(1);
+    let start = Instant::now();
+    let mut iterations = 0u32;
+    let mut min = Duration::MAX;
+    while iterations < 3 || start.elapsed() < budget {
+        let run = Instant::now();
+        black_box(engine::evaluate(black_box(input)));
+        min = min.min(run.elapsed());
+        iterations += 1;
+    }
+    (iterations, start.elapsed() / iterations, min)
+}
+
+fn ms(d: Duration) -> f64 {
+    d.as_secs_f64() * 1000.0
+}
+
+fn children(p: &Params, i: usize) -> Vec<usize> {
+    let levels = p.depth + 1;
+    if i % levels == p.depth {
+        return Vec::new();
+    }
+    (0..p.children)
+        .map(|c| i + 1 + c * levels)
+        .take_while(|&j| j < p.entities)
+        .collect()
+}
+
+fn packages(p: &Params, i: usize) -> Vec<usize> {
+    let mut out: Vec<usize> = Vec::new();
+    if p.packages == 0 {
+        return out;
+    }
+    for m in 0..p.package_fan_in.min(p.packages) {
+        let k = (i + m * 7) % p.packages;
+        if !out.contains(&k) {
+            out.push(k);
+        }
+    }
+    out
+}
+
+/// The policy input the Go pipeline builds for the synthetic design, reduced
+/// to the tables the rules read.
+fn synthetic_input(p: &Params) -> Value {
+    let mut files = Vec::new();
+    let mut entities = Vec::new();
+    let mut architectures = Vec::new();
+    let mut packages_out = Vec::new();
+    let mut signals = Vec::new();
+    let mut ports = Vec::new();
+    let mut processes = Vec::new();
+    let mut instances = Vec::new();
+    let mut generates = Vec::new();
+    let mut dependencies = Vec::new();
+    let mut use_clauses = Vec::new();
+    let mut symbols = Vec::new();
+
+    for k in 0..p.packages {
+        let file = format!("pkg_{k}.vhd");
+        files.push(json!({"path": file, "library": "work"}));
+        packages_out.push(json!({"name": format!("pkg_{k}"), "file": file, "line": 5}));
+        symbols.push(
+            json!({"name": format!("work.pkg_{k}"), "kind": "package", "file": file, "line": 5}),
+        );
+    }
+    for i in 0..p.entities {
+        let file = format!("e_{i}.vhd");
+        let entity = format!("e_{i}");
+        files.push(json!({"path": file, "library": "work"}));
+        symbols.push(
+            json!({"name": format!("work.{entity}"), "kind": "entity", "file": file, "line": 7}),
+        );
+
+        let entity_ports: Vec<Value> = [("clk", "in", "std_logic", 1), ("rst", "in", "std_logic", 1), ("din", "in", "std_logic_vector(7 downto 0)", 8), ("dout", "out", "std_logic_vector(7 downto 0)", 8)]
+            .iter()
+            .enumerate()
+            .map(|(n, (name, dir, ty, width))| json!({"name": name, "direction": dir, "type": ty, "line": 9 + n, "in_entity": entity, "width": width}))
+            .collect();
+        ports.extend(entity_ports.iter().cloned());
+        entities.push(json!({"name": entity, "file": file, "line": 7, "ports": entity_ports}));
+        architectures.push(json!({"name": "rtl", "entity_name": entity, "file": file, "line": 16}));
+
+        use_clauses.push(json!({"items": ["ieee.std_logic_1164.all", "ieee.numeric_std.all"], "file": file, "line": 2}));
+        for k in packages(p, i) {
+            use_clauses
+                .push(json!({"items": [format!("work.pkg_{k}.all")], "file": file, "line": 4}));
+            dependencies.push(json!({"source": file, "target": format!("work.pkg_{k}"), "kind": "use", "line": 4, "resolved": true}));
+            signals.push(json!({"name": format!("cnt_{k}"), "type": "unsigned", "file": file, "line": 18, "in_entity": entity, "width": 8}));
+        }
+        for m in 0..p.processes {
+            let input = if m == 0 {
+                "din".to_string()
+            } else {
+                format!("r_{}", m - 1)
+            };
+            signals.push(json!({"name": format!("r_{m}"), "type": "std_logic_vector(7 downto 0)", "file": file, "line": 17, "in_entity": entity, "width": 8}));
+            processes.push(json!({
+                "label": format!("p_{m}"),
+                "sensitivity_list": ["clk"],
+                "is_sequential": true,
+                "clock_signal": "clk",
+                "clock_edge": "rising",
+                "has_reset": true,
+                "reset_signal": "rst",
+                "assigned_signals": [format!("r_{m}")],
+                "read_signals": ["clk", "rst", input],
+                "file": file,
+                "line": 25 + m * 12,
+                "in_arch": "rtl",
+            }));
+        }
+        let last = format!("r_{}", p.processes - 1);
+        for (c, j) in children(p, i).into_iter().enumerate() {
+            let target = format!("work.e_{j}");
+            signals.push(json!({"name": format!("c_{c}"), "type": "std_logic_vector(7 downto 0)", "file": file, "line": 18, "in_entity": entity, "width": 8}));
+            instances.push(json!({
+                "name": format!("u_{c}"),
+                "target": target,
+                "port_map": {"clk": "clk", "rst": "rst", "din": last, "dout": format!("c_{c}")},
+                "file": file,
+                "line": 100 + c * 3,
+                "in_arch": "rtl",
+            }));
+            dependencies.push(json!({"source": file, "target": target, "kind": "instantiation", "line": 100 + c * 3, "resolved": true}));
+        }
+        signals.push(json!({"name": "gen_q", "type": "std_logic_vector", "file": file, "line": 19, "in_entity": entity, "width": 1 << p.generate_nesting}));
+        for g in 0..p.generate_nesting {
+            generates.push(json!({
+                "label": format!("g_{g}"),
+                "kind": "for",
+                "file": file,
+                "line": 120 + g,
+                "in_arch": "rtl",
+                "loop_var": format!("i{g}"),
+                "range_low": "0",
+                "range_high": "1",
+                "range_dir": "to",
+                "can_elaborate": true,
+                "iteration_count": 2,
+            }));
+        }
+    }
+
+    json!({
+        "standard": "2008",
+        "file_count": files.len(),
+        "files": files,
+        "entities": entities,
+        "architectures": architectures,
+        "packages": packages_out,
+        "signals": signals,
+        "ports": ports,
+        "processes": processes,
+        "instances": instances,
+        "generates": generates,
+        "dependencies": dependencies,
+        "use_clauses": use_clauses,
+        "symbols": symbols,
+    })
+}
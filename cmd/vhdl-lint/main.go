@@ -24,11 +24,18 @@
 package main
 
 import (
+	"encoding/json"
+	"flag"
 	"fmt"
+	"net"
 	"os"
+	"os/signal"
+	"syscall"
+	"time"
 
 	"github.com/robert-at-pretension-io/vhdl-lint/internal/config"
 	"github.com/robert-at-pretension-io/vhdl-lint/internal/indexer"
+	"github.com/robert-at-pretension-io/vhdl-lint/internal/server"
 )
 
 func main() {
@@ -86,12 +93,27 @@ func main() {
 			os.Exit(1)
 		}
 		runLintWithFlags(os.Args[2], false, false, false, false, true)
+	case "--timing-format":
+		if len(os.Args) < 4 {
+			printUsage()
+			os.Exit(1)
+		}
+		_ = os.Setenv("VHDL_TIMING_FORMAT", os.Args[2])
+		runLintWithFlags(os.Args[3], false, false, false, false, true)
 	case "--clear-policy-cache":
 		if len(os.Args) < 3 {
 			printUsage()
 			os.Exit(1)
 		}
 		runClearPolicyCache(os.Args[2])
+	case "--shard":
+		runShard(os.Args[2:])
+	case "merge":
+		runMerge(os.Args[2:])
+	case "serve":
+		runServe(os.Args[2:])
+	case "client":
+		runClient(os.Args[2:])
 	case "-h", "--help", "help":
 		printUsage()
 	case "-c", "--config":
@@ -111,6 +133,15 @@ func printUsage() {
 Commands:
   init              Create a vhdl_lint.json configuration file
   <path>            Lint VHDL files in the given path
+  serve <root>...   Keep a resident indexer per root, re-lint on change and
+                    answer lint requests on a unix socket
+                    (--socket, --interval, -c config)
+  client <root>     Ask a running server to lint root; prints JSON
+                    (--socket)
+  --shard i/N <path>  Extract shard i of N and write its facts artifact
+                    (--artifact-dir, -c config, -j)
+  merge <path> <artifact>...  Lint path using shard artifacts for facts
+                    (-c config, -j)
 
 Options:
   -v, --verbose     Enable verbose output (extraction details)
@@ -120,6 +151,8 @@ Options:
   --policy-stream   Stream Rust policy stderr without enabling timing
   -j, --json        Output results as JSON (for programmatic parsing)
   --timing          Emit timing.jsonl with pipeline timing events
+  --timing-format   Timing as jsonl, chrome (timing.trace.json) or pprof
+                    (timing.pb.gz): vhdl-lint --timing-format chrome <path>
   --clear-policy-cache  Remove cached policy results for the given path
   -c, --config      Specify config file: vhdl-lint -c config.json <path>
   -h, --help        Show this help message
@@ -214,3 +247,172 @@ func runClearPolicyCache(path string) {
 
 	fmt.Printf("Cleared policy cache in %s\n", cacheDir)
 }
+
+// loadConfigFor loads configPath, or the default config for path.
+func loadConfigFor(configPath, path string) *config.Config {
+	var cfg *config.Config
+	var err error
+	if configPath != "" {
+		cfg, err = config.LoadFile(configPath)
+	} else {
+		cfg, err = config.Load(path)
+	}
+	if err != nil {
+		fmt.Fprintf(os.Stderr, "Error loading config: %v\n", err)
+		os.Exit(1)
+	}
+	return cfg
+}
+
+func runShard(args []string) {
+	if len(args) < 1 {
+		printUsage()
+		os.Exit(1)
+	}
+	shard, err := indexer.ParseShard(args[0])
+	if err != nil {
+		fmt.Fprintf(os.Stderr, "Error: %v\n", err)
+		os.Exit(1)
+	}
+	fs := flag.NewFlagSet("shard", flag.ExitOnError)
+	artifactDir := fs.String("artifact-dir", "", "artifact directory (default: <cache dir>/shards)")
+	configPath := fs.String("c", "", "config file")
+	fs.StringVar(configPath, "config", "", "config file")
+	jsonOutput := fs.Bool("j", false, "print the artifact as JSON")
+	fs.BoolVar(jsonOutput, "json", false, "print the artifact as JSON")
+	_ = fs.Parse(args[1:])
+	if fs.NArg() != 1 {
+		printUsage()
+		os.Exit(1)
+	}
+	path := fs.Arg(0)
+
+	idx := indexer.NewWithConfig(loadConfigFor(*configPath, path))
+	idx.Shard = &shard
+	idx.ArtifactDir = *artifactDir
+	idx.JSONOutput = *jsonOutput
+	if err := idx.Run(path); err != nil {
+		fmt.Fprintf(os.Stderr, "Error: %v\n", err)
+		os.Exit(1)
+	}
+}
+
+func runMerge(args []string) {
+	fs := flag.NewFlagSet("merge", flag.ExitOnError)
+	configPath := fs.String("c", "", "config file")
+	fs.StringVar(configPath, "config", "", "config file")
+	jsonOutput := fs.Bool("j", false, "output results as JSON")
+	fs.BoolVar(jsonOutput, "json", false, "output results as JSON")
+	_ = fs.Parse(args)
+	if fs.NArg() < 2 {
+		printUsage()
+		os.Exit(1)
+	}
+	path := fs.Arg(0)
+
+	idx := indexer.NewWithConfig(loadConfigFor(*configPath, path))
+	idx.Artifacts = fs.Args()[1:]
+	idx.JSONOutput = *jsonOutput
+	if err := idx.Run(path); err != nil {
+		fmt.Fprintf(os.Stderr, "Error: %v\n", err)
+		os.Exit(1)
+	}
+}
+
+func runServe(args []string) {
+	fs := flag.NewFlagSet("serve", flag.ExitOnError)
+	socket := fs.String("socket", "", "unix socket path (default: derived from the roots)")
+	interval := fs.Duration("interval", 500*time.Millisecond, "watch scan interval")
+	configPath := fs.String("c", "", "config file for every root")
+	fs.StringVar(configPath, "config", "", "config file for every root")
+	_ = fs.Parse(args)
+	roots := fs.Args()
+	if len(roots) == 0 {
+		printUsage()
+		os.Exit(1)
+	}
+	if *socket == "" {
+		*socket = server.DefaultSocketPath(roots...)
+	}
+
+	srv, err := server.New(roots, server.Options{ConfigPath: *configPath, Interval: *interval})
+	if err != nil {
+		fmt.Fprintf(os.Stderr, "Error: %v\n", err)
+		os.Exit(1)
+	}
+	// A socket file left by a server that died is stale; a live one refuses
+	if _, err := net.Dial("unix", *socket); err == nil {
+		fmt.Fprintf(os.Stderr, "Error: a server is already listening on %s\n", *socket)
+		_ = srv.Close()
+		os.Exit(1)
+	}
+	_ = os.Remove(*socket)
+	ln, err := net.Listen("unix", *socket)
+	if err != nil {
+		fmt.Fprintf(os.Stderr, "Error: %v\n", err)
+		_ = srv.Close()
+		os.Exit(1)
+	}
+	defer os.Remove(*socket)
+	// Clients find the server through any one of its roots
+	links, err := server.LinkRootSockets(*socket, roots)
+	if err != nil {
+		fmt.Fprintf(os.Stderr, "Error: %v\n", err)
+		_ = ln.Close()
+		_ = os.Remove(*socket)
+		_ = srv.Close()
+		os.Exit(1)
+	}
+	defer func() {
+		for _, link := range links {
+			_ = os.Remove(link)
+		}
+	}()
+
+	sigs := make(chan os.Signal, 1)
+	signal.Notify(sigs, syscall.SIGINT, syscall.SIGTERM)
+	go func() {
+		<-sigs
+		_ = srv.Close()
+	}()
+
+	fmt.Fprintf(os.Stderr, "vhdl-lint serving %d root(s) on %s\n", len(roots), *socket)
+	srv.Watch()
+	if err := srv.Serve(ln); err != nil {
+		fmt.Fprintf(os.Stderr, "Error: %v\n", err)
+		_ = srv.Close()
+		os.Exit(1)
+	}
+	if err := srv.Close(); err != nil {
+		fmt.Fprintf(os.Stderr, "Error: %v\n", err)
+	}
+}
+
+func runClient(args []string) {
+	fs := flag.NewFlagSet("client", flag.ExitOnError)
+	socket := fs.String("socket", "", "unix socket path (default: the server serving root)")
+	_ = fs.Parse(args)
+	root := "."
+	if fs.NArg() > 0 {
+		root = fs.Arg(0)
+	}
+	if *socket == "" {
+		*socket = server.DefaultSocketPath(root)
+	}
+
+	resp, err := server.Call(*socket, server.Request{Method: "lint", Root: root})
+	if err != nil {
+		fmt.Fprintf(os.Stderr, "Error: %v\n", err)
+		os.Exit(1)
+	}
+	if !resp.OK {
+		fmt.Fprintf(os.Stderr, "Error: %s\n", resp.Error)
+		os.Exit(1)
+	}
+	enc := json.NewEncoder(os.Stdout)
+	enc.SetIndent("", "  ")
+	if err := enc.Encode(resp.Result); err != nil {
+		fmt.Fprintf(os.Stderr, "Error: %v\n", err)
+		os.Exit(1)
+	}
+}
@@ -0,0 +1,68 @@
+package main
+
+import (
+	"flag"
+	"fmt"
+	"os"
+
+	"github.com/robert-at-pretension-io/vhdl-lint/internal/synth"
+)
+
+func main() {
+	preset := flag.String("preset", "small", "base size: small, medium or large")
+	entities := flag.Int("entities", 0, "number of entities (0 = preset)")
+	depth := flag.Int("depth", -1, "hierarchy depth (-1 = preset)")
+	children := flag.Int("children", 0, "instances per non-leaf architecture (0 = preset)")
+	processes := flag.Int("processes", 0, "clocked processes per architecture (0 = preset)")
+	nesting := flag.Int("generate-nesting", -1, "for-generate nesting depth (-1 = preset)")
+	packages := flag.Int("packages", -1, "number of packages (-1 = preset)")
+	fanIn := flag.Int("package-fan-in", -1, "packages used per entity (-1 = preset)")
+	flag.Parse()
+
+	args := flag.Args()
+	if len(args) != 1 {
+		fmt.Fprintln(os.Stderr, "Usage: vhdl-synth [--preset small|medium|large] [--entities N] [--depth N] [--children N] [--processes N] [--generate-nesting N] [--packages N] [--package-fan-in N] <dir>")
+		os.Exit(1)
+	}
+
+	var p synth.Params
+	switch *preset {
+	case "small":
+		p = synth.Small
+	case "medium":
+		p = synth.Medium
+	case "large":
+		p = synth.Large
+	default:
+		fmt.Fprintf(os.Stderr, "Error: unknown preset %q\n", *preset)
+		os.Exit(1)
+	}
+	if *entities > 0 {
+		p.Entities = *entities
+	}
+	if *depth >= 0 {
+		p.Depth = *depth
+	}
+	if *children > 0 {
+		p.Children = *children
+	}
+	if *processes > 0 {
+		p.Processes = *processes
+	}
+	if *nesting >= 0 {
+		p.GenerateNesting = *nesting
+	}
+	if *packages >= 0 {
+		p.Packages = *packages
+	}
+	if *fanIn >= 0 {
+		p.PackageFanIn = *fanIn
+	}
+
+	files, err := synth.Generate(args[0], p)
+	if err != nil {
+		fmt.Fprintf(os.Stderr, "Error: %v\n", err)
+		os.Exit(1)
+	}
+	fmt.Printf("Wrote %d files to %s\n", len(files), args[0])
+}
@@ -55,6 +55,10 @@ type LintConfig struct {
 
 	// IgnoreRegions enables -- vhdl_lint off/on comment support
 	IgnoreRegions bool `json:"ignoreRegions,omitempty"`
+
+	// SkipTranslateOff excludes -- synthesis translate_off/translate_on
+	// regions from extraction (simulation-only code is not linted)
+	SkipTranslateOff bool `json:"skipTranslateOff,omitempty"`
 }
 
 // AnalysisConfig contains analysis options
@@ -65,6 +69,18 @@ type CacheConfig struct {
 
 	// Dir is the cache directory (relative to project root if not absolute)
 	Dir string `json:"dir,omitempty"`
+
+	// Strict hashes every file's content on every run instead of trusting an
+	// unchanged size/mtime/inode
+	Strict bool `json:"strict,omitempty"`
+
+	// Hash selects the content hash: "sha256" (default) or "fast"
+	// (non-cryptographic CRC pair, enough to detect edits)
+	Hash string `json:"hash,omitempty"`
+
+	// Remote shares facts between machines: a directory (relative to the
+	// project root if not absolute) or an http(s) URL taking GET/PUT
+	Remote string `json:"remote,omitempty"`
 }
 
 // AnalysisConfig contains analysis options
@@ -80,6 +96,19 @@ type AnalysisConfig struct {
 
 	// Cache controls incremental indexing cache behavior
 	Cache CacheConfig `json:"cache,omitempty"`
+
+	// StreamThresholdMB extracts files of at least this many MiB one chunk
+	// of design units at a time instead of whole (0 = never)
+	StreamThresholdMB int `json:"streamThresholdMB,omitempty"`
+
+	// ExtractMemoryMB caps the VHDL source, in MiB, held by all extraction
+	// workers at once; workers wait for room (0 = unlimited)
+	ExtractMemoryMB int `json:"extractMemoryMB,omitempty"`
+
+	// ThirdPartyFacts selects what is extracted from third-party files:
+	// "declarations" (default: design units, ports, types, subprograms and
+	// dependencies, without process or assignment analysis) or "full"
+	ThirdPartyFacts string `json:"thirdPartyFacts,omitempty"`
 }
 
 // DefaultConfig returns a sensible default configuration
@@ -267,15 +296,8 @@ func (c *Config) IsThirdPartyFile(filePath string) bool {
 	return false
 }
 
-// ShouldIgnoreFile checks if a file should be skipped entirely
+// ShouldIgnoreFile checks if a file should be skipped entirely. Filtering
+// many files should compile the patterns once with IgnoreMatcher.
 func (c *Config) ShouldIgnoreFile(filePath string) bool {
-	for _, pattern := range c.Lint.IgnorePatterns {
-		if matched, _ := filepath.Match(pattern, filePath); matched {
-			return true
-		}
-		if matched, _ := filepath.Match(pattern, filepath.Base(filePath)); matched {
-			return true
-		}
-	}
-	return false
+	return c.IgnoreMatcher().Match(filePath)
 }
@@ -1,7 +1,6 @@
 package config
 
 import (
-	"os"
 	"path/filepath"
 	"sort"
 	"strings"
@@ -16,6 +15,13 @@ type ResolvedLibrary struct {
 
 // ResolveLibraries expands all glob patterns and returns resolved file lists
 func (c *Config) ResolveLibraries(rootPath string) ([]ResolvedLibrary, error) {
+	return c.ResolveLibrariesWith(rootPath, NewLister(nil))
+}
+
+// ResolveLibrariesWith is ResolveLibraries listing directories through l,
+// so patterns sharing a base directory walk it once and a snapshot can
+// skip unchanged directories.
+func (c *Config) ResolveLibrariesWith(rootPath string, l *Lister) ([]ResolvedLibrary, error) {
 	type libAccumulator struct {
 		Name         string
 		IsThirdParty bool
@@ -52,7 +58,7 @@ func (c *Config) ResolveLibraries(rootPath string) ([]ResolvedLibrary, error) {
 			}
 
 			// Use doublestar-style glob expansion
-			matches, err := expandGlob(pattern)
+			matches, err := l.expandGlob(pattern)
 			if err != nil {
 				// Silently skip invalid patterns
 				continue
@@ -72,7 +78,7 @@ func (c *Config) ResolveLibraries(rootPath string) ([]ResolvedLibrary, error) {
 				pattern = filepath.Join(rootPath, pattern)
 			}
 
-			matches, err := expandGlob(pattern)
+			matches, err := l.expandGlob(pattern)
 			if err != nil {
 				continue
 			}
@@ -130,18 +136,19 @@ func (c *Config) ResolveLibraries(rootPath string) ([]ResolvedLibrary, error) {
 }
 
 // expandGlob expands a glob pattern, handling ** for recursive matching
-func expandGlob(pattern string) ([]string, error) {
+func (l *Lister) expandGlob(pattern string) ([]string, error) {
 	// Check if pattern contains **
 	if strings.Contains(pattern, "**") {
-		return expandDoubleStarGlob(pattern)
+		return l.expandDoubleStarGlob(pattern)
 	}
 
 	// Simple glob
-	return filepath.Glob(pattern)
+	return l.glob(pattern)
 }
 
-// expandDoubleStarGlob handles ** patterns by walking the directory tree
-func expandDoubleStarGlob(pattern string) ([]string, error) {
+// expandDoubleStarGlob handles ** patterns by matching the files of the
+// directory tree under the base
+func (l *Lister) expandDoubleStarGlob(pattern string) ([]string, error) {
 	var results []string
 
 	// Split pattern at **
@@ -159,37 +166,28 @@ func expandDoubleStarGlob(pattern string) ([]string, error) {
 		suffix = suffix[1:]
 	}
 
-	// Walk the directory tree
-	err := filepath.Walk(baseDir, func(path string, info os.FileInfo, err error) error {
-		if err != nil {
-			return nil // Skip errors, continue walking
-		}
-
-		if info.IsDir() {
-			return nil
-		}
-
+	// Errors are skipped: whatever could be listed is matched
+	files, _ := l.tree(baseDir)
+	for _, path := range files {
 		// Check if file matches the suffix pattern
 		if suffix == "" {
 			results = append(results, path)
-			return nil
+			continue
 		}
 
 		// Build the pattern for this specific path
 		relPath, err := filepath.Rel(baseDir, path)
 		if err != nil {
-			return nil
+			continue
 		}
 
 		// Try to match the suffix pattern against the relative path
 		if matchSuffix(relPath, suffix) {
 			results = append(results, path)
 		}
+	}
 
-		return nil
-	})
-
-	return results, err
+	return results, nil
 }
 
 // matchSuffix checks if a path matches a suffix pattern (after **)
@@ -0,0 +1,155 @@
+package config
+
+import (
+	"fmt"
+	"path/filepath"
+	"regexp"
+	"runtime"
+	"strings"
+	"unicode/utf8"
+)
+
+// IgnoreMatcher matches paths against lint.ignorePatterns, compiled once:
+// the patterns are translated to one regular expression, so a path costs
+// one automaton run against itself and one against its base name rather
+// than two filepath.Match calls per pattern.
+type IgnoreMatcher struct {
+	re *regexp.Regexp // nil: no translated patterns
+	// raw holds patterns left to filepath.Match: malformed ones, and
+	// classes with an empty range, which a regexp class cannot express
+	raw []string
+}
+
+// NewIgnoreMatcher compiles patterns (filepath.Match syntax).
+func NewIgnoreMatcher(patterns []string) *IgnoreMatcher {
+	m := &IgnoreMatcher{}
+	var alts []string
+	for _, pattern := range patterns {
+		expr, ok := globRegexp(pattern)
+		if ok {
+			_, err := regexp.Compile(expr)
+			ok = err == nil
+		}
+		if !ok {
+			m.raw = append(m.raw, pattern)
+			continue
+		}
+		alts = append(alts, expr)
+	}
+	if len(alts) > 0 {
+		m.re = regexp.MustCompile(`^(?:` + strings.Join(alts, "|") + `)$`)
+	}
+	return m
+}
+
+// Match reports whether filePath, or its base name, matches a pattern.
+func (m *IgnoreMatcher) Match(filePath string) bool {
+	base := filepath.Base(filePath)
+	if m.re != nil && (m.re.MatchString(filePath) || m.re.MatchString(base)) {
+		return true
+	}
+	for _, pattern := range m.raw {
+		if matched, _ := filepath.Match(pattern, filePath); matched {
+			return true
+		}
+		if matched, _ := filepath.Match(pattern, base); matched {
+			return true
+		}
+	}
+	return false
+}
+
+// IgnoreMatcher compiles c.Lint.IgnorePatterns.
+func (c *Config) IgnoreMatcher() *IgnoreMatcher {
+	return NewIgnoreMatcher(c.Lint.IgnorePatterns)
+}
+
+// globRegexp translates a filepath.Match pattern to an unanchored regular
+// expression matching the same names. ok is false for a malformed pattern
+// and for a class with an empty range such as [z-a].
+func globRegexp(pattern string) (string, bool) {
+	if _, err := filepath.Match(pattern, ""); err != nil {
+		return "", false
+	}
+	notSep := fmt.Sprintf(`[^\x{%x}]`, filepath.Separator)
+	escapes := runtime.GOOS != "windows"
+	var b strings.Builder
+	for i := 0; i < len(pattern); {
+		switch c := pattern[i]; {
+		case c == '*':
+			b.WriteString(notSep + "*")
+			i++
+		case c == '?':
+			b.WriteString(notSep)
+			i++
+		case c == '[':
+			class, n, ok := globClass(pattern[i+1:], escapes)
+			if !ok {
+				return "", false
+			}
+			b.WriteString(class)
+			i += 1 + n
+		case c == '\\' && escapes:
+			if i+1 >= len(pattern) {
+				return "", false
+			}
+			r, size := utf8.DecodeRuneInString(pattern[i+1:])
+			b.WriteString(regexp.QuoteMeta(string(r)))
+			i += 1 + size
+		default:
+			r, size := utf8.DecodeRuneInString(pattern[i:])
+			b.WriteString(regexp.QuoteMeta(string(r)))
+			i += size
+		}
+	}
+	return b.String(), true
+}
+
+// globClass translates the character class s starts (just past '[') and
+// returns it with the bytes it used, closing ']' included.
+func globClass(s string, escapes bool) (string, int, bool) {
+	var b strings.Builder
+	b.WriteByte('[')
+	i := 0
+	if i < len(s) && s[i] == '^' {
+		b.WriteByte('^')
+		i++
+	}
+	classRune := func() (rune, bool) {
+		if i >= len(s) || s[i] == '-' || s[i] == ']' {
+			return 0, false
+		}
+		if s[i] == '\\' && escapes {
+			i++
+			if i >= len(s) {
+				return 0, false
+			}
+		}
+		r, size := utf8.DecodeRuneInString(s[i:])
+		i += size
+		return r, true
+	}
+	ranges := 0
+	for {
+		if i < len(s) && s[i] == ']' && ranges > 0 {
+			b.WriteByte(']')
+			return b.String(), i + 1, true
+		}
+		lo, ok := classRune()
+		if !ok {
+			return "", 0, false
+		}
+		hi := lo
+		if i < len(s) && s[i] == '-' {
+			i++
+			if hi, ok = classRune(); !ok {
+				return "", 0, false
+			}
+		}
+		if lo > hi {
+			return "", 0, false
+		}
+		fmt.Fprintf(&b, `\x{%x}-\x{%x}`, lo, hi)
+		ranges++
+	}
+}
@@ -0,0 +1,50 @@
+package config
+
+import (
+	"path/filepath"
+	"testing"
+)
+
+func TestIgnoreMatcherAgreesWithMatch(t *testing.T) {
+	patterns := []string{
+		"*.vhd", "tb_*", "*_tb.vhd", "?ore.vhd", "[ab]*.vhd", "[^ab]*.vhd",
+		"[a-c]x.vhd", `\*lit.vhd`, "gen/*/*.vhd", "*/sim/*", "[]bad", "[z-a].vhd",
+		"*[", "ü*.vhd", "a.b", "(x)|y",
+	}
+	paths := []string{
+		"core.vhd", "rtl/core.vhd", "tb_top.vhd", "sim/tb_top.vhd", "fifo_tb.vhd",
+		"bx.vhd", "cx.vhd", "dx.vhd", "*lit.vhd", "xlit.vhd", "gen/a/b.vhd",
+		"gen/a/b/c.vhd", "top/sim/x", "a.b", "axb", "ünit.vhd", "(x)|y", "y",
+		"bad", "z.vhd", ".vhd",
+	}
+	for _, pattern := range patterns {
+		m := NewIgnoreMatcher([]string{pattern})
+		for _, p := range paths {
+			p = filepath.FromSlash(p)
+			want := false
+			if matched, _ := filepath.Match(pattern, p); matched {
+				want = true
+			}
+			if matched, _ := filepath.Match(pattern, filepath.Base(p)); matched {
+				want = true
+			}
+			if got := m.Match(p); got != want {
+				t.Errorf("pattern %q, path %q: Match = %v, filepath.Match = %v", pattern, p, got, want)
+			}
+		}
+	}
+
+	// All patterns at once: one alternation plus the filepath.Match ones
+	cfg := Config{Lint: LintConfig{IgnorePatterns: patterns}}
+	for _, p := range paths {
+		want := false
+		for _, pattern := range patterns {
+			if NewIgnoreMatcher([]string{pattern}).Match(p) {
+				want = true
+			}
+		}
+		if got := cfg.ShouldIgnoreFile(p); got != want {
+			t.Errorf("path %q: ShouldIgnoreFile = %v, want %v", p, got, want)
+		}
+	}
+}
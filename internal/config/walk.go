@@ -0,0 +1,337 @@
+package config
+
+import (
+	"encoding/json"
+	"fmt"
+	"os"
+	"path/filepath"
+	"runtime"
+	"sort"
+	"strings"
+	"sync"
+	"time"
+)
+
+// =============================================================================
+// DIRECTORY LISTING
+// =============================================================================
+//
+// Library globs and the fallback scan read the tree through a Lister:
+//
+//   - A tree is walked once per resolution, however many "**" patterns
+//     (files and excludes, every library) start from the same directory,
+//     and its directories are listed concurrently.
+//   - With a DirSnapshot, a directory whose mtime is unchanged since the
+//     last run is not listed again: its entries come from the snapshot. A
+//     directory's mtime changes whenever an entry is added, removed or
+//     renamed, which is all a listing records. Each directory is still
+//     stat'ed on every run.
+//
+// Listings are recorded only for directories last modified more than
+// snapshotRacyWindow before they were listed, so an entry added within the
+// mtime granularity of the filesystem cannot hide behind an unchanged
+// mtime.
+// =============================================================================
+
+const (
+	dirSnapshotVersion = 1
+	snapshotRacyWindow = 2 * time.Second
+)
+
+// dirListing is one directory's entries, by name.
+type dirListing struct {
+	ModTime int64    `json:"mtime"`
+	Files   []string `json:"files,omitempty"` // everything but directories
+	Dirs    []string `json:"dirs,omitempty"`
+}
+
+// DirSnapshot remembers directory listings between runs.
+type DirSnapshot struct {
+	mu   sync.Mutex
+	dirs map[string]dirListing
+	// seen is the directories used this run; Save keeps only those
+	seen  map[string]bool
+	dirty bool
+}
+
+type dirSnapshotFile struct {
+	Version int                   `json:"version"`
+	Dirs    map[string]dirListing `json:"dirs"`
+}
+
+// NewDirSnapshot returns an empty snapshot.
+func NewDirSnapshot() *DirSnapshot {
+	return &DirSnapshot{dirs: make(map[string]dirListing), seen: make(map[string]bool)}
+}
+
+// LoadDirSnapshot reads the snapshot saved at path. A missing snapshot, or
+// one from another version, is empty; an unreadable one is empty and an
+// error.
+func LoadDirSnapshot(path string) (*DirSnapshot, error) {
+	s := NewDirSnapshot()
+	data, err := os.ReadFile(path)
+	if os.IsNotExist(err) {
+		return s, nil
+	}
+	if err != nil {
+		return s, fmt.Errorf("reading directory snapshot: %w", err)
+	}
+	var file dirSnapshotFile
+	if err := json.Unmarshal(data, &file); err != nil {
+		return s, fmt.Errorf("parsing directory snapshot: %w", err)
+	}
+	if file.Version == dirSnapshotVersion && file.Dirs != nil {
+		s.dirs = file.Dirs
+	}
+	return s, nil
+}
+
+// Save writes the listings used since the snapshot was loaded to path,
+// unless nothing changed.
+func (s *DirSnapshot) Save(path string) error {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	if !s.dirty && len(s.seen) == len(s.dirs) {
+		return nil
+	}
+	file := dirSnapshotFile{Version: dirSnapshotVersion, Dirs: make(map[string]dirListing, len(s.seen))}
+	for dir := range s.seen {
+		file.Dirs[dir] = s.dirs[dir]
+	}
+	data, err := json.Marshal(file)
+	if err != nil {
+		return fmt.Errorf("marshaling directory snapshot: %w", err)
+	}
+	if err := os.MkdirAll(filepath.Dir(path), 0o755); err != nil {
+		return fmt.Errorf("writing directory snapshot: %w", err)
+	}
+	tmp := path + ".tmp"
+	if err := os.WriteFile(tmp, data, 0o644); err != nil {
+		return fmt.Errorf("writing directory snapshot: %w", err)
+	}
+	if err := os.Rename(tmp, path); err != nil {
+		return fmt.Errorf("writing directory snapshot: %w", err)
+	}
+	s.dirs = file.Dirs
+	s.dirty = false
+	return nil
+}
+
+func (s *DirSnapshot) lookup(dir string, modTime int64) (dirListing, bool) {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	listing, ok := s.dirs[dir]
+	if !ok || listing.ModTime != modTime {
+		return dirListing{}, false
+	}
+	s.seen[dir] = true
+	return listing, true
+}
+
+func (s *DirSnapshot) record(dir string, listing dirListing) {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	s.dirs[dir] = listing
+	s.seen[dir] = true
+	s.dirty = true
+}
+
+// Lister lists directories for one library resolution or scan. It is safe
+// for concurrent use.
+type Lister struct {
+	snapshot *DirSnapshot // nil: always list
+	// SkipHidden, set before first use, does not descend into directories
+	// whose name starts with '.' (caches, VCS metadata)
+	SkipHidden bool
+
+	mu    sync.Mutex
+	trees map[string]*treeListing
+}
+
+type treeListing struct {
+	once  sync.Once
+	files []string
+	err   error
+}
+
+// NewLister returns a Lister reusing snapshot's listings and recording new
+// ones in it. snapshot may be nil.
+func NewLister(snapshot *DirSnapshot) *Lister {
+	return &Lister{snapshot: snapshot, trees: make(map[string]*treeListing)}
+}
+
+// VHDLFiles returns every .vhd/.vhdl file under root (root itself when it
+// is a file), sorted. Like filepath.Walk, symbolic links are not followed.
+// The error is the first one met; the files found elsewhere are returned
+// with it.
+func (l *Lister) VHDLFiles(root string) ([]string, error) {
+	all, err := l.tree(root)
+	var files []string
+	for _, f := range all {
+		if isVHDLFile(f, "") {
+			files = append(files, f)
+		}
+	}
+	return files, err
+}
+
+// Files returns every non-directory under root (root itself when it is a
+// file), sorted, with errors as for VHDLFiles. The slice is shared with
+// later calls and must not be modified.
+func (l *Lister) Files(root string) ([]string, error) {
+	return l.tree(root)
+}
+
+// tree returns every non-directory under root, sorted, walking it at most
+// once per Lister.
+func (l *Lister) tree(root string) ([]string, error) {
+	root = filepath.Clean(root)
+	l.mu.Lock()
+	t := l.trees[root]
+	if t == nil {
+		t = &treeListing{}
+		l.trees[root] = t
+	}
+	l.mu.Unlock()
+	t.once.Do(func() {
+		t.files, t.err = l.walk(root)
+	})
+	return t.files, t.err
+}
+
+// walkParallelism bounds the directories listed at once. Listing waits on
+// the filesystem (on NFS, on round trips), not the CPU, so it runs wider
+// than GOMAXPROCS.
+func walkParallelism() int {
+	n := 4 * runtime.GOMAXPROCS(0)
+	if n > 64 {
+		n = 64
+	}
+	return n
+}
+
+func (l *Lister) walk(root string) ([]string, error) {
+	info, err := os.Lstat(root)
+	if err != nil {
+		return nil, err
+	}
+	if !info.IsDir() {
+		return []string{root}, nil
+	}
+
+	var (
+		mu       sync.Mutex
+		files    []string
+		firstErr error
+		wg       sync.WaitGroup
+	)
+	sem := make(chan struct{}, walkParallelism())
+	var visit func(dir string)
+	visit = func(dir string) {
+		defer wg.Done()
+		sem <- struct{}{}
+		listing, err := l.list(dir)
+		<-sem
+		mu.Lock()
+		if err != nil && firstErr == nil {
+			firstErr = err
+		}
+		for _, name := range listing.Files {
+			files = append(files, filepath.Join(dir, name))
+		}
+		mu.Unlock()
+		for _, name := range listing.Dirs {
+			if l.SkipHidden && strings.HasPrefix(name, ".") {
+				continue
+			}
+			wg.Add(1)
+			go visit(filepath.Join(dir, name))
+		}
+	}
+	wg.Add(1)
+	go visit(root)
+	wg.Wait()
+	sort.Strings(files)
+	return files, firstErr
+}
+
+// list returns dir's entries, from the snapshot when dir is unchanged.
+func (l *Lister) list(dir string) (dirListing, error) {
+	info, err := os.Stat(dir)
+	if err != nil {
+		return dirListing{}, err
+	}
+	modTime := info.ModTime().UnixNano()
+	if l.snapshot != nil {
+		if listing, ok := l.snapshot.lookup(dir, modTime); ok {
+			return listing, nil
+		}
+	}
+	entries, err := os.ReadDir(dir)
+	if err != nil {
+		return dirListing{}, err
+	}
+	listing := dirListing{ModTime: modTime}
+	for _, entry := range entries {
+		if entry.IsDir() {
+			listing.Dirs = append(listing.Dirs, entry.Name())
+		} else {
+			listing.Files = append(listing.Files, entry.Name())
+		}
+	}
+	if l.snapshot != nil && time.Since(info.ModTime()) > snapshotRacyWindow {
+		l.snapshot.record(dir, listing)
+	}
+	return listing, nil
+}
+
+// glob is filepath.Glob for a pattern whose directory part has no
+// metacharacters, listing the directory through l; other patterns go to
+// filepath.Glob.
+func (l *Lister) glob(pattern string) ([]string, error) {
+	dir, file := filepath.Split(pattern)
+	dir = cleanGlobDir(dir)
+	if !hasGlobMeta(file) || hasGlobMeta(dir) {
+		return filepath.Glob(pattern)
+	}
+	if _, err := filepath.Match(pattern, ""); err != nil {
+		return nil, err
+	}
+	listing, err := l.list(dir)
+	if err != nil {
+		return nil, nil // like filepath.Glob, I/O errors are no matches
+	}
+	names := make([]string, 0, len(listing.Files)+len(listing.Dirs))
+	names = append(names, listing.Files...)
+	names = append(names, listing.Dirs...)
+	sort.Strings(names)
+	var matches []string
+	for _, name := range names {
+		matched, err := filepath.Match(file, name)
+		if err != nil {
+			return matches, err
+		}
+		if matched {
+			matches = append(matches, filepath.Join(dir, name))
+		}
+	}
+	return matches, nil
+}
+
+func cleanGlobDir(dir string) string {
+	switch dir {
+	case "":
+		return "."
+	case string(filepath.Separator):
+		return dir
+	}
+	return dir[:len(dir)-1]
+}
+
+func hasGlobMeta(path string) bool {
+	magic := `*?[\`
+	if runtime.GOOS == "windows" {
+		magic = `*?[`
+	}
+	return strings.ContainsAny(path, magic)
+}
@@ -0,0 +1,189 @@
+package config
+
+import (
+	"os"
+	"path/filepath"
+	"reflect"
+	"sort"
+	"strings"
+	"testing"
+	"time"
+)
+
+func writeTree(t *testing.T, root string, files ...string) {
+	t.Helper()
+	for _, f := range files {
+		path := filepath.Join(root, f)
+		if err := os.MkdirAll(filepath.Dir(path), 0o755); err != nil {
+			t.Fatalf("mkdir: %v", err)
+		}
+		if err := os.WriteFile(path, []byte("-- "+f), 0o644); err != nil {
+			t.Fatalf("write %s: %v", f, err)
+		}
+	}
+}
+
+func TestListerMatchesWalk(t *testing.T) {
+	root := t.TempDir()
+	writeTree(t, root,
+		"top.vhd", "notes.txt",
+		"rtl/core.vhd", "rtl/core_pkg.vhdl",
+		"rtl/deep/a/b/leaf.vhd",
+		"sim/tb_core.vhd", "sim/old/tb_old.vhd",
+	)
+	if err := os.Symlink(filepath.Join(root, "rtl"), filepath.Join(root, "link")); err != nil {
+		t.Fatalf("symlink: %v", err)
+	}
+
+	var want []string
+	err := filepath.Walk(root, func(path string, info os.FileInfo, err error) error {
+		if err != nil {
+			return err
+		}
+		if !info.IsDir() && isVHDLFile(path, "") {
+			want = append(want, path)
+		}
+		return nil
+	})
+	if err != nil {
+		t.Fatalf("walk: %v", err)
+	}
+	sort.Strings(want)
+
+	got, err := NewLister(nil).VHDLFiles(root)
+	if err != nil {
+		t.Fatalf("VHDLFiles: %v", err)
+	}
+	if !reflect.DeepEqual(got, want) {
+		t.Fatalf("VHDLFiles = %v, want %v", got, want)
+	}
+
+	cfg := Config{
+		Libraries: map[string]LibraryConfig{
+			"work": {Files: []string{"**/*.vhd", "**/*.vhdl", "*.vhd"}, Exclude: []string{"sim/**/old/*.vhd"}},
+			"rtl":  {Files: []string{"rtl/**/*.vhd"}},
+		},
+	}
+	libs, err := cfg.ResolveLibraries(root)
+	if err != nil {
+		t.Fatalf("ResolveLibraries: %v", err)
+	}
+	rel := func(files []string) []string {
+		var out []string
+		for _, f := range files {
+			r, _ := filepath.Rel(root, f)
+			out = append(out, filepath.ToSlash(r))
+		}
+		sort.Strings(out)
+		return out
+	}
+	if got, want := rel(findLibFiles(t, libs, "work")), []string{
+		"rtl/core.vhd", "rtl/core_pkg.vhdl", "rtl/deep/a/b/leaf.vhd", "sim/tb_core.vhd", "top.vhd",
+	}; !reflect.DeepEqual(got, want) {
+		t.Fatalf("work = %v, want %v", got, want)
+	}
+	if got, want := rel(findLibFiles(t, libs, "rtl")), []string{
+		"rtl/core.vhd", "rtl/deep/a/b/leaf.vhd",
+	}; !reflect.DeepEqual(got, want) {
+		t.Fatalf("rtl = %v, want %v", got, want)
+	}
+}
+
+func TestListerSkipHidden(t *testing.T) {
+	root := t.TempDir()
+	writeTree(t, root, "top.vhd", ".git/objects/x.vhd", "rtl/.cache/y.vhd", "rtl/core.vhd", ".vhdl_lint.json")
+
+	l := NewLister(nil)
+	l.SkipHidden = true
+	got, err := l.Files(root)
+	if err != nil {
+		t.Fatalf("files: %v", err)
+	}
+	want := []string{
+		filepath.Join(root, ".vhdl_lint.json"),
+		filepath.Join(root, "rtl", "core.vhd"),
+		filepath.Join(root, "top.vhd"),
+	}
+	if !reflect.DeepEqual(got, want) {
+		t.Fatalf("files = %q, want %q", got, want)
+	}
+}
+
+func TestDirSnapshotSkipsUnchangedDirs(t *testing.T) {
+	root := t.TempDir()
+	writeTree(t, root, "rtl/core.vhd", "sim/tb.vhd")
+	old := time.Now().Add(-time.Hour)
+	for _, dir := range []string{root, filepath.Join(root, "rtl"), filepath.Join(root, "sim")} {
+		if err := os.Chtimes(dir, old, old); err != nil {
+			t.Fatalf("chtimes: %v", err)
+		}
+	}
+	snapPath := filepath.Join(t.TempDir(), "cache", "dir_snapshot.json")
+
+	list := func() []string {
+		t.Helper()
+		snap, err := LoadDirSnapshot(snapPath)
+		if err != nil {
+			t.Fatalf("LoadDirSnapshot: %v", err)
+		}
+		files, err := NewLister(snap).VHDLFiles(root)
+		if err != nil {
+			t.Fatalf("VHDLFiles: %v", err)
+		}
+		if err := snap.Save(snapPath); err != nil {
+			t.Fatalf("Save: %v", err)
+		}
+		var names []string
+		for _, f := range files {
+			names = append(names, filepath.Base(f))
+		}
+		return names
+	}
+
+	if got := list(); !reflect.DeepEqual(got, []string{"core.vhd", "tb.vhd"}) {
+		t.Fatalf("first run = %v", got)
+	}
+
+	// An entry added behind an unchanged mtime is not seen: rtl came from
+	// the snapshot, not a listing
+	writeTree(t, root, "rtl/hidden.vhd")
+	if err := os.Chtimes(filepath.Join(root, "rtl"), old, old); err != nil {
+		t.Fatalf("chtimes: %v", err)
+	}
+	if got := list(); !reflect.DeepEqual(got, []string{"core.vhd", "tb.vhd"}) {
+		t.Fatalf("unchanged dir was listed again: %v", got)
+	}
+
+	// A changed mtime lists the directory again
+	newer := old.Add(time.Minute)
+	if err := os.Chtimes(filepath.Join(root, "rtl"), newer, newer); err != nil {
+		t.Fatalf("chtimes: %v", err)
+	}
+	if got := list(); !reflect.DeepEqual(got, []string{"core.vhd", "hidden.vhd", "tb.vhd"}) {
+		t.Fatalf("changed dir = %v", got)
+	}
+
+	// A directory modified just now is listed but not recorded
+	writeTree(t, root, "fresh/new.vhd")
+	snap, _ := LoadDirSnapshot(snapPath)
+	if _, err := NewLister(snap).VHDLFiles(root); err != nil {
+		t.Fatalf("VHDLFiles: %v", err)
+	}
+	if _, ok := snap.dirs[filepath.Join(root, "fresh")]; ok {
+		t.Fatalf("racy directory was recorded")
+	}
+}
+
+func TestLoadDirSnapshotCorrupt(t *testing.T) {
+	path := filepath.Join(t.TempDir(), "dir_snapshot.json")
+	if err := os.WriteFile(path, []byte("{not json"), 0o644); err != nil {
+		t.Fatalf("write: %v", err)
+	}
+	snap, err := LoadDirSnapshot(path)
+	if err == nil || !strings.Contains(err.Error(), "directory snapshot") {
+		t.Fatalf("expected parse error, got %v", err)
+	}
+	if snap == nil || len(snap.dirs) != 0 {
+		t.Fatalf("expected empty snapshot")
+	}
+}
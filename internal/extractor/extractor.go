@@ -40,25 +40,95 @@ package extractor
 // =============================================================================
 
 import (
+	"bytes"
 	"context"
 	"fmt"
+	"io"
 	"os"
-	"regexp"
 	"strconv"
 	"strings"
+	"time"
 
 	sitter "github.com/smacker/go-tree-sitter"
 	tree_sitter_vhdl "github.com/tree-sitter/tree-sitter-vhdl"
 )
 
-// Extractor uses Tree-sitter to parse VHDL files and extract facts
+// Extractor uses Tree-sitter to parse VHDL files and extract facts.
+//
+// An Extractor keeps one long-lived parser and reusable scratch buffers
+// across Extract calls, so it is NOT safe for concurrent use: give each
+// worker goroutine its own (New is cheap; the language is shared).
 type Extractor struct {
 	lang *sitter.Language
+
+	// Per-worker scratch, reused across files
+	parser          *sitter.Parser
+	content         []byte
+	declaredSignals map[string]bool
+	cursor          *sitter.QueryCursor
+	decls           declPrefetch
+	walked          int // nodes walkTreeWithPkg entered since prefetchDecls
+
+	// SkipTranslateOff drops code between "-- synthesis translate_off" and
+	// "-- synthesis translate_on" pragmas from extraction. The scanner emits
+	// the pragmas as translate_off_pragma/translate_on_pragma extras, which
+	// may sit at different nesting levels; the walk carries the open region
+	// (translateOff) until its translate_on, at whatever depth that is.
+	SkipTranslateOff bool
+	translateOff     bool
+
+	// Trees, when set, keeps each file's syntax tree between calls so a
+	// changed file is reparsed incrementally (see TreeStore). Shared safely
+	// between Extractors.
+	Trees *TreeStore
+
+	// Queries prefetches entity, architecture, package and library clause
+	// names with one compiled tree-sitter query pass per file (see query.go)
+	// instead of reading them node by node in the walker. Same facts.
+	Queries bool
+
+	// StreamThreshold, when > 0, extracts files of at least this many bytes
+	// one chunk of design units at a time (see stream.go).
+	StreamThreshold int64
+
+	// Budget, when set, caps the source bytes held by all Extractors sharing
+	// it. Extract waits for its share.
+	Budget *MemoryBudget
+
+	// ParseStats fills FileFacts.Parse (parse time, node and ERROR counts)
+	// for timing reports, at the cost of one extra pass over each tree.
+	ParseStats bool
+
+	// tier is the Tier of the current ExtractTier call
+	tier Tier
+}
+
+// Tier selects how much of a file is analyzed.
+type Tier uint8
+
+const (
+	// TierFull extracts every fact.
+	TierFull Tier = iota
+	// TierDeclarations extracts what other files link against: design
+	// units, ports, generics, components, instances, signals, types,
+	// subprograms, constants and dependencies. Processes, concurrent
+	// assignments and PSL are not analyzed, and no CDC crossings or
+	// verification tags are reported.
+	TierDeclarations
+)
+
+func (t Tier) String() string {
+	if t == TierDeclarations {
+		return "declarations"
+	}
+	return "full"
 }
 
 // FileFacts contains all extracted information from a single VHDL file
 type FileFacts struct {
 	File           string
+	Tier           Tier       // how much of the file was analyzed
+	Parse          ParseStats // see Extractor.ParseStats
 	Entities       []Entity
 	Architectures  []Architecture
 	Packages       []Package
@@ -566,13 +636,34 @@ func New() *Extractor {
 }
 
 // Extract parses a VHDL file and extracts facts
-// Creates a new parser per call for thread safety
+// Reuses the Extractor's parser and buffers (see Extractor for concurrency)
 func (e *Extractor) Extract(filePath string) (FileFacts, error) {
+	return e.ExtractTier(filePath, TierFull)
+}
+
+// ExtractTier is Extract analyzing only as much as tier asks for.
+func (e *Extractor) ExtractTier(filePath string, tier Tier) (FileFacts, error) {
+	e.tier = tier
+	facts, err := e.extract(filePath)
+	facts.Tier = tier
+	return facts, err
+}
+
+func (e *Extractor) extract(filePath string) (FileFacts, error) {
 	facts := FileFacts{File: filePath}
-	declaredSignals := make(map[string]bool)
+
+	if e.StreamThreshold > 0 || e.Budget != nil {
+		if info, err := os.Stat(filePath); err == nil {
+			if e.lang != nil && e.StreamThreshold > 0 && info.Size() >= e.StreamThreshold {
+				return e.extractStreaming(filePath)
+			}
+			charged := e.Budget.Acquire(info.Size())
+			defer e.Budget.Release(charged)
+		}
+	}
 
 	// Read file
-	content, err := os.ReadFile(filePath)
+	content, err := e.readSource(filePath)
 	if err != nil {
 		return facts, fmt.Errorf("reading file: %w", err)
 	}
@@ -582,27 +673,93 @@ func (e *Extractor) Extract(filePath string) (FileFacts, error) {
 		return e.extractSimple(filePath, content)
 	}
 
-	// Create a new parser for this extraction (thread-safe)
-	parser := sitter.NewParser()
-	parser.SetLanguage(e.lang)
+	if e.parser == nil {
+		e.parser = sitter.NewParser()
+		e.parser.SetLanguage(e.lang)
+	}
+
+	if e.Trees != nil {
+		return e.extractIncremental(filePath, content)
+	}
 
 	// Parse with Tree-sitter
-	tree, err := parser.ParseCtx(context.Background(), nil, content)
+	parseStart := time.Now()
+	tree, err := e.parser.ParseCtx(context.Background(), nil, content)
 	if err != nil {
+		// A failed parse can leave the parser mid-document; start clean next time
+		e.parser.Reset()
 		return facts, fmt.Errorf("parsing: %w", err)
 	}
 	defer tree.Close()
+	parseDuration := time.Since(parseStart)
+
+	declaredSignals := e.resetDeclaredSignals()
 
 	// Walk the tree and extract facts
-	e.walkTree(tree.RootNode(), content, &facts, "", declaredSignals)
+	root := tree.RootNode()
+	if e.ParseStats {
+		facts.Parse.add(root, parseDuration)
+	}
+	e.prefetchDecls(root, content)
+	e.translateOff = false
+	e.walkTree(root, content, &facts, "", declaredSignals)
+	if e.ParseStats {
+		facts.Parse.addWalk(e)
+	}
 
-	// Detect clock domain crossings
-	facts.CDCCrossings = DetectCDCCrossings(&facts)
-	e.extractVerificationTags(content, &facts)
+	if e.tier == TierFull {
+		// Detect clock domain crossings
+		facts.CDCCrossings = DetectCDCCrossings(&facts)
+		e.extractVerificationTags(content, &facts)
+	}
 
 	return facts, nil
 }
 
+// resetDeclaredSignals returns the Extractor's declared-signal set, emptied.
+func (e *Extractor) resetDeclaredSignals() map[string]bool {
+	if e.declaredSignals == nil {
+		e.declaredSignals = make(map[string]bool)
+	} else {
+		clear(e.declaredSignals)
+	}
+	return e.declaredSignals
+}
+
+// readSource reads filePath into the Extractor's reusable buffer. The
+// returned slice is only valid until the next call; facts never retain it
+// (node text is copied out with Content).
+func (e *Extractor) readSource(filePath string) ([]byte, error) {
+	f, err := os.Open(filePath)
+	if err != nil {
+		return nil, err
+	}
+	defer f.Close()
+
+	info, err := f.Stat()
+	if err != nil {
+		return nil, err
+	}
+	size := int(info.Size())
+	if size == 0 {
+		// Size unknown (pipe, /proc) or empty file: read whatever is there
+		data, err := io.ReadAll(f)
+		if err != nil {
+			return nil, err
+		}
+		return data, nil
+	}
+	if cap(e.content) < size {
+		e.content = make([]byte, size)
+	}
+	buf := e.content[:size]
+	n, err := io.ReadFull(f, buf)
+	if err != nil && err != io.ErrUnexpectedEOF {
+		return nil, err
+	}
+	return buf[:n], nil
+}
+
 // walkTree traverses the syntax tree and extracts relevant nodes
 // context is the current architecture name (for scoping signals, processes, etc.)
 // We also need to track package context separately for type declarations
@@ -615,24 +772,29 @@ func (e *Extractor) walkTreeWithPkg(node *sitter.Node, source []byte, facts *Fil
 	if node == nil {
 		return
 	}
+	if e.translateOff {
+		e.seekTranslateOn(node, source, facts, pkgContext, archContext, declaredSignals)
+		return
+	}
+	e.walked++
 
 	nodeType := node.Type()
 
 	switch nodeType {
 	case "entity_declaration":
-		entity := e.extractEntity(node, source)
+		entity := e.entityAt(node, source)
 		facts.Entities = append(facts.Entities, entity)
 		// Extract ports from entity
 		e.extractPortsFromEntity(node, source, entity.Name, facts, declaredSignals)
 		archContext = entity.Name
 
 	case "architecture_body":
-		arch := e.extractArchitecture(node, source)
+		arch := e.architectureAt(node, source)
 		facts.Architectures = append(facts.Architectures, arch)
 		archContext = arch.Name
 
 	case "package_declaration":
-		pkg := e.extractPackage(node, source)
+		pkg := e.packageAt(node, source)
 		facts.Packages = append(facts.Packages, pkg)
 		pkgContext = pkg.Name
 	case "configuration_declaration":
@@ -671,6 +833,23 @@ func (e *Extractor) walkTreeWithPkg(node *sitter.Node, source []byte, facts *Fil
 		}
 
 	case "library_clause":
+		if libraries, ok := e.prefetchedLibraries(node); ok {
+			// Only identifiers below; nothing left for the walker
+			line := int(node.StartPoint().Row) + 1
+			if libraries[0] != "" {
+				facts.Dependencies = append(facts.Dependencies, Dependency{
+					Source: facts.File,
+					Target: libraries[0],
+					Kind:   "library",
+					Line:   line,
+				})
+			}
+			facts.LibraryClauses = append(facts.LibraryClauses, LibraryClause{
+				Libraries: libraries,
+				Line:      line,
+			})
+			return
+		}
 		dep := e.extractLibraryClause(node, source, facts.File)
 		if dep.Target != "" {
 			facts.Dependencies = append(facts.Dependencies, dep)
@@ -709,10 +888,12 @@ func (e *Extractor) walkTreeWithPkg(node *sitter.Node, source []byte, facts *Fil
 			facts.Dependencies = append(facts.Dependencies, dep)
 		}
 	case "psl_property_declaration", "psl_sequence_declaration", "psl_cover_statement", "psl_assume_statement", "psl_restrict_statement", "psl_default_clock":
-		e.extractPSLSignalReads(node, source, facts, declaredSignals)
+		if e.tier == TierFull {
+			e.extractPSLSignalReads(node, source, facts, declaredSignals)
+		}
 	case "assert_statement":
 		// PSL assert statements are parsed as assert_statement with PSL expressions inside.
-		if hasPSLChild(node) {
+		if e.tier == TierFull && hasPSLChild(node) {
 			e.extractPSLSignalReads(node, source, facts, declaredSignals)
 		}
 
@@ -821,6 +1002,9 @@ func (e *Extractor) walkTreeWithPkg(node *sitter.Node, source []byte, facts *Fil
 		facts.Components = append(facts.Components, comp)
 
 	case "group_declaration":
+		if e.tier != TierFull {
+			return
+		}
 		readSet := make(map[string]bool)
 		inParens := false
 		for i := 0; i < int(node.ChildCount()); i++ {
@@ -854,6 +1038,9 @@ func (e *Extractor) walkTreeWithPkg(node *sitter.Node, source []byte, facts *Fil
 	case "signal_assignment":
 		// Concurrent signal assignment (outside processes)
 		// Note: Sequential assignments inside processes are "sequential_signal_assignment"
+		if e.tier != TierFull {
+			return
+		}
 		ca := e.extractConcurrentAssignment(node, source, archContext, declaredSignals)
 		facts.ConcurrentAssignments = append(facts.ConcurrentAssignments, ca)
 		// Add to signal usages
@@ -876,6 +1063,10 @@ func (e *Extractor) walkTreeWithPkg(node *sitter.Node, source []byte, facts *Fil
 		facts.SignalDeps = append(facts.SignalDeps, deps...)
 
 	case "process_statement":
+		if e.tier != TierFull {
+			e.noteTranslatePragmas(node, source)
+			return // nothing declared inside is visible outside
+		}
 		proc := e.extractProcess(node, source, archContext, declaredSignals)
 		facts.Processes = append(facts.Processes, proc)
 		// Extract case statements within the process for latch detection
@@ -935,15 +1126,86 @@ func (e *Extractor) walkTreeWithPkg(node *sitter.Node, source []byte, facts *Fil
 		// Recursively flatten all nested generate contents into facts
 		e.flattenGenerateToFacts(&gen, archContext, facts)
 		// Don't recurse manually - extractGenerateStatement handles nested content
+		e.noteTranslatePragmas(node, source)
 		return
 	}
 
 	// Recurse into children
-	for i := 0; i < int(node.ChildCount()); i++ {
+	childCount := int(node.ChildCount())
+	for i := 0; i < childCount; i++ {
+		child := node.Child(i)
+		if e.SkipTranslateOff && child.Type() == "translate_off_pragma" {
+			e.translateOff = true
+			continue
+		}
+		e.walkTreeWithPkg(child, source, facts, pkgContext, archContext, declaredSignals)
+	}
+}
+
+// seekTranslateOn skips node, which starts inside a translate_off region,
+// up to the translate_on_pragma closing that region and walks what follows
+// it. The pragma may be nested anywhere below, so only subtrees whose text
+// cannot hold it are dropped whole. A design unit opened inside the region
+// still names the context of the code after the pragma.
+func (e *Extractor) seekTranslateOn(node *sitter.Node, source []byte, facts *FileFacts, pkgContext, archContext string, declaredSignals map[string]bool) {
+	if node.Type() == "translate_on_pragma" {
+		e.translateOff = false
+		return
+	}
+	if !mayHoldPragma(source[node.StartByte():node.EndByte()], "translate_on", "rtl_synthesis") {
+		return
+	}
+	switch node.Type() {
+	case "entity_declaration", "architecture_body":
+		if name := node.ChildByFieldName("name"); name != nil {
+			archContext = name.Content(source)
+		}
+	case "package_declaration", "package_body":
+		if name := node.ChildByFieldName("name"); name != nil {
+			pkgContext = name.Content(source)
+		}
+	}
+	childCount := int(node.ChildCount())
+	for i := 0; i < childCount; i++ {
+		// Still seeking until the pragma turns up, walked normally after
 		e.walkTreeWithPkg(node.Child(i), source, facts, pkgContext, archContext, declaredSignals)
 	}
 }
 
+// noteTranslatePragmas brings the translate_off state past node, a subtree
+// extracted by a case above without walking its children.
+func (e *Extractor) noteTranslatePragmas(node *sitter.Node, source []byte) {
+	if !e.SkipTranslateOff || !mayHoldPragma(source[node.StartByte():node.EndByte()], "translate_o", "rtl_synthesis") {
+		return
+	}
+	childCount := int(node.ChildCount())
+	for i := 0; i < childCount; i++ {
+		child := node.Child(i)
+		switch child.Type() {
+		case "translate_off_pragma":
+			e.translateOff = true
+		case "translate_on_pragma":
+			e.translateOff = false
+		default:
+			e.noteTranslatePragmas(child, source)
+		}
+	}
+}
+
+// mayHoldPragma reports whether text contains one of words, ignoring case:
+// a cheap test before descending a subtree for pragma nodes.
+func mayHoldPragma(text []byte, words ...string) bool {
+	for _, word := range words {
+		w := []byte(word) // lowercase, starting with a letter
+		for i := 0; i+len(w) <= len(text); i++ {
+			if text[i]|0x20 == w[0] && bytes.EqualFold(text[i:i+len(w)], w) {
+				return true
+			}
+		}
+	}
+	return false
+}
+
 func generateScopeLabel(gen *GenerateStatement) string {
 	if gen.Label != "" {
 		return gen.Label
@@ -1723,7 +1985,7 @@ func (e *Extractor) extractConcurrentAssignment(node *sitter.Node, source []byte
 	// Determine kind based on content
 	// VHDL selected assignment: "with expr select target <= value when choice, ..."
 	// VHDL conditional assignment: "target <= value when condition else other"
-	content := strings.ToLower(node.Content(source))
+	content := lowerNodeText(node, source)
 	// Selected assignments must start with "with" keyword (not just contain "select" in a signal name)
 	isSelected := strings.HasPrefix(strings.TrimSpace(content), "with ") && strings.Contains(content, " select ")
 	if strings.Contains(content, " when ") && strings.Contains(content, " else ") && !isSelected {
@@ -2433,7 +2695,7 @@ func (e *Extractor) extractGenericDeclsFromItem(node *sitter.Node, source []byte
 			})
 		}
 	default:
-		content := strings.ToLower(node.Content(source))
+		content := lowerNodeText(node, source)
 		if strings.HasPrefix(strings.TrimSpace(content), "package") {
 			for i := 0; i < int(node.ChildCount()); i++ {
 				child := node.Child(i)
@@ -2596,7 +2858,7 @@ func (e *Extractor) extractPorts(node *sitter.Node, source []byte) []Port {
 
 	// Extract direction from field (now visible in grammar as port_direction)
 	if dirNode := node.ChildByFieldName("direction"); dirNode != nil {
-		direction = strings.ToLower(dirNode.Content(source))
+		direction = lowerNodeText(dirNode, source)
 	}
 
 	// Collect names and type from grammar fields first
@@ -2739,7 +3001,7 @@ func (e *Extractor) extractProcess(node *sitter.Node, source []byte, context str
 				// Check if this is followed by ':'
 				if i+1 < int(node.ChildCount()) {
 					next := node.Child(i + 1)
-					if next.Content(source) == ":" {
+					if string(nodeBytes(next, source)) == ":" {
 						proc.Label = child.Content(source)
 					}
 				}
@@ -2809,7 +3071,7 @@ func (e *Extractor) analyzeProcessSemantics(node *sitter.Node, source []byte, pr
 					child := n.Child(i)
 					if child.Type() == "identifier" {
 						if funcName == "" {
-							funcName = strings.ToLower(child.Content(source))
+							funcName = lowerNodeText(child, source)
 						} else if argName == "" {
 							argName = child.Content(source)
 						}
@@ -2970,7 +3232,7 @@ func (e *Extractor) collectProcessVariables(node *sitter.Node, source []byte, va
 					break
 				}
 				if !sawColon && child.Type() == "identifier" {
-					varName := strings.ToLower(child.Content(source))
+					varName := lowerNodeText(child, source)
 					varSet[varName] = true
 					varNames = append(varNames, child.Content(source))
 				}
@@ -2989,9 +3251,8 @@ func (e *Extractor) collectProcessVariables(node *sitter.Node, source []byte, va
 
 		if n.Type() == "loop_statement" {
 			line := int(n.StartPoint().Row) + 1
-			loopText := n.Content(source)
-			if match := regexp.MustCompile(`(?i)\\bfor\\s+([a-zA-Z_][a-zA-Z0-9_]*)\\s+in\\b`).FindStringSubmatch(loopText); match != nil {
-				loopVar := match[1]
+			if match, ok := scanForLoopVar(nodeBytes(n, source)); ok {
+				loopVar := string(match)
 				varSet[strings.ToLower(loopVar)] = true
 				if vars != nil {
 					*vars = append(*vars, VariableDecl{
@@ -3112,7 +3373,7 @@ func (e *Extractor) isNotSignalRead(node *sitter.Node, source []byte) bool {
 	// VHDL can't syntactically distinguish array(i) from func(x)
 	// Use naming heuristics for common type conversions and functions
 	if parentType == "indexed_name" && fieldName == "prefix" {
-		name := strings.ToLower(node.Content(source))
+		name := lowerNodeText(node, source)
 		if e.isCommonVHDLFunction(name) {
 			return true
 		}
@@ -3175,7 +3436,7 @@ func (e *Extractor) isFunctionCall(node *sitter.Node, source []byte) bool {
 
 	// If this identifier is the prefix of an indexed_name, check if it looks like a function
 	if parent.Type() == "indexed_name" && fieldName == "prefix" {
-		name := strings.ToLower(node.Content(source))
+		name := lowerNodeText(node, source)
 		return e.isCommonVHDLFunction(name)
 	}
 
@@ -3370,6 +3631,30 @@ func identifierFollowedByArrow(node *sitter.Node, source []byte) bool {
 	return false
 }
 
+// nodeBytes is n's source text without the copy Content makes. The slice
+// aliases source: read it, don't keep or modify it.
+func nodeBytes(n *sitter.Node, source []byte) []byte {
+	return source[n.StartByte():n.EndByte()]
+}
+
+// lowerNodeText is strings.ToLower(n.Content(source)) with a single
+// allocation for ASCII text.
+func lowerNodeText(n *sitter.Node, source []byte) string {
+	text := nodeBytes(n, source)
+	var sb strings.Builder
+	sb.Grow(len(text))
+	for _, c := range text {
+		if c >= 0x80 {
+			return strings.ToLower(string(text))
+		}
+		if c >= 'A' && c <= 'Z' {
+			c += 'a' - 'A'
+		}
+		sb.WriteByte(c)
+	}
+	return sb.String()
+}
+
 func isIdentChar(b byte) bool {
 	return (b >= 'a' && b <= 'z') ||
 		(b >= 'A' && b <= 'Z') ||
@@ -3494,7 +3779,7 @@ func signalDeclarationHasDefault(node *sitter.Node, source []byte) bool {
 	if node == nil {
 		return false
 	}
-	return strings.Contains(node.Content(source), ":=")
+	return bytes.Contains(nodeBytes(node, source), []byte(":="))
 }
 
 // extractReadsFromNode finds all identifiers read in an expression
@@ -3526,7 +3811,7 @@ func (e *Extractor) extractReadsFromNodeSkipping(node *sitter.Node, source []byt
 			}
 			if fieldName == "prefix" && nodeHasField(parent, "attribute") {
 				if attrNode := parent.ChildByFieldName("attribute"); attrNode != nil {
-					if isStaticAttribute(attrNode.Content(source)) && identifierFollowedByTick(n, source) {
+					if isStaticAttribute(lowerNodeText(attrNode, source)) && identifierFollowedByTick(n, source) {
 						// Static attribute prefix (e.g., sig'range) is not a signal read.
 						return
 					}
@@ -3573,7 +3858,7 @@ func (e *Extractor) extractReadsFromNodeSkipping(node *sitter.Node, source []byt
 			}
 			if nodeHasField(parent, "attribute") {
 				if attrNode := parent.ChildByFieldName("attribute"); attrNode != nil {
-					if isStaticAttribute(attrNode.Content(source)) && identifierFollowedByTick(n, source) {
+					if isStaticAttribute(lowerNodeText(attrNode, source)) && identifierFollowedByTick(n, source) {
 						// Skip prefix for static attribute references like sig'length.
 						return
 					}
@@ -3587,11 +3872,11 @@ func (e *Extractor) extractReadsFromNodeSkipping(node *sitter.Node, source []byt
 			if fieldName == "prefix" && nodeHasField(parent, "content") {
 				// Prefix with parentheses: func(arg) or arr(idx)
 				// If the base isn't a declared signal/variable, treat as a call and skip.
-				if !isDeclaredSignalName(n.Content(source), declaredSignals, variableSet) {
+				if !isDeclaredSignalName(lowerNodeText(n, source), declaredSignals, variableSet) {
 					return
 				}
 			}
-			if identifierFollowedByParen(n, source) && !isDeclaredSignalName(n.Content(source), declaredSignals, variableSet) {
+			if identifierFollowedByParen(n, source) && !isDeclaredSignalName(lowerNodeText(n, source), declaredSignals, variableSet) {
 				// Heuristic: name followed by '(' with no declaration -> likely a call.
 				return
 			}
@@ -3681,7 +3966,7 @@ func (e *Extractor) checkResetPattern(node *sitter.Node, source []byte, proc *Pr
 	}
 
 	// Check if this is a clock edge condition (not a reset)
-	condContent := strings.ToLower(condNode.Content(source))
+	condContent := lowerNodeText(condNode, source)
 	if strings.Contains(condContent, "rising_edge") || strings.Contains(condContent, "falling_edge") {
 		return
 	}
@@ -3756,12 +4041,12 @@ func conditionHasClockEdge(condNode *sitter.Node, source []byte) bool {
 	if condNode == nil {
 		return false
 	}
-	condContent := strings.ToLower(condNode.Content(source))
+	condContent := lowerNodeText(condNode, source)
 	if strings.Contains(condContent, "rising_edge") || strings.Contains(condContent, "falling_edge") {
 		return true
 	}
 	if attrNode := condNode.ChildByFieldName("attribute"); attrNode != nil {
-		if strings.EqualFold(attrNode.Content(source), "event") {
+		if bytes.EqualFold(nodeBytes(attrNode, source), []byte("event")) {
 			return true
 		}
 	}
@@ -3789,7 +4074,7 @@ func (e *Extractor) extractClockEdgeFromIfStatement(node *sitter.Node, source []
 // extractClockEdgeFromCondition extracts clock edge from a condition wrapper node
 // Looks for rising_edge(clk) or falling_edge(clk) patterns
 func (e *Extractor) extractClockEdgeFromCondition(condNode *sitter.Node, source []byte, proc *Process) {
-	condContent := strings.ToLower(condNode.Content(source))
+	condContent := lowerNodeText(condNode, source)
 
 	// Quick check: does this condition contain a clock edge?
 	if !strings.Contains(condContent, "rising_edge") && !strings.Contains(condContent, "falling_edge") {
@@ -3808,7 +4093,7 @@ func (e *Extractor) extractClockEdgeFromCondition(condNode *sitter.Node, source
 			argName := ""
 
 			if prefixNode := child.ChildByFieldName("prefix"); prefixNode != nil {
-				funcName = strings.ToLower(prefixNode.Content(source))
+				funcName = lowerNodeText(prefixNode, source)
 			}
 			if contentNode := child.ChildByFieldName("content"); contentNode != nil {
 				argName = contentNode.Content(source)
@@ -3820,7 +4105,7 @@ func (e *Extractor) extractClockEdgeFromCondition(condNode *sitter.Node, source
 					c := child.Child(j)
 					if c.Type() == "identifier" {
 						if funcName == "" {
-							funcName = strings.ToLower(c.Content(source))
+							funcName = lowerNodeText(c, source)
 						} else if argName == "" {
 							argName = c.Content(source)
 						}
@@ -3838,7 +4123,7 @@ func (e *Extractor) extractClockEdgeFromCondition(condNode *sitter.Node, source
 
 		// Flat pattern: identifier("rising_edge"), "(", identifier(clk), ")"
 		if child.Type() == "identifier" {
-			funcName := strings.ToLower(child.Content(source))
+			funcName := lowerNodeText(child, source)
 			if funcName == "rising_edge" || funcName == "falling_edge" {
 				// Look for next identifier (skipping parentheses)
 				for j := i + 1; j < int(condNode.ChildCount()); j++ {
@@ -3856,7 +4141,7 @@ func (e *Extractor) extractClockEdgeFromCondition(condNode *sitter.Node, source
 
 	// Attribute-based clocking: clk'event and clk = '1'/'0'
 	attrNode := condNode.ChildByFieldName("attribute")
-	if attrNode != nil && strings.EqualFold(attrNode.Content(source), "event") {
+	if attrNode != nil && bytes.EqualFold(nodeBytes(attrNode, source), []byte("event")) {
 		if prefixNode := condNode.ChildByFieldName("prefix"); prefixNode != nil {
 			proc.ClockSignal = prefixNode.Content(source)
 			edge := clockEdgeFromEventCondition(condNode, source, proc.ClockSignal)
@@ -3876,12 +4161,12 @@ func clockEdgeFromEventCondition(condNode *sitter.Node, source []byte, clk strin
 	seenClk := false
 	for i := 0; i < int(condNode.ChildCount()); i++ {
 		child := condNode.Child(i)
-		if child.Type() == "identifier" && strings.EqualFold(child.Content(source), clk) {
+		if child.Type() == "identifier" && bytes.EqualFold(nodeBytes(child, source), []byte(clk)) {
 			seenClk = true
 			continue
 		}
 		if seenClk && child.Type() == "character_literal" {
-			lit := strings.TrimSpace(strings.ToLower(child.Content(source)))
+			lit := strings.TrimSpace(lowerNodeText(child, source))
 			if lit == "'1'" {
 				return "rising"
 			}
@@ -3901,12 +4186,11 @@ func (e *Extractor) extractSensitivityList(node *sitter.Node, source []byte) []s
 	childCount := int(node.ChildCount())
 	if childCount > 0 {
 		firstChild := node.Child(0)
-		firstContent := strings.ToLower(strings.TrimSpace(firstChild.Content(source)))
-		if firstContent == "all" {
+		if bytes.EqualFold(bytes.TrimSpace(nodeBytes(firstChild, source)), []byte("all")) {
 			return []string{"all"}
 		}
 	}
-	if strings.EqualFold(strings.TrimSpace(node.Content(source)), "all") {
+	if bytes.EqualFold(bytes.TrimSpace(nodeBytes(node, source)), []byte("all")) {
 		return []string{"all"}
 	}
 
@@ -4124,7 +4408,7 @@ func (e *Extractor) extractWaitStatement(node *sitter.Node, source []byte) WaitS
 	mode := ""
 	for i := 0; i < int(node.ChildCount()); i++ {
 		child := node.Child(i)
-		switch strings.ToLower(child.Content(source)) {
+		switch lowerNodeText(child, source) {
 		case "on":
 			mode = "on"
 			continue
@@ -5406,11 +5690,17 @@ func (e *Extractor) extractGenerateBody(node *sitter.Node, source []byte, gen *G
 			return // Don't recurse into instance
 
 		case "process_statement":
+			if e.tier != TierFull {
+				return
+			}
 			proc := e.extractProcess(n, source, gen.Label, declaredSignals)
 			gen.Processes = append(gen.Processes, proc)
 			return // Don't recurse into process
 
 		case "signal_assignment":
+			if e.tier != TierFull {
+				return
+			}
 			// Concurrent signal assignment inside generate block
 			ca := e.extractConcurrentAssignment(n, source, scope, declaredSignals)
 			gen.ConcurrentAssignments = append(gen.ConcurrentAssignments, ca)
@@ -5490,7 +5780,7 @@ func (e *Extractor) extractTypeDeclaration(node *sitter.Node, source []byte, pkg
 
 		default:
 			// Could be a simple type (integer range), access type, file type, etc.
-			content := strings.ToLower(defNode.Content(source))
+			content := lowerNodeText(defNode, source)
 			if strings.HasPrefix(content, "access") {
 				td.Kind = "access"
 			} else if strings.HasPrefix(content, "file") {
@@ -5503,7 +5793,7 @@ func (e *Extractor) extractTypeDeclaration(node *sitter.Node, source []byte, pkg
 				td.Kind = "alias" // Simple type alias
 				// Fallback: some grammars inline the range tokens and the definition
 				// field may only capture numeric children. Use the full declaration text.
-				full := strings.ToLower(node.Content(source))
+				full := lowerNodeText(node, source)
 				if strings.Contains(full, " range ") {
 					td.Kind = "range"
 					e.extractRangeDetailsFromText(full, &td)
@@ -5550,7 +5840,7 @@ func (e *Extractor) extractRecordFields(node *sitter.Node, source []byte) []Reco
 
 			for j := 0; j < int(child.ChildCount()); j++ {
 				elem := child.Child(j)
-				if elem.Content(source) == ":" {
+				if string(nodeBytes(elem, source)) == ":" {
 					sawColon = true
 					continue
 				}
@@ -5562,7 +5852,7 @@ func (e *Extractor) extractRecordFields(node *sitter.Node, source []byte) []Reco
 					}
 				}
 				if sawColon {
-					if elem.Content(source) == ";" {
+					if string(nodeBytes(elem, source)) == ";" {
 						break
 					}
 					if elem.Type() == "comment" {
@@ -5632,7 +5922,7 @@ func (e *Extractor) extractArrayTypeDetails(node *sitter.Node, source []byte, td
 				// Check if previous sibling was 'of' keyword
 				if i > 0 {
 					prev := node.Child(i - 1)
-					if strings.ToLower(prev.Content(source)) == "of" {
+					if lowerNodeText(prev, source) == "of" {
 						td.ElementType = child.Content(source)
 						continue
 					}
@@ -5680,8 +5970,7 @@ func extractPhysicalUnitsFromContent(content string) []string {
 		return nil
 	}
 	block := rest[:end]
-	re := regexp.MustCompile(`(?m)^[ \t]*([A-Za-z][A-Za-z0-9_]*)\s*(=|;)`)
-	matches := re.FindAllStringSubmatch(block, -1)
+	matches := physicalUnitPattern.FindAllStringSubmatch(block, -1)
 	if len(matches) == 0 {
 		return nil
 	}
@@ -5836,7 +6125,7 @@ func (e *Extractor) extractFunctionDeclaration(node *sitter.Node, source []byte,
 	}
 
 	// Check for pure/impure
-	content := strings.ToLower(node.Content(source))
+	content := lowerNodeText(node, source)
 	if strings.HasPrefix(content, "impure") {
 		fd.IsPure = false
 	}
@@ -5872,7 +6161,7 @@ func (e *Extractor) extractProcedureDeclaration(node *sitter.Node, source []byte
 	}
 
 	// Check if this has a body
-	content := strings.ToLower(node.Content(source))
+	content := lowerNodeText(node, source)
 	if strings.Contains(content, "begin") {
 		pd.HasBody = true
 	}
@@ -5910,12 +6199,12 @@ func (e *Extractor) extractSubprogramParameters(node *sitter.Node, source []byte
 
 			// Check for class (signal/variable/constant)
 			if classNode := n.ChildByFieldName("class"); classNode != nil {
-				class = strings.ToLower(classNode.Content(source))
+				class = lowerNodeText(classNode, source)
 			}
 
 			// Check for direction
 			if dirNode := n.ChildByFieldName("direction"); dirNode != nil {
-				direction = strings.ToLower(dirNode.Content(source))
+				direction = lowerNodeText(dirNode, source)
 			}
 
 			// Check for default
@@ -6412,9 +6701,9 @@ func CalculateWidth(typeStr string) int {
 		strings.HasPrefix(typeLower, "unsigned") ||
 		strings.HasPrefix(typeLower, "signed") {
 		// Match: (number downto/to number)
-		if match := regexp.MustCompile(`\(\s*(\d+)\s+(?:downto|to)\s+(\d+)\s*\)`).FindStringSubmatch(typeLower); match != nil {
-			high, _ := strconv.Atoi(match[1])
-			low, _ := strconv.Atoi(match[2])
+		if left, right, ok := scanNumericRange(typeLower); ok {
+			high, _ := strconv.Atoi(left)
+			low, _ := strconv.Atoi(right)
 			width := high - low
 			if width < 0 {
 				width = -width
@@ -6428,9 +6717,9 @@ func CalculateWidth(typeStr string) int {
 	// Integer subtypes with explicit range
 	// integer range 0 to 255 -> 8 bits (ceil(log2(256)))
 	// natural range 0 to 7 -> 3 bits
-	if match := regexp.MustCompile(`(?:integer|natural|positive)\s+range\s+(\d+)\s+to\s+(\d+)`).FindStringSubmatch(typeLower); match != nil {
-		low, _ := strconv.Atoi(match[1])
-		high, _ := strconv.Atoi(match[2])
+	if lowStr, highStr, ok := scanIntegerRange(typeLower); ok {
+		low, _ := strconv.Atoi(lowStr)
+		high, _ := strconv.Atoi(highStr)
 		rangeSize := high - low + 1
 		if rangeSize <= 0 {
 			return 0
@@ -582,6 +582,35 @@ func TestExtractorE2EBasedLiteralAggregate(t *testing.T) {
 	}
 }
 
+func TestExtractorE2ECharacterLiteralsAndTicks(t *testing.T) {
+	fixture := fixturePath(t, "character_literals_and_ticks.vhd")
+
+	ext := New()
+	facts, err := ext.Extract(fixture)
+	if err != nil {
+		t.Fatalf("extract: %v", err)
+	}
+
+	tri := mustFindType(t, facts.Types, "tri_t")
+	if tri.Kind != "enum" {
+		t.Fatalf("tri_t kind: expected enum, got %q", tri.Kind)
+	}
+	for _, lit := range []string{"'0'", "'1'", "'Z'", "'''"} {
+		assertContains(t, tri.EnumLiterals, lit)
+	}
+
+	scale := findConstant(t, facts.ConstantDecls, "SCALE")
+	if scale.Value != "2#1010#E2" {
+		t.Fatalf("constant SCALE value: expected 2#1010#E2, got %q", scale.Value)
+	}
+
+	proc := findProcess(t, facts.Processes, "p_tick")
+	assertContains(t, proc.SensitivityList, "clk")
+	if !hasSignalUsage(facts.SignalUsages, "a") {
+		t.Fatalf("expected signal usage for a, got %#v", facts.SignalUsages)
+	}
+}
+
 func TestExtractorE2EPackageGeneric2008(t *testing.T) {
 	fixture := fixturePath(t, "package_generic_2008.vhd")
 
@@ -3,6 +3,7 @@ package extractor
 import (
 	"os"
 	"path/filepath"
+	"reflect"
 	"strings"
 	"testing"
 )
@@ -618,6 +619,332 @@ end;
 	}
 }
 
+func TestExtractorSkipTranslateOff(t *testing.T) {
+	vhdl := `library ieee;
+use ieee.std_logic_1164.all;
+
+entity tro_top is
+  port(
+    clk : in std_logic;
+    y   : out std_logic
+  );
+end;
+
+architecture rtl of tro_top is
+  signal kept : std_logic;
+  -- synthesis translate_off
+  signal sim_only : std_logic;
+  -- synthesis translate_on
+begin
+  y <= kept;
+  -- pragma translate_off
+  p_monitor : process(clk)
+  begin
+    report "tick";
+  end process;
+  -- pragma translate_on
+end;
+`
+
+	facts := parseVHDL(t, vhdl)
+	mustFindSignal(t, facts.Signals, "sim_only")
+	mustFindProcess(t, facts.Processes, "p_monitor")
+
+	dir := t.TempDir()
+	path := filepath.Join(dir, "tro.vhd")
+	if err := os.WriteFile(path, []byte(vhdl), 0o600); err != nil {
+		t.Fatalf("write vhdl: %v", err)
+	}
+	ext := New()
+	ext.SkipTranslateOff = true
+	skipped, err := ext.Extract(path)
+	if err != nil {
+		t.Fatalf("extract: %v", err)
+	}
+	mustFindSignal(t, skipped.Signals, "kept")
+	for _, s := range skipped.Signals {
+		if s.Name == "sim_only" {
+			t.Fatalf("expected sim_only to be skipped, got %#v", skipped.Signals)
+		}
+	}
+	for _, p := range skipped.Processes {
+		if p.Label == "p_monitor" {
+			t.Fatalf("expected p_monitor to be skipped, got %#v", skipped.Processes)
+		}
+	}
+}
+
+func TestExtractorSkipTranslateOffAcrossNesting(t *testing.T) {
+	vhdl := `entity a is
+  port(clk : in bit);
+end;
+
+architecture rtl of a is
+  signal a_kept : bit;
+  -- synthesis translate_off
+  signal a_sim : bit;
+begin
+  p_a_sim : process(clk)
+  begin
+  end process;
+end;
+
+entity b is
+end;
+-- synthesis translate_on
+
+entity c is
+end;
+
+-- synthesis translate_off
+architecture rtl of c is
+  signal c_sim : bit;
+begin
+  -- synthesis translate_on
+  p_c_kept : process
+  begin
+    wait;
+  end process;
+end;
+`
+	dir := t.TempDir()
+	path := filepath.Join(dir, "nest.vhd")
+	if err := os.WriteFile(path, []byte(vhdl), 0o600); err != nil {
+		t.Fatalf("write vhdl: %v", err)
+	}
+
+	plain := New()
+	incremental := New()
+	incremental.Trees = NewTreeStore()
+	defer incremental.Trees.Close()
+	for name, ext := range map[string]*Extractor{"plain": plain, "incremental": incremental} {
+		ext.SkipTranslateOff = true
+		facts, err := ext.Extract(path)
+		if err != nil {
+			t.Fatalf("%s: extract: %v", name, err)
+		}
+		mustFindSignal(t, facts.Signals, "a_kept")
+		mustFindProcess(t, facts.Processes, "p_c_kept")
+		for _, s := range facts.Signals {
+			if s.Name == "a_sim" || s.Name == "c_sim" {
+				t.Fatalf("%s: expected %s to be skipped", name, s.Name)
+			}
+		}
+		for _, p := range facts.Processes {
+			if p.Label == "p_a_sim" {
+				t.Fatalf("%s: expected p_a_sim to be skipped", name)
+			}
+		}
+		var entities []string
+		for _, e := range facts.Entities {
+			entities = append(entities, e.Name)
+		}
+		// b sits inside the region opened in a's architecture; c follows
+		// the translate_on at the root
+		if strings.Join(entities, ",") != "a,c" {
+			t.Fatalf("%s: entities = %v, want a,c", name, entities)
+		}
+		for _, p := range facts.Processes {
+			if p.Label == "p_c_kept" && p.InArch != "rtl" {
+				t.Fatalf("%s: p_c_kept in %q, want rtl", name, p.InArch)
+			}
+		}
+	}
+}
+
+func TestExtractorDeclarationsTier(t *testing.T) {
+	vhdl := `library ieee;
+use ieee.std_logic_1164.all;
+
+entity tier_top is
+  port(
+    clk_a : in std_logic;
+    clk_b : in std_logic;
+    din   : in std_logic;
+    y     : out std_logic
+  );
+end;
+
+architecture rtl of tier_top is
+  signal reg_a, reg_b : std_logic;
+begin
+  p_a : process(clk_a)
+  begin
+    if rising_edge(clk_a) then
+      reg_a <= din;
+    end if;
+  end process;
+
+  p_b : process(clk_b)
+  begin
+    if rising_edge(clk_b) then
+      reg_b <= reg_a;
+    end if;
+  end process;
+
+  y <= reg_b;
+
+  g_child : for i in 0 to 1 generate
+    u_child : entity work.child port map (d => reg_b);
+  end generate;
+end;
+`
+
+	dir := t.TempDir()
+	path := filepath.Join(dir, "tier.vhd")
+	if err := os.WriteFile(path, []byte(vhdl), 0o600); err != nil {
+		t.Fatalf("write vhdl: %v", err)
+	}
+	ext := New()
+	full, err := ext.Extract(path)
+	if err != nil {
+		t.Fatalf("extract: %v", err)
+	}
+	if full.Tier != TierFull || len(full.Processes) != 2 || len(full.CDCCrossings) == 0 {
+		t.Fatalf("expected full facts, got tier %s, %d processes, %d crossings", full.Tier, len(full.Processes), len(full.CDCCrossings))
+	}
+
+	decls, err := ext.ExtractTier(path, TierDeclarations)
+	if err != nil {
+		t.Fatalf("extract declarations: %v", err)
+	}
+	if decls.Tier != TierDeclarations {
+		t.Fatalf("expected declarations tier, got %s", decls.Tier)
+	}
+	if _, ok := findEntity(decls.Entities, "tier_top"); !ok {
+		t.Fatalf("expected entity tier_top, got %#v", decls.Entities)
+	}
+	if len(decls.Ports) != len(full.Ports) || len(decls.Signals) != len(full.Signals) || len(decls.Dependencies) != len(full.Dependencies) {
+		t.Fatalf("expected the same declarations as the full tier, got %d/%d ports, %d/%d signals, %d/%d dependencies",
+			len(decls.Ports), len(full.Ports), len(decls.Signals), len(full.Signals), len(decls.Dependencies), len(full.Dependencies))
+	}
+	if len(decls.Instances) != 1 {
+		t.Fatalf("expected the generate's instance, got %#v", decls.Instances)
+	}
+	if len(decls.Processes) != 0 || len(decls.ConcurrentAssignments) != 0 || len(decls.CDCCrossings) != 0 || len(decls.ClockDomains) != 0 {
+		t.Fatalf("expected no body facts, got %d processes, %d assignments, %d crossings, %d clock domains",
+			len(decls.Processes), len(decls.ConcurrentAssignments), len(decls.CDCCrossings), len(decls.ClockDomains))
+	}
+
+	// The tier is per call: the same extractor goes back to full facts
+	again, err := ext.Extract(path)
+	if err != nil {
+		t.Fatalf("extract: %v", err)
+	}
+	if again.Tier != TierFull || len(again.Processes) != 2 {
+		t.Fatalf("expected full facts again, got tier %s, %d processes", again.Tier, len(again.Processes))
+	}
+}
+
+func TestExtractorReuseAcrossFiles(t *testing.T) {
+	dir := t.TempDir()
+	big := filepath.Join(dir, "big.vhd")
+	small := filepath.Join(dir, "small.vhd")
+	if err := os.WriteFile(big, []byte(`entity big_e is
+  port(a : in bit; y : out bit);
+end;
+architecture rtl of big_e is
+  signal big_sig : bit;
+begin
+  big_sig <= a;
+  y <= big_sig;
+end;
+`), 0o600); err != nil {
+		t.Fatalf("write vhdl: %v", err)
+	}
+	if err := os.WriteFile(small, []byte("entity small_e is end;\n"), 0o600); err != nil {
+		t.Fatalf("write vhdl: %v", err)
+	}
+
+	// One extractor, one parser, one buffer: the second (shorter) file must
+	// not see anything left over from the first.
+	ext := New()
+	first, err := ext.Extract(big)
+	if err != nil {
+		t.Fatalf("extract big: %v", err)
+	}
+	mustFindSignal(t, first.Signals, "big_sig")
+
+	second, err := ext.Extract(small)
+	if err != nil {
+		t.Fatalf("extract small: %v", err)
+	}
+	if _, ok := findEntity(second.Entities, "small_e"); !ok {
+		t.Fatalf("expected entity small_e, got %#v", second.Entities)
+	}
+	if len(second.Signals) != 0 || len(second.Ports) != 0 || len(second.Architectures) != 0 {
+		t.Fatalf("expected no carry-over from previous file, got signals=%#v ports=%#v archs=%#v",
+			second.Signals, second.Ports, second.Architectures)
+	}
+}
+
+func TestExtractorIncrementalReparse(t *testing.T) {
+	dir := t.TempDir()
+	path := filepath.Join(dir, "inc.vhd")
+	before := `entity inc_e is
+  port(a : in bit; y : out bit);
+end;
+architecture rtl of inc_e is
+  signal s1 : bit;
+begin
+  s1 <= a;
+  y <= s1;
+end;
+`
+	after := strings.Replace(before, "  signal s1 : bit;\n", "  signal s1 : bit;\n  signal s2 : bit;\n", 1)
+
+	trees := NewTreeStore()
+	defer trees.Close()
+	ext := New()
+	ext.Trees = trees
+
+	for i, src := range []string{before, after, after, before} {
+		if err := os.WriteFile(path, []byte(src), 0o600); err != nil {
+			t.Fatalf("write vhdl: %v", err)
+		}
+		got, err := ext.Extract(path)
+		if err != nil {
+			t.Fatalf("extract %d: %v", i, err)
+		}
+		want, err := New().Extract(path)
+		if err != nil {
+			t.Fatalf("full extract %d: %v", i, err)
+		}
+		if !reflect.DeepEqual(got, want) {
+			t.Fatalf("step %d: incremental facts differ from a full parse\ngot:  %#v\nwant: %#v", i, got, want)
+		}
+	}
+	if trees.Len() != 1 {
+		t.Fatalf("expected one kept tree, got %d", trees.Len())
+	}
+	trees.Retain([]string{path})
+	if trees.Len() != 1 {
+		t.Fatalf("expected the listed tree to be retained, got %d", trees.Len())
+	}
+	trees.Retain([]string{filepath.Join(dir, "renamed.vhd")})
+	if trees.Len() != 0 {
+		t.Fatalf("expected the unlisted tree to be dropped, got %d", trees.Len())
+	}
+}
+
+func TestComputeEdit(t *testing.T) {
+	old := []byte("ab\ncd\nef\n")
+	cur := []byte("ab\ncXYd\nef\n")
+	edit, ok := computeEdit(old, cur)
+	if !ok {
+		t.Fatalf("expected an edit")
+	}
+	if edit.StartIndex != 4 || edit.OldEndIndex != 4 || edit.NewEndIndex != 6 {
+		t.Fatalf("unexpected byte range %#v", edit)
+	}
+	if edit.StartPoint.Row != 1 || edit.StartPoint.Column != 1 || edit.NewEndPoint.Column != 3 {
+		t.Fatalf("unexpected points %#v", edit)
+	}
+	if _, ok := computeEdit(old, old); ok {
+		t.Fatalf("identical content should produce no edit")
+	}
+}
+
 func parseVHDL(t *testing.T, src string) FileFacts {
 	t.Helper()
 
@@ -967,3 +1294,96 @@ func hasCDCCrossing(crossings []CDCCrossing, signal, srcClock, dstClock string,
 	}
 	return false
 }
+
+func TestExtractorQueriesMatchWalker(t *testing.T) {
+	dir := t.TempDir()
+	path := filepath.Join(dir, "q.vhd")
+	if err := os.WriteFile(path, []byte(`library ieee, work;
+use ieee.std_logic_1164.all;
+
+package q_pkg is
+  constant W : integer := 4;
+end package;
+
+entity q_e is
+  generic(N : integer := 2);
+  port(a : in std_logic; y : out std_logic);
+end entity;
+
+architecture rtl of q_e is
+  signal s : std_logic;
+begin
+  s <= a;
+  y <= s;
+end architecture;
+
+library ieee;
+entity q_tb is end;
+architecture sim of q_tb is
+begin
+  dut : entity work.q_e port map(a => '0', y => open);
+end;
+`), 0o600); err != nil {
+		t.Fatalf("write vhdl: %v", err)
+	}
+
+	want, err := New().Extract(path)
+	if err != nil {
+		t.Fatalf("walker extract: %v", err)
+	}
+	ext := New()
+	ext.Queries = true
+	if _, err := loadExtractQuery(ext.lang); err != nil {
+		t.Fatalf("compile extract query: %v", err)
+	}
+	// Twice, so the second run also covers reused prefetch maps
+	for i := 0; i < 2; i++ {
+		got, err := ext.Extract(path)
+		if err != nil {
+			t.Fatalf("query extract: %v", err)
+		}
+		if !reflect.DeepEqual(got, want) {
+			t.Fatalf("run %d: query facts differ from the walker\ngot:  %#v\nwant: %#v", i, got, want)
+		}
+	}
+	if len(want.LibraryClauses) != 2 || len(want.LibraryClauses[0].Libraries) != 2 {
+		t.Fatalf("expected two library clauses, the first with two names, got %#v", want.LibraryClauses)
+	}
+
+	// The prefetch reports its matches and the walker the nodes it entered;
+	// the library clauses are not descended into with the prefetch
+	walker := New()
+	walker.ParseStats = true
+	walked, err := walker.Extract(path)
+	if err != nil {
+		t.Fatalf("walker extract: %v", err)
+	}
+	ext.ParseStats = true
+	queried, err := ext.Extract(path)
+	if err != nil {
+		t.Fatalf("query extract: %v", err)
+	}
+	if walked.Parse.QueryMatches != 0 || walked.Parse.Walked == 0 {
+		t.Fatalf("walker stats: %+v", walked.Parse)
+	}
+	// 1 package, 2 entities, 2 architectures, 3 library names
+	if queried.Parse.QueryMatches != 8 {
+		t.Fatalf("query matches = %d, want 8", queried.Parse.QueryMatches)
+	}
+	if queried.Parse.Walked >= walked.Parse.Walked {
+		t.Fatalf("query walk entered %d nodes, walker alone %d", queried.Parse.Walked, walked.Parse.Walked)
+	}
+}
+
+func TestExtractQueryMatchesQueryFile(t *testing.T) {
+	data, err := os.ReadFile(filepath.Join("..", "..", "tree-sitter-vhdl", "queries", "extract.scm"))
+	if err != nil {
+		t.Fatalf("read extract.scm: %v", err)
+	}
+	file := strings.Join(strings.Fields(string(data)), " ")
+	for _, pattern := range strings.Split(strings.TrimSpace(extractQuery), "\n\n") {
+		if !strings.Contains(file, strings.Join(strings.Fields(pattern), " ")) {
+			t.Errorf("pattern not in queries/extract.scm:\n%s", pattern)
+		}
+	}
+}
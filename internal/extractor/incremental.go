@@ -0,0 +1,338 @@
+package extractor
+
+import (
+	"bytes"
+	"context"
+	"fmt"
+	"reflect"
+	"sync"
+	"time"
+
+	sitter "github.com/smacker/go-tree-sitter"
+)
+
+// TreeStore keeps the last syntax tree and facts for each file so that a
+// later Extract of the same path can reparse incrementally: the edit between
+// the old and new content is applied with Tree.Edit, the parser reuses every
+// untouched subtree, and design units that end before the edit keep their
+// facts instead of being walked again.
+//
+// A TreeStore may be shared by several Extractors (one per worker); each path
+// is expected to be extracted by at most one of them at a time.
+type TreeStore struct {
+	mu    sync.Mutex
+	files map[string]*parsedFile
+}
+
+// parsedFile is the state kept for one path between extractions.
+type parsedFile struct {
+	content          []byte // private copy; the Extractor's read buffer is reused
+	tree             *sitter.Tree
+	facts            FileFacts
+	units            []unitMark
+	skipTranslateOff bool
+	tier             Tier
+}
+
+// unitMark records the extraction state after a top-level child of the root
+// (a design unit, or a comment/pragma between units) has been walked.
+type unitMark struct {
+	child   int    // index of the last root child covered by this mark
+	kind    string // node type of that child
+	start   uint32 // byte range of that child
+	end     uint32
+	lens    []int           // len of each FileFacts slice (see factSliceFields)
+	signals map[string]bool // declaredSignals snapshot; never mutated once taken
+	// translateOff is whether a translate_off region is still open after
+	// this child
+	translateOff bool
+}
+
+// factSliceFields lists the indexes of the FileFacts slice fields. Every fact
+// the tree walk produces is appended to one of them, so a prefix of the walk
+// is fully described by their lengths.
+var factSliceFields = func() []int {
+	var fields []int
+	t := reflect.TypeOf(FileFacts{})
+	for i := 0; i < t.NumField(); i++ {
+		if t.Field(i).Type.Kind() == reflect.Slice {
+			fields = append(fields, i)
+		}
+	}
+	return fields
+}()
+
+// NewTreeStore creates an empty TreeStore.
+func NewTreeStore() *TreeStore {
+	return &TreeStore{files: make(map[string]*parsedFile)}
+}
+
+// Forget drops the state kept for path (e.g. the file was deleted).
+func (s *TreeStore) Forget(path string) {
+	s.mu.Lock()
+	pf := s.files[path]
+	delete(s.files, path)
+	s.mu.Unlock()
+	if pf != nil {
+		pf.tree.Close()
+	}
+}
+
+// Retain drops the state kept for every path not in paths, so files
+// deleted or renamed since an earlier extraction do not keep their tree and
+// content copy for the life of the store.
+func (s *TreeStore) Retain(paths []string) {
+	keep := make(map[string]bool, len(paths))
+	for _, path := range paths {
+		keep[path] = true
+	}
+	var dropped []*parsedFile
+	s.mu.Lock()
+	for path, pf := range s.files {
+		if !keep[path] {
+			dropped = append(dropped, pf)
+			delete(s.files, path)
+		}
+	}
+	s.mu.Unlock()
+	for _, pf := range dropped {
+		pf.tree.Close()
+	}
+}
+
+// Close releases every kept tree.
+func (s *TreeStore) Close() {
+	s.mu.Lock()
+	files := s.files
+	s.files = make(map[string]*parsedFile)
+	s.mu.Unlock()
+	for _, pf := range files {
+		pf.tree.Close()
+	}
+}
+
+// Len returns the number of files with a kept tree.
+func (s *TreeStore) Len() int {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	return len(s.files)
+}
+
+// take removes and returns the state for path; the caller owns it until put.
+func (s *TreeStore) take(path string) *parsedFile {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	pf := s.files[path]
+	delete(s.files, path)
+	return pf
+}
+
+func (s *TreeStore) put(path string, pf *parsedFile) {
+	s.mu.Lock()
+	old := s.files[path]
+	s.files[path] = pf
+	s.mu.Unlock()
+	if old != nil && old != pf {
+		old.tree.Close()
+	}
+}
+
+// extractIncremental is Extract when e.Trees is set.
+func (e *Extractor) extractIncremental(filePath string, content []byte) (FileFacts, error) {
+	prev := e.Trees.take(filePath)
+	if prev != nil && (prev.skipTranslateOff != e.SkipTranslateOff || prev.tier != e.tier) {
+		prev.tree.Close()
+		prev = nil
+	}
+
+	var oldTree *sitter.Tree
+	editStart := 0
+	if prev != nil {
+		edit, changed := computeEdit(prev.content, content)
+		if !changed {
+			// Nothing to reparse; hand out a copy so the kept facts stay intact
+			e.Trees.put(filePath, prev)
+			return cloneFacts(prev.facts), nil
+		}
+		prev.tree.Edit(edit)
+		oldTree = prev.tree
+		editStart = int(edit.StartIndex)
+	}
+
+	parseStart := time.Now()
+	tree, err := e.parser.ParseCtx(context.Background(), oldTree, content)
+	if oldTree != nil {
+		oldTree.Close()
+	}
+	if err != nil {
+		e.parser.Reset()
+		return FileFacts{File: filePath}, fmt.Errorf("parsing: %w", err)
+	}
+	parseDuration := time.Since(parseStart)
+	root := tree.RootNode()
+
+	// Keep the facts of leading units the edit cannot have touched: they end
+	// strictly before the first changed byte and the new tree still has the
+	// same node there.
+	var units []unitMark
+	if prev != nil {
+		for _, m := range prev.units {
+			if int(m.end) >= editStart {
+				break
+			}
+			child := root.Child(m.child)
+			if child == nil || child.Type() != m.kind || child.StartByte() != m.start || child.EndByte() != m.end {
+				break
+			}
+			units = append(units, m)
+		}
+	}
+
+	facts := FileFacts{File: filePath}
+	declaredSignals := e.resetDeclaredSignals()
+	first := 0
+	e.translateOff = false
+	if len(units) > 0 {
+		last := units[len(units)-1]
+		facts = prefixFacts(prev.facts, last.lens)
+		for name := range last.signals {
+			declaredSignals[name] = true
+		}
+		first = last.child + 1
+		e.translateOff = last.translateOff
+	}
+
+	if e.ParseStats {
+		facts.Parse.add(root, parseDuration)
+	}
+	e.prefetchDecls(root, content)
+	units = e.walkUnits(root, first, content, &facts, declaredSignals, units)
+	if e.ParseStats {
+		facts.Parse.addWalk(e)
+	}
+
+	if e.tier == TierFull {
+		facts.CDCCrossings = DetectCDCCrossings(&facts)
+		e.extractVerificationTags(content, &facts)
+	}
+
+	e.Trees.put(filePath, &parsedFile{
+		content:          append([]byte(nil), content...),
+		tree:             tree,
+		facts:            facts,
+		units:            units,
+		skipTranslateOff: e.SkipTranslateOff,
+		tier:             e.tier,
+	})
+	return facts, nil
+}
+
+// walkUnits walks the root's children from index first, exactly as
+// walkTreeWithPkg does for the root, appending a unitMark after each one.
+func (e *Extractor) walkUnits(root *sitter.Node, first int, source []byte, facts *FileFacts, declaredSignals map[string]bool, units []unitMark) []unitMark {
+	childCount := int(root.ChildCount())
+	for i := first; i < childCount; i++ {
+		child := root.Child(i)
+		if e.SkipTranslateOff && child.Type() == "translate_off_pragma" {
+			e.translateOff = true
+		} else {
+			e.walkTreeWithPkg(child, source, facts, "", "", declaredSignals)
+		}
+		unit := markUnit(child, i, facts, declaredSignals, units)
+		unit.translateOff = e.translateOff
+		units = append(units, unit)
+	}
+	return units
+}
+
+func markUnit(child *sitter.Node, index int, facts *FileFacts, declaredSignals map[string]bool, units []unitMark) unitMark {
+	v := reflect.ValueOf(facts).Elem()
+	lens := make([]int, len(factSliceFields))
+	for j, f := range factSliceFields {
+		lens[j] = v.Field(f).Len()
+	}
+	// declaredSignals only grows, so an unchanged size means unchanged contents
+	var signals map[string]bool
+	if n := len(units); n > 0 && len(units[n-1].signals) == len(declaredSignals) {
+		signals = units[n-1].signals
+	} else {
+		signals = make(map[string]bool, len(declaredSignals))
+		for name := range declaredSignals {
+			signals[name] = true
+		}
+	}
+	return unitMark{
+		child:   index,
+		kind:    child.Type(),
+		start:   child.StartByte(),
+		end:     child.EndByte(),
+		lens:    lens,
+		signals: signals,
+	}
+}
+
+// prefixFacts copies the first lens[j] elements of each slice field of src
+// into fresh slices, so appends to the result never write into src.
+func prefixFacts(src FileFacts, lens []int) FileFacts {
+	dst := FileFacts{File: src.File}
+	sv := reflect.ValueOf(src)
+	dv := reflect.ValueOf(&dst).Elem()
+	for j, f := range factSliceFields {
+		n := lens[j]
+		if n == 0 {
+			continue
+		}
+		field := sv.Field(f)
+		out := reflect.MakeSlice(field.Type(), n, n)
+		reflect.Copy(out, field.Slice(0, n))
+		dv.Field(f).Set(out)
+	}
+	return dst
+}
+
+func cloneFacts(src FileFacts) FileFacts {
+	sv := reflect.ValueOf(src)
+	lens := make([]int, len(factSliceFields))
+	for j, f := range factSliceFields {
+		lens[j] = sv.Field(f).Len()
+	}
+	dst := prefixFacts(src, lens)
+	dst.Parse = src.Parse
+	return dst
+}
+
+// computeEdit describes the change from old to cur as a single edit spanning
+// everything between their common prefix and common suffix. It reports false
+// when the contents are identical.
+func computeEdit(old, cur []byte) (sitter.EditInput, bool) {
+	if bytes.Equal(old, cur) {
+		return sitter.EditInput{}, false
+	}
+	n := min(len(old), len(cur))
+	prefix := 0
+	for prefix < n && old[prefix] == cur[prefix] {
+		prefix++
+	}
+	suffix := 0
+	for suffix < n-prefix && old[len(old)-1-suffix] == cur[len(cur)-1-suffix] {
+		suffix++
+	}
+	oldEnd := len(old) - suffix
+	newEnd := len(cur) - suffix
+	return sitter.EditInput{
+		StartIndex:  uint32(prefix),
+		OldEndIndex: uint32(oldEnd),
+		NewEndIndex: uint32(newEnd),
+		StartPoint:  pointAt(old, prefix),
+		OldEndPoint: pointAt(old, oldEnd),
+		NewEndPoint: pointAt(cur, newEnd),
+	}, true
+}
+
+// pointAt converts a byte offset to a tree-sitter point (row, byte column).
+func pointAt(content []byte, offset int) sitter.Point {
+	head := content[:offset]
+	row := bytes.Count(head, []byte{'\n'})
+	col := offset - (bytes.LastIndexByte(head, '\n') + 1)
+	return sitter.Point{Row: uint32(row), Column: uint32(col)}
+}
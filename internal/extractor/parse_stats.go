@@ -0,0 +1,54 @@
+package extractor
+
+import (
+	"time"
+
+	sitter "github.com/smacker/go-tree-sitter"
+)
+
+// ParseStats describes the syntax tree behind a FileFacts: how long
+// tree-sitter took and how big and how broken the tree is. Filled only when
+// Extractor.ParseStats is set; cached facts keep the stats of the run that
+// extracted them.
+type ParseStats struct {
+	ParseMS float64 // tree-sitter parse time (summed over chunks when streamed)
+	Nodes   int     // syntax nodes, anonymous ones included
+	Errors  int     // ERROR and MISSING nodes
+	// Walked is the nodes the fact walker entered and QueryMatches the
+	// declaration query's matches (Extractor.Queries): the cgo traffic the
+	// prefetch saves and the traffic it adds
+	Walked       int
+	QueryMatches int
+}
+
+// addWalk counts the walk that followed e's last prefetchDecls.
+func (s *ParseStats) addWalk(e *Extractor) {
+	s.Walked += e.walked
+	s.QueryMatches += e.decls.matches
+}
+
+// add counts root's tree into s. The walk is a single cursor pass; subtrees
+// without errors are still walked for the node count.
+func (s *ParseStats) add(root *sitter.Node, parse time.Duration) {
+	s.ParseMS += float64(parse.Nanoseconds()) / 1_000_000.0
+	if root == nil {
+		return
+	}
+	cursor := sitter.NewTreeCursor(root)
+	defer cursor.Close()
+	for {
+		node := cursor.CurrentNode()
+		s.Nodes++
+		if node.IsMissing() || node.Type() == "ERROR" {
+			s.Errors++
+		}
+		if cursor.GoToFirstChild() {
+			continue
+		}
+		for !cursor.GoToNextSibling() {
+			if !cursor.GoToParent() {
+				return
+			}
+		}
+	}
+}
@@ -0,0 +1,44 @@
+package extractor
+
+import (
+	"os"
+	"path/filepath"
+	"testing"
+)
+
+func TestParseStatsCountNodesAndErrors(t *testing.T) {
+	dir := t.TempDir()
+	clean := filepath.Join(dir, "clean.vhd")
+	broken := filepath.Join(dir, "broken.vhd")
+	if err := os.WriteFile(clean, []byte("entity a is end entity;\narchitecture rtl of a is begin end architecture;\n"), 0o600); err != nil {
+		t.Fatal(err)
+	}
+	if err := os.WriteFile(broken, []byte("entity a is end entity;\narchitecture rtl of a is begin x <= ; end architecture;\n"), 0o600); err != nil {
+		t.Fatal(err)
+	}
+
+	e := New()
+	facts, err := e.Extract(clean)
+	if err != nil {
+		t.Fatalf("extract: %v", err)
+	}
+	if facts.Parse != (ParseStats{}) {
+		t.Fatalf("parse stats collected without ParseStats: %+v", facts.Parse)
+	}
+
+	e.ParseStats = true
+	facts, err = e.Extract(clean)
+	if err != nil {
+		t.Fatalf("extract: %v", err)
+	}
+	if facts.Parse.Nodes == 0 || facts.Parse.Errors != 0 {
+		t.Fatalf("clean file: %+v, want nodes and no errors", facts.Parse)
+	}
+	facts, err = e.Extract(broken)
+	if err != nil {
+		t.Fatalf("extract: %v", err)
+	}
+	if facts.Parse.Errors == 0 {
+		t.Fatalf("broken file: %+v, want errors", facts.Parse)
+	}
+}
@@ -109,3 +109,173 @@ func matchComponentInstantiation(line string) []string {
 	}
 	return nil
 }
+
+// Patterns used outside the line matchers above. Compiled once here; never
+// call regexp.MustCompile from extraction code.
+var (
+	// Pattern: <unit> = ... or <unit>; at the start of a line in a units block
+	physicalUnitPattern = regexp.MustCompile(`(?m)^[ \t]*([A-Za-z][A-Za-z0-9_]*)\s*(=|;)`)
+)
+
+// The scanners below replace regexes on the hottest paths. Each documents
+// the pattern it implements and returns the same leftmost match; submatches
+// are subslices of the input, so nothing is allocated.
+
+// scanNumericRange finds `\(\s*(\d+)\s+(?:downto|to)\s+(\d+)\s*\)` in a
+// lowercased type string and returns the two bounds.
+func scanNumericRange(s string) (left, right string, ok bool) {
+	for i := 0; i < len(s); i++ {
+		if s[i] != '(' {
+			continue
+		}
+		j := skipRegexSpace(s, i+1)
+		left, j = scanDigits(s, j)
+		if left == "" {
+			continue
+		}
+		k := skipRegexSpace(s, j)
+		if k == j {
+			continue
+		}
+		switch {
+		case strings.HasPrefix(s[k:], "downto"):
+			k += len("downto")
+		case strings.HasPrefix(s[k:], "to"):
+			k += len("to")
+		default:
+			continue
+		}
+		j = skipRegexSpace(s, k)
+		if j == k {
+			continue
+		}
+		right, j = scanDigits(s, j)
+		if right == "" {
+			continue
+		}
+		j = skipRegexSpace(s, j)
+		if j < len(s) && s[j] == ')' {
+			return left, right, true
+		}
+	}
+	return "", "", false
+}
+
+// scanIntegerRange finds `(?:integer|natural|positive)\s+range\s+(\d+)\s+to\s+(\d+)`
+// in a lowercased type string and returns the two bounds.
+func scanIntegerRange(s string) (low, high string, ok bool) {
+	for i := 0; i < len(s); i++ {
+		j := i
+		switch {
+		case strings.HasPrefix(s[i:], "integer"):
+			j += len("integer")
+		case strings.HasPrefix(s[i:], "natural"):
+			j += len("natural")
+		case strings.HasPrefix(s[i:], "positive"):
+			j += len("positive")
+		default:
+			continue
+		}
+		k := skipRegexSpace(s, j)
+		if k == j || !strings.HasPrefix(s[k:], "range") {
+			continue
+		}
+		j = k + len("range")
+		k = skipRegexSpace(s, j)
+		if k == j {
+			continue
+		}
+		low, j = scanDigits(s, k)
+		if low == "" {
+			continue
+		}
+		k = skipRegexSpace(s, j)
+		if k == j || !strings.HasPrefix(s[k:], "to") {
+			continue
+		}
+		j = k + len("to")
+		k = skipRegexSpace(s, j)
+		if k == j {
+			continue
+		}
+		high, _ = scanDigits(s, k)
+		if high == "" {
+			continue
+		}
+		return low, high, true
+	}
+	return "", "", false
+}
+
+// scanForLoopVar finds `(?i)\bfor\s+([a-zA-Z_][a-zA-Z0-9_]*)\s+in\b` in
+// loop source text and returns the loop variable.
+func scanForLoopVar(text []byte) ([]byte, bool) {
+	for i := 0; i+3 <= len(text); i++ {
+		if !equalFoldASCII(text[i:i+3], "for") || (i > 0 && isIdentChar(text[i-1])) {
+			continue
+		}
+		j := skipRegexSpaceBytes(text, i+3)
+		if j == i+3 || j == len(text) || !isIdentifierStart(text[j]) {
+			continue
+		}
+		start := j
+		for j < len(text) && isIdentChar(text[j]) {
+			j++
+		}
+		name := text[start:j]
+		k := skipRegexSpaceBytes(text, j)
+		if k == j || k+2 > len(text) || !equalFoldASCII(text[k:k+2], "in") {
+			continue
+		}
+		if k+2 < len(text) && isIdentChar(text[k+2]) {
+			continue
+		}
+		return name, true
+	}
+	return nil, false
+}
+
+// isRegexSpace is RE2's \s
+func isRegexSpace(c byte) bool {
+	return c == ' ' || c == '\t' || c == '\n' || c == '\f' || c == '\r'
+}
+
+func skipRegexSpace(s string, i int) int {
+	for i < len(s) && isRegexSpace(s[i]) {
+		i++
+	}
+	return i
+}
+
+func skipRegexSpaceBytes(b []byte, i int) int {
+	for i < len(b) && isRegexSpace(b[i]) {
+		i++
+	}
+	return i
+}
+
+// scanDigits returns the run of ASCII digits at s[i:] and the index after it.
+func scanDigits(s string, i int) (string, int) {
+	start := i
+	for i < len(s) && s[i] >= '0' && s[i] <= '9' {
+		i++
+	}
+	return s[start:i], i
+}
+
+// equalFoldASCII compares b to a lowercase ASCII word, ignoring case.
+func equalFoldASCII(b []byte, word string) bool {
+	if len(b) != len(word) {
+		return false
+	}
+	for i := 0; i < len(b); i++ {
+		c := b[i]
+		if c >= 'A' && c <= 'Z' {
+			c += 'a' - 'A'
+		}
+		if c != word[i] {
+			return false
+		}
+	}
+	return true
+}
@@ -0,0 +1,59 @@
+package extractor
+
+import (
+	"regexp"
+	"testing"
+)
+
+// The scanners must agree with the regexes they replaced.
+func TestScannersMatchRegexes(t *testing.T) {
+	numericRange := regexp.MustCompile(`\(\s*(\d+)\s+(?:downto|to)\s+(\d+)\s*\)`)
+	integerRange := regexp.MustCompile(`(?:integer|natural|positive)\s+range\s+(\d+)\s+to\s+(\d+)`)
+	forLoop := regexp.MustCompile(`(?i)\bfor\s+([a-zA-Z_][a-zA-Z0-9_]*)\s+in\b`)
+
+	types := []string{
+		"std_logic_vector(7 downto 0)",
+		"unsigned( 0 to 15 )",
+		"signed(15\tdownto\n8)",
+		"std_logic_vector(width-1 downto 0)",
+		"std_logic_vector(7downto 0)",
+		"array (0 to 3) of std_logic_vector(7 downto 0)",
+		"std_logic_vector((7 downto 0)",
+		"integer range 0 to 255",
+		"natural  range 1 to 7",
+		"positive range 0to 3",
+		"myinteger range 2 to 9 extra",
+		"integer range 0 to",
+		"",
+	}
+	for _, typ := range types {
+		left, right, ok := scanNumericRange(typ)
+		m := numericRange.FindStringSubmatch(typ)
+		if ok != (m != nil) || (ok && (left != m[1] || right != m[2])) {
+			t.Fatalf("scanNumericRange(%q) = %q %q %v, regex %q", typ, left, right, ok, m)
+		}
+		low, high, ok := scanIntegerRange(typ)
+		m = integerRange.FindStringSubmatch(typ)
+		if ok != (m != nil) || (ok && (low != m[1] || high != m[2])) {
+			t.Fatalf("scanIntegerRange(%q) = %q %q %v, regex %q", typ, low, high, ok, m)
+		}
+	}
+
+	loops := []string{
+		"for i in 0 to 7 loop",
+		"L1: FOR Idx IN data'range LOOP",
+		"before: for\n\tk\tin x loop",
+		"xfor i in 0 to 1 loop",
+		"for i inside loop",
+		"while done = '0' loop",
+		"for 1i in 0 to 1 loop",
+		"for",
+	}
+	for _, text := range loops {
+		name, ok := scanForLoopVar([]byte(text))
+		m := forLoop.FindStringSubmatch(text)
+		if ok != (m != nil) || (ok && string(name) != m[1]) {
+			t.Fatalf("scanForLoopVar(%q) = %q %v, regex %q", text, name, ok, m)
+		}
+	}
+}
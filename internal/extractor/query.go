@@ -0,0 +1,211 @@
+package extractor
+
+import (
+	"sync"
+
+	sitter "github.com/smacker/go-tree-sitter"
+)
+
+// Query-driven prefetch of shallow declaration facts.
+//
+// With Extractor.Queries set, one QueryCursor pass over the tree collects the
+// names of entities, architectures, packages and library clauses, matched in
+// C by the patterns below. The hand walker still visits every node for the
+// context-dependent semantics (ports, signals, processes, generates, ...) but
+// reads these names from the prefetch instead of a ChildByFieldName and
+// child scan per declaration. A declaration the patterns did not match (e.g.
+// a missing name) falls back to the extractXxx function, so the facts are
+// the same either way.
+//
+// The query pass is only a win if the walker work it saves outweighs its own
+// matches; with Extractor.ParseStats both are counted per file
+// (ParseStats.Walked, ParseStats.QueryMatches) and reported by --timing.
+//
+// The patterns are copied from tree-sitter-vhdl/queries/extract.scm (go:embed
+// cannot reach outside the package); TestExtractQueryMatchesQueryFile keeps
+// them in sync.
+const extractQuery = `
+(entity_declaration
+  name: (identifier) @entity.name) @entity
+
+(architecture_body
+  name: (identifier) @architecture.name
+  entity: (identifier) @architecture.entity) @architecture
+
+(package_declaration
+  name: (identifier) @package.name) @package
+
+(library_clause
+  (identifier) @library.name) @library
+`
+
+// compiledQuery is extractQuery with its capture ids resolved.
+type compiledQuery struct {
+	query *sitter.Query
+
+	entity, entityName             uint32
+	architecture, archName, archOf uint32
+	pkg, pkgName                   uint32
+	library, libraryName           uint32
+}
+
+var (
+	extractQueryOnce sync.Once
+	extractQueryC    *compiledQuery
+	extractQueryErr  error
+)
+
+// loadExtractQuery compiles extractQuery once per process; the compiled
+// query is read-only and shared by all Extractors.
+func loadExtractQuery(lang *sitter.Language) (*compiledQuery, error) {
+	extractQueryOnce.Do(func() {
+		q, err := sitter.NewQuery([]byte(extractQuery), lang)
+		if err != nil {
+			extractQueryErr = err
+			return
+		}
+		ids := make(map[string]uint32, q.CaptureCount())
+		for i := uint32(0); i < q.CaptureCount(); i++ {
+			ids[q.CaptureNameForId(i)] = i
+		}
+		extractQueryC = &compiledQuery{
+			query:        q,
+			entity:       ids["entity"],
+			entityName:   ids["entity.name"],
+			architecture: ids["architecture"],
+			archName:     ids["architecture.name"],
+			archOf:       ids["architecture.entity"],
+			pkg:          ids["package"],
+			pkgName:      ids["package.name"],
+			library:      ids["library"],
+			libraryName:  ids["library.name"],
+		}
+	})
+	return extractQueryC, extractQueryErr
+}
+
+// declPrefetch holds one file's query results, keyed by the declaration
+// node's start byte (unique per node type within a tree).
+type declPrefetch struct {
+	active        bool
+	matches       int
+	entities      map[uint32]string
+	architectures map[uint32][2]string
+	packages      map[uint32]string
+	libraries     map[uint32][]string
+}
+
+func (p *declPrefetch) reset() {
+	p.active = false
+	p.matches = 0
+	if p.entities == nil {
+		p.entities = make(map[uint32]string)
+		p.architectures = make(map[uint32][2]string)
+		p.packages = make(map[uint32]string)
+		p.libraries = make(map[uint32][]string)
+		return
+	}
+	clear(p.entities)
+	clear(p.architectures)
+	clear(p.packages)
+	clear(p.libraries)
+}
+
+// prefetchDecls runs the declaration query over root when e.Queries is set.
+// If the query cannot be compiled the walker extracts everything itself.
+func (e *Extractor) prefetchDecls(root *sitter.Node, source []byte) {
+	p := &e.decls
+	p.reset()
+	e.walked = 0
+	if !e.Queries {
+		return
+	}
+	cq, err := loadExtractQuery(e.lang)
+	if err != nil {
+		return
+	}
+	if e.cursor == nil {
+		e.cursor = sitter.NewQueryCursor()
+	}
+	e.cursor.Exec(cq.query, root)
+	for {
+		m, ok := e.cursor.NextMatch()
+		if !ok {
+			break
+		}
+		p.matches++
+		var unit *sitter.Node
+		var kind uint32
+		var name, of string
+		for _, c := range m.Captures {
+			switch c.Index {
+			case cq.entity, cq.architecture, cq.pkg, cq.library:
+				unit, kind = c.Node, c.Index
+			case cq.entityName, cq.archName, cq.pkgName, cq.libraryName:
+				name = c.Node.Content(source)
+			case cq.archOf:
+				of = c.Node.Content(source)
+			}
+		}
+		if unit == nil {
+			continue
+		}
+		start := unit.StartByte()
+		switch kind {
+		case cq.entity:
+			p.entities[start] = name
+		case cq.architecture:
+			p.architectures[start] = [2]string{name, of}
+		case cq.pkg:
+			p.packages[start] = name
+		case cq.library:
+			// One match per identifier, in source order
+			p.libraries[start] = append(p.libraries[start], name)
+		}
+	}
+	p.active = true
+}
+
+// entityAt is extractEntity, taking the name from the prefetch when present.
+func (e *Extractor) entityAt(node *sitter.Node, source []byte) Entity {
+	if e.decls.active {
+		if name, ok := e.decls.entities[node.StartByte()]; ok {
+			entity := Entity{Name: name, Line: int(node.StartPoint().Row) + 1}
+			if name != "" {
+				entity.Generics = e.extractGenericDeclsFromNode(node, source, name, "")
+			}
+			return entity
+		}
+	}
+	return e.extractEntity(node, source)
+}
+
+// architectureAt is extractArchitecture via the prefetch when present.
+func (e *Extractor) architectureAt(node *sitter.Node, source []byte) Architecture {
+	if e.decls.active {
+		if names, ok := e.decls.architectures[node.StartByte()]; ok {
+			return Architecture{Name: names[0], EntityName: names[1], Line: int(node.StartPoint().Row) + 1}
+		}
+	}
+	return e.extractArchitecture(node, source)
+}
+
+// packageAt is extractPackage via the prefetch when present.
+func (e *Extractor) packageAt(node *sitter.Node, source []byte) Package {
+	if e.decls.active {
+		if name, ok := e.decls.packages[node.StartByte()]; ok {
+			return Package{Name: name, Line: int(node.StartPoint().Row) + 1}
+		}
+	}
+	return e.extractPackage(node, source)
+}
+
+// prefetchedLibraries returns the library names of a library_clause node
+// from the prefetch; ok is false when the walker must scan the clause.
+func (e *Extractor) prefetchedLibraries(node *sitter.Node) (libraries []string, ok bool) {
+	if !e.decls.active {
+		return nil, false
+	}
+	libraries, ok = e.decls.libraries[node.StartByte()]
+	return libraries, ok
+}
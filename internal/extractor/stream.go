@@ -0,0 +1,342 @@
+package extractor
+
+import (
+	"bufio"
+	"context"
+	"fmt"
+	"io"
+	"os"
+	"reflect"
+	"sync"
+	"time"
+
+	sitter "github.com/smacker/go-tree-sitter"
+)
+
+// Streaming extraction for huge (generated) files.
+//
+// A file of at least Extractor.StreamThreshold bytes is read line by line
+// and cut into chunks at design unit boundaries: a line starting in column 0
+// with entity, architecture, package, configuration, context or library,
+// after a ';' that ended the previous unit. Small units are batched until a
+// chunk reaches streamChunkMin. Each chunk is parsed into its own tree,
+// walked like the root children of a whole-file parse, has its line numbers
+// shifted, and is appended to the file's facts before the next chunk is
+// read. Peak source and tree memory is then one chunk, not one file.
+//
+// Only the FileFacts of the file itself grow with it.
+
+// streamChunkMin is the smallest chunk cut at a unit boundary (a var so
+// tests can force one unit per chunk).
+var streamChunkMin = 1 << 20
+
+const streamReadBuffer = 256 << 10
+
+// MemoryBudget caps the source bytes held at once by the Extractors sharing
+// it: the whole file on the normal path and the chunk buffer when streaming,
+// charged before the buffer grows. A request larger than the cap waits until
+// nothing else is held, so a single huge file still goes through. A nil
+// budget is unlimited.
+type MemoryBudget struct {
+	mu    sync.Mutex
+	cond  *sync.Cond
+	limit int64
+	used  int64
+}
+
+// NewMemoryBudget returns a budget of limit bytes, or nil when limit <= 0.
+func NewMemoryBudget(limit int64) *MemoryBudget {
+	if limit <= 0 {
+		return nil
+	}
+	b := &MemoryBudget{limit: limit}
+	b.cond = sync.NewCond(&b.mu)
+	return b
+}
+
+// Acquire blocks until n bytes (at most the limit) fit and returns the amount
+// charged, to be handed back to Release.
+func (b *MemoryBudget) Acquire(n int64) int64 {
+	if b == nil || n <= 0 {
+		return 0
+	}
+	if n > b.limit {
+		n = b.limit
+	}
+	b.mu.Lock()
+	for b.used > 0 && b.used+n > b.limit {
+		b.cond.Wait()
+	}
+	b.used += n
+	b.mu.Unlock()
+	return n
+}
+
+// Release returns n bytes charged by Acquire.
+func (b *MemoryBudget) Release(n int64) {
+	if b == nil || n <= 0 {
+		return
+	}
+	b.mu.Lock()
+	b.used -= n
+	b.mu.Unlock()
+	b.cond.Broadcast()
+}
+
+// grow turns a charge of charged bytes into one covering n, returning the
+// new charge. The old charge is released before waiting, so two growers
+// cannot each hold what the other waits for; a charge already at the limit
+// covers anything.
+func (b *MemoryBudget) grow(charged, n int64) int64 {
+	if b == nil || n <= charged || charged >= b.limit {
+		return charged
+	}
+	b.Release(charged)
+	return b.Acquire(n)
+}
+
+// extractStreaming is Extract for files of at least StreamThreshold bytes.
+func (e *Extractor) extractStreaming(filePath string) (FileFacts, error) {
+	facts := FileFacts{File: filePath}
+	f, err := os.Open(filePath)
+	if err != nil {
+		return facts, fmt.Errorf("reading file: %w", err)
+	}
+	defer f.Close()
+
+	if e.parser == nil {
+		e.parser = sitter.NewParser()
+		e.parser.SetLanguage(e.lang)
+	}
+	if e.Trees != nil {
+		// Too big to keep a copy of; the next run starts from scratch
+		e.Trees.Forget(filePath)
+	}
+	declaredSignals := e.resetDeclaredSignals()
+
+	r := bufio.NewReaderSize(f, streamReadBuffer)
+	var split unitSplitter
+	chunk := e.content[:0]
+	var line []byte
+	chunkLine, lines := 0, 0
+	skipping := false
+	var charged int64
+	defer func() { e.Budget.Release(charged) }()
+
+	flush := func() error {
+		var err error
+		skipping, err = e.extractChunk(chunk, chunkLine, &facts, declaredSignals, skipping)
+		chunk = chunk[:0]
+		chunkLine = lines
+		return err
+	}
+
+	for {
+		var readErr error
+		line, readErr = readLine(r, line[:0])
+		if len(line) > 0 {
+			if split.startsUnit(line) && len(chunk) >= streamChunkMin {
+				if err := flush(); err != nil {
+					return facts, err
+				}
+			}
+			split.scan(line)
+			if need := len(chunk) + len(line); need > cap(chunk) {
+				// Charged before it is allocated: a unit far over
+				// streamChunkMin waits for budget like a whole file
+				size := max(2*cap(chunk), need, streamReadBuffer)
+				charged = e.Budget.grow(charged, int64(size))
+				chunk = append(make([]byte, 0, size), chunk...)
+			}
+			chunk = append(chunk, line...)
+			if line[len(line)-1] == '\n' {
+				lines++
+			}
+		}
+		if readErr == io.EOF {
+			break
+		}
+		if readErr != nil {
+			return facts, fmt.Errorf("reading file: %w", readErr)
+		}
+	}
+	if len(chunk) > 0 {
+		if err := flush(); err != nil {
+			return facts, err
+		}
+	}
+	// Keep the buffer for the next file only if the normal path could
+	// have grown one as large
+	if int64(cap(chunk)) < e.StreamThreshold {
+		e.content = chunk[:0]
+	} else {
+		e.content = nil
+	}
+
+	if e.tier == TierFull {
+		facts.CDCCrossings = DetectCDCCrossings(&facts)
+	}
+	return facts, nil
+}
+
+// extractChunk parses one chunk whose first line is line firstLine+1 of the
+// file and appends its facts. skipping is whether a translate_off region
+// from an earlier chunk is still open; the returned value is the same for
+// the next chunk.
+func (e *Extractor) extractChunk(source []byte, firstLine int, facts *FileFacts, declaredSignals map[string]bool, skipping bool) (bool, error) {
+	parseStart := time.Now()
+	tree, err := e.parser.ParseCtx(context.Background(), nil, source)
+	if err != nil {
+		e.parser.Reset()
+		return skipping, fmt.Errorf("parsing: %w", err)
+	}
+	defer tree.Close()
+	root := tree.RootNode()
+	if e.ParseStats {
+		facts.Parse.add(root, time.Since(parseStart))
+	}
+	e.prefetchDecls(root, source)
+
+	// The same root-level walk as walkTreeWithPkg, with the translate_off
+	// region allowed to run on into the next chunk
+	part := FileFacts{File: facts.File}
+	e.translateOff = skipping
+	childCount := int(root.ChildCount())
+	for i := 0; i < childCount; i++ {
+		child := root.Child(i)
+		if e.SkipTranslateOff && child.Type() == "translate_off_pragma" {
+			e.translateOff = true
+			continue
+		}
+		e.walkTreeWithPkg(child, source, &part, "", "", declaredSignals)
+	}
+	skipping = e.translateOff
+	if e.ParseStats {
+		facts.Parse.addWalk(e)
+	}
+	if e.tier == TierFull {
+		e.extractVerificationTags(source, &part)
+	}
+
+	shiftLines(reflect.ValueOf(&part).Elem(), firstLine)
+	dst := reflect.ValueOf(facts).Elem()
+	src := reflect.ValueOf(&part).Elem()
+	for _, f := range factSliceFields {
+		if src.Field(f).Len() > 0 {
+			dst.Field(f).Set(reflect.AppendSlice(dst.Field(f), src.Field(f)))
+		}
+	}
+	return skipping, nil
+}
+
+// readLine appends the next line of r, newline included, to buf.
+func readLine(r *bufio.Reader, buf []byte) ([]byte, error) {
+	for {
+		frag, err := r.ReadSlice('\n')
+		buf = append(buf, frag...)
+		if err != bufio.ErrBufferFull {
+			return buf, err
+		}
+	}
+}
+
+// shiftLines adds delta to every Line, LineStart and LineEnd int field
+// reachable from v through structs, slices and pointers.
+func shiftLines(v reflect.Value, delta int) {
+	if delta == 0 {
+		return
+	}
+	switch v.Kind() {
+	case reflect.Struct:
+		t := v.Type()
+		for i := 0; i < v.NumField(); i++ {
+			field := v.Field(i)
+			switch name := t.Field(i).Name; {
+			case field.Kind() == reflect.Int && (name == "Line" || name == "LineStart" || name == "LineEnd"):
+				field.SetInt(field.Int() + int64(delta))
+			case field.Kind() == reflect.Struct || field.Kind() == reflect.Slice || field.Kind() == reflect.Pointer:
+				shiftLines(field, delta)
+			}
+		}
+	case reflect.Slice:
+		if v.Type().Elem().Kind() == reflect.String {
+			return
+		}
+		for i := 0; i < v.Len(); i++ {
+			shiftLines(v.Index(i), delta)
+		}
+	case reflect.Pointer:
+		if !v.IsNil() {
+			shiftLines(v.Elem(), delta)
+		}
+	}
+}
+
+// unitSplitter finds design unit boundaries in a stream of lines, tracking
+// just enough lexical state (block comments, the last significant byte) to
+// tell a unit keyword at the start of a line from one inside a statement.
+type unitSplitter struct {
+	inBlockComment bool
+	last           byte
+}
+
+// streamUnitKeywords start a design unit or its context clause
+var streamUnitKeywords = []string{"entity", "architecture", "package", "configuration", "context", "library"}
+
+// startsUnit reports whether line, read after the lines already scanned,
+// starts a new design unit.
+func (s *unitSplitter) startsUnit(line []byte) bool {
+	if s.inBlockComment || s.last != ';' || len(line) == 0 || !isASCIILetter(line[0]) {
+		return false
+	}
+	end := 0
+	for end < len(line) && isASCIILetter(line[end]) {
+		end++
+	}
+	if end < len(line) && !isRegexSpace(line[end]) {
+		return false
+	}
+	for _, kw := range streamUnitKeywords {
+		if equalFoldASCII(line[:end], kw) {
+			return true
+		}
+	}
+	return false
+}
+
+// scan updates the state past line.
+func (s *unitSplitter) scan(line []byte) {
+	for i := 0; i < len(line); i++ {
+		c := line[i]
+		if s.inBlockComment {
+			if c == '*' && i+1 < len(line) && line[i+1] == '/' {
+				s.inBlockComment = false
+				i++
+			}
+			continue
+		}
+		switch {
+		case isRegexSpace(c):
+		case c == '-' && i+1 < len(line) && line[i+1] == '-':
+			return
+		case c == '/' && i+1 < len(line) && line[i+1] == '*':
+			s.inBlockComment = true
+			i++
+		case c == '"' || c == '\\':
+			// String literal or extended identifier; neither spans lines
+			for i++; i < len(line) && line[i] != c; i++ {
+			}
+			s.last = c
+		case c == '\'' && i+2 < len(line) && line[i+2] == '\'':
+			// Character literal, e.g. '"' or ';'
+			i += 2
+			s.last = '\''
+		default:
+			s.last = c
+		}
+	}
+}
+
+func isASCIILetter(c byte) bool {
+	return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')
+}
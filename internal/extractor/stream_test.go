@@ -0,0 +1,178 @@
+package extractor
+
+import (
+	"bufio"
+	"fmt"
+	"os"
+	"path/filepath"
+	"reflect"
+	"strings"
+	"testing"
+	"time"
+)
+
+func TestExtractorStreamingMatchesWhole(t *testing.T) {
+	vhdl := `library ieee;
+use ieee.std_logic_1164.all;
+
+package s_pkg is
+  constant W : integer := 4;
+end package;
+
+entity s_child is
+  port(a : in std_logic; y : out std_logic);
+end entity;
+
+architecture rtl of s_child is
+begin
+  y <= a;
+end architecture;
+
+-- synthesis translate_off
+entity s_sim is end;
+-- synthesis translate_on
+
+library ieee;
+use ieee.std_logic_1164.all;
+entity s_top is
+  port(clk : in std_logic; d : in std_logic; q : out std_logic);
+end entity;
+
+architecture rtl of s_top is
+  signal r : std_logic;
+begin
+  u0 : entity work.s_child port map(a => r, y => q);
+  p_reg : process(clk)
+  begin
+    if rising_edge(clk) then
+      r <= d;
+    end if;
+  end process;
+end architecture;
+`
+	dir := t.TempDir()
+	path := filepath.Join(dir, "s.vhd")
+	if err := os.WriteFile(path, []byte(vhdl), 0o600); err != nil {
+		t.Fatalf("write vhdl: %v", err)
+	}
+
+	oldMin := streamChunkMin
+	streamChunkMin = 1 // one design unit per chunk
+	defer func() { streamChunkMin = oldMin }()
+
+	for _, skip := range []bool{false, true} {
+		whole := New()
+		whole.SkipTranslateOff = skip
+		want, err := whole.Extract(path)
+		if err != nil {
+			t.Fatalf("whole extract: %v", err)
+		}
+		streamed := New()
+		streamed.SkipTranslateOff = skip
+		streamed.StreamThreshold = 1
+		streamed.Budget = NewMemoryBudget(64)
+		got, err := streamed.Extract(path)
+		if err != nil {
+			t.Fatalf("streaming extract: %v", err)
+		}
+		if !reflect.DeepEqual(got, want) {
+			t.Fatalf("skip=%v: streamed facts differ from a whole-file parse\ngot:  %#v\nwant: %#v", skip, got, want)
+		}
+	}
+}
+
+func TestUnitSplitterBoundaries(t *testing.T) {
+	src := `library ieee;
+use ieee.all;
+entity a is
+  port(x : in bit); -- entity
+end;
+/* entity
+entity b is */
+architecture r of a is
+  signal s : character := ';'
+    ;
+begin
+end;
+PACKAGE p is
+end;
+entityx
+`
+	r := bufio.NewReaderSize(strings.NewReader(src), 16)
+	var split unitSplitter
+	var got []string
+	var line []byte
+	for {
+		var err error
+		line, err = readLine(r, line[:0])
+		if len(line) > 0 {
+			if split.startsUnit(line) {
+				got = append(got, strings.TrimSpace(string(line)))
+			}
+			split.scan(line)
+		}
+		if err != nil {
+			break
+		}
+	}
+	want := []string{"entity a is", "architecture r of a is", "PACKAGE p is"}
+	if !reflect.DeepEqual(got, want) {
+		t.Fatalf("unit boundaries = %q, want %q", got, want)
+	}
+}
+
+func TestMemoryBudgetGrow(t *testing.T) {
+	b := NewMemoryBudget(100)
+	held := b.Acquire(60)
+	charged := b.grow(0, 30)
+	if charged != 30 || b.used != 90 {
+		t.Fatalf("grow within the limit: charged %d, used %d", charged, b.used)
+	}
+
+	done := make(chan int64)
+	go func() { done <- b.grow(charged, 80) }()
+	select {
+	case <-done:
+		t.Fatal("grow past the limit did not wait for other holders")
+	case <-time.After(20 * time.Millisecond):
+	}
+	b.Release(held)
+	if charged = <-done; charged != 80 || b.used != 80 {
+		t.Fatalf("grow after release: charged %d, used %d", charged, b.used)
+	}
+	if got := b.grow(charged, 500); got != 100 {
+		t.Fatalf("oversize grow charged %d, want the limit", got)
+	}
+	b.Release(100)
+	if b.used != 0 {
+		t.Fatalf("budget still holds %d bytes", b.used)
+	}
+}
+
+func TestExtractorStreamingDropsLargeBuffer(t *testing.T) {
+	var src strings.Builder
+	for i := 0; i < 200; i++ {
+		fmt.Fprintf(&src, "entity e%d is\nend entity;\n", i)
+	}
+	path := filepath.Join(t.TempDir(), "big.vhd")
+	if err := os.WriteFile(path, []byte(src.String()), 0o600); err != nil {
+		t.Fatalf("write vhdl: %v", err)
+	}
+
+	e := New()
+	e.StreamThreshold = 1024
+	e.Budget = NewMemoryBudget(1 << 20)
+	facts, err := e.Extract(path)
+	if err != nil {
+		t.Fatalf("streaming extract: %v", err)
+	}
+	if len(facts.Entities) != 200 {
+		t.Fatalf("got %d entities, want 200", len(facts.Entities))
+	}
+	if e.Budget.used != 0 {
+		t.Fatalf("budget still holds %d bytes after the file", e.Budget.used)
+	}
+	if int64(cap(e.content)) >= e.StreamThreshold {
+		t.Fatalf("kept a %d byte buffer, over the stream threshold", cap(e.content))
+	}
+}
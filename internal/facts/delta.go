@@ -1,5 +1,7 @@
 package facts
 
+import "sync"
+
 // Delta captures added and removed fact rows between two snapshots.
 type Delta struct {
 	Added   Tables `json:"added"`
@@ -8,36 +10,68 @@ type Delta struct {
 
 // ComputeDelta computes row-level additions and removals between two snapshots.
 func ComputeDelta(prev, next Tables) Delta {
-	return Delta{
-		Added:   diffTables(prev, next),
-		Removed: diffTables(next, prev),
+	return computeDelta(prev, next, nil)
+}
+
+// ComputeDeltaForFiles computes the delta for rows of the given files only.
+// It equals FilterDeltaByFiles(ComputeDelta(prev, next), files) without
+// hashing the rows of every other file.
+func ComputeDeltaForFiles(prev, next Tables, files map[string]bool) Delta {
+	if len(files) == 0 {
+		return Delta{
+			Added:   emptyTables(),
+			Removed: emptyTables(),
+		}
 	}
+	return computeDelta(prev, next, files)
 }
 
-func diffTables(from, to Tables) Tables {
-	out := emptyTables()
-
-	out.Files = diffFileRows(from.Files, to.Files)
-	out.Entities = diffEntityRows(from.Entities, to.Entities)
-	out.Architectures = diffArchitectureRows(from.Architectures, to.Architectures)
-	out.Packages = diffPackageRows(from.Packages, to.Packages)
-	out.Ports = diffPortRows(from.Ports, to.Ports)
-	out.Signals = diffSignalRows(from.Signals, to.Signals)
-	out.Instances = diffInstanceRows(from.Instances, to.Instances)
-	out.Dependencies = diffDependencyRows(from.Dependencies, to.Dependencies)
-	out.UseClauses = diffUseClauseRows(from.UseClauses, to.UseClauses)
-	out.LibraryClauses = diffLibraryClauseRows(from.LibraryClauses, to.LibraryClauses)
-	out.ContextClauses = diffContextClauseRows(from.ContextClauses, to.ContextClauses)
-	out.Processes = diffProcessRows(from.Processes, to.Processes)
-	out.Generates = diffGenerateRows(from.Generates, to.Generates)
-	out.Types = diffTypeRows(from.Types, to.Types)
-	out.Subtypes = diffSubtypeRows(from.Subtypes, to.Subtypes)
-	out.Functions = diffFunctionRows(from.Functions, to.Functions)
-	out.Procedures = diffProcedureRows(from.Procedures, to.Procedures)
-	out.Constants = diffConstantRows(from.Constants, to.Constants)
-	out.Symbols = diffSymbolRows(from.Symbols, to.Symbols)
-
-	return out
+// computeDelta diffs every table concurrently; files == nil means all rows.
+func computeDelta(prev, next Tables, files map[string]bool) Delta {
+	delta := Delta{
+		Added:   emptyTables(),
+		Removed: emptyTables(),
+	}
+	add, rem := &delta.Added, &delta.Removed
+
+	var wg sync.WaitGroup
+	run := func(diff func()) {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			diff()
+		}()
+	}
+	run(func() { add.Files, rem.Files = diffFileRows(prev.Files, next.Files, files) })
+	run(func() { add.Entities, rem.Entities = diffEntityRows(prev.Entities, next.Entities, files) })
+	run(func() {
+		add.Architectures, rem.Architectures = diffArchitectureRows(prev.Architectures, next.Architectures, files)
+	})
+	run(func() { add.Packages, rem.Packages = diffPackageRows(prev.Packages, next.Packages, files) })
+	run(func() { add.Ports, rem.Ports = diffPortRows(prev.Ports, next.Ports, files) })
+	run(func() { add.Signals, rem.Signals = diffSignalRows(prev.Signals, next.Signals, files) })
+	run(func() { add.Instances, rem.Instances = diffInstanceRows(prev.Instances, next.Instances, files) })
+	run(func() {
+		add.Dependencies, rem.Dependencies = diffDependencyRows(prev.Dependencies, next.Dependencies, files)
+	})
+	run(func() { add.UseClauses, rem.UseClauses = diffUseClauseRows(prev.UseClauses, next.UseClauses, files) })
+	run(func() {
+		add.LibraryClauses, rem.LibraryClauses = diffLibraryClauseRows(prev.LibraryClauses, next.LibraryClauses, files)
+	})
+	run(func() {
+		add.ContextClauses, rem.ContextClauses = diffContextClauseRows(prev.ContextClauses, next.ContextClauses, files)
+	})
+	run(func() { add.Processes, rem.Processes = diffProcessRows(prev.Processes, next.Processes, files) })
+	run(func() { add.Generates, rem.Generates = diffGenerateRows(prev.Generates, next.Generates, files) })
+	run(func() { add.Types, rem.Types = diffTypeRows(prev.Types, next.Types, files) })
+	run(func() { add.Subtypes, rem.Subtypes = diffSubtypeRows(prev.Subtypes, next.Subtypes, files) })
+	run(func() { add.Functions, rem.Functions = diffFunctionRows(prev.Functions, next.Functions, files) })
+	run(func() { add.Procedures, rem.Procedures = diffProcedureRows(prev.Procedures, next.Procedures, files) })
+	run(func() { add.Constants, rem.Constants = diffConstantRows(prev.Constants, next.Constants, files) })
+	run(func() { add.Symbols, rem.Symbols = diffSymbolRows(prev.Symbols, next.Symbols, files) })
+	wg.Wait()
+
+	return delta
 }
 
 func emptyTables() Tables {
@@ -64,170 +98,254 @@ func emptyTables() Tables {
 	}
 }
 
-func diffFileRows(from, to []FileRow) []FileRow {
-	return diffRows(from, to, func(r FileRow) string {
-		return r.Path + "|" + r.Library + "|" + boolKey(r.IsThirdParty)
+func diffFileRows(prev, next []FileRow, files map[string]bool) ([]FileRow, []FileRow) {
+	return diffRows(prev, next, files, func(r *FileRow) string { return r.Path }, func(r *FileRow) uint64 {
+		return newRowHash().str(r.Path).str(r.Library).bool(r.IsThirdParty).sum()
 	})
 }
 
-func diffEntityRows(from, to []EntityRow) []EntityRow {
-	return diffRows(from, to, func(r EntityRow) string {
-		return r.Name + "|" + r.File + "|" + intKey(r.Line)
+func diffEntityRows(prev, next []EntityRow, files map[string]bool) ([]EntityRow, []EntityRow) {
+	return diffRows(prev, next, files, func(r *EntityRow) string { return r.File }, func(r *EntityRow) uint64 {
+		return newRowHash().str(r.Name).str(r.File).int(r.Line).sum()
 	})
 }
 
-func diffArchitectureRows(from, to []ArchitectureRow) []ArchitectureRow {
-	return diffRows(from, to, func(r ArchitectureRow) string {
-		return r.Name + "|" + r.EntityName + "|" + r.File + "|" + intKey(r.Line)
+func diffArchitectureRows(prev, next []ArchitectureRow, files map[string]bool) ([]ArchitectureRow, []ArchitectureRow) {
+	return diffRows(prev, next, files, func(r *ArchitectureRow) string { return r.File }, func(r *ArchitectureRow) uint64 {
+		return newRowHash().str(r.Name).str(r.EntityName).str(r.File).int(r.Line).sum()
 	})
 }
 
-func diffPackageRows(from, to []PackageRow) []PackageRow {
-	return diffRows(from, to, func(r PackageRow) string {
-		return r.Name + "|" + r.File + "|" + intKey(r.Line)
+func diffPackageRows(prev, next []PackageRow, files map[string]bool) ([]PackageRow, []PackageRow) {
+	return diffRows(prev, next, files, func(r *PackageRow) string { return r.File }, func(r *PackageRow) uint64 {
+		return newRowHash().str(r.Name).str(r.File).int(r.Line).sum()
 	})
 }
 
-func diffPortRows(from, to []PortRow) []PortRow {
-	return diffRows(from, to, func(r PortRow) string {
-		return r.Entity + "|" + r.Name + "|" + r.Direction + "|" + r.Type + "|" + r.File + "|" + intKey(r.Line)
+func diffPortRows(prev, next []PortRow, files map[string]bool) ([]PortRow, []PortRow) {
+	return diffRows(prev, next, files, func(r *PortRow) string { return r.File }, func(r *PortRow) uint64 {
+		return newRowHash().str(r.Entity).str(r.Name).str(r.Direction).str(r.Type).str(r.File).int(r.Line).sum()
 	})
 }
 
-func diffSignalRows(from, to []SignalRow) []SignalRow {
-	return diffRows(from, to, func(r SignalRow) string {
-		return r.Name + "|" + r.Type + "|" + r.File + "|" + intKey(r.Line) + "|" + r.Scope
+func diffSignalRows(prev, next []SignalRow, files map[string]bool) ([]SignalRow, []SignalRow) {
+	return diffRows(prev, next, files, func(r *SignalRow) string { return r.File }, func(r *SignalRow) uint64 {
+		return newRowHash().str(r.Name).str(r.Type).str(r.File).int(r.Line).str(r.Scope).sum()
 	})
 }
 
-func diffInstanceRows(from, to []InstanceRow) []InstanceRow {
-	return diffRows(from, to, func(r InstanceRow) string {
-		return r.Name + "|" + r.Target + "|" + r.File + "|" + intKey(r.Line) + "|" + r.InArch
+func diffInstanceRows(prev, next []InstanceRow, files map[string]bool) ([]InstanceRow, []InstanceRow) {
+	return diffRows(prev, next, files, func(r *InstanceRow) string { return r.File }, func(r *InstanceRow) uint64 {
+		return newRowHash().str(r.Name).str(r.Target).str(r.File).int(r.Line).str(r.InArch).sum()
 	})
 }
 
-func diffDependencyRows(from, to []DependencyRow) []DependencyRow {
-	return diffRows(from, to, func(r DependencyRow) string {
-		return r.File + "|" + r.Target + "|" + r.Kind + "|" + intKey(r.Line)
+func diffDependencyRows(prev, next []DependencyRow, files map[string]bool) ([]DependencyRow, []DependencyRow) {
+	return diffRows(prev, next, files, func(r *DependencyRow) string { return r.File }, func(r *DependencyRow) uint64 {
+		return newRowHash().str(r.File).str(r.Target).str(r.Kind).int(r.Line).sum()
 	})
 }
 
-func diffUseClauseRows(from, to []UseClauseRow) []UseClauseRow {
-	return diffRows(from, to, func(r UseClauseRow) string {
-		return r.File + "|" + r.Item + "|" + intKey(r.Line)
+func diffUseClauseRows(prev, next []UseClauseRow, files map[string]bool) ([]UseClauseRow, []UseClauseRow) {
+	return diffRows(prev, next, files, func(r *UseClauseRow) string { return r.File }, func(r *UseClauseRow) uint64 {
+		return newRowHash().str(r.File).str(r.Item).int(r.Line).sum()
 	})
 }
 
-func diffLibraryClauseRows(from, to []LibraryClauseRow) []LibraryClauseRow {
-	return diffRows(from, to, func(r LibraryClauseRow) string {
-		return r.File + "|" + r.Library + "|" + intKey(r.Line)
+func diffLibraryClauseRows(prev, next []LibraryClauseRow, files map[string]bool) ([]LibraryClauseRow, []LibraryClauseRow) {
+	return diffRows(prev, next, files, func(r *LibraryClauseRow) string { return r.File }, func(r *LibraryClauseRow) uint64 {
+		return newRowHash().str(r.File).str(r.Library).int(r.Line).sum()
 	})
 }
 
-func diffContextClauseRows(from, to []ContextClauseRow) []ContextClauseRow {
-	return diffRows(from, to, func(r ContextClauseRow) string {
-		return r.File + "|" + r.Name + "|" + intKey(r.Line)
+func diffContextClauseRows(prev, next []ContextClauseRow, files map[string]bool) ([]ContextClauseRow, []ContextClauseRow) {
+	return diffRows(prev, next, files, func(r *ContextClauseRow) string { return r.File }, func(r *ContextClauseRow) uint64 {
+		return newRowHash().str(r.File).str(r.Name).int(r.Line).sum()
 	})
 }
 
-func diffProcessRows(from, to []ProcessRow) []ProcessRow {
-	return diffRows(from, to, func(r ProcessRow) string {
-		return r.Label + "|" + r.File + "|" + intKey(r.Line) + "|" + r.InArch + "|" + boolKey(r.IsSequential) + "|" + boolKey(r.IsComb)
+func diffProcessRows(prev, next []ProcessRow, files map[string]bool) ([]ProcessRow, []ProcessRow) {
+	return diffRows(prev, next, files, func(r *ProcessRow) string { return r.File }, func(r *ProcessRow) uint64 {
+		return newRowHash().str(r.Label).str(r.File).int(r.Line).str(r.InArch).bool(r.IsSequential).bool(r.IsComb).sum()
 	})
 }
 
-func diffGenerateRows(from, to []GenerateRow) []GenerateRow {
-	return diffRows(from, to, func(r GenerateRow) string {
-		return r.Label + "|" + r.Kind + "|" + r.File + "|" + intKey(r.Line) + "|" + r.InArch + "|" + boolKey(r.CanElab)
+func diffGenerateRows(prev, next []GenerateRow, files map[string]bool) ([]GenerateRow, []GenerateRow) {
+	return diffRows(prev, next, files, func(r *GenerateRow) string { return r.File }, func(r *GenerateRow) uint64 {
+		return newRowHash().str(r.Label).str(r.Kind).str(r.File).int(r.Line).str(r.InArch).bool(r.CanElab).sum()
 	})
 }
 
-func diffTypeRows(from, to []TypeRow) []TypeRow {
-	return diffRows(from, to, func(r TypeRow) string {
-		return r.Name + "|" + r.Kind + "|" + r.File + "|" + intKey(r.Line) + "|" + r.InPackage + "|" + r.InArch
+func diffTypeRows(prev, next []TypeRow, files map[string]bool) ([]TypeRow, []TypeRow) {
+	return diffRows(prev, next, files, func(r *TypeRow) string { return r.File }, func(r *TypeRow) uint64 {
+		return newRowHash().str(r.Name).str(r.Kind).str(r.File).int(r.Line).str(r.InPackage).str(r.InArch).sum()
 	})
 }
 
-func diffSubtypeRows(from, to []SubtypeRow) []SubtypeRow {
-	return diffRows(from, to, func(r SubtypeRow) string {
-		return r.Name + "|" + r.BaseType + "|" + r.File + "|" + intKey(r.Line) + "|" + r.InPackage + "|" + r.InArch
+func diffSubtypeRows(prev, next []SubtypeRow, files map[string]bool) ([]SubtypeRow, []SubtypeRow) {
+	return diffRows(prev, next, files, func(r *SubtypeRow) string { return r.File }, func(r *SubtypeRow) uint64 {
+		return newRowHash().str(r.Name).str(r.BaseType).str(r.File).int(r.Line).str(r.InPackage).str(r.InArch).sum()
 	})
 }
 
-func diffFunctionRows(from, to []FunctionRow) []FunctionRow {
-	return diffRows(from, to, func(r FunctionRow) string {
-		return r.Name + "|" + r.ReturnType + "|" + r.File + "|" + intKey(r.Line) + "|" + r.InPackage + "|" + r.InArch + "|" + boolKey(r.IsPure) + "|" + boolKey(r.HasBody)
+func diffFunctionRows(prev, next []FunctionRow, files map[string]bool) ([]FunctionRow, []FunctionRow) {
+	return diffRows(prev, next, files, func(r *FunctionRow) string { return r.File }, func(r *FunctionRow) uint64 {
+		return newRowHash().str(r.Name).str(r.ReturnType).str(r.File).int(r.Line).str(r.InPackage).str(r.InArch).
+			bool(r.IsPure).bool(r.HasBody).sum()
 	})
 }
 
-func diffProcedureRows(from, to []ProcedureRow) []ProcedureRow {
-	return diffRows(from, to, func(r ProcedureRow) string {
-		return r.Name + "|" + r.File + "|" + intKey(r.Line) + "|" + r.InPackage + "|" + r.InArch + "|" + boolKey(r.HasBody)
+func diffProcedureRows(prev, next []ProcedureRow, files map[string]bool) ([]ProcedureRow, []ProcedureRow) {
+	return diffRows(prev, next, files, func(r *ProcedureRow) string { return r.File }, func(r *ProcedureRow) uint64 {
+		return newRowHash().str(r.Name).str(r.File).int(r.Line).str(r.InPackage).str(r.InArch).bool(r.HasBody).sum()
 	})
 }
 
-func diffConstantRows(from, to []ConstantRow) []ConstantRow {
-	return diffRows(from, to, func(r ConstantRow) string {
-		return r.Name + "|" + r.Type + "|" + r.Value + "|" + r.File + "|" + intKey(r.Line) + "|" + r.InPackage + "|" + r.InArch
+func diffConstantRows(prev, next []ConstantRow, files map[string]bool) ([]ConstantRow, []ConstantRow) {
+	return diffRows(prev, next, files, func(r *ConstantRow) string { return r.File }, func(r *ConstantRow) uint64 {
+		return newRowHash().str(r.Name).str(r.Type).str(r.Value).str(r.File).int(r.Line).str(r.InPackage).str(r.InArch).sum()
 	})
 }
 
-func diffSymbolRows(from, to []SymbolRow) []SymbolRow {
-	return diffRows(from, to, func(r SymbolRow) string {
-		return r.Name + "|" + r.Kind + "|" + r.File + "|" + intKey(r.Line)
+func diffSymbolRows(prev, next []SymbolRow, files map[string]bool) ([]SymbolRow, []SymbolRow) {
+	return diffRows(prev, next, files, func(r *SymbolRow) string { return r.File }, func(r *SymbolRow) uint64 {
+		return newRowHash().str(r.Name).str(r.Kind).str(r.File).int(r.Line).sum()
 	})
 }
 
-func diffRows[T any](from, to []T, key func(T) string) []T {
-	fromSet := make(map[string]T, len(from))
-	for _, row := range from {
-		fromSet[key(row)] = row
+// diffRows returns the rows only in next (added) and only in prev (removed),
+// as sets, looking only at rows whose file is in files (all when nil). A
+// table whose rows match in order, which is every table an edit did not
+// touch, is settled in one pass without allocating.
+func diffRows[T comparable](prev, next []T, files map[string]bool, file func(*T) string, hash func(*T) uint64) (added, removed []T) {
+	if sameRows(prev, next, files, file) {
+		return []T{}, []T{}
 	}
-	var diff []T
-	for _, row := range to {
-		rowKey := key(row)
-		if _, ok := fromSet[rowKey]; !ok {
-			diff = append(diff, row)
+	prevSet := newRowSet(prev, files, file, hash)
+	nextSet := newRowSet(next, files, file, hash)
+	return nextSet.missingFrom(prevSet), prevSet.missingFrom(nextSet)
+}
+
+// sameRows reports whether prev and next hold the same rows of files in
+// the same order.
+func sameRows[T comparable](prev, next []T, files map[string]bool, file func(*T) string) bool {
+	i, j := 0, 0
+	for {
+		if files != nil {
+			for i < len(prev) && !files[file(&prev[i])] {
+				i++
+			}
+			for j < len(next) && !files[file(&next[j])] {
+				j++
+			}
 		}
+		if i == len(prev) || j == len(next) {
+			return i == len(prev) && j == len(next)
+		}
+		if prev[i] != next[j] {
+			return false
+		}
+		i++
+		j++
 	}
-	if diff == nil {
-		diff = []T{}
-	}
-	return diff
 }
 
-func boolKey(v bool) string {
-	if v {
-		return "1"
+// rowSet keys rows by their 64-bit hash. Rows are compared on lookup, so a
+// hash collision costs a scan of collided instead of a wrong delta.
+type rowSet[T comparable] struct {
+	rows     []T
+	hashes   []uint64
+	index    map[uint64]int
+	collided []T
+}
+
+func newRowSet[T comparable](rows []T, files map[string]bool, file func(*T) string, hash func(*T) uint64) *rowSet[T] {
+	s := &rowSet[T]{index: make(map[uint64]int, len(rows))}
+	for i := range rows {
+		row := &rows[i]
+		if files != nil && !files[file(row)] {
+			continue
+		}
+		h := hash(row)
+		s.rows = append(s.rows, *row)
+		s.hashes = append(s.hashes, h)
+		if first, ok := s.index[h]; !ok {
+			s.index[h] = len(s.rows) - 1
+		} else if s.rows[first] != *row {
+			s.collided = append(s.collided, *row)
+		}
 	}
-	return "0"
+	return s
 }
 
-func intKey(v int) string {
-	if v == 0 {
-		return "0"
+func (s *rowSet[T]) contains(h uint64, row T) bool {
+	first, ok := s.index[h]
+	if !ok {
+		return false
+	}
+	if s.rows[first] == row {
+		return true
+	}
+	for _, other := range s.collided {
+		if other == row {
+			return true
+		}
 	}
-	return itoa(v)
+	return false
 }
 
-func itoa(v int) string {
-	if v == 0 {
-		return "0"
+// missingFrom returns s's rows, in order, that other does not contain.
+func (s *rowSet[T]) missingFrom(other *rowSet[T]) []T {
+	diff := []T{}
+	for i, row := range s.rows {
+		if !other.contains(s.hashes[i], row) {
+			diff = append(diff, row)
+		}
 	}
-	neg := v < 0
-	if neg {
-		v = -v
+	return diff
+}
+
+// rowHash is FNV-1a over a row's columns, stable across processes.
+type rowHash uint64
+
+const (
+	fnvOffset64 rowHash = 14695981039346656037
+	fnvPrime64  rowHash = 1099511628211
+)
+
+func newRowHash() rowHash {
+	return fnvOffset64
+}
+
+func (h rowHash) byte(b byte) rowHash {
+	return (h ^ rowHash(b)) * fnvPrime64
+}
+
+// str hashes s followed by a terminator, so adjacent columns cannot run
+// together ("ab","c" vs "a","bc").
+func (h rowHash) str(s string) rowHash {
+	for i := 0; i < len(s); i++ {
+		h = h.byte(s[i])
 	}
-	var buf [20]byte
-	i := len(buf)
-	for v > 0 {
-		i--
-		buf[i] = byte('0' + v%10)
-		v /= 10
+	return h.byte(0xff)
+}
+
+func (h rowHash) int(v int) rowHash {
+	u := uint64(v)
+	for i := 0; i < 8; i++ {
+		h = h.byte(byte(u))
+		u >>= 8
 	}
-	if neg {
-		i--
-		buf[i] = '-'
+	return h
+}
+
+func (h rowHash) bool(v bool) rowHash {
+	if v {
+		return h.byte(1)
 	}
-	return string(buf[i:])
+	return h.byte(0)
+}
+
+func (h rowHash) sum() uint64 {
+	return uint64(h)
 }
@@ -1,6 +1,9 @@
 package facts
 
-import "testing"
+import (
+	"reflect"
+	"testing"
+)
 
 func TestComputeDeltaAddsAndRemoves(t *testing.T) {
 	prev := Tables{
@@ -35,3 +38,40 @@ func TestComputeDeltaAddsAndRemoves(t *testing.T) {
 		t.Fatalf("expected use clause removed, got %+v", delta.Removed.UseClauses)
 	}
 }
+
+func TestComputeDeltaForFilesMatchesFilteredDelta(t *testing.T) {
+	prev := Tables{
+		Entities: []EntityRow{
+			{Name: "a", File: "a.vhd", Line: 1},
+			{Name: "b", File: "b.vhd", Line: 1},
+		},
+		Signals: []SignalRow{
+			{Name: "s", File: "a.vhd", Line: 4, Scope: "a"},
+			{Name: "t", File: "b.vhd", Line: 4, Scope: "b"},
+		},
+	}
+	next := Tables{
+		Entities: []EntityRow{
+			{Name: "a", File: "a.vhd", Line: 2},
+			{Name: "b", File: "b.vhd", Line: 2},
+		},
+		Signals: []SignalRow{
+			{Name: "s", File: "a.vhd", Line: 4, Scope: "a"},
+			{Name: "t", File: "b.vhd", Line: 4, Scope: "b"},
+		},
+	}
+	files := map[string]bool{"a.vhd": true}
+
+	got := ComputeDeltaForFiles(prev, next, files)
+	want := FilterDeltaByFiles(ComputeDelta(prev, next), files)
+
+	if !reflect.DeepEqual(got, want) {
+		t.Fatalf("per-file delta differs:\n got %+v\nwant %+v", got, want)
+	}
+	if len(got.Added.Entities) != 1 || got.Added.Entities[0].Line != 2 || got.Added.Entities[0].File != "a.vhd" {
+		t.Fatalf("expected a.vhd entity re-added at line 2, got %+v", got.Added.Entities)
+	}
+	if len(got.Added.Signals) != 0 || len(got.Removed.Signals) != 0 {
+		t.Fatalf("expected no signal changes, got %+v / %+v", got.Added.Signals, got.Removed.Signals)
+	}
+}
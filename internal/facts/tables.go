@@ -181,28 +181,39 @@ type SymbolRow struct {
 
 // BuildTables converts extractor FileFacts into a normalized relational model.
 func BuildTables(facts []extractor.FileFacts, fileLibs map[string]config.FileLibraryInfo, thirdParty map[string]bool, symbols []SymbolRow) Tables {
+	// Size every table up front: on a large project the tables hold millions
+	// of rows, and growing them by appending would copy each several times
+	// and leave up to half of every backing array unused.
+	var nUses, nLibs int
+	for _, f := range facts {
+		for _, use := range f.UseClauses {
+			nUses += len(use.Items)
+		}
+		for _, lib := range f.LibraryClauses {
+			nLibs += len(lib.Libraries)
+		}
+	}
 	tables := Tables{
-		Files:          []FileRow{},
-		Entities:       []EntityRow{},
-		Architectures:  []ArchitectureRow{},
-		Packages:       []PackageRow{},
-		Ports:          []PortRow{},
-		Signals:        []SignalRow{},
-		Instances:      []InstanceRow{},
-		Dependencies:   []DependencyRow{},
-		UseClauses:     []UseClauseRow{},
-		LibraryClauses: []LibraryClauseRow{},
-		ContextClauses: []ContextClauseRow{},
-		Processes:      []ProcessRow{},
-		Generates:      []GenerateRow{},
-		Types:          []TypeRow{},
-		Subtypes:       []SubtypeRow{},
-		Functions:      []FunctionRow{},
-		Procedures:     []ProcedureRow{},
-		Constants:      []ConstantRow{},
-		Symbols:        []SymbolRow{},
+		Files:          make([]FileRow, 0, len(facts)),
+		Entities:       make([]EntityRow, 0, countRows(facts, func(f *extractor.FileFacts) int { return len(f.Entities) })),
+		Architectures:  make([]ArchitectureRow, 0, countRows(facts, func(f *extractor.FileFacts) int { return len(f.Architectures) })),
+		Packages:       make([]PackageRow, 0, countRows(facts, func(f *extractor.FileFacts) int { return len(f.Packages) })),
+		Ports:          make([]PortRow, 0, countRows(facts, func(f *extractor.FileFacts) int { return len(f.Ports) })),
+		Signals:        make([]SignalRow, 0, countRows(facts, func(f *extractor.FileFacts) int { return len(f.Signals) })),
+		Instances:      make([]InstanceRow, 0, countRows(facts, func(f *extractor.FileFacts) int { return len(f.Instances) })),
+		Dependencies:   make([]DependencyRow, 0, countRows(facts, func(f *extractor.FileFacts) int { return len(f.Dependencies) })),
+		UseClauses:     make([]UseClauseRow, 0, nUses),
+		LibraryClauses: make([]LibraryClauseRow, 0, nLibs),
+		ContextClauses: make([]ContextClauseRow, 0, countRows(facts, func(f *extractor.FileFacts) int { return len(f.ContextClauses) })),
+		Processes:      make([]ProcessRow, 0, countRows(facts, func(f *extractor.FileFacts) int { return len(f.Processes) })),
+		Generates:      make([]GenerateRow, 0, countRows(facts, func(f *extractor.FileFacts) int { return len(f.Generates) })),
+		Types:          make([]TypeRow, 0, countRows(facts, func(f *extractor.FileFacts) int { return len(f.Types) })),
+		Subtypes:       make([]SubtypeRow, 0, countRows(facts, func(f *extractor.FileFacts) int { return len(f.Subtypes) })),
+		Functions:      make([]FunctionRow, 0, countRows(facts, func(f *extractor.FileFacts) int { return len(f.Functions) })),
+		Procedures:     make([]ProcedureRow, 0, countRows(facts, func(f *extractor.FileFacts) int { return len(f.Procedures) })),
+		Constants:      make([]ConstantRow, 0, countRows(facts, func(f *extractor.FileFacts) int { return len(f.ConstantDecls) })),
+		Symbols:        make([]SymbolRow, 0, len(symbols)),
 	}
-
 	seenFiles := make(map[string]bool)
 	for _, f := range facts {
 		if !seenFiles[f.File] {
@@ -400,3 +411,11 @@ func BuildTables(facts []extractor.FileFacts, fileLibs map[string]config.FileLib
 
 	return tables
 }
+
+func countRows(facts []extractor.FileFacts, rows func(*extractor.FileFacts) int) int {
+	n := 0
+	for i := range facts {
+		n += rows(&facts[i])
+	}
+	return n
+}
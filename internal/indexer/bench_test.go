@@ -0,0 +1,100 @@
+package indexer
+
+import (
+	"bufio"
+	"encoding/json"
+	"io"
+	"os"
+	"path/filepath"
+	"testing"
+
+	"github.com/robert-at-pretension-io/vhdl-lint/internal/synth"
+)
+
+// Pipeline benchmarks over synthetic designs (internal/synth). Besides ns/op,
+// every stage of timing.jsonl (scan, extract, elaborate, facts_validate,
+// resolve, build_input, validate, policy, total) is reported as
+// <stage>-ms/op, so a regression points at the stage that caused it:
+//
+//	go test ./internal/indexer -run '^$' -bench Pipeline -benchtime 5x
+//
+// "cold" runs without the cache, "warm" re-lints an unchanged, cached tree.
+// The policy stage runs TestMain's stub unless VHDL_POLICY_BIN points at a
+// real vhdl_policy. The large design only runs with VHDL_BENCH_LARGE=1.
+func BenchmarkPipeline(b *testing.B) {
+	sizes := []struct {
+		name   string
+		params synth.Params
+	}{
+		{"small", synth.Small},
+		{"medium", synth.Medium},
+		{"large", synth.Large},
+	}
+	for _, size := range sizes {
+		size := size
+		if size.name == "large" && !envBool("VHDL_BENCH_LARGE") {
+			continue
+		}
+		b.Run(size.name+"/cold", func(b *testing.B) { benchmarkPipeline(b, size.params, false) })
+		b.Run(size.name+"/warm", func(b *testing.B) { benchmarkPipeline(b, size.params, true) })
+	}
+}
+
+func benchmarkPipeline(b *testing.B, params synth.Params, warm bool) {
+	dir := b.TempDir()
+	files, err := synth.Generate(dir, params)
+	if err != nil {
+		b.Fatalf("generate design: %v", err)
+	}
+	cfg := defaultTestConfig(files, filepath.Join(dir, ".cache"), warm)
+	timingPath := filepath.Join(dir, "timing.jsonl")
+	run := func() {
+		idx := NewWithConfig(cfg)
+		idx.JSONOutput = true
+		idx.Output = io.Discard
+		idx.Timing = true
+		idx.TimingPath = timingPath
+		if err := idx.Run(dir); err != nil {
+			b.Fatalf("run: %v", err)
+		}
+	}
+	if warm {
+		run()
+	}
+
+	stages := make(map[string]float64)
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		run()
+		b.StopTimer()
+		if err := addStageTimes(timingPath, stages); err != nil {
+			b.Fatalf("read timing: %v", err)
+		}
+		b.StartTimer()
+	}
+	b.StopTimer()
+	for stage, ms := range stages {
+		b.ReportMetric(ms/float64(b.N), stage+"-ms/op")
+	}
+	b.ReportMetric(float64(len(files)), "files")
+}
+
+// addStageTimes adds the stage durations of one run's timing.jsonl to stages.
+func addStageTimes(path string, stages map[string]float64) error {
+	f, err := os.Open(path)
+	if err != nil {
+		return err
+	}
+	defer f.Close()
+	scanner := bufio.NewScanner(f)
+	for scanner.Scan() {
+		var event timingEvent
+		if err := json.Unmarshal(scanner.Bytes(), &event); err != nil {
+			return err
+		}
+		if event.Kind == "stage" {
+			stages[event.Phase] += event.DurationMS
+		}
+	}
+	return scanner.Err()
+}
@@ -2,37 +2,99 @@ package indexer
 
 import (
 	"crypto/sha256"
+	"encoding/binary"
 	"encoding/hex"
 	"encoding/json"
 	"fmt"
+	"hash/crc32"
 	"io"
 	"os"
 	"path/filepath"
 	"sync"
+	"time"
 
 	"github.com/robert-at-pretension-io/vhdl-lint/internal/extractor"
 )
 
-const cacheIndexVersion = 1
+// The facts cache is a single append-only file, facts.bin:
+//
+//	header:  "VLFACTS\x00" | u32 version
+//	record:  u32 payload length | u32 crc32c(payload) | payload
+//	payload: path | content hash | parser version | extractor version |
+//	         size | mtime | inode | facts
+//
+// Header strings are uvarint length-prefixed, the stat stamp is varints, and
+// facts use the binary codec in
+// fact_codec.go. Load maps the file and indexes record headers only; Get
+// decodes a record straight from the mapping. Put appends, so the newest
+// record for a path wins, and Save compacts once dead records dominate.
+const factStoreVersion = 3
+
+const (
+	factStoreMagic      = "VLFACTS\x00"
+	factStoreHeaderSize = len(factStoreMagic) + 4
+	factRecordHeader    = 8
+	// Compact when dead bytes exceed live bytes and this floor
+	factStoreCompactMin = 1 << 20
+	// Files modified this recently get no stamp: an edit landing in the same
+	// mtime tick as our stat would otherwise go unnoticed (git's "racily
+	// clean" problem). They are hashed once more on the next run.
+	stampRacyWindow = 2 * time.Second
+)
+
+// Content hash algorithms (Analysis.Cache.Hash)
+const (
+	cacheHashSHA256 = "sha256"
+	cacheHashFast   = "fast"
+)
+
+var crc32c = crc32.MakeTable(crc32.Castagnoli)
 
 type cacheEntry struct {
-	ContentHash     string `json:"content_hash"`
-	FactsPath       string `json:"facts_path"`
-	ParserVersion   string `json:"parser_version"`
-	ExtractorVersion string `json:"extractor_version"`
+	offset      int64 // payload offset in facts.bin
+	length      uint32
+	crc         uint32
+	contentHash string
+	stamp       fileStamp
+	factsStart  int // offset of the facts encoding within the payload
 }
 
-type cacheIndex struct {
-	Version int                  `json:"version"`
-	Entries map[string]cacheEntry `json:"entries"`
+// fileStamp is the stat snapshot that lets an unchanged file skip hashing.
+// The zero stamp never matches.
+type fileStamp struct {
+	size  int64
+	mtime int64 // UnixNano
+	inode uint64
+}
+
+func statFile(path string) (fileStamp, error) {
+	info, err := os.Stat(path)
+	if err != nil {
+		return fileStamp{}, err
+	}
+	return fileStamp{size: info.Size(), mtime: info.ModTime().UnixNano(), inode: fileInode(info)}, nil
+}
+
+// cacheable drops stamps too close to now to be trusted (see stampRacyWindow).
+func (s fileStamp) cacheable(now time.Time) fileStamp {
+	if now.UnixNano()-s.mtime < int64(stampRacyWindow) {
+		return fileStamp{}
+	}
+	return s
 }
 
 type factsCache struct {
-	dir             string
-	parserVersion   string
+	dir              string
+	parserVersion    string
 	extractorVersion string
-	mu              sync.Mutex
-	index           cacheIndex
+	mu               sync.Mutex
+	entries          map[string]cacheEntry
+	mapped           []byte   // facts.bin as of Load (header included)
+	retired          [][]byte // mappings replaced by compaction, released in Save
+	file             *os.File // append handle, opened on first Put
+	size             int64    // bytes of valid data in facts.bin
+	dead             int64    // bytes of superseded or stale records
+	rewrite          bool     // facts.bin is missing, foreign or torn: rewrite on Put/Save
 }
 
 func newFactsCache(dir, parserVersion, extractorVersion string) *factsCache {
@@ -40,24 +102,12 @@ func newFactsCache(dir, parserVersion, extractorVersion string) *factsCache {
 		dir:              dir,
 		parserVersion:    parserVersion,
 		extractorVersion: extractorVersion,
-		index: cacheIndex{
-			Version: cacheIndexVersion,
-			Entries: make(map[string]cacheEntry),
-		},
+		entries:          make(map[string]cacheEntry),
 	}
 }
 
-func (c *factsCache) indexPath() string {
-	return filepath.Join(c.dir, "index.json")
-}
-
-func (c *factsCache) factsDir() string {
-	return filepath.Join(c.dir, "facts")
-}
-
-func (c *factsCache) factsPathForFile(filePath string) string {
-	h := sha256.Sum256([]byte(filePath))
-	return filepath.Join(c.factsDir(), hex.EncodeToString(h[:]) + ".json")
+func (c *factsCache) storePath() string {
+	return filepath.Join(c.dir, "facts.bin")
 }
 
 func (c *factsCache) Load() error {
@@ -67,90 +117,347 @@ func (c *factsCache) Load() error {
 	if err := os.MkdirAll(c.dir, 0o755); err != nil {
 		return fmt.Errorf("cache mkdir: %w", err)
 	}
-	path := c.indexPath()
-	data, err := os.ReadFile(path)
+	f, err := os.Open(c.storePath())
 	if err != nil {
 		if os.IsNotExist(err) {
+			c.rewrite = true
 			return nil
 		}
-		return fmt.Errorf("read cache index: %w", err)
+		return fmt.Errorf("open facts store: %w", err)
+	}
+	defer f.Close()
+	info, err := f.Stat()
+	if err != nil {
+		return fmt.Errorf("stat facts store: %w", err)
 	}
-	var idx cacheIndex
-	if err := json.Unmarshal(data, &idx); err != nil {
-		return fmt.Errorf("parse cache index: %w", err)
+	if info.Size() < int64(factStoreHeaderSize) {
+		c.rewrite = true
+		return nil
+	}
+	data, err := mapFile(f, int(info.Size()))
+	if err != nil {
+		return fmt.Errorf("map facts store: %w", err)
 	}
-	if idx.Version != cacheIndexVersion {
+	c.mapped = data
+
+	if string(data[:len(factStoreMagic)]) != factStoreMagic ||
+		binary.LittleEndian.Uint32(data[len(factStoreMagic):]) != factStoreVersion {
 		// Reset on version mismatch
-		c.index = cacheIndex{Version: cacheIndexVersion, Entries: make(map[string]cacheEntry)}
+		c.rewrite = true
 		return nil
 	}
-	if idx.Entries == nil {
-		idx.Entries = make(map[string]cacheEntry)
+
+	pos := factStoreHeaderSize
+	for pos+factRecordHeader <= len(data) {
+		length := binary.LittleEndian.Uint32(data[pos:])
+		end := pos + factRecordHeader + int(length)
+		if end > len(data) || end < pos {
+			break // torn tail from an interrupted append
+		}
+		payload := data[pos+factRecordHeader : end]
+		path, entry, ok := c.recordKey(payload)
+		if !ok {
+			c.dead += int64(end - pos)
+		} else {
+			if old, exists := c.entries[path]; exists {
+				c.dead += int64(old.length) + factRecordHeader
+			}
+			entry.offset = int64(pos + factRecordHeader)
+			entry.length = length
+			entry.crc = binary.LittleEndian.Uint32(data[pos+4:])
+			c.entries[path] = entry
+		}
+		pos = end
+	}
+	c.size = int64(pos)
+	if pos != len(data) {
+		c.rewrite = true
 	}
-	c.index = idx
 	return nil
 }
 
+// recordKey parses the key fields of a record payload into an entry (offset,
+// length and crc are left to the caller). It reports false when the record
+// was written by another parser/extractor version or is malformed.
+func (c *factsCache) recordKey(payload []byte) (string, cacheEntry, bool) {
+	d := &factDecoder{data: payload}
+	path := d.bytes(d.length())
+	hash := d.bytes(d.length())
+	parser := d.bytes(d.length())
+	ext := d.bytes(d.length())
+	size := d.uvarint()
+	mtime := d.uvarint()
+	inode := d.uvarint()
+	if d.err != nil || string(parser) != c.parserVersion || string(ext) != c.extractorVersion {
+		return "", cacheEntry{}, false
+	}
+	return string(path), cacheEntry{
+		contentHash: string(hash),
+		stamp:       fileStamp{size: int64(size), mtime: int64(mtime), inode: inode},
+		factsStart:  d.pos,
+	}, true
+}
+
+// appendRecordKey appends the key fields recordKey reads.
+func (c *factsCache) appendRecordKey(buf []byte, filePath, contentHash string, stamp fileStamp) []byte {
+	for _, s := range []string{filePath, contentHash, c.parserVersion, c.extractorVersion} {
+		buf = binary.AppendUvarint(buf, uint64(len(s)))
+		buf = append(buf, s...)
+	}
+	buf = binary.AppendUvarint(buf, uint64(stamp.size))
+	buf = binary.AppendUvarint(buf, uint64(stamp.mtime))
+	return binary.AppendUvarint(buf, stamp.inode)
+}
+
+// Save flushes appended records and compacts the store when most of it is
+// dead, then releases the mapping.
 func (c *factsCache) Save() error {
 	c.mu.Lock()
 	defer c.mu.Unlock()
-	return writeJSONAtomic(c.indexPath(), c.index)
+
+	var err error
+	if c.rewrite || (c.dead > factStoreCompactMin && c.dead > c.size-c.dead) {
+		err = c.compactLocked()
+	}
+	if c.file != nil {
+		if cerr := c.file.Close(); cerr != nil && err == nil {
+			err = fmt.Errorf("close facts store: %w", cerr)
+		}
+		c.file = nil
+	}
+	for _, m := range append(c.retired, c.mapped) {
+		if m != nil {
+			_ = unmapFile(m)
+		}
+	}
+	c.mapped = nil
+	c.retired = nil
+	return err
+}
+
+// compactLocked rewrites facts.bin with only the live records.
+func (c *factsCache) compactLocked() error {
+	tmp, err := os.CreateTemp(c.dir, ".tmp-facts-*.bin")
+	if err != nil {
+		return fmt.Errorf("temp facts store: %w", err)
+	}
+	fail := func(err error) error {
+		_ = tmp.Close()
+		_ = os.Remove(tmp.Name())
+		return err
+	}
+
+	buf := make([]byte, 0, 1<<16)
+	buf = appendStoreHeader(buf)
+	entries := make(map[string]cacheEntry, len(c.entries))
+	offset := int64(len(buf))
+	for path, entry := range c.entries {
+		payload, err := c.payloadLocked(entry)
+		if err != nil {
+			return fail(err)
+		}
+		buf = appendRecordHeader(buf, entry.length, entry.crc)
+		entry.offset = offset + factRecordHeader
+		buf = append(buf, payload...)
+		offset += factRecordHeader + int64(entry.length)
+		entries[path] = entry
+		if len(buf) >= 1<<20 {
+			if _, err := tmp.Write(buf); err != nil {
+				return fail(fmt.Errorf("write facts store: %w", err))
+			}
+			buf = buf[:0]
+		}
+	}
+	if _, err := tmp.Write(buf); err != nil {
+		return fail(fmt.Errorf("write facts store: %w", err))
+	}
+	if err := tmp.Close(); err != nil {
+		_ = os.Remove(tmp.Name())
+		return fmt.Errorf("close facts store: %w", err)
+	}
+	if c.file != nil {
+		_ = c.file.Close()
+		c.file = nil
+	}
+	// The old mapping stays valid after the rename (it pins the old file)
+	if err := os.Rename(tmp.Name(), c.storePath()); err != nil {
+		_ = os.Remove(tmp.Name())
+		return fmt.Errorf("rename facts store: %w", err)
+	}
+	// Offsets now refer to the new file; reads go through the append handle.
+	// Gets may still be decoding from the old mapping, so it is kept until Save.
+	if c.mapped != nil {
+		c.retired = append(c.retired, c.mapped)
+		c.mapped = nil
+	}
+	c.entries = entries
+	c.size = offset
+	c.dead = 0
+	c.rewrite = false
+	return nil
 }
 
-func (c *factsCache) Get(filePath, contentHash string) (extractor.FileFacts, bool, error) {
+// payloadLocked returns a record's payload: from the mapping when it was
+// there at Load, otherwise read back from the append handle.
+func (c *factsCache) payloadLocked(entry cacheEntry) ([]byte, error) {
+	end := entry.offset + int64(entry.length)
+	if end <= int64(len(c.mapped)) {
+		return c.mapped[entry.offset:end], nil
+	}
+	if c.file == nil {
+		return nil, fmt.Errorf("read cached facts: record past end of store")
+	}
+	buf := make([]byte, entry.length)
+	if _, err := c.file.ReadAt(buf, entry.offset); err != nil {
+		return nil, fmt.Errorf("read cached facts: %w", err)
+	}
+	return buf, nil
+}
+
+// GetByStamp returns the cached facts for filePath when its stat stamp is
+// unchanged since they were stored, without reading the file.
+func (c *factsCache) GetByStamp(filePath string, stamp fileStamp) (extractor.FileFacts, bool, error) {
 	c.mu.Lock()
-	entry, ok := c.index.Entries[filePath]
-	c.mu.Unlock()
-	if !ok {
+	entry, ok := c.entries[filePath]
+	if !ok || entry.stamp == (fileStamp{}) || entry.stamp != stamp {
+		c.mu.Unlock()
 		return extractor.FileFacts{}, false, nil
 	}
-	if entry.ContentHash != contentHash {
-		return extractor.FileFacts{}, false, nil
+	payload, err := c.payloadLocked(entry)
+	c.mu.Unlock()
+	if err != nil {
+		return extractor.FileFacts{}, false, err
 	}
-	if entry.ParserVersion != c.parserVersion || entry.ExtractorVersion != c.extractorVersion {
+	return decodeEntry(entry, payload)
+}
+
+// Get returns the cached facts for filePath when its content hash matches.
+// A hit under a new stamp (file touched but not changed) re-records the
+// entry so the next run can take the stat fast path.
+func (c *factsCache) Get(filePath, contentHash string, stamp fileStamp) (extractor.FileFacts, bool, error) {
+	c.mu.Lock()
+	entry, ok := c.entries[filePath]
+	if !ok || entry.contentHash != contentHash {
+		c.mu.Unlock()
 		return extractor.FileFacts{}, false, nil
 	}
-
-	data, err := os.ReadFile(entry.FactsPath)
+	payload, err := c.payloadLocked(entry)
+	c.mu.Unlock()
 	if err != nil {
-		return extractor.FileFacts{}, false, fmt.Errorf("read cached facts: %w", err)
+		return extractor.FileFacts{}, false, err
 	}
-	var facts extractor.FileFacts
-	if err := json.Unmarshal(data, &facts); err != nil {
-		return extractor.FileFacts{}, false, fmt.Errorf("parse cached facts: %w", err)
+	facts, ok, err := decodeEntry(entry, payload)
+	if !ok || err != nil {
+		return facts, ok, err
+	}
+	if stamp = stamp.cacheable(time.Now()); stamp != entry.stamp {
+		if err := c.restamp(filePath, entry, payload, stamp); err != nil {
+			return facts, true, err
+		}
 	}
 	return facts, true, nil
 }
 
-func (c *factsCache) Put(filePath, contentHash string, facts extractor.FileFacts) error {
-	factsPath := c.factsPathForFile(filePath)
-	if err := os.MkdirAll(filepath.Dir(factsPath), 0o755); err != nil {
-		return fmt.Errorf("cache facts dir: %w", err)
+// decodeEntry decodes entry's payload. The entry and its payload must come
+// from the same critical section: a compaction in between renumbers the
+// offsets, and the old entry would read another record of the new file.
+func decodeEntry(entry cacheEntry, payload []byte) (extractor.FileFacts, bool, error) {
+	if crc32.Checksum(payload, crc32c) != entry.crc {
+		return extractor.FileFacts{}, false, fmt.Errorf("parse cached facts: checksum mismatch")
 	}
-	if err := writeJSONAtomic(factsPath, facts); err != nil {
-		return err
+	facts, err := decodeFacts(payload[entry.factsStart:])
+	if err != nil {
+		return extractor.FileFacts{}, false, fmt.Errorf("parse cached facts: %w", err)
 	}
+	return facts, true, nil
+}
+
+// restamp appends a copy of entry's record, payload, under a new stamp.
+func (c *factsCache) restamp(filePath string, entry cacheEntry, payload []byte, stamp fileStamp) error {
+	out := c.appendRecordKey(make([]byte, 0, len(payload)+16), filePath, entry.contentHash, stamp)
+	factsStart := len(out)
+	out = append(out, payload[entry.factsStart:]...)
+	return c.appendRecord(filePath, entry.contentHash, stamp, factsStart, out)
+}
+
+func (c *factsCache) Put(filePath, contentHash string, stamp fileStamp, facts extractor.FileFacts) error {
+	stamp = stamp.cacheable(time.Now())
+	payload := c.appendRecordKey(make([]byte, 0, 4096), filePath, contentHash, stamp)
+	factsStart := len(payload)
+	payload = encodeFacts(payload, &facts)
+	return c.appendRecord(filePath, contentHash, stamp, factsStart, payload)
+}
+
+func (c *factsCache) appendRecord(filePath, contentHash string, stamp fileStamp, factsStart int, payload []byte) error {
+	crc := crc32.Checksum(payload, crc32c)
+	record := appendRecordHeader(make([]byte, 0, factRecordHeader+len(payload)), uint32(len(payload)), crc)
+	record = append(record, payload...)
 
 	c.mu.Lock()
-	c.index.Entries[filePath] = cacheEntry{
-		ContentHash:      contentHash,
-		FactsPath:        factsPath,
-		ParserVersion:    c.parserVersion,
-		ExtractorVersion: c.extractorVersion,
+	defer c.mu.Unlock()
+	if err := c.openAppendLocked(); err != nil {
+		return err
 	}
-	c.mu.Unlock()
+	if _, err := c.file.Write(record); err != nil {
+		return fmt.Errorf("write cached facts: %w", err)
+	}
+	if old, exists := c.entries[filePath]; exists {
+		c.dead += int64(old.length) + factRecordHeader
+	}
+	c.entries[filePath] = cacheEntry{
+		offset:      c.size + factRecordHeader,
+		length:      uint32(len(payload)),
+		crc:         crc,
+		contentHash: contentHash,
+		stamp:       stamp,
+		factsStart:  factsStart,
+	}
+	c.size += int64(len(record))
 	return nil
 }
 
+// openAppendLocked opens facts.bin for appending, first rewriting it when it
+// is missing, from another version, or has a torn tail.
+func (c *factsCache) openAppendLocked() error {
+	if c.file != nil {
+		return nil
+	}
+	if c.rewrite {
+		if err := c.compactLocked(); err != nil {
+			return err
+		}
+	}
+	f, err := os.OpenFile(c.storePath(), os.O_RDWR|os.O_APPEND, 0o644)
+	if err != nil {
+		return fmt.Errorf("open facts store: %w", err)
+	}
+	c.file = f
+	return nil
+}
+
+func appendStoreHeader(buf []byte) []byte {
+	buf = append(buf, factStoreMagic...)
+	return binary.LittleEndian.AppendUint32(buf, factStoreVersion)
+}
+
+func appendRecordHeader(buf []byte, length, crc uint32) []byte {
+	buf = binary.LittleEndian.AppendUint32(buf, length)
+	return binary.LittleEndian.AppendUint32(buf, crc)
+}
+
 func writeJSONAtomic(path string, v any) error {
 	data, err := json.MarshalIndent(v, "", "  ")
 	if err != nil {
 		return fmt.Errorf("marshal cache json: %w", err)
 	}
+	return writeFileAtomic(path, data)
+}
+
+func writeFileAtomic(path string, data []byte) error {
 	if err := os.MkdirAll(filepath.Dir(path), 0o755); err != nil {
 		return fmt.Errorf("cache dir: %w", err)
 	}
-	tmp, err := os.CreateTemp(filepath.Dir(path), ".tmp-*.json")
+	tmp, err := os.CreateTemp(filepath.Dir(path), ".tmp-*"+filepath.Ext(path))
 	if err != nil {
 		return fmt.Errorf("temp cache file: %w", err)
 	}
@@ -170,6 +477,29 @@ func writeJSONAtomic(path string, v any) error {
 	return nil
 }
 
+// hashCacheFile computes the cache content hash of path with the configured
+// algorithm. Fast hashes are prefixed so switching algorithms misses rather
+// than comparing unlike digests.
+func hashCacheFile(path, algo string) (string, error) {
+	if algo != cacheHashFast {
+		return hashFile(path)
+	}
+	f, err := os.Open(path)
+	if err != nil {
+		return "", err
+	}
+	defer f.Close()
+
+	// Two hardware-accelerated CRCs over different polynomials: much cheaper
+	// than SHA-256 and 64 bits of change detection (not collision resistance).
+	castagnoli := crc32.New(crc32c)
+	ieee := crc32.NewIEEE()
+	if _, err := io.Copy(io.MultiWriter(castagnoli, ieee), f); err != nil {
+		return "", err
+	}
+	return "crc:" + hex.EncodeToString(ieee.Sum(castagnoli.Sum(nil))), nil
+}
+
 func hashFile(path string) (string, error) {
 	f, err := os.Open(path)
 	if err != nil {
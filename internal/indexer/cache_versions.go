@@ -1,9 +1,13 @@
 package indexer
 
 import (
+	"crypto/sha256"
+	"encoding/hex"
 	"os"
 	"path/filepath"
 	"runtime"
+	"sort"
+	"strings"
 
 	"github.com/robert-at-pretension-io/vhdl-lint/internal/config"
 )
@@ -42,8 +46,13 @@ func computeCacheVersions(rootPath string) cacheVersions {
 			repoRoot = filepath.Dir(rootPath)
 		}
 	}
+	// The external scanner tokenizes literals and comments, so it is part
+	// of the parser version alongside the grammar.
 	parserVersion := hashFileIfExists(filepath.Join(repoRoot, "tree-sitter-vhdl", "grammar.js"))
-	extractorVersion := hashFileIfExists(filepath.Join(repoRoot, "internal", "extractor", "extractor.go"))
+	if scannerVersion := hashFileIfExists(filepath.Join(repoRoot, "tree-sitter-vhdl", "src", "scanner.c")); scannerVersion != "" && parserVersion != "" {
+		parserVersion += "+" + scannerVersion
+	}
+	extractorVersion := hashGoPackage(filepath.Join(repoRoot, "internal", "extractor"))
 
 	if parserVersion == "" {
 		parserVersion = "unknown"
@@ -55,6 +64,13 @@ func computeCacheVersions(rootPath string) cacheVersions {
 	return cacheVersions{parser: parserVersion, extractor: extractorVersion}
 }
 
+// known reports whether both versions were computed: an unknown version
+// (option suffixes included) matches every other unknown one, so facts
+// keyed by it cannot be shared.
+func (v cacheVersions) known() bool {
+	return !strings.HasPrefix(v.parser, "unknown") && !strings.HasPrefix(v.extractor, "unknown")
+}
+
 func findRepoRootForCache() string {
 	_, file, _, ok := runtime.Caller(0)
 	if !ok {
@@ -74,6 +90,40 @@ func findRepoRootForCache() string {
 	}
 }
 
+// hashGoPackage hashes the names and contents of the non-test .go files in
+// dir: extraction logic spans the whole package, not just extractor.go. It
+// returns "" when dir has none or one cannot be read.
+func hashGoPackage(dir string) string {
+	entries, err := os.ReadDir(dir)
+	if err != nil {
+		return ""
+	}
+	var files []string
+	for _, entry := range entries {
+		name := entry.Name()
+		if entry.IsDir() || filepath.Ext(name) != ".go" || strings.HasSuffix(name, "_test.go") {
+			continue
+		}
+		files = append(files, name)
+	}
+	if len(files) == 0 {
+		return ""
+	}
+	sort.Strings(files)
+	hasher := sha256.New()
+	for _, name := range files {
+		data, err := os.ReadFile(filepath.Join(dir, name))
+		if err != nil {
+			return ""
+		}
+		hasher.Write([]byte(name))
+		hasher.Write([]byte{0})
+		hasher.Write(data)
+		hasher.Write([]byte{0})
+	}
+	return hex.EncodeToString(hasher.Sum(nil))
+}
+
 func hashFileIfExists(path string) string {
 	if path == "" {
 		return ""
@@ -0,0 +1,207 @@
+package indexer
+
+import (
+	"sort"
+	"strings"
+
+	"github.com/robert-at-pretension-io/vhdl-lint/internal/extractor"
+	"github.com/robert-at-pretension-io/vhdl-lint/internal/facts"
+	"github.com/robert-at-pretension-io/vhdl-lint/internal/policy"
+)
+
+// Cone linting (VHDL_LINT_CONE=1): after an incremental run, only the
+// reverse-dependency cone of the changed files is validated and evaluated:
+// the changed files plus, transitively, every file that uses or instantiates
+// one of them. The policy input for it also carries the files the cone
+// depends on, so packages and instantiated entities still resolve.
+// Results for every file in that scope are taken from the evaluation; those
+// of files outside it come from the previous run's policy cache.
+//
+// The merged result is an approximation: project-wide rules that compare
+// unrelated files (e.g. duplicate names) only see the scope, and a change can
+// affect files outside it. It is saved as an approximate policy cache entry:
+// a later cone run builds on it, but a run without changes evaluates the
+// whole input again rather than reusing it, so a full run is still the
+// reference.
+//
+// The dependents graph is built from the new facts, so it misses files that
+// depended on a changed file only under the old ones (a renamed entity, a
+// dropped use clause). A cone run therefore needs every changed file's
+// interface, what other files see of it and use through it, to be the same
+// as in the previous run's fact tables; otherwise the whole input is
+// evaluated.
+
+// lintConePlan is what a cone run evaluates and what it reuses.
+type lintConePlan struct {
+	prev    *policyCacheEntry
+	cone    map[string]bool
+	inScope map[string]bool // the cone and what it depends on
+	scope   []extractor.FileFacts
+}
+
+// planLintCone returns nil when the previous policy result cannot be reused:
+// no cache entry, another version, a different set of files, or a changed
+// file whose interface differs from the previous fact tables'.
+func (idx *Indexer) planLintCone(cacheDir string, factFiles []string, factsByFile map[string]extractor.FileFacts, tables facts.Tables, changed map[string]bool) (*lintConePlan, error) {
+	entry, err := loadPolicyCache(cacheDir)
+	if err != nil || entry == nil {
+		return nil, err
+	}
+	if entry.Version != policyCacheVersion || len(entry.Files) != len(factFiles) {
+		return nil, nil
+	}
+	for i := range factFiles {
+		if entry.Files[i] != factFiles[i] {
+			return nil, nil
+		}
+	}
+	prevTables, ok, err := loadFactTablesCache(cacheDir)
+	if err != nil || !ok {
+		return nil, err
+	}
+	prevInterfaces := fileInterfaces(prevTables, changed)
+	for f, iface := range fileInterfaces(tables, changed) {
+		if prevInterfaces[f] != iface {
+			return nil, nil
+		}
+	}
+
+	dependents := buildDependentsGraph(factsByFile, idx.Symbols, idx.FileLibraries)
+	cone := make(map[string]bool)
+	for f := range changed {
+		cone[f] = true
+		for _, level := range computeImpact(f, dependents).Levels {
+			for _, dep := range level {
+				cone[dep] = true
+			}
+		}
+	}
+
+	// Forward closure: what the cone uses and instantiates
+	inScope := make(map[string]bool, len(cone))
+	var frontier []string
+	for f := range cone {
+		inScope[f] = true
+		frontier = append(frontier, f)
+	}
+	for len(frontier) > 0 {
+		f := frontier[len(frontier)-1]
+		frontier = frontier[:len(frontier)-1]
+		for _, dep := range resolveDependencies(factsByFile[f], f, idx.Symbols, idx.FileLibraries) {
+			if _, ok := factsByFile[dep]; ok && !inScope[dep] {
+				inScope[dep] = true
+				frontier = append(frontier, dep)
+			}
+		}
+	}
+
+	plan := &lintConePlan{prev: entry, cone: cone, inScope: inScope}
+	for _, facts := range idx.Facts {
+		if inScope[facts.File] {
+			plan.scope = append(plan.scope, facts)
+		}
+	}
+	return plan, nil
+}
+
+// merge combines fresh, the evaluation of the cone's scope, with the
+// previous result: entries of files in the scope come from fresh,
+// everything else (including violations without a file) from the previous
+// run.
+func (p *lintConePlan) merge(fresh *policy.Result) *policy.Result {
+	prev := &p.prev.Result
+	merged := &policy.Result{Violations: []policy.Violation{}}
+	for _, v := range prev.Violations {
+		if !p.inScope[v.File] {
+			merged.Violations = append(merged.Violations, v)
+		}
+	}
+	for _, v := range fresh.Violations {
+		if p.inScope[v.File] {
+			merged.Violations = append(merged.Violations, v)
+		}
+	}
+	for _, m := range prev.MissingChecks {
+		if !p.inScope[m.File] {
+			merged.MissingChecks = append(merged.MissingChecks, m)
+		}
+	}
+	for _, m := range fresh.MissingChecks {
+		if p.inScope[m.File] {
+			merged.MissingChecks = append(merged.MissingChecks, m)
+		}
+	}
+	for _, a := range prev.AmbiguousConstructs {
+		if !p.inScope[a.File] {
+			merged.AmbiguousConstructs = append(merged.AmbiguousConstructs, a)
+		}
+	}
+	for _, a := range fresh.AmbiguousConstructs {
+		if p.inScope[a.File] {
+			merged.AmbiguousConstructs = append(merged.AmbiguousConstructs, a)
+		}
+	}
+	merged.Summary.TotalViolations = len(merged.Violations)
+	for _, v := range merged.Violations {
+		switch v.Severity {
+		case "error":
+			merged.Summary.Errors++
+		case "warning":
+			merged.Summary.Warnings++
+		case "info":
+			merged.Summary.Info++
+		}
+	}
+	return merged
+}
+
+// fileInterfaces returns, for each of files, a key of what other files can
+// see of it or reach through it: its exported symbols, entities,
+// architectures and ports, and the units it uses, names in context and
+// library clauses, and instantiates. Lines are left out, so an edit that
+// only moves declarations keeps the key.
+func fileInterfaces(tables facts.Tables, files map[string]bool) map[string]string {
+	parts := make(map[string][]string, len(files))
+	add := func(file string, fields ...string) {
+		if files[file] {
+			parts[file] = append(parts[file], strings.Join(fields, "\x00"))
+		}
+	}
+	for _, r := range tables.Symbols {
+		add(r.File, "symbol", r.Kind, r.Name)
+	}
+	for _, r := range tables.Entities {
+		add(r.File, "entity", r.Name)
+	}
+	for _, r := range tables.Architectures {
+		add(r.File, "architecture", r.Name, r.EntityName)
+	}
+	for _, r := range tables.Packages {
+		add(r.File, "package", r.Name)
+	}
+	for _, r := range tables.Ports {
+		add(r.File, "port", r.Entity, r.Name, r.Direction, r.Type)
+	}
+	for _, r := range tables.Dependencies {
+		add(r.File, "dependency", r.Kind, r.Target)
+	}
+	for _, r := range tables.UseClauses {
+		add(r.File, "use", r.Item)
+	}
+	for _, r := range tables.LibraryClauses {
+		add(r.File, "library", r.Library)
+	}
+	for _, r := range tables.ContextClauses {
+		add(r.File, "context", r.Name)
+	}
+	for _, r := range tables.Instances {
+		add(r.File, "instance", r.Target)
+	}
+	keys := make(map[string]string, len(files))
+	for file := range files {
+		p := parts[file]
+		sort.Strings(p)
+		keys[file] = strings.Join(p, "\x01")
+	}
+	return keys
+}
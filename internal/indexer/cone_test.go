@@ -0,0 +1,149 @@
+package indexer
+
+import (
+	"reflect"
+	"sort"
+	"testing"
+
+	"github.com/robert-at-pretension-io/vhdl-lint/internal/config"
+	"github.com/robert-at-pretension-io/vhdl-lint/internal/extractor"
+	"github.com/robert-at-pretension-io/vhdl-lint/internal/facts"
+	"github.com/robert-at-pretension-io/vhdl-lint/internal/policy"
+)
+
+func TestLintConePlanAndMerge(t *testing.T) {
+	idx := New()
+	idx.Facts = []extractor.FileFacts{
+		{File: "pkg.vhd", Packages: []extractor.Package{{Name: "pkg", Line: 1}}},
+		{File: "leaf.vhd", Entities: []extractor.Entity{{Name: "leaf", Line: 1}},
+			Dependencies: []extractor.Dependency{{Target: "work.pkg", Kind: "use", Line: 1}}},
+		{File: "top.vhd", Dependencies: []extractor.Dependency{{Target: "work.leaf", Kind: "instantiation", Line: 3}}},
+		{File: "util.vhd", Packages: []extractor.Package{{Name: "util", Line: 1}}},
+		{File: "other.vhd", Dependencies: []extractor.Dependency{{Target: "work.util", Kind: "use", Line: 1}}},
+	}
+	factsByFile := make(map[string]extractor.FileFacts)
+	var files []string
+	for _, f := range idx.Facts {
+		factsByFile[f.File] = f
+		files = append(files, f.File)
+		idx.FileLibraries[f.File] = config.FileLibraryInfo{LibraryName: "work"}
+	}
+	sort.Strings(files)
+	idx.Symbols.Add(Symbol{Name: "work.pkg", Kind: "package", File: "pkg.vhd", Line: 1})
+	idx.Symbols.Add(Symbol{Name: "work.leaf", Kind: "entity", File: "leaf.vhd", Line: 1})
+	idx.Symbols.Add(Symbol{Name: "work.util", Kind: "package", File: "util.vhd", Line: 1})
+
+	dir := t.TempDir()
+	if err := savePolicyCache(dir, policyCacheEntry{
+		Version:     policyCacheVersion,
+		Files:       files,
+		Approximate: true,
+		Result: policy.Result{Violations: []policy.Violation{
+			{Rule: "r", Severity: "warning", File: "other.vhd", Line: 1},
+			{Rule: "r", Severity: "warning", File: "leaf.vhd", Line: 1},
+			{Rule: "global", Severity: "info", File: "", Line: 0},
+		}},
+	}); err != nil {
+		t.Fatalf("save policy cache: %v", err)
+	}
+	tables := facts.BuildTables(idx.Facts, idx.FileLibraries, nil, idx.buildSymbolRows())
+	if err := saveFactTablesCache(dir, tables); err != nil {
+		t.Fatalf("save fact tables: %v", err)
+	}
+
+	plan, err := idx.planLintCone(dir, files, factsByFile, tables, map[string]bool{"leaf.vhd": true})
+	if err != nil || plan == nil {
+		t.Fatalf("expected a cone plan, got %v, %v", plan, err)
+	}
+	if want := map[string]bool{"leaf.vhd": true, "top.vhd": true}; !reflect.DeepEqual(plan.cone, want) {
+		t.Fatalf("cone = %v, want %v", plan.cone, want)
+	}
+	var scope []string
+	for _, f := range plan.scope {
+		scope = append(scope, f.File)
+	}
+	if want := []string{"pkg.vhd", "leaf.vhd", "top.vhd"}; !reflect.DeepEqual(scope, want) {
+		t.Fatalf("scope = %v, want %v", scope, want)
+	}
+
+	merged := plan.merge(&policy.Result{Violations: []policy.Violation{
+		{Rule: "r", Severity: "error", File: "top.vhd", Line: 3},
+		{Rule: "r", Severity: "warning", File: "pkg.vhd", Line: 1},
+	}})
+	// pkg.vhd was evaluated with the cone, so its fresh entry is taken too
+	wantViolations := []policy.Violation{
+		{Rule: "r", Severity: "warning", File: "other.vhd", Line: 1},
+		{Rule: "global", Severity: "info", File: "", Line: 0},
+		{Rule: "r", Severity: "error", File: "top.vhd", Line: 3},
+		{Rule: "r", Severity: "warning", File: "pkg.vhd", Line: 1},
+	}
+	if !reflect.DeepEqual(merged.Violations, wantViolations) {
+		t.Fatalf("merged violations = %#v", merged.Violations)
+	}
+	if s := merged.Summary; s.TotalViolations != 4 || s.Errors != 1 || s.Warnings != 2 || s.Info != 1 {
+		t.Fatalf("merged summary = %#v", s)
+	}
+
+	// An approximate entry feeds later cone runs but is never a full hit
+	if plan, err := idx.planLintCone(dir, files, factsByFile, tables, map[string]bool{"leaf.vhd": true}); err != nil || plan == nil {
+		t.Fatalf("expected a cone plan over the approximate entry, got %v, %v", plan, err)
+	}
+	if ok, _ := policyCacheValid(&policyCacheEntry{Version: policyCacheVersion, Files: files, Approximate: true}, policy.Input{}, files); ok {
+		t.Fatal("approximate cone entry accepted as a full policy cache hit")
+	}
+
+	// A different file set (e.g. a file was deleted) means a full run
+	if plan, err := idx.planLintCone(dir, files[1:], factsByFile, tables, map[string]bool{"leaf.vhd": true}); err != nil || plan != nil {
+		t.Fatalf("expected no cone plan for another file set, got %v, %v", plan, err)
+	}
+
+	// leaf.vhd renames its entity: top.vhd depended on it only under the
+	// old facts, so the cone would miss it and a full run is needed
+	renamed := tables
+	renamed.Entities = append([]facts.EntityRow(nil), tables.Entities...)
+	for i := range renamed.Entities {
+		if renamed.Entities[i].File == "leaf.vhd" {
+			renamed.Entities[i].Name = "leaf2"
+		}
+	}
+	if plan, err := idx.planLintCone(dir, files, factsByFile, renamed, map[string]bool{"leaf.vhd": true}); err != nil || plan != nil {
+		t.Fatalf("expected no cone plan after an interface change, got %v, %v", plan, err)
+	}
+	// A body-only change, lines moved included, keeps the cone
+	moved := tables
+	moved.Dependencies = append([]facts.DependencyRow(nil), tables.Dependencies...)
+	for i := range moved.Dependencies {
+		moved.Dependencies[i].Line += 10
+	}
+	if plan, err := idx.planLintCone(dir, files, factsByFile, moved, map[string]bool{"leaf.vhd": true}); err != nil || plan == nil {
+		t.Fatalf("expected a cone plan after moving lines, got %v, %v", plan, err)
+	}
+}
+
+// Stats describe the design, not the scope a cone run evaluated.
+func TestFactStatsMatchFullInput(t *testing.T) {
+	idx := New()
+	idx.Facts = []extractor.FileFacts{
+		{File: "a.vhd", Entities: []extractor.Entity{{Name: "a", Line: 1}},
+			Ports:     []extractor.Port{{Name: "clk", Direction: "in", Type: "bit", InEntity: "a", Line: 2}},
+			Signals:   []extractor.Signal{{Name: "s", Type: "bit", InEntity: "a", Line: 5}, {Name: "bad", Line: 6}},
+			Processes: []extractor.Process{{Label: "p", Line: 7}}},
+		{File: "b.vhd", Packages: []extractor.Package{{Name: "pkg", Line: 1}},
+			Instances: []extractor.Instance{{Name: "u", Target: "work.a", Line: 3}},
+			Generates: []extractor.GenerateStatement{{Label: "g", Line: 4}}},
+	}
+	input := idx.buildPolicyInput()
+	got := factStats(idx.Facts)
+	want := ExtractionStats{
+		Entities:  len(input.Entities),
+		Packages:  len(input.Packages),
+		Signals:   len(input.Signals),
+		Ports:     len(input.Ports),
+		Processes: len(input.Processes),
+		Instances: len(input.Instances),
+		Generates: len(input.Generates),
+	}
+	if got != want {
+		t.Fatalf("factStats = %+v, full input counts %+v", got, want)
+	}
+}
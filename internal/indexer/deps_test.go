@@ -27,7 +27,7 @@ func TestImpactExpansion(t *testing.T) {
 		"c.vhd": factsC,
 	}
 
-	symbols := &SymbolTable{symbols: make(map[string]Symbol)}
+	symbols := NewSymbolTable()
 	symbols.Add(Symbol{Name: "work.pkg", Kind: "package", File: "a.vhd", Line: 1})
 
 	fileLibs := map[string]config.FileLibraryInfo{
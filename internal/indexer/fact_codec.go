@@ -0,0 +1,419 @@
+package indexer
+
+import (
+	"encoding/binary"
+	"errors"
+	"fmt"
+	"math"
+	"reflect"
+	"sort"
+	"strings"
+
+	"github.com/robert-at-pretension-io/vhdl-lint/internal/extractor"
+)
+
+// Binary encoding for cached FileFacts.
+//
+// Strings are interned into a per-record table and referenced by index, ints
+// are zigzag varints, and slices, maps and pointers carry a nil marker so a
+// decoded FileFacts is identical to the encoded one (nil stays nil, empty stays
+// empty). The encoder and decoder are compiled once from the type by
+// reflection, so adding a field to a fact type needs no codec changes. The
+// layout follows the types, so records are only read back under the same
+// extractor version (part of every record's key).
+
+var errCodecCorrupt = errors.New("corrupt cached facts")
+
+type factEncoder struct {
+	buf     []byte
+	strings map[string]uint64
+	table   []string
+}
+
+type factDecoder struct {
+	data    []byte
+	pos     int
+	strings []string
+	err     error
+}
+
+type typeCodec struct {
+	enc func(*factEncoder, reflect.Value)
+	dec func(*factDecoder, reflect.Value)
+}
+
+// fileFactsCodec is compiled at init, before any worker can use it.
+var fileFactsCodec = compileCodec(reflect.TypeOf(extractor.FileFacts{}), map[reflect.Type]*typeCodec{})
+
+// encodeFacts appends the encoding of facts (string table, then body) to dst.
+func encodeFacts(dst []byte, facts *extractor.FileFacts) []byte {
+	return encodeRecord(dst, fileFactsCodec, reflect.ValueOf(facts).Elem())
+}
+
+// decodeFacts decodes a record produced by encodeFacts. data is only read;
+// every string in the result is copied out of it.
+func decodeFacts(data []byte) (extractor.FileFacts, error) {
+	var facts extractor.FileFacts
+	if err := decodeRecord(data, fileFactsCodec, reflect.ValueOf(&facts).Elem()); err != nil {
+		return extractor.FileFacts{}, err
+	}
+	return facts, nil
+}
+
+// encodeRecord appends the string table, then the body of v under c.
+func encodeRecord(dst []byte, c *typeCodec, v reflect.Value) []byte {
+	e := &factEncoder{strings: make(map[string]uint64)}
+	c.enc(e, v)
+
+	dst = binary.AppendUvarint(dst, uint64(len(e.table)))
+	for _, s := range e.table {
+		dst = binary.AppendUvarint(dst, uint64(len(s)))
+		dst = append(dst, s...)
+	}
+	return append(dst, e.buf...)
+}
+
+// decodeRecord decodes a record of encodeRecord into v. The string table is
+// copied into one allocation that every decoded string slices, so a record
+// costs one string allocation however many strings it has, and equal strings
+// share their bytes.
+func decodeRecord(data []byte, c *typeCodec, v reflect.Value) error {
+	d := &factDecoder{data: data}
+	n := d.length()
+	if d.err == nil {
+		spans := make([]int, 0, 2*n)
+		total := 0
+		for i := 0; i < n && d.err == nil; i++ {
+			l := d.length()
+			start := d.pos
+			d.bytes(l)
+			spans = append(spans, start, l)
+			total += l
+		}
+		if d.err == nil {
+			var arena strings.Builder
+			arena.Grow(total)
+			for i := 0; i < len(spans); i += 2 {
+				arena.Write(data[spans[i] : spans[i]+spans[i+1]])
+			}
+			all := arena.String()
+			d.strings = make([]string, n)
+			off := 0
+			for i := range d.strings {
+				l := spans[2*i+1]
+				d.strings[i] = all[off : off+l]
+				off += l
+			}
+		}
+	}
+	if d.err == nil {
+		c.dec(d, v)
+	}
+	if d.err == nil && d.pos != len(d.data) {
+		d.err = errCodecCorrupt
+	}
+	return d.err
+}
+
+func (e *factEncoder) uvarint(v uint64) {
+	e.buf = binary.AppendUvarint(e.buf, v)
+}
+
+func (e *factEncoder) str(s string) {
+	id, ok := e.strings[s]
+	if !ok {
+		id = uint64(len(e.table))
+		e.strings[s] = id
+		e.table = append(e.table, s)
+	}
+	e.uvarint(id)
+}
+
+func (d *factDecoder) uvarint() uint64 {
+	if d.err != nil {
+		return 0
+	}
+	v, n := binary.Uvarint(d.data[d.pos:])
+	if n <= 0 {
+		d.err = errCodecCorrupt
+		return 0
+	}
+	d.pos += n
+	return v
+}
+
+// length reads a count, rejecting values that cannot fit in what is left
+// (every encoded element takes at least one byte).
+func (d *factDecoder) length() int {
+	v := d.uvarint()
+	if v > uint64(len(d.data)-d.pos) {
+		d.err = errCodecCorrupt
+		return 0
+	}
+	return int(v)
+}
+
+func (d *factDecoder) bytes(n int) []byte {
+	if d.err != nil {
+		return nil
+	}
+	if n > len(d.data)-d.pos {
+		d.err = errCodecCorrupt
+		return nil
+	}
+	b := d.data[d.pos : d.pos+n]
+	d.pos += n
+	return b
+}
+
+func (d *factDecoder) str() string {
+	id := d.uvarint()
+	if d.err != nil {
+		return ""
+	}
+	if id >= uint64(len(d.strings)) {
+		d.err = errCodecCorrupt
+		return ""
+	}
+	return d.strings[id]
+}
+
+// nilMarker reads the 0 (nil) / n+1 prefix used by slices and maps.
+func (d *factDecoder) nilMarker() (int, bool) {
+	v := d.uvarint()
+	if v == 0 || d.err != nil {
+		return 0, false
+	}
+	if v-1 > uint64(len(d.data)-d.pos) {
+		d.err = errCodecCorrupt
+		return 0, false
+	}
+	return int(v - 1), true
+}
+
+func compileCodec(t reflect.Type, seen map[reflect.Type]*typeCodec) *typeCodec {
+	if c, ok := seen[t]; ok {
+		return c
+	}
+	// Registered before the body is built so recursive types (generates
+	// nested in generates) resolve to this codec.
+	c := &typeCodec{}
+	seen[t] = c
+
+	switch t.Kind() {
+	case reflect.String:
+		c.enc = func(e *factEncoder, v reflect.Value) { e.str(v.String()) }
+		c.dec = func(d *factDecoder, v reflect.Value) { v.SetString(d.str()) }
+
+	case reflect.Bool:
+		c.enc = func(e *factEncoder, v reflect.Value) {
+			if v.Bool() {
+				e.buf = append(e.buf, 1)
+			} else {
+				e.buf = append(e.buf, 0)
+			}
+		}
+		c.dec = func(d *factDecoder, v reflect.Value) {
+			b := d.bytes(1)
+			if d.err == nil {
+				v.SetBool(b[0] != 0)
+			}
+		}
+
+	case reflect.Int, reflect.Int8, reflect.Int16, reflect.Int32, reflect.Int64:
+		c.enc = func(e *factEncoder, v reflect.Value) { e.buf = binary.AppendVarint(e.buf, v.Int()) }
+		c.dec = func(d *factDecoder, v reflect.Value) {
+			if d.err != nil {
+				return
+			}
+			x, n := binary.Varint(d.data[d.pos:])
+			if n <= 0 {
+				d.err = errCodecCorrupt
+				return
+			}
+			d.pos += n
+			v.SetInt(x)
+		}
+
+	case reflect.Uint, reflect.Uint8, reflect.Uint16, reflect.Uint32, reflect.Uint64:
+		c.enc = func(e *factEncoder, v reflect.Value) { e.uvarint(v.Uint()) }
+		c.dec = func(d *factDecoder, v reflect.Value) { v.SetUint(d.uvarint()) }
+
+	case reflect.Float32, reflect.Float64:
+		c.enc = func(e *factEncoder, v reflect.Value) {
+			e.buf = binary.LittleEndian.AppendUint64(e.buf, math.Float64bits(v.Float()))
+		}
+		c.dec = func(d *factDecoder, v reflect.Value) {
+			b := d.bytes(8)
+			if d.err == nil {
+				v.SetFloat(math.Float64frombits(binary.LittleEndian.Uint64(b)))
+			}
+		}
+
+	case reflect.Slice:
+		elem := compileCodec(t.Elem(), seen)
+		c.enc = func(e *factEncoder, v reflect.Value) {
+			if v.IsNil() {
+				e.uvarint(0)
+				return
+			}
+			n := v.Len()
+			e.uvarint(uint64(n) + 1)
+			for i := 0; i < n; i++ {
+				elem.enc(e, v.Index(i))
+			}
+		}
+		c.dec = func(d *factDecoder, v reflect.Value) {
+			n, ok := d.nilMarker()
+			if !ok {
+				return
+			}
+			s := reflect.MakeSlice(t, n, n)
+			for i := 0; i < n && d.err == nil; i++ {
+				elem.dec(d, s.Index(i))
+			}
+			v.Set(s)
+		}
+
+	case reflect.Map:
+		if t.Key().Kind() != reflect.String {
+			panic(fmt.Sprintf("fact codec: unsupported map key in %s", t))
+		}
+		elem := compileCodec(t.Elem(), seen)
+		c.enc = func(e *factEncoder, v reflect.Value) {
+			if v.IsNil() {
+				e.uvarint(0)
+				return
+			}
+			// Sorted keys keep the encoding deterministic
+			keys := v.MapKeys()
+			sort.Slice(keys, func(i, j int) bool { return keys[i].String() < keys[j].String() })
+			e.uvarint(uint64(len(keys)) + 1)
+			for _, k := range keys {
+				e.str(k.String())
+				elem.enc(e, v.MapIndex(k))
+			}
+		}
+		c.dec = func(d *factDecoder, v reflect.Value) {
+			n, ok := d.nilMarker()
+			if !ok {
+				return
+			}
+			m := reflect.MakeMapWithSize(t, n)
+			key := reflect.New(t.Key()).Elem()
+			val := reflect.New(t.Elem()).Elem()
+			for i := 0; i < n && d.err == nil; i++ {
+				key.SetString(d.str())
+				val.Set(reflect.Zero(t.Elem()))
+				elem.dec(d, val)
+				m.SetMapIndex(key, val)
+			}
+			v.Set(m)
+		}
+
+	case reflect.Pointer:
+		elem := compileCodec(t.Elem(), seen)
+		c.enc = func(e *factEncoder, v reflect.Value) {
+			if v.IsNil() {
+				e.uvarint(0)
+				return
+			}
+			e.uvarint(1)
+			elem.enc(e, v.Elem())
+		}
+		c.dec = func(d *factDecoder, v reflect.Value) {
+			if d.uvarint() == 0 || d.err != nil {
+				return
+			}
+			p := reflect.New(t.Elem())
+			elem.dec(d, p.Elem())
+			v.Set(p)
+		}
+
+	case reflect.Struct:
+		// Exported fields only, matching what the JSON cache stored
+		var fields []int
+		var codecs []*typeCodec
+		for i := 0; i < t.NumField(); i++ {
+			f := t.Field(i)
+			if !f.IsExported() || f.Tag.Get("json") == "-" {
+				continue
+			}
+			fields = append(fields, i)
+			codecs = append(codecs, compileCodec(f.Type, seen))
+		}
+		c.enc = func(e *factEncoder, v reflect.Value) {
+			for i, f := range fields {
+				codecs[i].enc(e, v.Field(f))
+			}
+		}
+		c.dec = func(d *factDecoder, v reflect.Value) {
+			for i, f := range fields {
+				if d.err != nil {
+					return
+				}
+				codecs[i].dec(d, v.Field(f))
+			}
+		}
+
+	default:
+		panic(fmt.Sprintf("fact codec: unsupported type %s", t))
+	}
+	return c
+}
+
+// codecLayout describes the encoding compileCodec derives from t: the kind
+// of every value and the encoded struct fields, by name, in order. Records
+// of types with the same layout decode as each other; any other change to
+// the types (a field added, removed, renamed or retyped) changes it.
+func codecLayout(t reflect.Type) string {
+	var b strings.Builder
+	writeCodecLayout(&b, t, map[reflect.Type]bool{})
+	return b.String()
+}
+
+// open holds the types being described, so recursive types end in a
+// back reference.
+func writeCodecLayout(b *strings.Builder, t reflect.Type, open map[reflect.Type]bool) {
+	switch t.Kind() {
+	case reflect.String:
+		b.WriteString("string")
+	case reflect.Bool:
+		b.WriteString("bool")
+	case reflect.Int, reflect.Int8, reflect.Int16, reflect.Int32, reflect.Int64:
+		b.WriteString("int")
+	case reflect.Uint, reflect.Uint8, reflect.Uint16, reflect.Uint32, reflect.Uint64:
+		b.WriteString("uint")
+	case reflect.Float32, reflect.Float64:
+		b.WriteString("float")
+	case reflect.Slice:
+		b.WriteString("[]")
+		writeCodecLayout(b, t.Elem(), open)
+	case reflect.Map:
+		b.WriteString("map[string]")
+		writeCodecLayout(b, t.Elem(), open)
+	case reflect.Pointer:
+		b.WriteString("*")
+		writeCodecLayout(b, t.Elem(), open)
+	case reflect.Struct:
+		if open[t] {
+			b.WriteString("@" + t.String())
+			return
+		}
+		open[t] = true
+		b.WriteString("{")
+		for i := 0; i < t.NumField(); i++ {
+			f := t.Field(i)
+			if !f.IsExported() || f.Tag.Get("json") == "-" {
+				continue
+			}
+			b.WriteString(f.Name + " ")
+			writeCodecLayout(b, f.Type, open)
+			b.WriteString(";")
+		}
+		b.WriteString("}")
+		delete(open, t)
+	default:
+		b.WriteString(t.String())
+	}
+}
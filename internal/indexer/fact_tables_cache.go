@@ -1,23 +1,46 @@
 package indexer
 
 import (
-	"encoding/json"
+	"bytes"
+	"crypto/sha256"
+	"encoding/binary"
+	"errors"
 	"fmt"
 	"os"
 	"path/filepath"
+	"reflect"
 
 	"github.com/robert-at-pretension-io/vhdl-lint/internal/facts"
 )
 
-const factTablesCacheVersion = 1
+// The fact tables of the last run, for the policy daemon's delta. Stored as
+// one fact_codec record: every distinct string once in the record's string
+// table, rows as varint string IDs. Decoded tables share one string arena,
+// so repeated file, type and scope names cost their bytes once.
+//
+// The codec is positional, so the header carries a fingerprint of the
+// facts.Tables layout besides the format version: a cache written before a
+// row struct changed is a miss, not a misread. So is any record that does
+// not decode; the tables are rebuilt and saved again on the next run.
 
-type factTablesCache struct {
-	Version int          `json:"version"`
-	Tables  facts.Tables `json:"tables"`
-}
+const factTablesCacheVersion = 3
+
+const factTablesCacheFile = "fact_tables.bin"
+
+var factTablesMagic = []byte("VHFT")
 
+var factTablesCodec = compileCodec(reflect.TypeOf(facts.Tables{}), map[reflect.Type]*typeCodec{})
+
+var factTablesLayout = func() uint64 {
+	sum := sha256.Sum256([]byte(codecLayout(reflect.TypeOf(facts.Tables{}))))
+	return binary.LittleEndian.Uint64(sum[:8])
+}()
+
+// loadFactTablesCache returns the tables saveFactTablesCache left in dir.
+// ok is false when there are none it can use: no file, another version or
+// layout, or a record that does not decode. Only a read failure is an error.
 func loadFactTablesCache(dir string) (facts.Tables, bool, error) {
-	path := filepath.Join(dir, "fact_tables.json")
+	path := filepath.Join(dir, factTablesCacheFile)
 	data, err := os.ReadFile(path)
 	if err != nil {
 		if os.IsNotExist(err) {
@@ -25,23 +48,37 @@ func loadFactTablesCache(dir string) (facts.Tables, bool, error) {
 		}
 		return facts.Tables{}, false, fmt.Errorf("read fact tables cache: %w", err)
 	}
-	var cache factTablesCache
-	if err := json.Unmarshal(data, &cache); err != nil {
-		return facts.Tables{}, false, fmt.Errorf("parse fact tables cache: %w", err)
+	if !bytes.HasPrefix(data, factTablesMagic) {
+		return facts.Tables{}, false, nil
+	}
+	data = data[len(factTablesMagic):]
+	version, n := binary.Uvarint(data)
+	if n <= 0 || version != factTablesCacheVersion {
+		return facts.Tables{}, false, nil
+	}
+	data = data[n:]
+	layout, n := binary.Uvarint(data)
+	if n <= 0 || layout != factTablesLayout {
+		return facts.Tables{}, false, nil
 	}
-	if cache.Version != factTablesCacheVersion {
+	var tables facts.Tables
+	if err := decodeRecord(data[n:], factTablesCodec, reflect.ValueOf(&tables).Elem()); err != nil {
 		return facts.Tables{}, false, nil
 	}
-	return cache.Tables, true, nil
+	return tables, true, nil
 }
 
 func saveFactTablesCache(dir string, tables facts.Tables) error {
-	cache := factTablesCache{
-		Version: factTablesCacheVersion,
-		Tables:  tables,
-	}
-	if err := writeJSONAtomic(filepath.Join(dir, "fact_tables.json"), cache); err != nil {
+	buf := append([]byte{}, factTablesMagic...)
+	buf = binary.AppendUvarint(buf, factTablesCacheVersion)
+	buf = binary.AppendUvarint(buf, factTablesLayout)
+	buf = encodeRecord(buf, factTablesCodec, reflect.ValueOf(&tables).Elem())
+	if err := writeFileAtomic(filepath.Join(dir, factTablesCacheFile), buf); err != nil {
 		return fmt.Errorf("write fact tables cache: %w", err)
 	}
+	// Drop the JSON cache of earlier versions
+	if err := os.Remove(filepath.Join(dir, "fact_tables.json")); err != nil && !errors.Is(err, os.ErrNotExist) {
+		return fmt.Errorf("remove old fact tables cache: %w", err)
+	}
 	return nil
 }
@@ -1,6 +1,9 @@
 package indexer
 
 import (
+	"encoding/binary"
+	"os"
+	"path/filepath"
 	"reflect"
 	"testing"
 
@@ -12,11 +15,15 @@ func TestFactTablesCacheRoundTrip(t *testing.T) {
 	tables := facts.Tables{
 		Files: []facts.FileRow{
 			{Path: "a.vhd", Library: "work", IsThirdParty: false},
+			{Path: "b.vhd", Library: "work", IsThirdParty: true},
+		},
+		Entities:      []facts.EntityRow{{Name: "top", File: "a.vhd", Line: 3}},
+		Architectures: []facts.ArchitectureRow{},
+		Packages:      []facts.PackageRow{},
+		Ports: []facts.PortRow{
+			{Entity: "top", Name: "clk", Direction: "in", Type: "std_logic", File: "a.vhd", Line: 4},
+			{Entity: "top", Name: "q", Direction: "out", Type: "std_logic", File: "a.vhd", Line: 5},
 		},
-		Entities:       []facts.EntityRow{},
-		Architectures:  []facts.ArchitectureRow{},
-		Packages:       []facts.PackageRow{},
-		Ports:          []facts.PortRow{},
 		Signals:        []facts.SignalRow{},
 		Instances:      []facts.InstanceRow{},
 		Dependencies:   []facts.DependencyRow{},
@@ -30,7 +37,7 @@ func TestFactTablesCacheRoundTrip(t *testing.T) {
 		Functions:      []facts.FunctionRow{},
 		Procedures:     []facts.ProcedureRow{},
 		Constants:      []facts.ConstantRow{},
-		Symbols:        []facts.SymbolRow{},
+		Symbols:        nil, // nil stays nil
 	}
 
 	if err := saveFactTablesCache(dir, tables); err != nil {
@@ -47,4 +54,54 @@ func TestFactTablesCacheRoundTrip(t *testing.T) {
 	if !reflect.DeepEqual(tables, loaded) {
 		t.Fatalf("tables mismatch: expected %#v got %#v", tables, loaded)
 	}
+
+	// A corrupt record is a miss: the next run rebuilds and saves the tables
+	corrupt := append([]byte{}, factTablesMagic...)
+	corrupt = binary.AppendUvarint(corrupt, factTablesCacheVersion)
+	corrupt = binary.AppendUvarint(corrupt, factTablesLayout)
+	corrupt = append(corrupt, 0xff)
+	if err := os.WriteFile(filepath.Join(dir, factTablesCacheFile), corrupt, 0o644); err != nil {
+		t.Fatalf("write corrupt cache: %v", err)
+	}
+	if _, ok, err := loadFactTablesCache(dir); err != nil || ok {
+		t.Fatalf("expected a miss for a corrupt cache, ok=%v err=%v", ok, err)
+	}
+
+	// So is one written under another layout of the row types
+	other := append([]byte{}, factTablesMagic...)
+	other = binary.AppendUvarint(other, factTablesCacheVersion)
+	other = binary.AppendUvarint(other, factTablesLayout+1)
+	other = encodeRecord(other, factTablesCodec, reflect.ValueOf(&tables).Elem())
+	if err := os.WriteFile(filepath.Join(dir, factTablesCacheFile), other, 0o644); err != nil {
+		t.Fatalf("write cache: %v", err)
+	}
+	if _, ok, err := loadFactTablesCache(dir); err != nil || ok {
+		t.Fatalf("expected a miss for another layout, ok=%v err=%v", ok, err)
+	}
+}
+
+func TestCodecLayoutTracksFields(t *testing.T) {
+	type rowA struct {
+		Name string
+		Line int
+	}
+	type rowB struct {
+		Name string
+		File string
+		Line int
+	}
+	type rowC struct {
+		Label string
+		Line  int
+	}
+	layoutA := codecLayout(reflect.TypeOf([]rowA{}))
+	if layoutA == codecLayout(reflect.TypeOf([]rowB{})) {
+		t.Fatal("an added field kept the layout")
+	}
+	if layoutA == codecLayout(reflect.TypeOf([]rowC{})) {
+		t.Fatal("a renamed field kept the layout")
+	}
+	if codecLayout(reflect.TypeOf(facts.Tables{})) != codecLayout(reflect.TypeOf(facts.Tables{})) {
+		t.Fatal("layout is not deterministic")
+	}
 }
@@ -27,8 +27,10 @@ package indexer
 import (
 	"encoding/json"
 	"fmt"
+	"io"
 	"os"
 	"path/filepath"
+	"runtime"
 	"sort"
 	"strings"
 	"sync"
@@ -74,13 +76,46 @@ type Indexer struct {
 	// JSON output mode
 	JSONOutput bool
 
-	// Timing output (JSONL)
-	Timing     bool
-	TimingPath string
+	// Timing output: jsonl (default), chrome or pprof (see timing.go)
+	Timing       bool
+	TimingPath   string
+	TimingFormat string
+
+	// Collect per-file parse stats for timing events (set by Run)
+	parseStats bool
+
+	// Syntax trees kept across Run calls so changed files are reparsed
+	// incrementally (nil: every miss is a full parse)
+	Trees *extractor.TreeStore
 
 	// Optional extractor factory (for tests)
 	extractorFactory func() FactsExtractor
 
+	// Shared by the extractors of one Run (Analysis.ExtractMemoryMB)
+	extractBudget *extractor.MemoryBudget
+
+	// Resident keeps validators and the policy daemon between Run calls
+	// (see resident.go); release them with Close
+	Resident bool
+	resident residentState
+
+	// Output receives the JSON result (default os.Stdout)
+	Output io.Writer
+
+	// LastResult is the result of the last Run that got to policy evaluation
+	LastResult *LintResult
+
+	// Sharded extraction (see shard.go): with Shard set, Run extracts only
+	// the files the shard owns and writes their facts to an artifact in
+	// ArtifactDir (default <cache dir>/shards) instead of linting; Artifacts
+	// are shard outputs whose facts stand in for extraction
+	Shard       *Shard
+	ArtifactDir string
+	Artifacts   []string
+
+	// ArtifactPath is the artifact written by the last shard Run
+	ArtifactPath string
+
 	// Optional cache version override (for tests)
 	cacheVersionOverride *cacheVersions
 }
@@ -108,6 +143,10 @@ type LintResult struct {
 
 	// Parse errors encountered
 	ParseErrors []ParseError `json:"parse_errors,omitempty"`
+
+	// Problems that did not affect the result (e.g. the remote cache was
+	// unreachable and the run went on without it)
+	Warnings []string `json:"warnings,omitempty"`
 }
 
 // ResultSummary provides aggregate violation counts
@@ -145,12 +184,6 @@ type ParseError struct {
 	Message string `json:"message"`
 }
 
-// SymbolTable holds all exported symbols across files
-type SymbolTable struct {
-	mu      sync.RWMutex
-	symbols map[string]Symbol
-}
-
 // Symbol represents an exported VHDL construct
 type Symbol struct {
 	Name string // Qualified name: work.my_entity
@@ -164,6 +197,19 @@ type FactsExtractor interface {
 	Extract(path string) (extractor.FileFacts, error)
 }
 
+// tieredExtractor is a FactsExtractor that can extract less than every fact
+// (see extractor.Tier).
+type tieredExtractor interface {
+	ExtractTier(path string, tier extractor.Tier) (extractor.FileFacts, error)
+}
+
+func extractAt(ext FactsExtractor, path string, tier extractor.Tier) (extractor.FileFacts, error) {
+	if t, ok := ext.(tieredExtractor); ok {
+		return t.ExtractTier(path, tier)
+	}
+	return ext.Extract(path)
+}
+
 type cacheVersions struct {
 	parser    string
 	extractor string
@@ -176,9 +222,7 @@ func New() *Indexer {
 		Libraries: map[string]string{
 			"work": ".", // Default: work library is current directory
 		},
-		Symbols: &SymbolTable{
-			symbols: make(map[string]Symbol),
-		},
+		Symbols:         NewSymbolTable(),
 		FileLibraries:   make(map[string]config.FileLibraryInfo),
 		ThirdPartyFiles: make(map[string]bool),
 	}
@@ -195,14 +239,57 @@ func (idx *Indexer) newExtractor() FactsExtractor {
 	if idx.extractorFactory != nil {
 		return idx.extractorFactory()
 	}
-	return extractor.New()
+	ext := extractor.New()
+	ext.ParseStats = idx.parseStats
+	if idx.Config != nil {
+		ext.SkipTranslateOff = idx.Config.Lint.SkipTranslateOff
+		ext.StreamThreshold = int64(idx.Config.Analysis.StreamThresholdMB) << 20
+	}
+	ext.Budget = idx.extractBudget
+	ext.Trees = idx.Trees
+	ext.Queries = envBool("VHDL_EXTRACT_QUERIES")
+	return ext
+}
+
+// extractionTier is the Tier ext extracts file f at. Violations in
+// third-party files are never reported, so unless Analysis.ThirdPartyFacts
+// is "full" they only need what other files link against.
+func (idx *Indexer) extractionTier(ext FactsExtractor, f string) extractor.Tier {
+	if _, ok := ext.(tieredExtractor); !ok {
+		return extractor.TierFull
+	}
+	if idx.ThirdPartyFiles[f] && (idx.Config == nil || idx.Config.Analysis.ThirdPartyFacts != "full") {
+		return extractor.TierDeclarations
+	}
+	return extractor.TierFull
+}
+
+// extractionWorkers sizes the extraction pool: Analysis.MaxParallelFiles when
+// set, otherwise GOMAXPROCS, and never more workers than files.
+func (idx *Indexer) extractionWorkers(fileCount int) int {
+	workers := runtime.GOMAXPROCS(0)
+	if idx.Config != nil && idx.Config.Analysis.MaxParallelFiles > 0 {
+		workers = idx.Config.Analysis.MaxParallelFiles
+	}
+	if workers > fileCount {
+		workers = fileCount
+	}
+	if workers < 1 {
+		workers = 1
+	}
+	return workers
 }
 
 func (idx *Indexer) cacheVersions(rootPath string) cacheVersions {
 	if idx.cacheVersionOverride != nil {
 		return *idx.cacheVersionOverride
 	}
-	return computeCacheVersions(rootPath)
+	versions := computeCacheVersions(rootPath)
+	// Extractor options change the facts produced for the same content
+	if idx.Config != nil && idx.Config.Lint.SkipTranslateOff {
+		versions.extractor += "+skip_translate_off"
+	}
+	return versions
 }
 
 func (idx *Indexer) registerSymbolsForFacts(facts extractor.FileFacts, filePath string) {
@@ -282,11 +369,13 @@ func (idx *Indexer) Run(rootPath string) error {
 	recordPipelineErr := func(err error) {
 		pipelineErrs = append(pipelineErrs, err)
 	}
-	timing := newTimingRecorder(runStart, idx.resolveTimingPath(rootPath))
+	timingFormat := idx.resolveTimingFormat()
+	timing := newTimingRecorder(runStart, idx.resolveTimingPath(rootPath, timingFormat), timingFormat)
 	if err := timing.Err(); err != nil {
 		recordPipelineErr(fmt.Errorf("timing output disabled: %w", err))
 	}
 	defer timing.Close()
+	idx.parseStats = timing.Enabled()
 
 	// 0. Load configuration if not already loaded
 	if idx.Config == nil {
@@ -298,8 +387,9 @@ func (idx *Indexer) Run(rootPath string) error {
 	}
 
 	// Reset per-run state
-	idx.Symbols = &SymbolTable{symbols: make(map[string]Symbol)}
+	idx.Symbols = NewSymbolTable()
 	idx.Facts = nil
+	idx.LastResult = nil
 	idx.FileLibraries = make(map[string]config.FileLibraryInfo)
 	idx.ThirdPartyFiles = make(map[string]bool)
 
@@ -308,9 +398,23 @@ func (idx *Indexer) Run(rootPath string) error {
 	var files []string
 	var err error
 
+	// With the cache on, directories unchanged since the last run are not
+	// listed again
+	var dirSnapshot *config.DirSnapshot
+	dirSnapshotPath := ""
+	if cacheEnabled(idx.Config) {
+		dirSnapshotPath = filepath.Join(resolveCacheDir(rootPath, idx.Config), "dir_snapshot.json")
+		var snapErr error
+		dirSnapshot, snapErr = config.LoadDirSnapshot(dirSnapshotPath)
+		if snapErr != nil {
+			recordPipelineErr(fmt.Errorf("directory snapshot reset: %w", snapErr))
+		}
+	}
+	lister := config.NewLister(dirSnapshot)
+
 	// Check if config has library definitions
 	if len(idx.Config.Libraries) > 0 {
-		libs, resolveErr := idx.Config.ResolveLibraries(rootPath)
+		libs, resolveErr := idx.Config.ResolveLibrariesWith(rootPath, lister)
 		if resolveErr != nil {
 			return fmt.Errorf("resolve libraries: %w", resolveErr)
 		}
@@ -352,32 +456,55 @@ func (idx *Indexer) Run(rootPath string) error {
 
 	// Fallback to directory scan if no files from config
 	if len(files) == 0 {
-		files, err = idx.findVHDLFiles(rootPath)
+		files, err = lister.VHDLFiles(rootPath)
 		if err != nil {
 			return fmt.Errorf("scanning files: %w", err)
 		}
 	}
+	if dirSnapshot != nil {
+		if err := dirSnapshot.Save(dirSnapshotPath); err != nil {
+			recordPipelineErr(err)
+		}
+	}
 
 	// Filter out ignored files
+	ignore := idx.Config.IgnoreMatcher()
 	var filteredFiles []string
 	for _, f := range files {
-		if !idx.Config.ShouldIgnoreFile(f) {
+		if !ignore.Match(f) {
 			filteredFiles = append(filteredFiles, f)
 		}
 	}
 	files = filteredFiles
 
+	if idx.Shard != nil {
+		owned := files[:0]
+		for _, f := range files {
+			if idx.Shard.Owns(shardKey(rootPath, f)) {
+				owned = append(owned, f)
+			}
+		}
+		files = owned
+	}
+
 	if !idx.JSONOutput {
-		fmt.Printf("Found %d VHDL files\n", len(files))
+		if idx.Shard != nil {
+			fmt.Printf("Found %d VHDL files for shard %s\n", len(files), idx.Shard)
+		} else {
+			fmt.Printf("Found %d VHDL files\n", len(files))
+		}
 	}
 	scanDuration := time.Since(stepStart)
 	timing.RecordStage("scan", stepStart, scanDuration, "")
 
 	// 2. Pass 1: Parallel extraction (with optional cache)
+	// A bounded pool of workers, each owning one extractor (and so one
+	// long-lived tree-sitter parser), pulls files from a queue.
 	stepStart = time.Now()
-	ext := idx.newExtractor()
 	var cache *factsCache
 	var cacheDir string
+	var cacheStrict bool
+	var cacheHash string
 	if cacheEnabled(idx.Config) {
 		cacheDir = resolveCacheDir(rootPath, idx.Config)
 		versions := idx.cacheVersions(rootPath)
@@ -386,6 +513,29 @@ func (idx *Indexer) Run(rootPath string) error {
 			recordPipelineErr(fmt.Errorf("cache disabled: %w", err))
 			cache = nil
 		}
+		cacheStrict = idx.Config.Analysis.Cache.Strict
+		cacheHash = idx.Config.Analysis.Cache.Hash
+	}
+	var remote *remoteFactsCache
+	if cache != nil && idx.Config.Analysis.Cache.Remote != "" {
+		baseDir := rootPath
+		if info, err := os.Stat(rootPath); err == nil && !info.IsDir() {
+			baseDir = filepath.Dir(rootPath)
+		}
+		remote, err = newRemoteFactsCache(idx.Config.Analysis.Cache.Remote, baseDir, cacheHash, idx.cacheVersions(rootPath))
+		if err != nil {
+			recordPipelineErr(fmt.Errorf("remote cache disabled: %w", err))
+			remote = nil
+		} else {
+			defer remote.Close()
+		}
+	}
+	var artifacts map[string]artifactFile
+	if len(idx.Artifacts) > 0 {
+		artifacts, err = loadShardArtifacts(idx.Artifacts, idx.cacheVersions(rootPath))
+		if err != nil {
+			return fmt.Errorf("load artifacts: %w", err)
+		}
 	}
 	var wg sync.WaitGroup
 	var progressMu sync.Mutex
@@ -394,66 +544,164 @@ func (idx *Indexer) Run(rootPath string) error {
 	if progressEnabled {
 		fmt.Printf("\n=== Extraction Progress ===\n")
 	}
-	factsChan := make(chan extractor.FileFacts, len(files))
+	// Facts are collected while workers run; the small buffer back-pressures
+	// extraction instead of holding every file's facts in the channel
+	factsChan := make(chan extractor.FileFacts, 2*idx.extractionWorkers(len(files)))
+	factsByFile := make(map[string]extractor.FileFacts)
+	collected := make(chan struct{})
+	go func() {
+		defer close(collected)
+		for facts := range factsChan {
+			idx.Facts = append(idx.Facts, facts)
+			factsByFile[facts.File] = facts
+		}
+	}()
+	idx.extractBudget = extractor.NewMemoryBudget(int64(idx.Config.Analysis.ExtractMemoryMB) << 20)
 	errChan := make(chan error, len(files))
 	pipelineErrChan := make(chan error, len(files))
 	var changedMu sync.Mutex
 	changedFiles := make(map[string]bool)
 
-	for _, file := range files {
-		wg.Add(1)
-		go func(f string) {
-			defer wg.Done()
-			fileStart := time.Now()
-			var contentHash string
-			if cache != nil {
+	extractFile := func(ext FactsExtractor, worker int, f string) {
+		fileStart := time.Now()
+		// Facts extracted at another tier are a miss wherever they come from
+		tier := idx.extractionTier(ext, f)
+		var contentHash string
+		var stamp fileStamp
+		// reuse takes facts extracted earlier; facts the local cache did not
+		// have are changes as far as the cone and policy cache are concerned
+		reuse := func(facts extractor.FileFacts, status string) {
+			label := "cache hit"
+			switch status {
+			case "artifact":
+				label = "artifact"
+			case "remote_hit":
+				label = "remote hit"
+			}
+			if cache != nil && (status == "artifact" || status == "remote_hit") {
+				changedMu.Lock()
+				changedFiles[f] = true
+				changedMu.Unlock()
+			}
+			factsChan <- facts
+			idx.registerSymbolsForFacts(facts, f)
+			fileDuration := time.Since(fileStart)
+			timing.RecordFile("extract", f, status, worker, facts.Parse, fileStart, fileDuration)
+			if progressEnabled {
+				emitProgress(&progressMu, &progress, len(files), facts, label, idx.Trace, fileDuration)
+			}
+		}
+		if cache != nil {
+			// Stat before reading, so an edit made while we hash or extract
+			// leaves a stale stamp and is picked up next run
+			if st, err := statFile(f); err == nil {
+				stamp = st
+				if !cacheStrict {
+					if facts, ok, err := cache.GetByStamp(f, stamp); err == nil && ok && facts.Tier == tier {
+						reuse(facts, "cache_hit_stat")
+						return
+					} else if err != nil {
+						pipelineErrChan <- fmt.Errorf("cache read failed for %s: %w", f, err)
+					}
+				}
+			}
+			h, err := hashCacheFile(f, cacheHash)
+			if err != nil {
+				errChan <- fmt.Errorf("%s: %w", f, err)
+				return
+			}
+			contentHash = h
+			facts, ok, err := cache.Get(f, contentHash, stamp)
+			if err != nil {
+				pipelineErrChan <- fmt.Errorf("cache read failed for %s: %w", f, err)
+			}
+			if ok && facts.Tier == tier {
+				reuse(facts, "cache_hit")
+				return
+			}
+		}
+		if entry, ok := artifacts[shardKey(rootPath, f)]; ok {
+			sha := contentHash
+			if sha == "" || cacheHash == cacheHashFast {
 				h, err := hashFile(f)
 				if err != nil {
 					errChan <- fmt.Errorf("%s: %w", f, err)
 					return
 				}
-				contentHash = h
-				if facts, ok, err := cache.Get(f, contentHash); err == nil && ok {
-					factsChan <- facts
-					idx.registerSymbolsForFacts(facts, f)
-					fileDuration := time.Since(fileStart)
-					timing.RecordFile("extract", f, "cache_hit", fileStart, fileDuration)
-					if progressEnabled {
-						emitProgress(&progressMu, &progress, len(files), facts, "cache hit", idx.Trace, fileDuration)
+				sha = h
+			}
+			if sha == entry.contentHash && entry.facts.Tier == tier {
+				facts := entry.facts
+				relocateFacts(&facts, f)
+				if cache != nil && contentHash != "" {
+					if err := cache.Put(f, contentHash, stamp, facts); err != nil {
+						pipelineErrChan <- fmt.Errorf("cache write failed for %s: %w", f, err)
 					}
-					return
-				} else if err != nil {
-					pipelineErrChan <- fmt.Errorf("cache read failed for %s: %w", f, err)
 				}
-			}
-
-			facts, err := ext.Extract(f)
-			if err != nil {
-				errChan <- fmt.Errorf("%s: %w", f, err)
+				reuse(facts, "artifact")
 				return
 			}
-			if cache != nil && contentHash != "" {
-				if err := cache.Put(f, contentHash, facts); err != nil {
+		}
+		if remote != nil && contentHash != "" {
+			if facts, ok := remote.Get(f, contentHash, tier); ok {
+				if err := cache.Put(f, contentHash, stamp, facts); err != nil {
 					pipelineErrChan <- fmt.Errorf("cache write failed for %s: %w", f, err)
 				}
+				reuse(facts, "remote_hit")
+				return
 			}
-			if cache != nil {
-				changedMu.Lock()
-				changedFiles[f] = true
-				changedMu.Unlock()
+		}
+
+		facts, err := extractAt(ext, f, tier)
+		if err != nil {
+			errChan <- fmt.Errorf("%s: %w", f, err)
+			return
+		}
+		if cache != nil && contentHash != "" {
+			if err := cache.Put(f, contentHash, stamp, facts); err != nil {
+				pipelineErrChan <- fmt.Errorf("cache write failed for %s: %w", f, err)
 			}
-			fileDuration := time.Since(fileStart)
-			timing.RecordFile("extract", f, "extracted", fileStart, fileDuration)
-			if progressEnabled {
-				emitProgress(&progressMu, &progress, len(files), facts, "extracted", idx.Trace, fileDuration)
+			if remote != nil {
+				remote.Put(contentHash, facts)
 			}
-			factsChan <- facts
-			idx.registerSymbolsForFacts(facts, f)
-		}(file)
+		}
+		if cache != nil {
+			changedMu.Lock()
+			changedFiles[f] = true
+			changedMu.Unlock()
+		}
+		fileDuration := time.Since(fileStart)
+		timing.RecordFile("extract", f, "extracted", worker, facts.Parse, fileStart, fileDuration)
+		if progressEnabled {
+			emitProgress(&progressMu, &progress, len(files), facts, "extracted", idx.Trace, fileDuration)
+		}
+		factsChan <- facts
+		idx.registerSymbolsForFacts(facts, f)
+	}
+
+	jobs := make(chan string)
+	for w := 0; w < idx.extractionWorkers(len(files)); w++ {
+		wg.Add(1)
+		go func(worker int) {
+			defer wg.Done()
+			ext := idx.newExtractor()
+			for f := range jobs {
+				extractFile(ext, worker, f)
+			}
+		}(w)
+	}
+	for _, file := range files {
+		jobs <- file
 	}
+	close(jobs)
 
 	wg.Wait()
 	close(factsChan)
+	<-collected
+	// Facts arrive in completion order; rules that pick the first of
+	// several declarations (and the policy daemon, which sees rows
+	// sorted) need the same order every run.
+	sort.Slice(idx.Facts, func(i, j int) bool { return idx.Facts[i].File < idx.Facts[j].File })
 	close(errChan)
 	close(pipelineErrChan)
 
@@ -466,20 +714,23 @@ func (idx *Indexer) Run(rootPath string) error {
 		recordPipelineErr(err)
 	}
 
-	// Collect facts
-	factsByFile := make(map[string]extractor.FileFacts)
-	for facts := range factsChan {
-		idx.Facts = append(idx.Facts, facts)
-		factsByFile[facts.File] = facts
-	}
 	if cache != nil {
 		if err := cache.Save(); err != nil {
 			recordPipelineErr(fmt.Errorf("cache save failed: %w", err))
 		}
 	}
+	if idx.Trees != nil {
+		// Kept trees outlive Run: drop those of files gone since the last one
+		idx.Trees.Retain(files)
+	}
 	extractDuration := time.Since(stepStart)
 	timing.RecordStage("extract", stepStart, extractDuration, "")
 
+	// A shard stops at its facts: linking and policy run on the merge node
+	if idx.Shard != nil {
+		return idx.finishShard(rootPath, files, factsByFile, errs, remoteWarnings(remote), timing, runStart, pipelineErrs)
+	}
+
 	// Cache impact visualization (verbose/progress/trace)
 	if cache != nil && progressEnabled && len(changedFiles) > 0 {
 		fmt.Printf("\n=== Cache Impact ===\n")
@@ -523,15 +774,23 @@ func (idx *Indexer) Run(rootPath string) error {
 	stepStart = time.Now()
 	factTables := facts.BuildTables(idx.Facts, idx.FileLibraries, idx.ThirdPartyFiles, idx.buildSymbolRows())
 	factFiles := sortedFactFiles(factTables)
-	factsValidator, err := validator.NewFactsValidator()
+	factsValidator, err := idx.tablesValidator()
 	if err != nil {
 		return fmt.Errorf("CRITICAL: Failed to initialize facts validator: %w", err)
 	}
-	if err := factsValidator.Validate(factTables); err != nil {
+	fastValidate := envBool("VHDL_FAST_VALIDATE")
+	factsValidateMode := ""
+	if fastValidate {
+		err = factsValidator.ValidateFast(factTables)
+		factsValidateMode = "typed"
+	} else {
+		err = factsValidator.Validate(factTables)
+	}
+	if err != nil {
 		return fmt.Errorf("CRITICAL: Fact table contract violation: %w", err)
 	}
 	factsValidateDuration = time.Since(stepStart)
-	timing.RecordStage("facts_validate", stepStart, factsValidateDuration, "")
+	timing.RecordStage("facts_validate", stepStart, factsValidateDuration, factsValidateMode)
 
 	// Verbose output for debugging
 	if idx.Verbose {
@@ -819,42 +1078,62 @@ func (idx *Indexer) Run(rootPath string) error {
 
 	// 4. Build policy engine input
 	stepStart = time.Now()
-	policyInput := idx.buildPolicyInput()
+	var cone *lintConePlan
+	if cache != nil && len(changedFiles) > 0 && envBool("VHDL_LINT_CONE") && !envBool("VHDL_POLICY_DAEMON") {
+		plan, err := idx.planLintCone(cacheDir, factFiles, factsByFile, factTables, changedFiles)
+		if err != nil {
+			recordPipelineErr(fmt.Errorf("cone lint disabled: %w", err))
+		}
+		cone = plan
+	}
+	var policyInput policy.Input
+	if cone != nil {
+		policyInput = idx.buildPolicyInputFor(cone.scope)
+		// The previous result only stands for this configuration
+		if hash, err := policyConfigHash(policyInput); err != nil || hash != cone.prev.ConfigHash {
+			cone = nil
+		}
+	}
+	if cone == nil {
+		policyInput = idx.buildPolicyInput()
+	}
 	buildDuration := time.Since(stepStart)
 	timing.RecordStage("build_input", stepStart, buildDuration, "")
 
 	// 5. Validate data structure before policy evaluation (CUE contract enforcement)
 	stepStart = time.Now()
-	v, err := validator.New()
+	v, err := idx.inputValidator()
 	if err != nil {
 		return fmt.Errorf("CRITICAL: Failed to initialize CUE validator: %w", err)
 	}
 	if err := validateVerificationTags(v, &policyInput); err != nil {
 		return fmt.Errorf("CRITICAL: Failed to validate verification tags: %w", err)
 	}
-	if err := v.Validate(policyInput); err != nil {
+	validateInput := policyInput
+	validateScope := ""
+	if fastValidate && cache != nil {
+		if changedInput, ok := changedValidationInput(cacheDir, policyInput, factFiles, changedFiles); ok {
+			validateInput = changedInput
+			validateScope = "changed"
+		}
+	}
+	if err := v.Validate(validateInput); err != nil {
 		return fmt.Errorf("CRITICAL: Data contract violation (Go -> policy engine mismatch): %w", err)
 	}
 	validateDuration := time.Since(stepStart)
-	timing.RecordStage("validate", stepStart, validateDuration, "")
+	timing.RecordStage("validate", stepStart, validateDuration, validateScope)
 
 	// 6. Run policy evaluation and build result
 	stepStart = time.Now()
+	// Counted over every file: a cone run's policy input has only its scope
+	stats := factStats(idx.Facts)
+	stats.Files = len(files)
+	stats.Symbols = idx.Symbols.Len()
 	lintResult := LintResult{
 		Violations:  []policy.Violation{},
 		ParseErrors: []ParseError{},
-		Stats: ExtractionStats{
-			Files:     len(files),
-			Symbols:   idx.Symbols.Len(),
-			Entities:  len(policyInput.Entities),
-			Packages:  len(policyInput.Packages),
-			Signals:   len(policyInput.Signals),
-			Ports:     len(policyInput.Ports),
-			Processes: len(policyInput.Processes),
-			Instances: len(policyInput.Instances),
-			Generates: len(policyInput.Generates),
-		},
-		Files: []FileResult{},
+		Stats:       stats,
+		Files:       []FileResult{},
 	}
 
 	// Add parse errors
@@ -870,13 +1149,34 @@ func (idx *Indexer) Run(rootPath string) error {
 	policyDelta := false
 
 	if envBool("VHDL_POLICY_DAEMON") {
-		if cache == nil {
+		if cache == nil && !idx.Resident {
 			recordPipelineErr(fmt.Errorf("policy daemon requested but cache disabled"))
 		}
-		if result, usedDelta, err := runPolicyDaemon(cacheDir, cache != nil, factTables, changedFiles); err != nil {
+		run := func() (*policy.Result, bool, error) {
+			return runPolicyDaemon(cacheDir, cache != nil, factTables, changedFiles)
+		}
+		if idx.Resident {
+			run = func() (*policy.Result, bool, error) {
+				return idx.runResidentPolicyDaemon(factTables, changedFiles)
+			}
+		}
+		if result, usedDelta, err := run(); err != nil {
 			recordPipelineErr(fmt.Errorf("policy daemon failed: %w", err))
 		} else {
-			applyPolicyResult(&lintResult, result)
+			timing.RecordRules("policy", time.Now(), result.Timings)
+			// The daemon owns a few rule families; the batch engine
+			// evaluates the rest, or daemon mode would drop them
+			policyEngine, err := policy.New(".")
+			if err != nil {
+				return fmt.Errorf("initialize policy engine: %w", err)
+			}
+			policyEngine.Timings = timing.Enabled()
+			rest, err := policyEngine.Evaluate(policy.WithoutDaemonRules(policyInput))
+			if err != nil {
+				return fmt.Errorf("policy evaluation failed: %w", err)
+			}
+			timing.RecordRules("policy", time.Now(), rest.Timings)
+			applyPolicyResult(&lintResult, policy.MergeDaemonResult(result, rest))
 			policyUsedDaemon = true
 			policyDelta = usedDelta
 		}
@@ -906,17 +1206,27 @@ func (idx *Indexer) Run(rootPath string) error {
 		if err != nil {
 			return fmt.Errorf("initialize policy engine: %w", err)
 		}
+		policyEngine.Timings = timing.Enabled()
 		result, err := policyEngine.Evaluate(policyInput)
 		if err != nil {
 			return fmt.Errorf("policy evaluation failed: %w", err)
 		}
+		timing.RecordRules("policy", time.Now(), result.Timings)
+		result.Timings = nil
+		if cone != nil {
+			result = cone.merge(result)
+		}
 		applyPolicyResult(&lintResult, result)
 		if cache != nil && cacheHash != "" {
 			if err := savePolicyCache(cacheDir, policyCacheEntry{
-				Version:    policyCacheVersion,
-				ConfigHash: cacheHash,
-				Files:      factFiles,
-				Result:     *result,
+				Version:     policyCacheVersion,
+				ConfigHash:  cacheHash,
+				Files:       factFiles,
+				Result:      *result,
+				SchemaHash:  validator.InputSchemaHash(),
+				Approximate: cone != nil,
+				// A cone run validated only its scope's input
+				ValidatedAll: cone == nil,
 			}); err != nil {
 				recordPipelineErr(fmt.Errorf("policy cache save failed: %w", err))
 			}
@@ -929,10 +1239,17 @@ func (idx *Indexer) Run(rootPath string) error {
 		}
 	}
 
+	lintResult.Warnings = remoteWarnings(remote)
+	idx.LastResult = &lintResult
+
 	// Output results
 	if idx.JSONOutput {
 		// JSON output mode
-		enc := json.NewEncoder(os.Stdout)
+		out := idx.Output
+		if out == nil {
+			out = os.Stdout
+		}
+		enc := json.NewEncoder(out)
 		enc.SetIndent("", "  ")
 		if err := enc.Encode(lintResult); err != nil {
 			return fmt.Errorf("failed to encode JSON output: %w", err)
@@ -971,6 +1288,9 @@ func (idx *Indexer) Run(rootPath string) error {
 				fmt.Printf("  %s\n", e.Message)
 			}
 		}
+		for _, w := range lintResult.Warnings {
+			fmt.Fprintf(os.Stderr, "warning: %s\n", w)
+		}
 	}
 	policyDuration := time.Since(stepStart)
 	policyStatus := ""
@@ -982,6 +1302,8 @@ func (idx *Indexer) Run(rootPath string) error {
 		}
 	} else if policyCached {
 		policyStatus = "cached"
+	} else if cone != nil {
+		policyStatus = "cone"
 	}
 	timing.RecordStage("policy", stepStart, policyDuration, policyStatus)
 
@@ -1004,12 +1326,19 @@ func (idx *Indexer) Run(rootPath string) error {
 			fmt.Printf("  policy:      %s (%s)\n", label, formatDuration(policyDuration))
 		} else if policyCached {
 			fmt.Printf("  policy:      cached (%s)\n", formatDuration(policyDuration))
+		} else if cone != nil {
+			fmt.Printf("  policy:      cone of %d files (%s)\n", len(cone.cone), formatDuration(policyDuration))
 		} else {
 			fmt.Printf("  policy:      %s\n", formatDuration(policyDuration))
 		}
 		fmt.Printf("  total:       %s\n", formatDuration(time.Since(runStart)))
+		printSlowest("Slowest Files", timing.Slowest("file", slowestShown))
+		printSlowest("Slowest Policy Rules", timing.Slowest("rule", slowestShown))
 	}
 	timing.RecordStage("total", runStart, time.Since(runStart), "")
+	if err := timing.Close(); err != nil {
+		recordPipelineErr(err)
+	}
 
 	if len(pipelineErrs) > 0 {
 		return fmt.Errorf("pipeline errors:\n%s", formatPipelineErrors(pipelineErrs))
@@ -1081,9 +1410,11 @@ func runPolicyDaemon(cacheDir string, cacheEnabled bool, tables facts.Tables, ch
 			if _, err := daemon.Init(prev); err != nil {
 				return nil, false, err
 			}
-			delta := facts.ComputeDelta(prev, tables)
+			var delta facts.Delta
 			if len(changedFiles) > 0 {
-				delta = facts.FilterDeltaByFiles(delta, changedFiles)
+				delta = facts.ComputeDeltaForFiles(prev, tables, changedFiles)
+			} else {
+				delta = facts.ComputeDelta(prev, tables)
 			}
 			result, err := daemon.Delta(delta)
 			return result, true, err
@@ -1108,13 +1439,41 @@ func sortedFactFiles(tables facts.Tables) []string {
 	return files
 }
 
+// factStats counts the design units and declarations of fileFacts as the
+// policy input built from all of them would hold them.
+func factStats(fileFacts []extractor.FileFacts) ExtractionStats {
+	var stats ExtractionStats
+	for i := range fileFacts {
+		f := &fileFacts[i]
+		stats.Entities += len(f.Entities)
+		stats.Packages += len(f.Packages)
+		for _, s := range f.Signals {
+			// buildPolicyInputFor skips untyped (malformed) signals
+			if s.Type != "" {
+				stats.Signals++
+			}
+		}
+		stats.Ports += len(f.Ports)
+		stats.Processes += len(f.Processes)
+		stats.Instances += len(f.Instances)
+		stats.Generates += len(f.Generates)
+	}
+	return stats
+}
+
 // buildPolicyInput converts extracted facts to the policy engine input format
 func (idx *Indexer) buildPolicyInput() policy.Input {
+	return idx.buildPolicyInputFor(idx.Facts)
+}
+
+// buildPolicyInputFor is buildPolicyInput over a subset of the files (symbols
+// are still the whole project's)
+func (idx *Indexer) buildPolicyInputFor(fileFacts []extractor.FileFacts) policy.Input {
 	// Initialize all slices to empty (not nil) to ensure JSON serialization
 	// produces [] instead of null - the CUE contract requires arrays
 	input := policy.Input{
 		Standard:              idx.Config.Standard,
-		FileCount:             len(idx.Facts),
+		FileCount:             len(fileFacts),
 		Entities:              []policy.Entity{},
 		Architectures:         []policy.Architecture{},
 		Packages:              []policy.Package{},
@@ -1168,8 +1527,8 @@ func (idx *Indexer) buildPolicyInput() policy.Input {
 	}
 
 	// Add file/library mappings
-	fileList := make([]string, 0, len(idx.Facts))
-	for _, facts := range idx.Facts {
+	fileList := make([]string, 0, len(fileFacts))
+	for _, facts := range fileFacts {
 		fileList = append(fileList, facts.File)
 	}
 	sort.Strings(fileList)
@@ -1186,7 +1545,7 @@ func (idx *Indexer) buildPolicyInput() policy.Input {
 	}
 
 	// Aggregate facts from all files
-	for _, facts := range idx.Facts {
+	for _, facts := range fileFacts {
 		for _, e := range facts.Entities {
 			// Find ports for this entity (initialize to empty, not nil)
 			ports := []policy.Port{}
@@ -1846,446 +2205,6 @@ func validateVerificationTags(v *validator.Validator, input *policy.Input) error
 	return nil
 }
 
-func (idx *Indexer) populateScopesDefsUses(input *policy.Input) {
-	scopeByID := make(map[string]policy.Scope)
-	fileScope := make(map[string]string)
-	entityScopes := make(map[string]map[string]string)
-	packageScopes := make(map[string]map[string]string)
-	archScopes := make(map[string]map[string]string)
-	archPathScopes := make(map[string]map[string]string)
-
-	normalize := func(name string) string {
-		return strings.ToLower(strings.TrimSpace(name))
-	}
-
-	ensureMap := func(m map[string]map[string]string, file string) map[string]string {
-		if m[file] == nil {
-			m[file] = make(map[string]string)
-		}
-		return m[file]
-	}
-
-	addScope := func(id, kind, file string, line int, parent string) string {
-		if id == "" {
-			return ""
-		}
-		if existing, ok := scopeByID[id]; ok {
-			if line > 0 && (existing.Line < 1 || (existing.Line == 1 && line != 1)) {
-				existing.Line = line
-				scopeByID[id] = existing
-			}
-			return id
-		}
-		if line < 1 {
-			line = 1
-		}
-		path := []string{id}
-		if parent != "" {
-			if parentScope, ok := scopeByID[parent]; ok && len(parentScope.Path) > 0 {
-				path = append(append([]string{}, parentScope.Path...), id)
-			} else {
-				path = []string{parent, id}
-			}
-		}
-		scopeByID[id] = policy.Scope{
-			Name:   id,
-			Kind:   kind,
-			File:   file,
-			Line:   line,
-			Parent: parent,
-			Path:   path,
-		}
-		return id
-	}
-
-	ensureFileScope := func(file string) string {
-		if file == "" {
-			return ""
-		}
-		if id, ok := fileScope[file]; ok {
-			return id
-		}
-		id := "file:" + file
-		addScope(id, "file", file, 1, "")
-		fileScope[file] = id
-		return id
-	}
-
-	ensureEntityScope := func(file, name string, line int) string {
-		if name == "" {
-			return ensureFileScope(file)
-		}
-		m := ensureMap(entityScopes, file)
-		key := normalize(name)
-		if id, ok := m[key]; ok {
-			return id
-		}
-		parent := ensureFileScope(file)
-		id := parent + "::entity:" + key
-		addScope(id, "entity", file, line, parent)
-		m[key] = id
-		return id
-	}
-
-	ensurePackageScope := func(file, name string, line int) string {
-		if name == "" {
-			return ensureFileScope(file)
-		}
-		m := ensureMap(packageScopes, file)
-		key := normalize(name)
-		if id, ok := m[key]; ok {
-			return id
-		}
-		parent := ensureFileScope(file)
-		id := parent + "::package:" + key
-		addScope(id, "package", file, line, parent)
-		m[key] = id
-		return id
-	}
-
-	ensureArchScope := func(file, name string, line int) string {
-		if name == "" {
-			return ensureFileScope(file)
-		}
-		m := ensureMap(archScopes, file)
-		key := normalize(name)
-		if id, ok := m[key]; ok {
-			return id
-		}
-		parent := ensureFileScope(file)
-		id := parent + "::arch:" + key
-		addScope(id, "architecture", file, line, parent)
-		m[key] = id
-		ensureMap(archPathScopes, file)[key] = id
-		return id
-	}
-
-	splitScopePath := func(path string) []string {
-		raw := strings.Split(path, ".")
-		parts := make([]string, 0, len(raw))
-		for _, part := range raw {
-			part = strings.TrimSpace(part)
-			if part == "" {
-				continue
-			}
-			parts = append(parts, part)
-		}
-		return parts
-	}
-
-	ensureArchPathScope := func(file, archPath string) string {
-		parts := splitScopePath(archPath)
-		if len(parts) == 0 {
-			return ensureFileScope(file)
-		}
-		archName := parts[0]
-		parent := ensureArchScope(file, archName, 1)
-		currentKey := normalize(archName)
-		ensureMap(archPathScopes, file)[currentKey] = parent
-		for _, seg := range parts[1:] {
-			if seg == "" {
-				continue
-			}
-			segKey := normalize(seg)
-			currentKey = currentKey + "." + segKey
-			if id, ok := ensureMap(archPathScopes, file)[currentKey]; ok {
-				parent = id
-				continue
-			}
-			id := parent + "::generate:" + segKey
-			addScope(id, "generate", file, 1, parent)
-			ensureMap(archPathScopes, file)[currentKey] = id
-			parent = id
-		}
-		return parent
-	}
-
-	ensureGenerateScope := func(file string, gen policy.GenerateStatement) string {
-		parent := ensureArchPathScope(file, gen.InArch)
-		label := strings.TrimSpace(gen.Label)
-		if label == "" {
-			label = fmt.Sprintf("gen@%d", gen.Line)
-		}
-		pathKey := normalize(strings.Trim(strings.Join([]string{gen.InArch, label}, "."), "."))
-		if pathKey == "" {
-			return parent
-		}
-		if id, ok := ensureMap(archPathScopes, file)[pathKey]; ok {
-			if scope, ok := scopeByID[id]; ok && gen.Line > 0 && (scope.Line < 1 || (scope.Line == 1 && gen.Line != 1)) {
-				scope.Line = gen.Line
-				scopeByID[id] = scope
-			}
-			return id
-		}
-		id := parent + "::generate:" + normalize(label)
-		addScope(id, "generate", file, gen.Line, parent)
-		ensureMap(archPathScopes, file)[pathKey] = id
-		return id
-	}
-
-	scopeForContext := func(file, context string) string {
-		ctx := normalize(context)
-		if ctx == "" {
-			return ensureFileScope(file)
-		}
-		if scopes := packageScopes[file]; scopes != nil {
-			if id, ok := scopes[ctx]; ok {
-				return id
-			}
-		}
-		if scopes := entityScopes[file]; scopes != nil {
-			if id, ok := scopes[ctx]; ok {
-				return id
-			}
-		}
-		if scopes := archPathScopes[file]; scopes != nil {
-			if id, ok := scopes[ctx]; ok {
-				return id
-			}
-		}
-		if scopes := archScopes[file]; scopes != nil {
-			if id, ok := scopes[ctx]; ok {
-				return id
-			}
-		}
-		return ensureFileScope(file)
-	}
-
-	// Seed file scopes
-	for _, fileInfo := range input.Files {
-		ensureFileScope(fileInfo.Path)
-	}
-
-	// Build scopes for entities, packages, architectures, and generates
-	for _, ent := range input.Entities {
-		ensureEntityScope(ent.File, ent.Name, ent.Line)
-	}
-	for _, pkg := range input.Packages {
-		ensurePackageScope(pkg.File, pkg.Name, pkg.Line)
-	}
-	for _, arch := range input.Architectures {
-		ensureArchScope(arch.File, arch.Name, arch.Line)
-	}
-	for _, gen := range input.Generates {
-		ensureGenerateScope(gen.File, gen)
-	}
-
-	// Export scopes in deterministic order
-	scopeIDs := make([]string, 0, len(scopeByID))
-	for id := range scopeByID {
-		scopeIDs = append(scopeIDs, id)
-	}
-	sort.Strings(scopeIDs)
-	for _, id := range scopeIDs {
-		input.Scopes = append(input.Scopes, scopeByID[id])
-	}
-
-	// Symbol definitions
-	for _, ent := range input.Entities {
-		fileScopeID := ensureFileScope(ent.File)
-		input.SymbolDefs = append(input.SymbolDefs, policy.SymbolDef{
-			Name:  ent.Name,
-			Kind:  "entity",
-			File:  ent.File,
-			Line:  ent.Line,
-			Scope: fileScopeID,
-		})
-		entityScopeID := ensureEntityScope(ent.File, ent.Name, ent.Line)
-		for _, port := range ent.Ports {
-			input.SymbolDefs = append(input.SymbolDefs, policy.SymbolDef{
-				Name:  port.Name,
-				Kind:  "port",
-				File:  ent.File,
-				Line:  port.Line,
-				Scope: entityScopeID,
-			})
-		}
-		for _, gen := range ent.Generics {
-			input.SymbolDefs = append(input.SymbolDefs, policy.SymbolDef{
-				Name:  gen.Name,
-				Kind:  "generic",
-				File:  ent.File,
-				Line:  gen.Line,
-				Scope: entityScopeID,
-			})
-		}
-	}
-
-	for _, arch := range input.Architectures {
-		fileScopeID := ensureFileScope(arch.File)
-		input.SymbolDefs = append(input.SymbolDefs, policy.SymbolDef{
-			Name:  arch.Name,
-			Kind:  "architecture",
-			File:  arch.File,
-			Line:  arch.Line,
-			Scope: fileScopeID,
-		})
-	}
-
-	for _, pkg := range input.Packages {
-		pkgScopeID := ensurePackageScope(pkg.File, pkg.Name, pkg.Line)
-		input.SymbolDefs = append(input.SymbolDefs, policy.SymbolDef{
-			Name:  pkg.Name,
-			Kind:  "package",
-			File:  pkg.File,
-			Line:  pkg.Line,
-			Scope: pkgScopeID,
-		})
-	}
-
-	for _, sig := range input.Signals {
-		scopeID := scopeForContext(sig.File, sig.InEntity)
-		input.SymbolDefs = append(input.SymbolDefs, policy.SymbolDef{
-			Name:  sig.Name,
-			Kind:  "signal",
-			File:  sig.File,
-			Line:  sig.Line,
-			Scope: scopeID,
-		})
-	}
-
-	for _, typ := range input.Types {
-		scopeName := typ.InPackage
-		if scopeName == "" {
-			scopeName = typ.InArch
-		}
-		scopeID := scopeForContext(typ.File, scopeName)
-		input.SymbolDefs = append(input.SymbolDefs, policy.SymbolDef{
-			Name:  typ.Name,
-			Kind:  "type",
-			File:  typ.File,
-			Line:  typ.Line,
-			Scope: scopeID,
-		})
-	}
-
-	for _, st := range input.Subtypes {
-		scopeName := st.InPackage
-		if scopeName == "" {
-			scopeName = st.InArch
-		}
-		scopeID := scopeForContext(st.File, scopeName)
-		input.SymbolDefs = append(input.SymbolDefs, policy.SymbolDef{
-			Name:  st.Name,
-			Kind:  "subtype",
-			File:  st.File,
-			Line:  st.Line,
-			Scope: scopeID,
-		})
-	}
-
-	for _, fn := range input.Functions {
-		scopeName := fn.InPackage
-		if scopeName == "" {
-			scopeName = fn.InArch
-		}
-		scopeID := scopeForContext(fn.File, scopeName)
-		input.SymbolDefs = append(input.SymbolDefs, policy.SymbolDef{
-			Name:  fn.Name,
-			Kind:  "function",
-			File:  fn.File,
-			Line:  fn.Line,
-			Scope: scopeID,
-		})
-	}
-
-	for _, pr := range input.Procedures {
-		scopeName := pr.InPackage
-		if scopeName == "" {
-			scopeName = pr.InArch
-		}
-		scopeID := scopeForContext(pr.File, scopeName)
-		input.SymbolDefs = append(input.SymbolDefs, policy.SymbolDef{
-			Name:  pr.Name,
-			Kind:  "procedure",
-			File:  pr.File,
-			Line:  pr.Line,
-			Scope: scopeID,
-		})
-	}
-
-	for _, c := range input.ConstantDecls {
-		scopeName := c.InPackage
-		if scopeName == "" {
-			scopeName = c.InArch
-		}
-		scopeID := scopeForContext(c.File, scopeName)
-		input.SymbolDefs = append(input.SymbolDefs, policy.SymbolDef{
-			Name:  c.Name,
-			Kind:  "constant",
-			File:  c.File,
-			Line:  c.Line,
-			Scope: scopeID,
-		})
-	}
-
-	// Name uses from processes
-	for _, proc := range input.Processes {
-		scopeID := scopeForContext(proc.File, proc.InArch)
-		context := proc.Label
-		if context == "" {
-			context = fmt.Sprintf("process@%d", proc.Line)
-		}
-		for _, call := range proc.FunctionCalls {
-			name := strings.TrimSpace(call.Name)
-			if name == "" {
-				continue
-			}
-			input.NameUses = append(input.NameUses, policy.NameUse{
-				Name:    name,
-				Kind:    "function_call",
-				File:    proc.File,
-				Line:    call.Line,
-				Scope:   scopeID,
-				Context: context,
-			})
-		}
-		for _, call := range proc.ProcedureCalls {
-			name := strings.TrimSpace(call.FullName)
-			if name == "" {
-				name = strings.TrimSpace(call.Name)
-			}
-			if name == "" {
-				continue
-			}
-			input.NameUses = append(input.NameUses, policy.NameUse{
-				Name:    name,
-				Kind:    "procedure_call",
-				File:    proc.File,
-				Line:    call.Line,
-				Scope:   scopeID,
-				Context: context,
-			})
-		}
-	}
-
-	// Name uses from signal dependencies
-	for _, dep := range input.SignalDeps {
-		scopeID := scopeForContext(dep.File, dep.InArch)
-		context := dep.InProcess
-		if dep.Source != "" {
-			input.NameUses = append(input.NameUses, policy.NameUse{
-				Name:    dep.Source,
-				Kind:    "signal_read",
-				File:    dep.File,
-				Line:    dep.Line,
-				Scope:   scopeID,
-				Context: context,
-			})
-		}
-		if dep.Target != "" {
-			input.NameUses = append(input.NameUses, policy.NameUse{
-				Name:    dep.Target,
-				Kind:    "signal_write",
-				File:    dep.File,
-				Line:    dep.Line,
-				Scope:   scopeID,
-				Context: context,
-			})
-		}
-	}
-}
-
 func (idx *Indexer) buildSymbolRows() []facts.SymbolRow {
 	if idx.Symbols == nil {
 		return nil
@@ -2309,77 +2228,6 @@ func (idx *Indexer) buildSymbolRows() []facts.SymbolRow {
 	return rows
 }
 
-func (idx *Indexer) findVHDLFiles(root string) ([]string, error) {
-	var files []string
-
-	err := filepath.Walk(root, func(path string, info os.FileInfo, err error) error {
-		if err != nil {
-			return err
-		}
-		if info.IsDir() {
-			return nil
-		}
-		ext := strings.ToLower(filepath.Ext(path))
-		if ext == ".vhd" || ext == ".vhdl" {
-			files = append(files, path)
-		}
-		return nil
-	})
-
-	return files, err
-}
-
-// SymbolTable methods
-
-func (st *SymbolTable) Add(sym Symbol) {
-	st.mu.Lock()
-	defer st.mu.Unlock()
-	st.symbols[sym.Name] = sym
-}
-
-func (st *SymbolTable) Has(name string) bool {
-	st.mu.RLock()
-	defer st.mu.RUnlock()
-	_, ok := st.symbols[name]
-	return ok
-}
-
-func (st *SymbolTable) HasSuffix(base string) bool {
-	st.mu.RLock()
-	defer st.mu.RUnlock()
-	suffix := "." + base
-	for name := range st.symbols {
-		if strings.HasSuffix(name, suffix) {
-			return true
-		}
-	}
-	return false
-}
-
-func (st *SymbolTable) Get(name string) (Symbol, bool) {
-	st.mu.RLock()
-	defer st.mu.RUnlock()
-	sym, ok := st.symbols[name]
-	return sym, ok
-}
-
-func (st *SymbolTable) All() map[string]Symbol {
-	st.mu.RLock()
-	defer st.mu.RUnlock()
-	// Return a copy
-	result := make(map[string]Symbol)
-	for k, v := range st.symbols {
-		result[k] = v
-	}
-	return result
-}
-
-func (st *SymbolTable) Len() int {
-	st.mu.RLock()
-	defer st.mu.RUnlock()
-	return len(st.symbols)
-}
-
 // isStandardLibrary checks if a library is a standard/vendor library
 func isStandardLibrary(name string) bool {
 	standard := []string{
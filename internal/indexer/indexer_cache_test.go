@@ -2,12 +2,16 @@ package indexer
 
 import (
 	"encoding/json"
+	"fmt"
 	"io"
 	"os"
 	"path/filepath"
+	"reflect"
 	"sort"
+	"sync"
 	"sync/atomic"
 	"testing"
+	"time"
 
 	"github.com/robert-at-pretension-io/vhdl-lint/internal/config"
 	"github.com/robert-at-pretension-io/vhdl-lint/internal/extractor"
@@ -23,6 +27,11 @@ func (c *countingExtractor) Extract(path string) (extractor.FileFacts, error) {
 	return c.inner.Extract(path)
 }
 
+func (c *countingExtractor) ExtractTier(path string, tier extractor.Tier) (extractor.FileFacts, error) {
+	atomic.AddInt32(c.count, 1)
+	return extractAt(c.inner, path, tier)
+}
+
 func writeVHDL(t *testing.T, dir, name, content string) string {
 	t.Helper()
 	path := filepath.Join(dir, name)
@@ -171,6 +180,119 @@ func TestCacheInvalidationOnVersionChange(t *testing.T) {
 	}
 }
 
+func TestExtractorVersionCoversPackageSources(t *testing.T) {
+	dir := t.TempDir()
+	write := func(name, content string) {
+		t.Helper()
+		if err := os.WriteFile(filepath.Join(dir, name), []byte(content), 0o644); err != nil {
+			t.Fatalf("write %s: %v", name, err)
+		}
+	}
+	write("extractor.go", "package extractor")
+	write("stream.go", "package extractor // v1")
+	write("stream_test.go", "package extractor // t1")
+	v1 := hashGoPackage(dir)
+	if v1 == "" {
+		t.Fatal("expected a package hash")
+	}
+
+	write("stream_test.go", "package extractor // t2")
+	if got := hashGoPackage(dir); got != v1 {
+		t.Fatal("test files changed the extractor version")
+	}
+	write("stream.go", "package extractor // v2")
+	if got := hashGoPackage(dir); got == v1 {
+		t.Fatal("a change outside extractor.go kept the extractor version")
+	}
+	if got := hashGoPackage(filepath.Join(dir, "missing")); got != "" {
+		t.Fatalf("missing package hashed to %q", got)
+	}
+}
+
+func TestThirdPartyFilesExtractDeclarations(t *testing.T) {
+	dir := t.TempDir()
+	own := writeVHDL(t, dir, "top.vhd", "entity top is end entity; architecture rtl of top is signal d : bit; begin u_ip : entity ip.core port map (d => d); end architecture;")
+	vendor := writeVHDL(t, dir, "core.vhd", "entity core is port (clk : in bit; d : in bit; q : out bit); end entity; architecture rtl of core is begin p : process(clk) begin if clk'event and clk = '1' then q <= d; end if; end process; end architecture;")
+	cacheDir := filepath.Join(dir, ".cache")
+	cfg := defaultTestConfig([]string{own}, cacheDir, true)
+	cfg.Libraries["ip"] = config.LibraryConfig{Files: []string{vendor}, IsThirdParty: true}
+
+	factsOf := func(idx *Indexer, path string) extractor.FileFacts {
+		t.Helper()
+		for _, facts := range idx.Facts {
+			if facts.File == path {
+				return facts
+			}
+		}
+		t.Fatalf("no facts for %s", path)
+		return extractor.FileFacts{}
+	}
+
+	var count int32
+	idx := NewWithConfig(cfg)
+	idx.extractorFactory = func() FactsExtractor {
+		return &countingExtractor{inner: extractor.New(), count: &count}
+	}
+	runIndexerForTest(t, idx, dir)
+	core := factsOf(idx, vendor)
+	if core.Tier != extractor.TierDeclarations || len(core.Processes) != 0 {
+		t.Fatalf("expected declaration-only facts for the third-party file, got tier %s with %d processes", core.Tier, len(core.Processes))
+	}
+	if len(core.Entities) != 1 || len(core.Ports) != 3 {
+		t.Fatalf("expected the third-party entity and its ports, got %d entities, %d ports", len(core.Entities), len(core.Ports))
+	}
+	if top := factsOf(idx, own); top.Tier != extractor.TierFull {
+		t.Fatalf("expected full facts for the project file, got tier %s", top.Tier)
+	}
+
+	// Asking for full third-party facts misses the declaration-only entry
+	cfg.Analysis.ThirdPartyFacts = "full"
+	var count2 int32
+	idx2 := NewWithConfig(cfg)
+	idx2.extractorFactory = func() FactsExtractor {
+		return &countingExtractor{inner: extractor.New(), count: &count2}
+	}
+	runIndexerForTest(t, idx2, dir)
+	if got := atomic.LoadInt32(&count2); got != 1 {
+		t.Fatalf("expected only the third-party file re-extracted, got %d extracts", got)
+	}
+	if core := factsOf(idx2, vendor); core.Tier != extractor.TierFull || len(core.Processes) != 1 {
+		t.Fatalf("expected full facts for the third-party file, got tier %s with %d processes", core.Tier, len(core.Processes))
+	}
+}
+
+func TestDirSnapshotScanSeesNewFiles(t *testing.T) {
+	dir := t.TempDir()
+	rtl := filepath.Join(dir, "rtl")
+	if err := os.MkdirAll(rtl, 0o755); err != nil {
+		t.Fatalf("mkdir: %v", err)
+	}
+	writeVHDL(t, rtl, "a.vhd", "entity a is end entity;")
+	old := time.Now().Add(-time.Hour)
+	if err := os.Chtimes(rtl, old, old); err != nil {
+		t.Fatalf("chtimes: %v", err)
+	}
+	cacheDir := filepath.Join(dir, ".cache")
+	cfg := defaultTestConfig([]string{"**/*.vhd"}, cacheDir, true)
+
+	idx := NewWithConfig(cfg)
+	runIndexerForTest(t, idx, dir)
+	if len(idx.Facts) != 1 {
+		t.Fatalf("expected 1 file, got %d", len(idx.Facts))
+	}
+	if _, err := os.Stat(filepath.Join(cacheDir, "dir_snapshot.json")); err != nil {
+		t.Fatalf("expected directory snapshot: %v", err)
+	}
+
+	// Adding a file changes the directory's mtime, so rtl is listed again
+	writeVHDL(t, rtl, "b.vhd", "entity b is end entity;")
+	idx2 := NewWithConfig(cfg)
+	runIndexerForTest(t, idx2, dir)
+	if len(idx2.Facts) != 2 {
+		t.Fatalf("expected 2 files after adding one, got %d", len(idx2.Facts))
+	}
+}
+
 func TestCachedRunMatchesFresh(t *testing.T) {
 	dir := t.TempDir()
 	file1 := writeVHDL(t, dir, "pkg.vhd", "package my_pkg is constant C : integer := 1; end package;")
@@ -197,3 +319,186 @@ func TestCachedRunMatchesFresh(t *testing.T) {
 		}
 	}
 }
+
+func TestFactsStoreRoundTripAndTornTail(t *testing.T) {
+	dir := t.TempDir()
+	file := writeVHDL(t, dir, "a.vhd", `entity a is
+  port(clk : in bit; d : in bit; q : out bit);
+end entity;
+architecture rtl of a is
+  signal r : bit;
+begin
+  process(clk) begin
+    if clk'event and clk = '1' then r <= d; end if;
+  end process;
+  q <= r;
+end architecture;`)
+	facts, err := extractor.New().Extract(file)
+	if err != nil {
+		t.Fatalf("extract: %v", err)
+	}
+	cacheDir := filepath.Join(dir, ".cache")
+
+	cache := newFactsCache(cacheDir, "p", "e")
+	if err := cache.Load(); err != nil {
+		t.Fatalf("load: %v", err)
+	}
+	if err := cache.Put(file, "h1", fileStamp{}, facts); err != nil {
+		t.Fatalf("put: %v", err)
+	}
+	if err := cache.Save(); err != nil {
+		t.Fatalf("save: %v", err)
+	}
+
+	// Simulate an append interrupted mid-record
+	store, err := os.OpenFile(filepath.Join(cacheDir, "facts.bin"), os.O_WRONLY|os.O_APPEND, 0)
+	if err != nil {
+		t.Fatalf("open store: %v", err)
+	}
+	if _, err := store.Write([]byte{0xff, 0, 0, 0, 1, 2, 3}); err != nil {
+		t.Fatalf("write store: %v", err)
+	}
+	_ = store.Close()
+
+	cache = newFactsCache(cacheDir, "p", "e")
+	if err := cache.Load(); err != nil {
+		t.Fatalf("reload: %v", err)
+	}
+	got, ok, err := cache.Get(file, "h1", fileStamp{})
+	if err != nil || !ok {
+		t.Fatalf("expected cache hit, ok=%v err=%v", ok, err)
+	}
+	if !reflect.DeepEqual(got, facts) {
+		t.Fatalf("cached facts differ from extracted facts\ngot:  %#v\nwant: %#v", got, facts)
+	}
+	if _, ok, _ := cache.Get(file, "h2", fileStamp{}); ok {
+		t.Fatalf("expected miss for a different content hash")
+	}
+	if err := cache.Save(); err != nil {
+		t.Fatalf("save after torn tail: %v", err)
+	}
+
+	other := newFactsCache(cacheDir, "p", "other-extractor")
+	if err := other.Load(); err != nil {
+		t.Fatalf("load other version: %v", err)
+	}
+	if _, ok, _ := other.Get(file, "h1", fileStamp{}); ok {
+		t.Fatalf("expected miss for a different extractor version")
+	}
+}
+
+// A Put that compacts a torn store renumbers every offset; Gets running
+// alongside it must not read an old offset from the new file.
+func TestFactsStoreGetDuringCompaction(t *testing.T) {
+	cacheDir := filepath.Join(t.TempDir(), ".cache")
+	old := fileStamp{size: 1, mtime: time.Now().Add(-time.Hour).UnixNano(), inode: 1}
+	names := make([]string, 64)
+	for i := range names {
+		names[i] = fmt.Sprintf("f%02d.vhd", i)
+	}
+
+	for round := 0; round < 5; round++ {
+		cache := newFactsCache(cacheDir, "p", "e")
+		if err := cache.Load(); err != nil {
+			t.Fatalf("load: %v", err)
+		}
+		for _, name := range names {
+			if err := cache.Put(name, "h", old, extractor.FileFacts{File: name}); err != nil {
+				t.Fatalf("put: %v", err)
+			}
+		}
+		if err := cache.Save(); err != nil {
+			t.Fatalf("save: %v", err)
+		}
+		store, err := os.OpenFile(filepath.Join(cacheDir, "facts.bin"), os.O_WRONLY|os.O_APPEND, 0)
+		if err != nil {
+			t.Fatalf("open store: %v", err)
+		}
+		if _, err := store.Write([]byte{0xff, 0, 0, 0, 1}); err != nil {
+			t.Fatalf("write store: %v", err)
+		}
+		_ = store.Close()
+
+		cache = newFactsCache(cacheDir, "p", "e")
+		if err := cache.Load(); err != nil {
+			t.Fatalf("reload: %v", err)
+		}
+		var wg sync.WaitGroup
+		var done atomic.Bool
+		errs := make(chan error, len(names)+1)
+		for _, name := range names {
+			wg.Add(1)
+			go func(name string) {
+				defer wg.Done()
+				for !done.Load() {
+					got, ok, err := cache.GetByStamp(name, old)
+					if err == nil && (!ok || got.File != name) {
+						err = fmt.Errorf("%s: ok=%v file=%q", name, ok, got.File)
+					}
+					if err != nil {
+						errs <- err
+						return
+					}
+				}
+			}(name)
+		}
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			defer done.Store(true)
+			time.Sleep(time.Millisecond)
+			if err := cache.Put("new.vhd", "h", old, extractor.FileFacts{File: "new.vhd"}); err != nil {
+				errs <- err
+			}
+		}()
+		wg.Wait()
+		close(errs)
+		for err := range errs {
+			t.Fatalf("round %d: %v", round, err)
+		}
+		if err := cache.Save(); err != nil {
+			t.Fatalf("save: %v", err)
+		}
+	}
+}
+
+func TestFactsCacheStatFastPath(t *testing.T) {
+	dir := t.TempDir()
+	cache := newFactsCache(filepath.Join(dir, ".cache"), "p", "e")
+	if err := cache.Load(); err != nil {
+		t.Fatalf("load: %v", err)
+	}
+	old := fileStamp{size: 42, mtime: time.Now().Add(-time.Hour).UnixNano(), inode: 7}
+	facts := extractor.FileFacts{File: "a.vhd"}
+	if err := cache.Put("a.vhd", "h1", old, facts); err != nil {
+		t.Fatalf("put: %v", err)
+	}
+	if _, ok, err := cache.GetByStamp("a.vhd", old); err != nil || !ok {
+		t.Fatalf("expected stamp hit, ok=%v err=%v", ok, err)
+	}
+	moved := old
+	moved.inode = 8
+	if _, ok, _ := cache.GetByStamp("a.vhd", moved); ok {
+		t.Fatalf("expected miss for a different inode")
+	}
+
+	// Same content under a new stamp: hash hit, then the new stamp is trusted
+	if _, ok, err := cache.Get("a.vhd", "h1", moved); err != nil || !ok {
+		t.Fatalf("expected hash hit, ok=%v err=%v", ok, err)
+	}
+	if _, ok, _ := cache.GetByStamp("a.vhd", moved); !ok {
+		t.Fatalf("expected stamp hit after restamp")
+	}
+
+	// A file modified just now is never trusted by stamp
+	racy := fileStamp{size: 42, mtime: time.Now().UnixNano(), inode: 9}
+	if err := cache.Put("b.vhd", "h2", racy, facts); err != nil {
+		t.Fatalf("put: %v", err)
+	}
+	if _, ok, _ := cache.GetByStamp("b.vhd", racy); ok {
+		t.Fatalf("expected racy stamp to be dropped")
+	}
+	if err := cache.Save(); err != nil {
+		t.Fatalf("save: %v", err)
+	}
+}
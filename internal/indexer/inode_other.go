@@ -0,0 +1,10 @@
+//go:build !unix
+
+package indexer
+
+import "os"
+
+// fileInode is unavailable here; size and mtime alone stamp the file.
+func fileInode(info os.FileInfo) uint64 {
+	return 0
+}
@@ -0,0 +1,17 @@
+//go:build unix
+
+package indexer
+
+import (
+	"os"
+	"syscall"
+)
+
+// fileInode returns the inode number behind info, so a file replaced by a
+// different one with the same size and mtime (e.g. a checkout) still misses.
+func fileInode(info os.FileInfo) uint64 {
+	if st, ok := info.Sys().(*syscall.Stat_t); ok {
+		return uint64(st.Ino)
+	}
+	return 0
+}
@@ -0,0 +1,22 @@
+//go:build !unix
+
+package indexer
+
+import (
+	"io"
+	"os"
+)
+
+// mapFile reads the first size bytes of f; platforms without mmap get a
+// private copy instead of a mapping.
+func mapFile(f *os.File, size int) ([]byte, error) {
+	data := make([]byte, size)
+	if _, err := io.ReadFull(f, data); err != nil {
+		return nil, err
+	}
+	return data, nil
+}
+
+func unmapFile(data []byte) error {
+	return nil
+}
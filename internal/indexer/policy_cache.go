@@ -13,13 +13,21 @@ import (
 	"github.com/robert-at-pretension-io/vhdl-lint/internal/policy"
 )
 
-const policyCacheVersion = 2
+const policyCacheVersion = 3
 
 type policyCacheEntry struct {
 	Version    int           `json:"version"`
 	ConfigHash string        `json:"config_hash"`
 	Files      []string      `json:"files"`
 	Result     policy.Result `json:"result"`
+	// SchemaHash is the schema.cue the run's input was validated against
+	SchemaHash string `json:"schema_hash,omitempty"`
+	// Approximate marks a cone run's merged result (see cone.go): it is
+	// never reused as the result of a run without changes
+	Approximate bool `json:"approximate,omitempty"`
+	// ValidatedAll: every row of the input behind Result was validated,
+	// by this run or (changed rows only) on top of such an entry
+	ValidatedAll bool `json:"validated_all,omitempty"`
 }
 
 func loadPolicyCache(dir string) (*policyCacheEntry, error) {
@@ -54,7 +62,7 @@ func policyCacheValid(entry *policyCacheEntry, input policy.Input, files []strin
 	if entry == nil {
 		return false, nil
 	}
-	if entry.Version != policyCacheVersion {
+	if entry.Version != policyCacheVersion || entry.Approximate {
 		return false, nil
 	}
 	hash, err := policyConfigHash(input)
@@ -0,0 +1,285 @@
+package indexer
+
+import (
+	"bytes"
+	"crypto/sha256"
+	"encoding/hex"
+	"errors"
+	"fmt"
+	"io"
+	"net/http"
+	"os"
+	"path/filepath"
+	"strings"
+	"sync"
+	"sync/atomic"
+	"time"
+
+	"github.com/robert-at-pretension-io/vhdl-lint/internal/extractor"
+)
+
+// =============================================================================
+// REMOTE FACTS CACHE
+// =============================================================================
+//
+// Analysis.Cache.Remote shares extracted facts between machines: a local
+// cache miss is looked up remotely before extracting, and every extraction
+// is uploaded. Entries are keyed by the file's content hash and the parser
+// and extractor versions, never by path, so a file moved or checked out
+// elsewhere still hits; the facts are stored with paths cleared and
+// relocated on the way in.
+//
+// Remote is a directory (a shared mount; entries at <dir>/<key[:2]>/<key>)
+// or an http(s) URL (GET/PUT <url>/<key>, 404 is a miss).
+//
+// A key must stand for exactly one set of facts, so the remote cache is
+// refused with the fast content hash (not collision resistant) and when the
+// parser or extractor version is unknown.
+//
+// The remote fails open: the first failed request turns it off for the rest
+// of the run (lookups miss, uploads are dropped) and Close reports the
+// failure as a warning, so an unreachable team cache costs at most one
+// timeout per worker and never fails a lint. Uploads are queued and sent
+// by a background goroutine, off the extraction path.
+// =============================================================================
+
+const remoteCacheTimeout = 10 * time.Second
+
+// remoteStore is a content-addressed blob store.
+type remoteStore interface {
+	// Get returns the blob for key, or ok=false when there is none.
+	Get(key string) (data []byte, ok bool, err error)
+	Put(key string, data []byte) error
+}
+
+// newRemoteStore opens the store named by spec (Analysis.Cache.Remote)
+// relative to baseDir.
+func newRemoteStore(spec, baseDir string) (remoteStore, error) {
+	if strings.HasPrefix(spec, "http://") || strings.HasPrefix(spec, "https://") {
+		return &httpStore{base: strings.TrimRight(spec, "/"), client: &http.Client{Timeout: remoteCacheTimeout}}, nil
+	}
+	dir := spec
+	if !filepath.IsAbs(dir) {
+		dir = filepath.Join(baseDir, dir)
+	}
+	if info, err := os.Stat(dir); err != nil {
+		return nil, fmt.Errorf("remote cache: %w", err)
+	} else if !info.IsDir() {
+		return nil, fmt.Errorf("remote cache: %s is not a directory", dir)
+	}
+	return dirStore{dir: dir}, nil
+}
+
+// remoteFactsKey is the store key for a file's facts at tier. Full-tier
+// keys carry no tier, so they match those written before tiers existed.
+func remoteFactsKey(contentHash string, versions cacheVersions, tier extractor.Tier) string {
+	h := sha256.New()
+	h.Write([]byte("vhdl-lint-facts\x00"))
+	h.Write([]byte(contentHash))
+	h.Write([]byte{0})
+	h.Write([]byte(versions.parser))
+	h.Write([]byte{0})
+	h.Write([]byte(versions.extractor))
+	if tier != extractor.TierFull {
+		h.Write([]byte{0})
+		h.Write([]byte(tier.String()))
+	}
+	return hex.EncodeToString(h.Sum(nil))
+}
+
+// remoteFactsCache wraps a store with the facts encoding.
+type remoteFactsCache struct {
+	store    remoteStore
+	versions cacheVersions
+
+	down atomic.Bool // set by the first failure
+
+	mu        sync.Mutex
+	failure   error
+	pending   []remotePut
+	uploading bool
+	uploads   sync.WaitGroup
+}
+
+type remotePut struct {
+	key  string
+	data []byte
+}
+
+func newRemoteFactsCache(spec, baseDir, hashAlgo string, versions cacheVersions) (*remoteFactsCache, error) {
+	if hashAlgo == cacheHashFast {
+		return nil, errors.New("remote cache needs the sha256 content hash")
+	}
+	if !versions.known() {
+		return nil, errors.New("remote cache needs known parser and extractor versions")
+	}
+	store, err := newRemoteStore(spec, baseDir)
+	if err != nil {
+		return nil, err
+	}
+	return &remoteFactsCache{store: store, versions: versions}, nil
+}
+
+// Get returns the facts stored for contentHash at tier, relocated to path.
+// Once the remote is down every lookup misses.
+func (r *remoteFactsCache) Get(path, contentHash string, tier extractor.Tier) (extractor.FileFacts, bool) {
+	if r.down.Load() {
+		return extractor.FileFacts{}, false
+	}
+	data, ok, err := r.store.Get(remoteFactsKey(contentHash, r.versions, tier))
+	if err != nil {
+		r.fail(fmt.Errorf("read: %w", err))
+		return extractor.FileFacts{}, false
+	}
+	if !ok {
+		return extractor.FileFacts{}, false
+	}
+	facts, err := decodeFacts(data)
+	if err != nil {
+		r.fail(fmt.Errorf("entry for %s: %w", path, err))
+		return extractor.FileFacts{}, false
+	}
+	if facts.Tier != tier {
+		return extractor.FileFacts{}, false
+	}
+	relocateFacts(&facts, path)
+	return facts, true
+}
+
+// Put queues facts for upload under contentHash and their tier.
+func (r *remoteFactsCache) Put(contentHash string, facts extractor.FileFacts) {
+	if r.down.Load() {
+		return
+	}
+	relocateFacts(&facts, "")
+	put := remotePut{key: remoteFactsKey(contentHash, r.versions, facts.Tier), data: encodeFacts(nil, &facts)}
+	r.mu.Lock()
+	defer r.mu.Unlock()
+	r.pending = append(r.pending, put)
+	if !r.uploading {
+		r.uploading = true
+		r.uploads.Add(1)
+		go r.upload()
+	}
+}
+
+// upload sends queued entries until the queue is empty or the remote is down.
+func (r *remoteFactsCache) upload() {
+	defer r.uploads.Done()
+	for {
+		r.mu.Lock()
+		if len(r.pending) == 0 || r.down.Load() {
+			r.pending = nil
+			r.uploading = false
+			r.mu.Unlock()
+			return
+		}
+		put := r.pending[0]
+		r.pending = r.pending[1:]
+		r.mu.Unlock()
+		if err := r.store.Put(put.key, put.data); err != nil {
+			r.fail(fmt.Errorf("write: %w", err))
+		}
+	}
+}
+
+// fail turns the remote off for the rest of the run, keeping the first error.
+func (r *remoteFactsCache) fail(err error) {
+	r.mu.Lock()
+	defer r.mu.Unlock()
+	if r.failure == nil {
+		r.failure = err
+	}
+	r.down.Store(true)
+}
+
+// Close waits for queued uploads and returns the failure that turned the
+// remote off, if any.
+func (r *remoteFactsCache) Close() error {
+	r.uploads.Wait()
+	r.mu.Lock()
+	defer r.mu.Unlock()
+	return r.failure
+}
+
+// remoteWarnings closes remote (nil allowed) and reports its failure.
+func remoteWarnings(remote *remoteFactsCache) []string {
+	if remote == nil {
+		return nil
+	}
+	if err := remote.Close(); err != nil {
+		return []string{fmt.Sprintf("remote cache unavailable, not used for the rest of the run: %v", err)}
+	}
+	return nil
+}
+
+// dirStore keeps blobs in a directory tree, fanned out by key prefix.
+type dirStore struct {
+	dir string
+}
+
+func (s dirStore) path(key string) string {
+	return filepath.Join(s.dir, key[:2], key)
+}
+
+func (s dirStore) Get(key string) ([]byte, bool, error) {
+	data, err := os.ReadFile(s.path(key))
+	if errors.Is(err, os.ErrNotExist) {
+		return nil, false, nil
+	}
+	if err != nil {
+		return nil, false, err
+	}
+	return data, true, nil
+}
+
+func (s dirStore) Put(key string, data []byte) error {
+	if _, err := os.Stat(s.path(key)); err == nil {
+		return nil // content-addressed: already there
+	}
+	return writeFileAtomic(s.path(key), data)
+}
+
+// httpStore keeps blobs behind a plain GET/PUT HTTP endpoint.
+type httpStore struct {
+	base   string
+	client *http.Client
+}
+
+func (s *httpStore) Get(key string) ([]byte, bool, error) {
+	resp, err := s.client.Get(s.base + "/" + key)
+	if err != nil {
+		return nil, false, err
+	}
+	defer resp.Body.Close()
+	switch resp.StatusCode {
+	case http.StatusOK:
+		data, err := io.ReadAll(resp.Body)
+		if err != nil {
+			return nil, false, err
+		}
+		return data, true, nil
+	case http.StatusNotFound:
+		return nil, false, nil
+	default:
+		return nil, false, fmt.Errorf("GET %s: %s", key, resp.Status)
+	}
+}
+
+func (s *httpStore) Put(key string, data []byte) error {
+	req, err := http.NewRequest(http.MethodPut, s.base+"/"+key, bytes.NewReader(data))
+	if err != nil {
+		return err
+	}
+	req.Header.Set("Content-Type", "application/octet-stream")
+	resp, err := s.client.Do(req)
+	if err != nil {
+		return err
+	}
+	defer resp.Body.Close()
+	_, _ = io.Copy(io.Discard, resp.Body)
+	if resp.StatusCode/100 != 2 {
+		return fmt.Errorf("PUT %s: %s", key, resp.Status)
+	}
+	return nil
+}
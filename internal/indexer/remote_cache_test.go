@@ -0,0 +1,149 @@
+package indexer
+
+import (
+	"fmt"
+	"io"
+	"net/http"
+	"net/http/httptest"
+	"path/filepath"
+	"strings"
+	"sync"
+	"sync/atomic"
+	"testing"
+
+	"github.com/robert-at-pretension-io/vhdl-lint/internal/extractor"
+)
+
+const remoteTestSource = "library ieee; use ieee.std_logic_1164.all; entity a is end entity; architecture rtl of a is begin end architecture;"
+
+func TestRemoteCacheSharesFactsAcrossCheckouts(t *testing.T) {
+	remote := t.TempDir()
+	versions := cacheVersions{parser: "p1", extractor: "e1"}
+
+	run := func(dir string) (*Indexer, int32) {
+		file := writeVHDL(t, dir, "a.vhd", remoteTestSource)
+		cfg := defaultTestConfig([]string{file}, filepath.Join(dir, ".cache"), true)
+		cfg.Analysis.Cache.Remote = remote
+		var count int32
+		idx := NewWithConfig(cfg)
+		idx.cacheVersionOverride = &versions
+		idx.extractorFactory = func() FactsExtractor {
+			return &countingExtractor{inner: extractor.New(), count: &count}
+		}
+		runIndexerForTest(t, idx, dir)
+		return idx, atomic.LoadInt32(&count)
+	}
+
+	if _, n := run(t.TempDir()); n != 1 {
+		t.Fatalf("first checkout extracted %d files, want 1", n)
+	}
+	second := t.TempDir()
+	idx, n := run(second)
+	if n != 0 {
+		t.Fatalf("second checkout extracted %d files, want 0 (remote hit)", n)
+	}
+	if want := filepath.Join(second, "a.vhd"); len(idx.Facts) != 1 || idx.Facts[0].File != want {
+		t.Fatalf("remote facts not relocated to %s: %+v", want, idx.Facts)
+	}
+	deps := idx.Facts[0].Dependencies
+	if len(deps) == 0 {
+		t.Fatal("expected the use clause's dependencies in the remote facts")
+	}
+	for _, d := range deps {
+		if d.Source != idx.Facts[0].File {
+			t.Fatalf("dependency %s has source %q, want %s", d.Target, d.Source, idx.Facts[0].File)
+		}
+	}
+}
+
+func TestRemoteCacheRefusesFastHash(t *testing.T) {
+	_, err := newRemoteFactsCache(t.TempDir(), "", cacheHashFast, cacheVersions{parser: "p1", extractor: "e1"})
+	if err == nil {
+		t.Fatal("expected remote cache with the fast hash to be refused")
+	}
+	_, err = newRemoteFactsCache(t.TempDir(), "", "", cacheVersions{parser: "unknown", extractor: "e1"})
+	if err == nil {
+		t.Fatal("expected remote cache with an unknown parser version to be refused")
+	}
+}
+
+func TestHTTPStoreRoundTrip(t *testing.T) {
+	var mu sync.Mutex
+	blobs := make(map[string][]byte)
+	srv := httptest.NewServer(http.HandlerFunc(func(w http.ResponseWriter, r *http.Request) {
+		key := strings.TrimPrefix(r.URL.Path, "/cache/")
+		mu.Lock()
+		defer mu.Unlock()
+		switch r.Method {
+		case http.MethodGet:
+			data, ok := blobs[key]
+			if !ok {
+				http.NotFound(w, r)
+				return
+			}
+			_, _ = w.Write(data)
+		case http.MethodPut:
+			data, _ := io.ReadAll(r.Body)
+			blobs[key] = data
+			w.WriteHeader(http.StatusCreated)
+		}
+	}))
+	defer srv.Close()
+
+	r, err := newRemoteFactsCache(srv.URL+"/cache/", "", "", cacheVersions{parser: "p1", extractor: "e1"})
+	if err != nil {
+		t.Fatal(err)
+	}
+	if _, ok := r.Get("a.vhd", "h1", extractor.TierFull); ok {
+		t.Fatal("empty store: unexpected hit")
+	}
+	facts := extractor.FileFacts{File: "x/a.vhd", Entities: []extractor.Entity{{Name: "a"}}}
+	r.Put("h1", facts)
+	// Uploads run in the background; Close waits for them
+	if err := r.Close(); err != nil {
+		t.Fatal(err)
+	}
+	got, ok := r.Get("y/a.vhd", "h1", extractor.TierFull)
+	if !ok {
+		t.Fatal("get after put: miss")
+	}
+	if got.File != "y/a.vhd" || len(got.Entities) != 1 || got.Entities[0].Name != "a" {
+		t.Fatalf("round trip: %+v", got)
+	}
+	if facts.File != "x/a.vhd" {
+		t.Fatalf("Put modified the caller's facts: %s", facts.File)
+	}
+}
+
+func TestRemoteCacheFailsOpen(t *testing.T) {
+	var requests int32
+	srv := httptest.NewServer(http.HandlerFunc(func(w http.ResponseWriter, r *http.Request) {
+		atomic.AddInt32(&requests, 1)
+		http.Error(w, "down", http.StatusServiceUnavailable)
+	}))
+	defer srv.Close()
+
+	dir := t.TempDir()
+	var files []string
+	for i := 0; i < 8; i++ {
+		files = append(files, writeVHDL(t, dir, fmt.Sprintf("u%d.vhd", i), fmt.Sprintf("entity u%d is end entity;", i)))
+	}
+	cfg := defaultTestConfig(files, filepath.Join(dir, ".cache"), true)
+	cfg.Analysis.Cache.Remote = srv.URL
+	cfg.Analysis.MaxParallelFiles = 2
+	idx := NewWithConfig(cfg)
+	idx.cacheVersionOverride = &cacheVersions{parser: "p1", extractor: "e1"}
+
+	// The lint succeeds and reports the remote as a warning
+	result := runIndexerForTest(t, idx, dir)
+	if len(idx.Facts) != len(files) {
+		t.Fatalf("extracted %d files, want %d", len(idx.Facts), len(files))
+	}
+	if len(result.Warnings) != 1 || !strings.Contains(result.Warnings[0], "remote cache unavailable") {
+		t.Fatalf("expected one remote cache warning, got %v", result.Warnings)
+	}
+	// Only lookups already in flight when it failed reached the remote
+	if n := atomic.LoadInt32(&requests); n > 2 {
+		t.Fatalf("remote got %d requests after failing, want at most one per worker", n)
+	}
+}
@@ -0,0 +1,101 @@
+package indexer
+
+import (
+	"fmt"
+
+	"github.com/robert-at-pretension-io/vhdl-lint/internal/facts"
+	"github.com/robert-at-pretension-io/vhdl-lint/internal/policy"
+	"github.com/robert-at-pretension-io/vhdl-lint/internal/validator"
+)
+
+// Resident state: with Indexer.Resident set (vhdl-lint serve), the CUE
+// validators, the vhdl_policyd process and the fact tables it was last fed
+// outlive Run, so a warm run compiles no schema, starts no process and loads
+// no tables from disk. Close releases them.
+
+type residentState struct {
+	validator      *validator.Validator
+	factsValidator *validator.FactsValidator
+	daemon         *policy.Daemon
+	daemonTables   facts.Tables
+}
+
+func (idx *Indexer) inputValidator() (*validator.Validator, error) {
+	if idx.resident.validator != nil {
+		return idx.resident.validator, nil
+	}
+	v, err := validator.New()
+	if err != nil {
+		return nil, err
+	}
+	if idx.Resident {
+		idx.resident.validator = v
+	}
+	return v, nil
+}
+
+func (idx *Indexer) tablesValidator() (*validator.FactsValidator, error) {
+	if idx.resident.factsValidator != nil {
+		return idx.resident.factsValidator, nil
+	}
+	v, err := validator.NewFactsValidator()
+	if err != nil {
+		return nil, err
+	}
+	if idx.Resident {
+		idx.resident.factsValidator = v
+	}
+	return v, nil
+}
+
+// runResidentPolicyDaemon is runPolicyDaemon against a daemon kept across
+// runs: the first run initializes it with tables, later runs send the delta
+// from the tables it already holds. A failed daemon is dropped and the next
+// run starts a new one.
+func (idx *Indexer) runResidentPolicyDaemon(tables facts.Tables, changedFiles map[string]bool) (*policy.Result, bool, error) {
+	r := &idx.resident
+	if r.daemon == nil {
+		daemon, err := policy.NewDaemon(".")
+		if err != nil {
+			return nil, false, err
+		}
+		result, err := daemon.Init(tables)
+		if err != nil {
+			_ = daemon.Close()
+			return nil, false, err
+		}
+		r.daemon = daemon
+		r.daemonTables = tables
+		return result, false, nil
+	}
+
+	var delta facts.Delta
+	if len(changedFiles) > 0 {
+		delta = facts.ComputeDeltaForFiles(r.daemonTables, tables, changedFiles)
+	} else {
+		delta = facts.ComputeDelta(r.daemonTables, tables)
+	}
+	result, err := r.daemon.Delta(delta)
+	if err != nil {
+		_ = r.daemon.Close()
+		r.daemon = nil
+		r.daemonTables = facts.Tables{}
+		return nil, true, fmt.Errorf("resident daemon: %w", err)
+	}
+	r.daemonTables = tables
+	return result, true, nil
+}
+
+// Close releases what a Resident indexer keeps between runs: the policy
+// daemon and the kept syntax trees.
+func (idx *Indexer) Close() error {
+	var err error
+	if idx.resident.daemon != nil {
+		err = idx.resident.daemon.Close()
+	}
+	idx.resident = residentState{}
+	if idx.Trees != nil {
+		idx.Trees.Close()
+	}
+	return err
+}
@@ -0,0 +1,604 @@
+package indexer
+
+import (
+	"fmt"
+	"sort"
+	"strings"
+	"sync"
+
+	"github.com/robert-at-pretension-io/vhdl-lint/internal/policy"
+)
+
+// populateScopesDefsUses fills input.Scopes, SymbolDefs and NameUses.
+//
+// Every scope id is rooted at its file's scope ("file:<path>"), so files
+// share no scope state. Each file's scopes, and the scope of each of its
+// rows, are resolved on a worker pool; the results are then emitted in the
+// same order a single pass over the input would produce.
+func (idx *Indexer) populateScopesDefsUses(input *policy.Input) {
+	work := make(map[string]*fileScopeWork)
+	var files []string
+	forFile := func(file string) *fileScopeWork {
+		w, ok := work[file]
+		if !ok {
+			w = &fileScopeWork{}
+			work[file] = w
+			files = append(files, file)
+		}
+		return w
+	}
+	for _, fileInfo := range input.Files {
+		forFile(fileInfo.Path).seeded = true
+	}
+	for i, ent := range input.Entities {
+		w := forFile(ent.File)
+		w.entities = append(w.entities, i)
+	}
+	for i, pkg := range input.Packages {
+		w := forFile(pkg.File)
+		w.packages = append(w.packages, i)
+	}
+	for i, arch := range input.Architectures {
+		w := forFile(arch.File)
+		w.archs = append(w.archs, i)
+	}
+	for i, gen := range input.Generates {
+		w := forFile(gen.File)
+		w.generates = append(w.generates, i)
+	}
+	for i, sig := range input.Signals {
+		w := forFile(sig.File)
+		w.signals = append(w.signals, i)
+	}
+	for i, typ := range input.Types {
+		w := forFile(typ.File)
+		w.types = append(w.types, i)
+	}
+	for i, st := range input.Subtypes {
+		w := forFile(st.File)
+		w.subtypes = append(w.subtypes, i)
+	}
+	for i, fn := range input.Functions {
+		w := forFile(fn.File)
+		w.functions = append(w.functions, i)
+	}
+	for i, pr := range input.Procedures {
+		w := forFile(pr.File)
+		w.procedures = append(w.procedures, i)
+	}
+	for i, c := range input.ConstantDecls {
+		w := forFile(c.File)
+		w.constants = append(w.constants, i)
+	}
+	for i, proc := range input.Processes {
+		w := forFile(proc.File)
+		w.processes = append(w.processes, i)
+	}
+	for i, dep := range input.SignalDeps {
+		w := forFile(dep.File)
+		w.signalDeps = append(w.signalDeps, i)
+	}
+
+	// Scope of each row, by row index; every file writes only its own rows
+	rows := rowScopes{
+		entityFile:  make([]string, len(input.Entities)),
+		entity:      make([]string, len(input.Entities)),
+		archFile:    make([]string, len(input.Architectures)),
+		pkg:         make([]string, len(input.Packages)),
+		signal:      make([]string, len(input.Signals)),
+		typ:         make([]string, len(input.Types)),
+		subtype:     make([]string, len(input.Subtypes)),
+		function:    make([]string, len(input.Functions)),
+		procedure:   make([]string, len(input.Procedures)),
+		constant:    make([]string, len(input.ConstantDecls)),
+		process:     make([]string, len(input.Processes)),
+		signalDep:   make([]string, len(input.SignalDeps)),
+		scopesBatch: make([][]policy.Scope, len(files)),
+	}
+
+	jobs := make(chan int)
+	var wg sync.WaitGroup
+	for w := idx.extractionWorkers(len(files)); w > 0; w-- {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			for k := range jobs {
+				resolveFileScopes(input, files[k], work[files[k]], &rows, k)
+			}
+		}()
+	}
+	for k := range files {
+		jobs <- k
+	}
+	close(jobs)
+	wg.Wait()
+
+	// Export scopes in deterministic order
+	total := 0
+	for _, batch := range rows.scopesBatch {
+		total += len(batch)
+	}
+	if total > 0 {
+		input.Scopes = make([]policy.Scope, 0, total)
+	}
+	for _, batch := range rows.scopesBatch {
+		input.Scopes = append(input.Scopes, batch...)
+	}
+	sort.Slice(input.Scopes, func(i, j int) bool { return input.Scopes[i].Name < input.Scopes[j].Name })
+
+	// Symbol definitions
+	for i, ent := range input.Entities {
+		input.SymbolDefs = append(input.SymbolDefs, policy.SymbolDef{
+			Name:  ent.Name,
+			Kind:  "entity",
+			File:  ent.File,
+			Line:  ent.Line,
+			Scope: rows.entityFile[i],
+		})
+		for _, port := range ent.Ports {
+			input.SymbolDefs = append(input.SymbolDefs, policy.SymbolDef{
+				Name:  port.Name,
+				Kind:  "port",
+				File:  ent.File,
+				Line:  port.Line,
+				Scope: rows.entity[i],
+			})
+		}
+		for _, gen := range ent.Generics {
+			input.SymbolDefs = append(input.SymbolDefs, policy.SymbolDef{
+				Name:  gen.Name,
+				Kind:  "generic",
+				File:  ent.File,
+				Line:  gen.Line,
+				Scope: rows.entity[i],
+			})
+		}
+	}
+	for i, arch := range input.Architectures {
+		input.SymbolDefs = append(input.SymbolDefs, policy.SymbolDef{
+			Name:  arch.Name,
+			Kind:  "architecture",
+			File:  arch.File,
+			Line:  arch.Line,
+			Scope: rows.archFile[i],
+		})
+	}
+	for i, pkg := range input.Packages {
+		input.SymbolDefs = append(input.SymbolDefs, policy.SymbolDef{
+			Name:  pkg.Name,
+			Kind:  "package",
+			File:  pkg.File,
+			Line:  pkg.Line,
+			Scope: rows.pkg[i],
+		})
+	}
+	for i, sig := range input.Signals {
+		input.SymbolDefs = append(input.SymbolDefs, policy.SymbolDef{
+			Name:  sig.Name,
+			Kind:  "signal",
+			File:  sig.File,
+			Line:  sig.Line,
+			Scope: rows.signal[i],
+		})
+	}
+	for i, typ := range input.Types {
+		input.SymbolDefs = append(input.SymbolDefs, policy.SymbolDef{
+			Name:  typ.Name,
+			Kind:  "type",
+			File:  typ.File,
+			Line:  typ.Line,
+			Scope: rows.typ[i],
+		})
+	}
+	for i, st := range input.Subtypes {
+		input.SymbolDefs = append(input.SymbolDefs, policy.SymbolDef{
+			Name:  st.Name,
+			Kind:  "subtype",
+			File:  st.File,
+			Line:  st.Line,
+			Scope: rows.subtype[i],
+		})
+	}
+	for i, fn := range input.Functions {
+		input.SymbolDefs = append(input.SymbolDefs, policy.SymbolDef{
+			Name:  fn.Name,
+			Kind:  "function",
+			File:  fn.File,
+			Line:  fn.Line,
+			Scope: rows.function[i],
+		})
+	}
+	for i, pr := range input.Procedures {
+		input.SymbolDefs = append(input.SymbolDefs, policy.SymbolDef{
+			Name:  pr.Name,
+			Kind:  "procedure",
+			File:  pr.File,
+			Line:  pr.Line,
+			Scope: rows.procedure[i],
+		})
+	}
+	for i, c := range input.ConstantDecls {
+		input.SymbolDefs = append(input.SymbolDefs, policy.SymbolDef{
+			Name:  c.Name,
+			Kind:  "constant",
+			File:  c.File,
+			Line:  c.Line,
+			Scope: rows.constant[i],
+		})
+	}
+
+	// Name uses from processes
+	for i, proc := range input.Processes {
+		scopeID := rows.process[i]
+		context := proc.Label
+		if context == "" {
+			context = fmt.Sprintf("process@%d", proc.Line)
+		}
+		for _, call := range proc.FunctionCalls {
+			name := strings.TrimSpace(call.Name)
+			if name == "" {
+				continue
+			}
+			input.NameUses = append(input.NameUses, policy.NameUse{
+				Name:    name,
+				Kind:    "function_call",
+				File:    proc.File,
+				Line:    call.Line,
+				Scope:   scopeID,
+				Context: context,
+			})
+		}
+		for _, call := range proc.ProcedureCalls {
+			name := strings.TrimSpace(call.FullName)
+			if name == "" {
+				name = strings.TrimSpace(call.Name)
+			}
+			if name == "" {
+				continue
+			}
+			input.NameUses = append(input.NameUses, policy.NameUse{
+				Name:    name,
+				Kind:    "procedure_call",
+				File:    proc.File,
+				Line:    call.Line,
+				Scope:   scopeID,
+				Context: context,
+			})
+		}
+	}
+
+	// Name uses from signal dependencies
+	for i, dep := range input.SignalDeps {
+		scopeID := rows.signalDep[i]
+		context := dep.InProcess
+		if dep.Source != "" {
+			input.NameUses = append(input.NameUses, policy.NameUse{
+				Name:    dep.Source,
+				Kind:    "signal_read",
+				File:    dep.File,
+				Line:    dep.Line,
+				Scope:   scopeID,
+				Context: context,
+			})
+		}
+		if dep.Target != "" {
+			input.NameUses = append(input.NameUses, policy.NameUse{
+				Name:    dep.Target,
+				Kind:    "signal_write",
+				File:    dep.File,
+				Line:    dep.Line,
+				Scope:   scopeID,
+				Context: context,
+			})
+		}
+	}
+}
+
+// fileScopeWork lists one file's rows, as indexes into the input slices.
+type fileScopeWork struct {
+	seeded     bool // listed in input.Files
+	entities   []int
+	packages   []int
+	archs      []int
+	generates  []int
+	signals    []int
+	types      []int
+	subtypes   []int
+	functions  []int
+	procedures []int
+	constants  []int
+	processes  []int
+	signalDeps []int
+}
+
+// rowScopes receives the resolved scope id of every row, plus each file's
+// exported scopes.
+type rowScopes struct {
+	entityFile  []string
+	entity      []string
+	archFile    []string
+	pkg         []string
+	signal      []string
+	typ         []string
+	subtype     []string
+	function    []string
+	procedure   []string
+	constant    []string
+	process     []string
+	signalDep   []string
+	scopesBatch [][]policy.Scope
+}
+
+// resolveFileScopes builds file's scopes from its entities, packages,
+// architectures and generates, exports them, then resolves the scope of
+// each of its definitions and uses. Scopes created only while resolving
+// (fallbacks to the file scope) are not exported, as before.
+func resolveFileScopes(input *policy.Input, file string, w *fileScopeWork, rows *rowScopes, k int) {
+	fs := newFileScopes(file)
+	if w.seeded {
+		fs.ensureFile()
+	}
+	for _, i := range w.entities {
+		fs.ensureEntity(input.Entities[i].Name, input.Entities[i].Line)
+	}
+	for _, i := range w.packages {
+		fs.ensurePackage(input.Packages[i].Name, input.Packages[i].Line)
+	}
+	for _, i := range w.archs {
+		fs.ensureArch(input.Architectures[i].Name, input.Architectures[i].Line)
+	}
+	for _, i := range w.generates {
+		fs.ensureGenerate(input.Generates[i])
+	}
+
+	batch := make([]policy.Scope, 0, len(fs.byID))
+	for _, scope := range fs.byID {
+		batch = append(batch, scope)
+	}
+	rows.scopesBatch[k] = batch
+
+	for _, i := range w.entities {
+		ent := &input.Entities[i]
+		rows.entityFile[i] = fs.ensureFile()
+		rows.entity[i] = fs.ensureEntity(ent.Name, ent.Line)
+	}
+	for _, i := range w.archs {
+		rows.archFile[i] = fs.ensureFile()
+	}
+	for _, i := range w.packages {
+		pkg := &input.Packages[i]
+		rows.pkg[i] = fs.ensurePackage(pkg.Name, pkg.Line)
+	}
+	for _, i := range w.signals {
+		rows.signal[i] = fs.scopeForContext(input.Signals[i].InEntity)
+	}
+	for _, i := range w.types {
+		rows.typ[i] = fs.scopeForContext(packageOrArch(input.Types[i].InPackage, input.Types[i].InArch))
+	}
+	for _, i := range w.subtypes {
+		rows.subtype[i] = fs.scopeForContext(packageOrArch(input.Subtypes[i].InPackage, input.Subtypes[i].InArch))
+	}
+	for _, i := range w.functions {
+		rows.function[i] = fs.scopeForContext(packageOrArch(input.Functions[i].InPackage, input.Functions[i].InArch))
+	}
+	for _, i := range w.procedures {
+		rows.procedure[i] = fs.scopeForContext(packageOrArch(input.Procedures[i].InPackage, input.Procedures[i].InArch))
+	}
+	for _, i := range w.constants {
+		rows.constant[i] = fs.scopeForContext(packageOrArch(input.ConstantDecls[i].InPackage, input.ConstantDecls[i].InArch))
+	}
+	for _, i := range w.processes {
+		rows.process[i] = fs.scopeForContext(input.Processes[i].InArch)
+	}
+	for _, i := range w.signalDeps {
+		rows.signalDep[i] = fs.scopeForContext(input.SignalDeps[i].InArch)
+	}
+}
+
+func packageOrArch(inPackage, inArch string) string {
+	if inPackage != "" {
+		return inPackage
+	}
+	return inArch
+}
+
+// fileScopes is the scope tree of one file.
+type fileScopes struct {
+	file      string
+	fileID    string
+	byID      map[string]policy.Scope
+	entities  map[string]string
+	packages  map[string]string
+	archs     map[string]string
+	archPaths map[string]string
+}
+
+func newFileScopes(file string) *fileScopes {
+	return &fileScopes{
+		file:      file,
+		byID:      make(map[string]policy.Scope),
+		entities:  make(map[string]string),
+		packages:  make(map[string]string),
+		archs:     make(map[string]string),
+		archPaths: make(map[string]string),
+	}
+}
+
+func normalizeScopeName(name string) string {
+	return strings.ToLower(strings.TrimSpace(name))
+}
+
+func splitScopePath(path string) []string {
+	raw := strings.Split(path, ".")
+	parts := make([]string, 0, len(raw))
+	for _, part := range raw {
+		part = strings.TrimSpace(part)
+		if part == "" {
+			continue
+		}
+		parts = append(parts, part)
+	}
+	return parts
+}
+
+func (fs *fileScopes) add(id, kind string, line int, parent string) string {
+	if id == "" {
+		return ""
+	}
+	if existing, ok := fs.byID[id]; ok {
+		if line > 0 && (existing.Line < 1 || (existing.Line == 1 && line != 1)) {
+			existing.Line = line
+			fs.byID[id] = existing
+		}
+		return id
+	}
+	if line < 1 {
+		line = 1
+	}
+	path := []string{id}
+	if parent != "" {
+		if parentScope, ok := fs.byID[parent]; ok && len(parentScope.Path) > 0 {
+			path = append(append([]string{}, parentScope.Path...), id)
+		} else {
+			path = []string{parent, id}
+		}
+	}
+	fs.byID[id] = policy.Scope{
+		Name:   id,
+		Kind:   kind,
+		File:   fs.file,
+		Line:   line,
+		Parent: parent,
+		Path:   path,
+	}
+	return id
+}
+
+func (fs *fileScopes) ensureFile() string {
+	if fs.file == "" {
+		return ""
+	}
+	if fs.fileID != "" {
+		return fs.fileID
+	}
+	id := "file:" + fs.file
+	fs.add(id, "file", 1, "")
+	fs.fileID = id
+	return id
+}
+
+func (fs *fileScopes) ensureEntity(name string, line int) string {
+	if name == "" {
+		return fs.ensureFile()
+	}
+	key := normalizeScopeName(name)
+	if id, ok := fs.entities[key]; ok {
+		return id
+	}
+	parent := fs.ensureFile()
+	id := parent + "::entity:" + key
+	fs.add(id, "entity", line, parent)
+	fs.entities[key] = id
+	return id
+}
+
+func (fs *fileScopes) ensurePackage(name string, line int) string {
+	if name == "" {
+		return fs.ensureFile()
+	}
+	key := normalizeScopeName(name)
+	if id, ok := fs.packages[key]; ok {
+		return id
+	}
+	parent := fs.ensureFile()
+	id := parent + "::package:" + key
+	fs.add(id, "package", line, parent)
+	fs.packages[key] = id
+	return id
+}
+
+func (fs *fileScopes) ensureArch(name string, line int) string {
+	if name == "" {
+		return fs.ensureFile()
+	}
+	key := normalizeScopeName(name)
+	if id, ok := fs.archs[key]; ok {
+		return id
+	}
+	parent := fs.ensureFile()
+	id := parent + "::arch:" + key
+	fs.add(id, "architecture", line, parent)
+	fs.archs[key] = id
+	fs.archPaths[key] = id
+	return id
+}
+
+func (fs *fileScopes) ensureArchPath(archPath string) string {
+	parts := splitScopePath(archPath)
+	if len(parts) == 0 {
+		return fs.ensureFile()
+	}
+	archName := parts[0]
+	parent := fs.ensureArch(archName, 1)
+	currentKey := normalizeScopeName(archName)
+	fs.archPaths[currentKey] = parent
+	for _, seg := range parts[1:] {
+		if seg == "" {
+			continue
+		}
+		segKey := normalizeScopeName(seg)
+		currentKey = currentKey + "." + segKey
+		if id, ok := fs.archPaths[currentKey]; ok {
+			parent = id
+			continue
+		}
+		id := parent + "::generate:" + segKey
+		fs.add(id, "generate", 1, parent)
+		fs.archPaths[currentKey] = id
+		parent = id
+	}
+	return parent
+}
+
+func (fs *fileScopes) ensureGenerate(gen policy.GenerateStatement) string {
+	parent := fs.ensureArchPath(gen.InArch)
+	label := strings.TrimSpace(gen.Label)
+	if label == "" {
+		label = fmt.Sprintf("gen@%d", gen.Line)
+	}
+	pathKey := normalizeScopeName(strings.Trim(strings.Join([]string{gen.InArch, label}, "."), "."))
+	if pathKey == "" {
+		return parent
+	}
+	if id, ok := fs.archPaths[pathKey]; ok {
+		if scope, ok := fs.byID[id]; ok && gen.Line > 0 && (scope.Line < 1 || (scope.Line == 1 && gen.Line != 1)) {
+			scope.Line = gen.Line
+			fs.byID[id] = scope
+		}
+		return id
+	}
+	id := parent + "::generate:" + normalizeScopeName(label)
+	fs.add(id, "generate", gen.Line, parent)
+	fs.archPaths[pathKey] = id
+	return id
+}
+
+func (fs *fileScopes) scopeForContext(context string) string {
+	ctx := normalizeScopeName(context)
+	if ctx == "" {
+		return fs.ensureFile()
+	}
+	if id, ok := fs.packages[ctx]; ok {
+		return id
+	}
+	if id, ok := fs.entities[ctx]; ok {
+		return id
+	}
+	if id, ok := fs.archPaths[ctx]; ok {
+		return id
+	}
+	if id, ok := fs.archs[ctx]; ok {
+		return id
+	}
+	return fs.ensureFile()
+}
@@ -0,0 +1,283 @@
+package indexer
+
+import (
+	"crypto/sha256"
+	"encoding/binary"
+	"encoding/hex"
+	"encoding/json"
+	"fmt"
+	"hash/fnv"
+	"os"
+	"path/filepath"
+	"sort"
+	"strconv"
+	"strings"
+	"time"
+
+	"github.com/robert-at-pretension-io/vhdl-lint/internal/extractor"
+)
+
+// =============================================================================
+// SHARDED EXTRACTION
+// =============================================================================
+//
+// Extraction can be split across CI nodes:
+//
+//	vhdl-lint --shard 1/4 --artifact-dir out <root>   # on each of 4 nodes
+//	vhdl-lint merge <root> out/facts-*.vfa            # on one node
+//
+// A shard extracts the files it owns (by a hash of the root-relative path,
+// so every node agrees without coordination) and writes them as one fact
+// artifact, named by the SHA-256 of its bytes: the same files and versions
+// always give the same artifact. Merge runs the normal pipeline with the
+// artifacts' facts in place of extraction: symbols are linked and policy is
+// evaluated over the combined tables. A file whose content no longer
+// matches its artifact entry, or that no artifact covers, is extracted
+// locally.
+//
+// Artifact layout:
+//
+//	"VHFA" | uvarint version | parser version | extractor version |
+//	uvarint files | per file: path | content hash | facts
+//
+// Strings are uvarint length-prefixed, paths are root-relative with forward
+// slashes, and facts are a length-prefixed fact_codec.go record with file
+// paths cleared (relocateFacts restores them).
+// =============================================================================
+
+const (
+	shardArtifactMagic   = "VHFA"
+	shardArtifactVersion = 1
+	shardArtifactExt     = ".vfa"
+)
+
+// Shard is node Index of Count (1-based, as in "--shard 2/4").
+type Shard struct {
+	Index int
+	Count int
+}
+
+// ParseShard parses "i/N" with 1 <= i <= N.
+func ParseShard(s string) (Shard, error) {
+	i, n, ok := strings.Cut(s, "/")
+	index, err1 := strconv.Atoi(i)
+	count, err2 := strconv.Atoi(n)
+	if !ok || err1 != nil || err2 != nil || count < 1 || index < 1 || index > count {
+		return Shard{}, fmt.Errorf("invalid shard %q (want i/N with 1 <= i <= N)", s)
+	}
+	return Shard{Index: index, Count: count}, nil
+}
+
+func (s Shard) String() string {
+	return fmt.Sprintf("%d/%d", s.Index, s.Count)
+}
+
+// Owns reports whether the file at root-relative path rel belongs to s.
+func (s Shard) Owns(rel string) bool {
+	h := fnv.New64a()
+	_, _ = h.Write([]byte(rel))
+	return int(h.Sum64()%uint64(s.Count)) == s.Index-1
+}
+
+// shardKey is path relative to the lint root, with forward slashes, so
+// nodes with different checkout directories agree on it.
+func shardKey(rootPath, path string) string {
+	root := rootPath
+	if info, err := os.Stat(rootPath); err == nil && !info.IsDir() {
+		root = filepath.Dir(rootPath)
+	}
+	absRoot, err1 := filepath.Abs(root)
+	absPath, err2 := filepath.Abs(path)
+	if err1 != nil || err2 != nil {
+		return filepath.ToSlash(path)
+	}
+	rel, err := filepath.Rel(absRoot, absPath)
+	if err != nil {
+		return filepath.ToSlash(path)
+	}
+	return filepath.ToSlash(rel)
+}
+
+// relocateFacts sets every file path in facts to path: the file, each
+// dependency's source and each crossing's file. The slices are copied
+// first: facts shares them with the caller's.
+func relocateFacts(facts *extractor.FileFacts, path string) {
+	facts.File = path
+	if len(facts.Dependencies) > 0 {
+		deps := make([]extractor.Dependency, len(facts.Dependencies))
+		copy(deps, facts.Dependencies)
+		for i := range deps {
+			deps[i].Source = path
+		}
+		facts.Dependencies = deps
+	}
+	if len(facts.CDCCrossings) > 0 {
+		crossings := make([]extractor.CDCCrossing, len(facts.CDCCrossings))
+		copy(crossings, facts.CDCCrossings)
+		for i := range crossings {
+			crossings[i].File = path
+		}
+		facts.CDCCrossings = crossings
+	}
+}
+
+// ShardResult is the JSON output of a shard Run.
+type ShardResult struct {
+	Shard    string   `json:"shard"`
+	Artifact string   `json:"artifact"`
+	Files    int      `json:"files"`
+	Failed   []string `json:"failed,omitempty"`
+	Warnings []string `json:"warnings,omitempty"`
+}
+
+// finishShard writes the facts of a shard Run and reports the artifact.
+// Files that failed to extract are left out; the merge node extracts them
+// itself and reports their errors with the lint result.
+func (idx *Indexer) finishShard(rootPath string, files []string, factsByFile map[string]extractor.FileFacts, extractErrs []error, warnings []string, timing *timingRecorder, runStart time.Time, pipelineErrs []error) error {
+	dir := idx.ArtifactDir
+	if dir == "" {
+		dir = filepath.Join(resolveCacheDir(rootPath, idx.Config), "shards")
+	}
+	stepStart := time.Now()
+	path, err := writeShardArtifact(dir, rootPath, files, factsByFile, idx.cacheVersions(rootPath))
+	if err != nil {
+		return fmt.Errorf("write artifact: %w", err)
+	}
+	idx.ArtifactPath = path
+	timing.RecordStage("artifact", stepStart, time.Since(stepStart), "")
+
+	result := ShardResult{Shard: idx.Shard.String(), Artifact: path, Files: len(factsByFile), Warnings: warnings}
+	for _, e := range extractErrs {
+		result.Failed = append(result.Failed, e.Error())
+	}
+	if idx.JSONOutput {
+		out := idx.Output
+		if out == nil {
+			out = os.Stdout
+		}
+		enc := json.NewEncoder(out)
+		enc.SetIndent("", "  ")
+		if err := enc.Encode(result); err != nil {
+			return fmt.Errorf("failed to encode JSON output: %w", err)
+		}
+	} else {
+		fmt.Printf("Shard %s: facts for %d files in %s\n", result.Shard, result.Files, path)
+		for _, msg := range result.Failed {
+			fmt.Printf("  extraction failed: %s\n", msg)
+		}
+		for _, w := range result.Warnings {
+			fmt.Fprintf(os.Stderr, "warning: %s\n", w)
+		}
+	}
+
+	timing.RecordStage("total", runStart, time.Since(runStart), "")
+	if err := timing.Close(); err != nil {
+		pipelineErrs = append(pipelineErrs, err)
+	}
+	if len(pipelineErrs) > 0 {
+		return fmt.Errorf("pipeline errors:\n%s", formatPipelineErrors(pipelineErrs))
+	}
+	return nil
+}
+
+// artifactFile is one file of a loaded artifact.
+type artifactFile struct {
+	contentHash string
+	facts       extractor.FileFacts // paths cleared
+}
+
+// writeShardArtifact writes the facts of files (keyed by path) to a
+// content-addressed artifact in dir and returns its path. Content hashes are
+// always SHA-256, whatever Analysis.Cache.Hash says: the merge node trusts
+// them to say its checkout matches the shard's.
+func writeShardArtifact(dir, rootPath string, files []string, factsByFile map[string]extractor.FileFacts, versions cacheVersions) (string, error) {
+	type entry struct {
+		key, path string
+	}
+	entries := make([]entry, 0, len(files))
+	for _, f := range files {
+		if _, ok := factsByFile[f]; ok {
+			entries = append(entries, entry{shardKey(rootPath, f), f})
+		}
+	}
+	sort.Slice(entries, func(i, j int) bool { return entries[i].key < entries[j].key })
+
+	buf := append([]byte(nil), shardArtifactMagic...)
+	buf = binary.AppendUvarint(buf, shardArtifactVersion)
+	buf = appendArtifactString(buf, versions.parser)
+	buf = appendArtifactString(buf, versions.extractor)
+	buf = binary.AppendUvarint(buf, uint64(len(entries)))
+	var record []byte
+	for _, e := range entries {
+		hash, err := hashFile(e.path)
+		if err != nil {
+			return "", fmt.Errorf("hash %s: %w", e.path, err)
+		}
+		facts := factsByFile[e.path]
+		relocateFacts(&facts, "")
+		record = encodeFacts(record[:0], &facts)
+		buf = appendArtifactString(buf, e.key)
+		buf = appendArtifactString(buf, hash)
+		buf = binary.AppendUvarint(buf, uint64(len(record)))
+		buf = append(buf, record...)
+	}
+
+	sum := sha256.Sum256(buf)
+	path := filepath.Join(dir, "facts-"+hex.EncodeToString(sum[:])+shardArtifactExt)
+	if err := writeFileAtomic(path, buf); err != nil {
+		return "", err
+	}
+	return path, nil
+}
+
+func appendArtifactString(buf []byte, s string) []byte {
+	buf = binary.AppendUvarint(buf, uint64(len(s)))
+	return append(buf, s...)
+}
+
+// loadShardArtifacts reads artifacts written with versions into one map by
+// root-relative path. Artifacts from another parser or extractor would
+// merge facts the local pipeline cannot produce, so they are an error, as
+// are artifacts whose versions are unknown (they match any other unknown).
+func loadShardArtifacts(paths []string, versions cacheVersions) (map[string]artifactFile, error) {
+	out := make(map[string]artifactFile)
+	for _, path := range paths {
+		data, err := os.ReadFile(path)
+		if err != nil {
+			return nil, fmt.Errorf("read artifact: %w", err)
+		}
+		if len(data) < len(shardArtifactMagic) || string(data[:len(shardArtifactMagic)]) != shardArtifactMagic {
+			return nil, fmt.Errorf("artifact %s: not a fact artifact", path)
+		}
+		d := &factDecoder{data: data, pos: len(shardArtifactMagic)}
+		if v := d.uvarint(); d.err == nil && v != shardArtifactVersion {
+			return nil, fmt.Errorf("artifact %s: version %d, want %d", path, v, shardArtifactVersion)
+		}
+		parser := string(d.bytes(d.length()))
+		ext := string(d.bytes(d.length()))
+		if d.err == nil && !(cacheVersions{parser: parser, extractor: ext}).known() {
+			return nil, fmt.Errorf("artifact %s: written with an unknown parser/extractor version", path)
+		}
+		if d.err == nil && (parser != versions.parser || ext != versions.extractor) {
+			return nil, fmt.Errorf("artifact %s: written by another parser/extractor version", path)
+		}
+		n := d.uvarint()
+		for i := uint64(0); i < n && d.err == nil; i++ {
+			key := string(d.bytes(d.length()))
+			hash := string(d.bytes(d.length()))
+			record := d.bytes(d.length())
+			if d.err != nil {
+				break
+			}
+			facts, err := decodeFacts(record)
+			if err != nil {
+				return nil, fmt.Errorf("artifact %s: %s: %w", path, key, err)
+			}
+			out[key] = artifactFile{contentHash: hash, facts: facts}
+		}
+		if d.err != nil {
+			return nil, fmt.Errorf("artifact %s: %w", path, d.err)
+		}
+	}
+	return out, nil
+}
@@ -0,0 +1,193 @@
+package indexer
+
+import (
+	"bytes"
+	"fmt"
+	"path/filepath"
+	"sync/atomic"
+	"testing"
+
+	"github.com/robert-at-pretension-io/vhdl-lint/internal/extractor"
+)
+
+func TestParseShard(t *testing.T) {
+	s, err := ParseShard("2/4")
+	if err != nil || s != (Shard{Index: 2, Count: 4}) {
+		t.Fatalf("ParseShard(2/4) = %+v, %v", s, err)
+	}
+	for _, bad := range []string{"0/4", "5/4", "a/b", "3", "1/0", ""} {
+		if _, err := ParseShard(bad); err == nil {
+			t.Fatalf("ParseShard(%q): expected error", bad)
+		}
+	}
+}
+
+func TestShardsPartitionFiles(t *testing.T) {
+	shards := []Shard{{1, 3}, {2, 3}, {3, 3}}
+	for i := 0; i < 50; i++ {
+		rel := fmt.Sprintf("rtl/unit_%d.vhd", i)
+		owners := 0
+		for _, s := range shards {
+			if s.Owns(rel) {
+				owners++
+			}
+		}
+		if owners != 1 {
+			t.Fatalf("%s owned by %d shards", rel, owners)
+		}
+	}
+}
+
+func writeShardDesign(t *testing.T, dir string) []string {
+	t.Helper()
+	return []string{
+		writeVHDL(t, dir, "pkg.vhd", "package my_pkg is constant C : integer := 1; end package;"),
+		writeVHDL(t, dir, "a.vhd", "library work; use work.my_pkg.all; entity a is end entity; architecture rtl of a is signal x : integer := C; begin end architecture;"),
+		writeVHDL(t, dir, "b.vhd", "entity b is end entity; architecture rtl of b is begin u : entity work.a; end architecture;"),
+		writeVHDL(t, dir, "c.vhd", "entity c is end entity; architecture rtl of c is signal s : bit; begin end architecture;"),
+	}
+}
+
+func runShardForTest(t *testing.T, files []string, dir, artifactDir string, shard Shard, versions cacheVersions) string {
+	t.Helper()
+	idx := NewWithConfig(defaultTestConfig(files, filepath.Join(dir, ".cache"), false))
+	idx.cacheVersionOverride = &versions
+	idx.Shard = &shard
+	idx.ArtifactDir = artifactDir
+	idx.JSONOutput = true
+	idx.Output = &bytes.Buffer{}
+	if err := idx.Run(dir); err != nil {
+		t.Fatalf("shard %s: %v", shard, err)
+	}
+	return idx.ArtifactPath
+}
+
+func TestShardMergeMatchesFullRun(t *testing.T) {
+	dir := t.TempDir()
+	files := writeShardDesign(t, dir)
+	versions := cacheVersions{parser: "p1", extractor: "e1"}
+	artifactDir := filepath.Join(t.TempDir(), "artifacts")
+
+	var artifacts []string
+	for i := 1; i <= 2; i++ {
+		artifacts = append(artifacts, runShardForTest(t, files, dir, artifactDir, Shard{i, 2}, versions))
+	}
+	if again := runShardForTest(t, files, dir, artifactDir, Shard{1, 2}, versions); again != artifacts[0] {
+		t.Fatalf("shard artifact not deterministic: %s vs %s", again, artifacts[0])
+	}
+
+	full := normalizeResult(runIndexerForTest(t, NewWithConfig(defaultTestConfig(files, filepath.Join(dir, ".cache"), false)), dir))
+
+	var count int32
+	idx := NewWithConfig(defaultTestConfig(files, filepath.Join(dir, ".cache"), false))
+	idx.cacheVersionOverride = &versions
+	idx.Artifacts = artifacts
+	idx.extractorFactory = func() FactsExtractor {
+		return &countingExtractor{inner: extractor.New(), count: &count}
+	}
+	merged := normalizeResult(runIndexerForTest(t, idx, dir))
+	if got := atomic.LoadInt32(&count); got != 0 {
+		t.Fatalf("merge extracted %d files, want 0", got)
+	}
+	if merged.Summary != full.Summary || merged.Stats != full.Stats {
+		t.Fatalf("merge differs from full run: merged=%+v/%+v full=%+v/%+v", merged.Summary, merged.Stats, full.Summary, full.Stats)
+	}
+	for _, facts := range idx.Facts {
+		for _, c := range facts.CDCCrossings {
+			if c.File != facts.File {
+				t.Fatalf("crossing in %s has file %q", facts.File, c.File)
+			}
+		}
+	}
+}
+
+func TestMergeExtractsChangedAndUncoveredFiles(t *testing.T) {
+	dir := t.TempDir()
+	files := writeShardDesign(t, dir)
+	versions := cacheVersions{parser: "p1", extractor: "e1"}
+	artifact := runShardForTest(t, files[:3], dir, t.TempDir(), Shard{1, 1}, versions)
+
+	// a.vhd changed since the shard ran; c.vhd was never in it
+	writeVHDL(t, dir, "a.vhd", "entity a is end entity; architecture rtl of a is begin end architecture;")
+
+	var count int32
+	idx := NewWithConfig(defaultTestConfig(files, filepath.Join(dir, ".cache"), false))
+	idx.cacheVersionOverride = &versions
+	idx.Artifacts = []string{artifact}
+	idx.extractorFactory = func() FactsExtractor {
+		return &countingExtractor{inner: extractor.New(), count: &count}
+	}
+	runIndexerForTest(t, idx, dir)
+	if got := atomic.LoadInt32(&count); got != 2 {
+		t.Fatalf("merge extracted %d files, want 2", got)
+	}
+}
+
+func TestMergeAtAnotherRootRelocatesPaths(t *testing.T) {
+	versions := cacheVersions{parser: "p1", extractor: "e1"}
+	shardDir := t.TempDir()
+	artifact := runShardForTest(t, writeShardDesign(t, shardDir), shardDir, t.TempDir(), Shard{1, 1}, versions)
+
+	// The merge node's checkout lives elsewhere
+	dir := t.TempDir()
+	files := writeShardDesign(t, dir)
+	full := normalizeResult(runIndexerForTest(t, NewWithConfig(defaultTestConfig(files, filepath.Join(dir, ".cache"), false)), dir))
+
+	var count int32
+	idx := NewWithConfig(defaultTestConfig(files, filepath.Join(dir, ".cache"), false))
+	idx.cacheVersionOverride = &versions
+	idx.Artifacts = []string{artifact}
+	idx.extractorFactory = func() FactsExtractor {
+		return &countingExtractor{inner: extractor.New(), count: &count}
+	}
+	merged := normalizeResult(runIndexerForTest(t, idx, dir))
+	if got := atomic.LoadInt32(&count); got != 0 {
+		t.Fatalf("merge extracted %d files, want 0", got)
+	}
+	deps := 0
+	for _, facts := range idx.Facts {
+		for _, d := range facts.Dependencies {
+			deps++
+			if d.Source != facts.File {
+				t.Fatalf("dependency %s of %s has source %q", d.Target, facts.File, d.Source)
+			}
+		}
+	}
+	if deps == 0 {
+		t.Fatal("expected dependencies in the merged facts")
+	}
+	if merged.Summary != full.Summary || merged.Stats != full.Stats {
+		t.Fatalf("merge at another root differs from full run: merged=%+v/%+v full=%+v/%+v", merged.Summary, merged.Stats, full.Summary, full.Stats)
+	}
+}
+
+func TestMergeRejectsOtherVersions(t *testing.T) {
+	dir := t.TempDir()
+	files := writeShardDesign(t, dir)
+	artifact := runShardForTest(t, files, dir, t.TempDir(), Shard{1, 1}, cacheVersions{parser: "p1", extractor: "e1"})
+
+	idx := NewWithConfig(defaultTestConfig(files, filepath.Join(dir, ".cache"), false))
+	idx.cacheVersionOverride = &cacheVersions{parser: "p1", extractor: "e2"}
+	idx.Artifacts = []string{artifact}
+	idx.JSONOutput = true
+	idx.Output = &bytes.Buffer{}
+	if err := idx.Run(dir); err == nil {
+		t.Fatal("expected merge of an artifact from another extractor version to fail")
+	}
+}
+
+func TestMergeRejectsUnknownVersions(t *testing.T) {
+	dir := t.TempDir()
+	files := writeShardDesign(t, dir)
+	unknown := cacheVersions{parser: "unknown", extractor: "unknown+skip_translate_off"}
+	artifact := runShardForTest(t, files, dir, t.TempDir(), Shard{1, 1}, unknown)
+
+	idx := NewWithConfig(defaultTestConfig(files, filepath.Join(dir, ".cache"), false))
+	idx.cacheVersionOverride = &unknown
+	idx.Artifacts = []string{artifact}
+	idx.JSONOutput = true
+	idx.Output = &bytes.Buffer{}
+	if err := idx.Run(dir); err == nil {
+		t.Fatal("expected merge of an artifact with unknown versions to fail")
+	}
+}
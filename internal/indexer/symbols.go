@@ -0,0 +1,112 @@
+package indexer
+
+import "sync"
+
+// symbolShards splits the table so concurrent extraction workers registering
+// symbols rarely contend on the same lock.
+const symbolShards = 64
+
+// SymbolTable holds all exported symbols across files
+type SymbolTable struct {
+	shards [symbolShards]symbolShard
+}
+
+type symbolShard struct {
+	mu      sync.RWMutex
+	symbols map[string]Symbol
+	// suffixes holds every dotted suffix of the names hashed to other
+	// shards as well ("work.pkg.t" adds "pkg.t" and "t"), so HasSuffix is
+	// one lookup instead of a scan
+	suffixes map[string]struct{}
+}
+
+// NewSymbolTable returns an empty symbol table.
+func NewSymbolTable() *SymbolTable {
+	st := &SymbolTable{}
+	for i := range st.shards {
+		st.shards[i].symbols = make(map[string]Symbol)
+		st.shards[i].suffixes = make(map[string]struct{})
+	}
+	return st
+}
+
+// shard picks a shard by FNV-1a of key.
+func (st *SymbolTable) shard(key string) *symbolShard {
+	h := uint32(2166136261)
+	for i := 0; i < len(key); i++ {
+		h ^= uint32(key[i])
+		h *= 16777619
+	}
+	return &st.shards[h%symbolShards]
+}
+
+func (st *SymbolTable) Add(sym Symbol) {
+	s := st.shard(sym.Name)
+	s.mu.Lock()
+	_, existed := s.symbols[sym.Name]
+	s.symbols[sym.Name] = sym
+	s.mu.Unlock()
+	if existed {
+		return
+	}
+	for i := 0; i < len(sym.Name); i++ {
+		if sym.Name[i] != '.' {
+			continue
+		}
+		suffix := sym.Name[i+1:]
+		ss := st.shard(suffix)
+		ss.mu.Lock()
+		ss.suffixes[suffix] = struct{}{}
+		ss.mu.Unlock()
+	}
+}
+
+func (st *SymbolTable) Has(name string) bool {
+	s := st.shard(name)
+	s.mu.RLock()
+	defer s.mu.RUnlock()
+	_, ok := s.symbols[name]
+	return ok
+}
+
+// HasSuffix reports whether any symbol name ends with "." + base.
+func (st *SymbolTable) HasSuffix(base string) bool {
+	s := st.shard(base)
+	s.mu.RLock()
+	defer s.mu.RUnlock()
+	_, ok := s.suffixes[base]
+	return ok
+}
+
+func (st *SymbolTable) Get(name string) (Symbol, bool) {
+	s := st.shard(name)
+	s.mu.RLock()
+	defer s.mu.RUnlock()
+	sym, ok := s.symbols[name]
+	return sym, ok
+}
+
+func (st *SymbolTable) All() map[string]Symbol {
+	// Return a copy
+	result := make(map[string]Symbol, st.Len())
+	for i := range st.shards {
+		s := &st.shards[i]
+		s.mu.RLock()
+		for k, v := range s.symbols {
+			result[k] = v
+		}
+		s.mu.RUnlock()
+	}
+	return result
+}
+
+func (st *SymbolTable) Len() int {
+	n := 0
+	for i := range st.shards {
+		s := &st.shards[i]
+		s.mu.RLock()
+		n += len(s.symbols)
+		s.mu.RUnlock()
+	}
+	return n
+}
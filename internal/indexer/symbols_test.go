@@ -0,0 +1,44 @@
+package indexer
+
+import (
+	"strings"
+	"sync"
+	"testing"
+)
+
+func TestSymbolTableHasSuffixMatchesScan(t *testing.T) {
+	names := []string{"work.top", "work.pkg.state_t", "lib.core", "work.pkg.core"}
+	st := NewSymbolTable()
+	var wg sync.WaitGroup
+	for _, name := range names {
+		for i := 0; i < 4; i++ {
+			wg.Add(1)
+			go func(name string) {
+				defer wg.Done()
+				st.Add(Symbol{Name: name, Kind: "entity"})
+			}(name)
+		}
+	}
+	wg.Wait()
+
+	if st.Len() != len(names) {
+		t.Fatalf("expected %d symbols, got %d", len(names), st.Len())
+	}
+	for _, base := range []string{"top", "state_t", "pkg.state_t", "core", "t", "work", "kg.state_t", ""} {
+		want := false
+		for _, name := range names {
+			if strings.HasSuffix(name, "."+base) {
+				want = true
+			}
+		}
+		if got := st.HasSuffix(base); got != want {
+			t.Fatalf("HasSuffix(%q) = %v, want %v", base, got, want)
+		}
+	}
+	if _, ok := st.Get("work.pkg.core"); !ok {
+		t.Fatalf("expected work.pkg.core to be present")
+	}
+	if got := len(st.All()); got != len(names) {
+		t.Fatalf("expected All to copy %d symbols, got %d", len(names), got)
+	}
+}
@@ -2,24 +2,49 @@ package indexer
 
 import (
 	"encoding/json"
+	"fmt"
 	"os"
 	"path/filepath"
+	"sort"
+	"strings"
 	"sync"
 	"time"
+
+	"github.com/robert-at-pretension-io/vhdl-lint/internal/extractor"
+	"github.com/robert-at-pretension-io/vhdl-lint/internal/policy"
 )
 
+// Timing events nest by time: "file" events (one per extracted file) fall
+// inside the extract stage, "rule" events (one per policy rule family or
+// daemon step, as reported by the Rust side) inside the policy stage.
 type timingEvent struct {
 	Phase      string  `json:"phase"`
 	Kind       string  `json:"kind"`
 	File       string  `json:"file,omitempty"`
+	Name       string  `json:"name,omitempty"` // rule family or daemon step (kind "rule")
 	Status     string  `json:"status,omitempty"`
+	Thread     int     `json:"thread,omitempty"` // extraction worker or policy thread
+	Count      int     `json:"count,omitempty"`  // violations (kind "rule")
+	Nodes      int     `json:"nodes,omitempty"`  // syntax nodes (kind "file")
+	Errors     int     `json:"errors,omitempty"` // ERROR and MISSING nodes (kind "file")
+	Walked     int     `json:"walked,omitempty"` // nodes the fact walker entered (kind "file")
+	Matches    int     `json:"query_matches,omitempty"`
+	ParseMS    float64 `json:"parse_ms,omitempty"`
 	StartMS    float64 `json:"start_ms"`
 	DurationMS float64 `json:"duration_ms"`
 	EndMS      float64 `json:"end_ms"`
 }
 
+// Timing output formats (Indexer.TimingFormat, VHDL_TIMING_FORMAT)
+const (
+	timingFormatJSONL  = "jsonl"  // one timingEvent per line, written as recorded
+	timingFormatChrome = "chrome" // Chrome trace events (chrome://tracing, Perfetto)
+	timingFormatPprof  = "pprof"  // gzipped profile.proto for go tool pprof
+)
+
 type timingRecorder struct {
 	enabled bool
+	format  string
 	start   time.Time
 	mu      sync.Mutex
 	events  []timingEvent
@@ -28,11 +53,17 @@ type timingRecorder struct {
 	err     error
 }
 
-func newTimingRecorder(start time.Time, path string) *timingRecorder {
-	tr := &timingRecorder{start: start}
+func newTimingRecorder(start time.Time, path, format string) *timingRecorder {
+	tr := &timingRecorder{start: start, format: format}
 	if path == "" {
 		return tr
 	}
+	switch format {
+	case timingFormatJSONL, timingFormatChrome, timingFormatPprof:
+	default:
+		tr.err = fmt.Errorf("unknown timing format %q (want jsonl, chrome or pprof)", format)
+		return tr
+	}
 	f, err := os.Create(path)
 	if err != nil {
 		tr.err = err
@@ -40,7 +71,9 @@ func newTimingRecorder(start time.Time, path string) *timingRecorder {
 	}
 	tr.enabled = true
 	tr.file = f
-	tr.enc = json.NewEncoder(f)
+	if format == timingFormatJSONL {
+		tr.enc = json.NewEncoder(f)
+	}
 	return tr
 }
 
@@ -55,28 +88,40 @@ func (tr *timingRecorder) Err() error {
 	return tr.err
 }
 
-func (tr *timingRecorder) Close() {
+// Close writes the chrome and pprof exports, which need every event, and
+// closes the output. Safe to call more than once.
+func (tr *timingRecorder) Close() error {
 	if tr == nil || tr.file == nil {
-		return
+		return nil
+	}
+	f := tr.file
+	tr.file = nil
+	tr.mu.Lock()
+	events := tr.events
+	tr.mu.Unlock()
+	var err error
+	switch tr.format {
+	case timingFormatChrome:
+		err = writeChromeTrace(f, events)
+	case timingFormatPprof:
+		err = writePprof(f, events, tr.start)
+	}
+	if cerr := f.Close(); err == nil {
+		err = cerr
 	}
-	_ = tr.file.Close()
+	if err != nil {
+		return fmt.Errorf("write %s timing: %w", tr.format, err)
+	}
+	return nil
 }
 
-func (tr *timingRecorder) record(phase, kind, file, status string, start time.Time, duration time.Duration) {
+func (tr *timingRecorder) record(event timingEvent, start time.Time, duration time.Duration) {
 	if tr == nil || !tr.enabled {
 		return
 	}
-	startMS := durationToMS(start.Sub(tr.start))
-	durationMS := durationToMS(duration)
-	event := timingEvent{
-		Phase:      phase,
-		Kind:       kind,
-		File:       file,
-		Status:     status,
-		StartMS:    startMS,
-		DurationMS: durationMS,
-		EndMS:      startMS + durationMS,
-	}
+	event.StartMS = durationToMS(start.Sub(tr.start))
+	event.DurationMS = durationToMS(duration)
+	event.EndMS = event.StartMS + event.DurationMS
 	tr.mu.Lock()
 	tr.events = append(tr.events, event)
 	if tr.enc != nil {
@@ -86,38 +131,149 @@ func (tr *timingRecorder) record(phase, kind, file, status string, start time.Ti
 }
 
 func (tr *timingRecorder) RecordStage(phase string, start time.Time, duration time.Duration, status string) {
-	tr.record(phase, "stage", "", status, start, duration)
+	tr.record(timingEvent{Phase: phase, Kind: "stage", Status: status}, start, duration)
 }
 
-func (tr *timingRecorder) RecordFile(phase, file, status string, start time.Time, duration time.Duration) {
-	tr.record(phase, "file", file, status, start, duration)
+// RecordFile records one file of a stage, run on the given worker, with the
+// parse stats of its facts (zero when they were not collected).
+func (tr *timingRecorder) RecordFile(phase, file, status string, worker int, parse extractor.ParseStats, start time.Time, duration time.Duration) {
+	tr.record(timingEvent{
+		Phase:   phase,
+		Kind:    "file",
+		File:    file,
+		Status:  status,
+		Thread:  worker,
+		Nodes:   parse.Nodes,
+		Errors:  parse.Errors,
+		Walked:  parse.Walked,
+		Matches: parse.QueryMatches,
+		ParseMS: parse.ParseMS,
+	}, start, duration)
+}
+
+// RecordRules records the spans the policy engine reported for a call that
+// ended at end. Span offsets are relative to the engine's own clock, so they
+// are placed to finish with the call (process start-up and input decoding
+// happen before them).
+func (tr *timingRecorder) RecordRules(phase string, end time.Time, spans []policy.Timing) {
+	if !tr.Enabled() || len(spans) == 0 {
+		return
+	}
+	var last float64
+	for _, s := range spans {
+		last = max(last, s.StartMS+s.DurationMS)
+	}
+	origin := end.Add(-msToDuration(last))
+	for _, s := range spans {
+		tr.record(timingEvent{
+			Phase:  phase,
+			Kind:   "rule",
+			Name:   s.Name,
+			Thread: s.Thread,
+			Count:  s.Count,
+		}, origin.Add(msToDuration(s.StartMS)), msToDuration(s.DurationMS))
+	}
+}
+
+// Slowest returns the n longest events of kind, longest first.
+func (tr *timingRecorder) Slowest(kind string, n int) []timingEvent {
+	if tr == nil {
+		return nil
+	}
+	tr.mu.Lock()
+	var out []timingEvent
+	for _, ev := range tr.events {
+		if ev.Kind == kind {
+			out = append(out, ev)
+		}
+	}
+	tr.mu.Unlock()
+	sort.SliceStable(out, func(i, j int) bool { return out[i].DurationMS > out[j].DurationMS })
+	if len(out) > n {
+		out = out[:n]
+	}
+	return out
+}
+
+// slowestShown is how many files and rules the verbose timing summary lists.
+const slowestShown = 5
+
+// printSlowest lists events under title, when there are any.
+func printSlowest(title string, events []timingEvent) {
+	if len(events) == 0 {
+		return
+	}
+	fmt.Printf("\n=== %s ===\n", title)
+	for _, ev := range events {
+		switch ev.Kind {
+		case "file":
+			detail := ev.Status
+			if ev.Nodes > 0 {
+				detail = fmt.Sprintf("%s, %d nodes, %d errors, parse %s, %d walked", ev.Status, ev.Nodes, ev.Errors, formatDuration(msToDuration(ev.ParseMS)), ev.Walked)
+				if ev.Matches > 0 {
+					detail += fmt.Sprintf(", %d query matches", ev.Matches)
+				}
+			}
+			fmt.Printf("  %-10s %s (%s)\n", formatDuration(msToDuration(ev.DurationMS)), ev.File, detail)
+		default:
+			fmt.Printf("  %-10s %s (%d violations)\n", formatDuration(msToDuration(ev.DurationMS)), ev.Name, ev.Count)
+		}
+	}
 }
 
 func durationToMS(d time.Duration) float64 {
 	return float64(d.Nanoseconds()) / 1_000_000.0
 }
 
-func (idx *Indexer) resolveTimingPath(rootPath string) string {
+func msToDuration(ms float64) time.Duration {
+	return time.Duration(ms * float64(time.Millisecond))
+}
+
+// resolveTimingFormat is VHDL_TIMING_FORMAT, else Indexer.TimingFormat, else
+// jsonl.
+func (idx *Indexer) resolveTimingFormat() string {
+	if env := strings.ToLower(strings.TrimSpace(os.Getenv("VHDL_TIMING_FORMAT"))); env != "" {
+		return env
+	}
+	if idx != nil && idx.TimingFormat != "" {
+		return idx.TimingFormat
+	}
+	return timingFormatJSONL
+}
+
+// defaultTimingFile names the timing output in the root when no path is set.
+func defaultTimingFile(format string) string {
+	switch format {
+	case timingFormatChrome:
+		return "timing.trace.json"
+	case timingFormatPprof:
+		return "timing.pb.gz"
+	}
+	return "timing.jsonl"
+}
+
+func (idx *Indexer) resolveTimingPath(rootPath, format string) string {
 	if idx == nil {
 		return ""
 	}
 	if envPath := os.Getenv("VHDL_TIMING_JSONL"); envPath != "" {
 		return envPath
 	}
+	name := defaultTimingFile(format)
 	if idx.Timing {
 		if idx.TimingPath != "" {
 			return idx.TimingPath
 		}
 		if rootPath == "" {
-			return "timing.jsonl"
+			return name
 		}
-		return filepath.Join(rootPath, "timing.jsonl")
+		return filepath.Join(rootPath, name)
 	}
 	if envBool("VHDL_TIMING") {
 		if rootPath == "" {
-			return "timing.jsonl"
+			return name
 		}
-		return filepath.Join(rootPath, "timing.jsonl")
+		return filepath.Join(rootPath, name)
 	}
 	return ""
 }
@@ -2,12 +2,17 @@ package indexer
 
 import (
 	"bytes"
+	"compress/gzip"
+	"encoding/binary"
 	"encoding/json"
+	"io"
 	"os"
 	"path/filepath"
 	"testing"
+	"time"
 
 	"github.com/robert-at-pretension-io/vhdl-lint/internal/extractor"
+	"github.com/robert-at-pretension-io/vhdl-lint/internal/policy"
 )
 
 func TestTimingJSONLWritten(t *testing.T) {
@@ -53,3 +58,118 @@ func TestTimingJSONLWritten(t *testing.T) {
 		t.Fatalf("expected scan and total timing events")
 	}
 }
+
+func TestTimingChromeTrace(t *testing.T) {
+	dir := t.TempDir()
+	file := writeVHDL(t, dir, "a.vhd", "entity a is end entity; architecture rtl of a is begin end architecture;")
+	cfg := defaultTestConfig([]string{file}, filepath.Join(dir, ".cache"), false)
+
+	idx := NewWithConfig(cfg)
+	idx.Timing = true
+	idx.TimingFormat = timingFormatChrome
+	idx.JSONOutput = true
+	idx.extractorFactory = func() FactsExtractor { return extractor.New() }
+	runIndexerForTest(t, idx, dir)
+
+	raw, err := os.ReadFile(filepath.Join(dir, "timing.trace.json"))
+	if err != nil {
+		t.Fatalf("read trace: %v", err)
+	}
+	var trace struct {
+		TraceEvents []chromeEvent `json:"traceEvents"`
+	}
+	if err := json.Unmarshal(raw, &trace); err != nil {
+		t.Fatalf("parse trace: %v", err)
+	}
+	var stage, fileSpan bool
+	for _, ev := range trace.TraceEvents {
+		stage = stage || (ev.Ph == "X" && ev.Cat == "stage" && ev.Name == "extract")
+		fileSpan = fileSpan || (ev.Ph == "X" && ev.Cat == "file" && ev.Name == "a.vhd" && ev.TID >= chromeFileTID)
+	}
+	if !stage || !fileSpan {
+		t.Fatalf("trace lacks the extract stage or the file span: %s", raw)
+	}
+}
+
+func TestTimingPprof(t *testing.T) {
+	dir := t.TempDir()
+	path := filepath.Join(dir, "timing.pb.gz")
+	start := time.Now()
+	tr := newTimingRecorder(start, path, timingFormatPprof)
+	tr.RecordFile("extract", "vendor/a.vhd", "extracted", 0, extractor.ParseStats{Nodes: 40, Errors: 2}, start, 3*time.Millisecond)
+	tr.RecordStage("extract", start, 4*time.Millisecond, "")
+	tr.RecordRules("policy", start.Add(10*time.Millisecond), []policy.Timing{{Name: "core", DurationMS: 2, Count: 1}})
+	if err := tr.Close(); err != nil {
+		t.Fatalf("close: %v", err)
+	}
+
+	f, err := os.Open(path)
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer f.Close()
+	zr, err := gzip.NewReader(f)
+	if err != nil {
+		t.Fatalf("gzip: %v", err)
+	}
+	raw, err := io.ReadAll(zr)
+	if err != nil {
+		t.Fatal(err)
+	}
+	strs := map[string]bool{}
+	samples := 0
+	for len(raw) > 0 {
+		key, n := binary.Uvarint(raw)
+		raw = raw[n:]
+		switch key & 7 {
+		case 0:
+			_, n = binary.Uvarint(raw)
+			raw = raw[n:]
+		case 2:
+			size, n := binary.Uvarint(raw)
+			body := raw[n : n+int(size)]
+			raw = raw[n+int(size):]
+			switch key >> 3 {
+			case 2:
+				samples++
+			case 6:
+				strs[string(body)] = true
+			}
+		default:
+			t.Fatalf("unexpected wire type in %d", key)
+		}
+	}
+	// file, extract self time, rule
+	if samples != 3 {
+		t.Errorf("samples = %d, want 3", samples)
+	}
+	for _, s := range []string{"wall", "errors", "vendor/a.vhd", "vendor/", "extract", "core", "policy"} {
+		if !strs[s] {
+			t.Errorf("string table lacks %q", s)
+		}
+	}
+}
+
+func TestRecordRulesEndWithTheCall(t *testing.T) {
+	start := time.Now()
+	tr := newTimingRecorder(start, filepath.Join(t.TempDir(), "timing.jsonl"), timingFormatJSONL)
+	defer tr.Close()
+	end := start.Add(100 * time.Millisecond)
+	tr.RecordRules("policy", end, []policy.Timing{
+		{Name: "evaluate", StartMS: 0, DurationMS: 30},
+		{Name: "core", StartMS: 5, DurationMS: 20, Thread: 2, Count: 3},
+	})
+	rules := tr.Slowest("rule", 5)
+	if len(rules) != 2 || rules[0].Name != "evaluate" || rules[1].Name != "core" {
+		t.Fatalf("rules = %+v", rules)
+	}
+	if got := rules[0].EndMS; got < 99.9 || got > 100.1 {
+		t.Errorf("evaluate ends at %.3fms, want 100ms", got)
+	}
+	if got := rules[1].StartMS; got < 74.9 || got > 75.1 {
+		t.Errorf("core starts at %.3fms, want 75ms", got)
+	}
+	if rules[1].Thread != 2 || rules[1].Count != 3 {
+		t.Errorf("core = %+v", rules[1])
+	}
+}
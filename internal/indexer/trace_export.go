@@ -0,0 +1,251 @@
+package indexer
+
+import (
+	"compress/gzip"
+	"encoding/binary"
+	"encoding/json"
+	"io"
+	"path/filepath"
+	"strconv"
+	"time"
+)
+
+// =============================================================================
+// TIMING EXPORTS
+// =============================================================================
+//
+// chrome: the trace-event JSON read by chrome://tracing and ui.perfetto.dev.
+// Stages are one track, each extraction worker and each policy thread gets
+// its own, so file and rule spans nest under the stage they ran in.
+//
+// pprof: a profile.proto (gzipped, as go tool pprof expects) with one sample
+// per file and per rule span, stacked under directory and stage:
+//
+//	go tool pprof -top timing.pb.gz                    # slowest files/rules
+//	go tool pprof -top -sample_index=errors timing.pb.gz
+//
+// Values are wall time per item, so items that ran in parallel add up to
+// more than their stage. A stage also gets a sample for whatever time its
+// items do not account for.
+// =============================================================================
+
+// Chrome trace tracks for items: worker/thread n is tid base+n.
+const (
+	chromeStageTID  = 1
+	chromeFileTID   = 100
+	chromeRuleTID   = 1000
+	chromeProcessID = 1
+)
+
+type chromeEvent struct {
+	Name string         `json:"name"`
+	Cat  string         `json:"cat,omitempty"`
+	Ph   string         `json:"ph"`
+	PID  int            `json:"pid"`
+	TID  int            `json:"tid"`
+	TS   float64        `json:"ts"`
+	Dur  float64        `json:"dur,omitempty"`
+	Args map[string]any `json:"args,omitempty"`
+}
+
+func writeChromeTrace(w io.Writer, events []timingEvent) error {
+	trace := []chromeEvent{
+		{Name: "process_name", Ph: "M", PID: chromeProcessID, Args: map[string]any{"name": "vhdl-lint"}},
+	}
+	tracks := make(map[int]bool)
+	track := func(tid int, name string) int {
+		if !tracks[tid] {
+			tracks[tid] = true
+			trace = append(trace, chromeEvent{Name: "thread_name", Ph: "M", PID: chromeProcessID, TID: tid, Args: map[string]any{"name": name}})
+		}
+		return tid
+	}
+	for _, ev := range events {
+		name := ev.Phase
+		args := map[string]any{}
+		var tid int
+		switch ev.Kind {
+		case "file":
+			name = filepath.Base(ev.File)
+			tid = track(chromeFileTID+ev.Thread, "extract worker "+strconv.Itoa(ev.Thread))
+			args["file"] = ev.File
+			if ev.Nodes > 0 {
+				args["nodes"] = ev.Nodes
+				args["errors"] = ev.Errors
+				args["parse_ms"] = ev.ParseMS
+				args["walked"] = ev.Walked
+				args["query_matches"] = ev.Matches
+			}
+		case "rule":
+			name = ev.Name
+			tid = track(chromeRuleTID+ev.Thread, "policy thread "+strconv.Itoa(ev.Thread))
+			args["violations"] = ev.Count
+		default:
+			tid = track(chromeStageTID, "pipeline")
+		}
+		if ev.Status != "" {
+			args["status"] = ev.Status
+		}
+		trace = append(trace, chromeEvent{
+			Name: name,
+			Cat:  ev.Kind,
+			Ph:   "X",
+			PID:  chromeProcessID,
+			TID:  tid,
+			TS:   ev.StartMS * 1000,
+			Dur:  ev.DurationMS * 1000,
+			Args: args,
+		})
+	}
+	enc := json.NewEncoder(w)
+	return enc.Encode(struct {
+		TraceEvents     []chromeEvent `json:"traceEvents"`
+		DisplayTimeUnit string        `json:"displayTimeUnit"`
+	}{trace, "ms"})
+}
+
+// pprofBuilder assembles a profile.proto message by hand; the format is
+// small and stable (github.com/google/pprof/proto/profile.proto) and not
+// worth a dependency.
+type pprofBuilder struct {
+	strings   map[string]int64
+	table     []string
+	functions map[string]uint64 // also the location id: one line each
+	funcBuf   []byte
+	locBuf    []byte
+	samples   []byte
+}
+
+func newPprofBuilder() *pprofBuilder {
+	return &pprofBuilder{strings: map[string]int64{"": 0}, table: []string{""}, functions: map[string]uint64{}}
+}
+
+func (b *pprofBuilder) str(s string) int64 {
+	if id, ok := b.strings[s]; ok {
+		return id
+	}
+	id := int64(len(b.table))
+	b.strings[s] = id
+	b.table = append(b.table, s)
+	return id
+}
+
+// location returns the location id for a frame named name in file.
+func (b *pprofBuilder) location(name, file string) uint64 {
+	key := name + "\x00" + file
+	if id, ok := b.functions[key]; ok {
+		return id
+	}
+	id := uint64(len(b.functions) + 1)
+	b.functions[key] = id
+
+	var fn []byte
+	fn = pbUint(fn, 1, id)
+	fn = pbInt(fn, 2, b.str(name))
+	fn = pbInt(fn, 3, b.str(name))
+	fn = pbInt(fn, 4, b.str(file))
+	b.funcBuf = pbBytes(b.funcBuf, 5, fn)
+
+	var line []byte
+	line = pbUint(line, 1, id)
+	var loc []byte
+	loc = pbUint(loc, 1, id)
+	loc = pbBytes(loc, 4, line)
+	b.locBuf = pbBytes(b.locBuf, 4, loc)
+	return id
+}
+
+// sample adds values for a stack given leaf first.
+func (b *pprofBuilder) sample(stack []uint64, values ...int64) {
+	var ids, vals []byte
+	for _, id := range stack {
+		ids = binary.AppendUvarint(ids, id)
+	}
+	for _, v := range values {
+		vals = binary.AppendUvarint(vals, uint64(v))
+	}
+	var s []byte
+	s = pbBytes(s, 1, ids)
+	s = pbBytes(s, 2, vals)
+	b.samples = pbBytes(b.samples, 2, s)
+}
+
+func writePprof(w io.Writer, events []timingEvent, start time.Time) error {
+	b := newPprofBuilder()
+	sampleTypes := [][2]string{{"wall", "nanoseconds"}, {"nodes", "count"}, {"errors", "count"}}
+
+	// Time the items of each stage account for
+	itemNS := make(map[string]int64)
+	var totalNS int64
+	for _, ev := range events {
+		ns := int64(ev.DurationMS * 1e6)
+		switch ev.Kind {
+		case "file":
+			stage := b.location(ev.Phase, "")
+			dir := b.location(filepath.Dir(ev.File)+string(filepath.Separator), "")
+			file := b.location(ev.File, ev.File)
+			b.sample([]uint64{file, dir, stage}, ns, int64(ev.Nodes), int64(ev.Errors))
+			itemNS[ev.Phase] += ns
+		case "rule":
+			stage := b.location(ev.Phase, "")
+			rule := b.location(ev.Name, "")
+			b.sample([]uint64{rule, stage}, ns, 0, 0)
+			itemNS[ev.Phase] += ns
+		}
+	}
+	for _, ev := range events {
+		if ev.Kind != "stage" {
+			continue
+		}
+		ns := int64(ev.DurationMS * 1e6)
+		if ev.Phase == "total" {
+			totalNS = ns
+			continue
+		}
+		if self := ns - itemNS[ev.Phase]; self > 0 {
+			b.sample([]uint64{b.location(ev.Phase, "")}, self, 0, 0)
+		}
+	}
+
+	var p []byte
+	for _, st := range sampleTypes {
+		var vt []byte
+		vt = pbInt(vt, 1, b.str(st[0]))
+		vt = pbInt(vt, 2, b.str(st[1]))
+		p = pbBytes(p, 1, vt)
+	}
+	defaultType := b.str("wall")
+	p = append(p, b.samples...)
+	p = append(p, b.locBuf...)
+	p = append(p, b.funcBuf...)
+	for _, s := range b.table {
+		p = pbBytes(p, 6, []byte(s))
+	}
+	p = pbInt(p, 9, start.UnixNano())
+	p = pbInt(p, 10, totalNS)
+	p = pbInt(p, 14, defaultType)
+
+	zw := gzip.NewWriter(w)
+	if _, err := zw.Write(p); err != nil {
+		return err
+	}
+	return zw.Close()
+}
+
+// Protocol buffer wire encoding: varint fields (wire type 0) and
+// length-delimited fields (wire type 2).
+
+func pbUint(b []byte, field int, v uint64) []byte {
+	b = binary.AppendUvarint(b, uint64(field)<<3)
+	return binary.AppendUvarint(b, v)
+}
+
+func pbInt(b []byte, field int, v int64) []byte {
+	return pbUint(b, field, uint64(v))
+}
+
+func pbBytes(b []byte, field int, v []byte) []byte {
+	b = binary.AppendUvarint(b, uint64(field)<<3|2)
+	b = binary.AppendUvarint(b, uint64(len(v)))
+	return append(b, v...)
+}
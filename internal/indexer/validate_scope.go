@@ -0,0 +1,64 @@
+package indexer
+
+import (
+	"reflect"
+
+	"github.com/robert-at-pretension-io/vhdl-lint/internal/policy"
+	"github.com/robert-at-pretension-io/vhdl-lint/internal/validator"
+)
+
+// Fast validation (VHDL_FAST_VALIDATE=1):
+//   - fact tables are checked by validator.FactsValidator.ValidateFast, the
+//     typed Go mirror of facts_schema.cue (CUE still reports any failure)
+//   - after an incremental run, the policy input is validated only for the
+//     rows of the changed files, when the previous policy result was
+//     produced by a run over the same files, configuration and schema.cue
+//     that validated everything else (ValidatedAll; a cone run validates
+//     only its scope and does not count).
+//
+// Rows of unchanged files are not rechecked even if cross-file resolution
+// changed one of their values; a run without changes, or without the
+// toggle, still validates the whole input.
+
+// changedValidationInput returns the part of input to validate after an
+// incremental run, or false when everything must be validated.
+func changedValidationInput(cacheDir string, input policy.Input, factFiles []string, changed map[string]bool) (policy.Input, bool) {
+	if len(changed) == 0 {
+		return input, false
+	}
+	entry, err := loadPolicyCache(cacheDir)
+	if err != nil || entry == nil || !entry.ValidatedAll || entry.SchemaHash != validator.InputSchemaHash() {
+		return input, false
+	}
+	if ok, err := policyCacheValid(entry, input, factFiles); err != nil || !ok {
+		return input, false
+	}
+	return filterInputByFiles(input, changed), true
+}
+
+// filterInputByFiles keeps the rows of files in every list whose rows carry a
+// File; other lists (and scalars) are kept whole. Lists stay non-nil, as the
+// CUE contract requires.
+func filterInputByFiles(input policy.Input, files map[string]bool) policy.Input {
+	out := input
+	v := reflect.ValueOf(&out).Elem()
+	for i := 0; i < v.NumField(); i++ {
+		field := v.Field(i)
+		if field.Kind() != reflect.Slice || field.Type().Elem().Kind() != reflect.Struct {
+			continue
+		}
+		fileField, ok := field.Type().Elem().FieldByName("File")
+		if !ok || fileField.Type.Kind() != reflect.String {
+			continue
+		}
+		kept := reflect.MakeSlice(field.Type(), 0, 0)
+		for j := 0; j < field.Len(); j++ {
+			row := field.Index(j)
+			if files[row.FieldByIndex(fileField.Index).String()] {
+				kept = reflect.Append(kept, row)
+			}
+		}
+		field.Set(kept)
+	}
+	return out
+}
@@ -0,0 +1,84 @@
+package indexer
+
+import (
+	"reflect"
+	"testing"
+
+	"github.com/robert-at-pretension-io/vhdl-lint/internal/policy"
+	"github.com/robert-at-pretension-io/vhdl-lint/internal/validator"
+)
+
+func TestFilterInputByFiles(t *testing.T) {
+	input := policy.Input{
+		Standard:  "2008",
+		FileCount: 2,
+		Entities: []policy.Entity{
+			{Name: "a", File: "a.vhd", Line: 1},
+			{Name: "b", File: "b.vhd", Line: 1},
+		},
+		Signals: []policy.Signal{{Name: "s", File: "a.vhd", Line: 4}},
+		Files: []policy.FileInfo{
+			{Path: "a.vhd", Library: "work"},
+			{Path: "b.vhd", Library: "work"},
+		},
+		Constants: []string{"W"},
+	}
+
+	got := filterInputByFiles(input, map[string]bool{"b.vhd": true})
+	if want := []policy.Entity{{Name: "b", File: "b.vhd", Line: 1}}; !reflect.DeepEqual(got.Entities, want) {
+		t.Fatalf("entities = %#v, want %#v", got.Entities, want)
+	}
+	if got.Signals == nil || len(got.Signals) != 0 {
+		t.Fatalf("signals = %#v, want an empty non-nil list", got.Signals)
+	}
+	// Lists without a File column and scalars are kept whole
+	if !reflect.DeepEqual(got.Files, input.Files) || !reflect.DeepEqual(got.Constants, input.Constants) {
+		t.Fatalf("files/constants changed: %#v, %#v", got.Files, got.Constants)
+	}
+	if got.Standard != "2008" || got.FileCount != 2 {
+		t.Fatalf("scalars changed: %q, %d", got.Standard, got.FileCount)
+	}
+	if len(input.Entities) != 2 {
+		t.Fatalf("input was modified: %#v", input.Entities)
+	}
+}
+
+func TestChangedValidationNeedsFullyValidatedEntry(t *testing.T) {
+	input := policy.Input{
+		Standard: "2008",
+		Entities: []policy.Entity{
+			{Name: "a", File: "a.vhd", Line: 1},
+			{Name: "b", File: "b.vhd", Line: 1},
+		},
+	}
+	files := []string{"a.vhd", "b.vhd"}
+	hash, err := policyConfigHash(input)
+	if err != nil {
+		t.Fatalf("policyConfigHash error: %v", err)
+	}
+	changed := map[string]bool{"b.vhd": true}
+
+	for _, validatedAll := range []bool{false, true} {
+		dir := t.TempDir()
+		if err := savePolicyCache(dir, policyCacheEntry{
+			Version:      policyCacheVersion,
+			ConfigHash:   hash,
+			Files:        files,
+			SchemaHash:   validator.InputSchemaHash(),
+			ValidatedAll: validatedAll,
+		}); err != nil {
+			t.Fatalf("savePolicyCache error: %v", err)
+		}
+		got, ok := changedValidationInput(dir, input, files, changed)
+		if ok != validatedAll {
+			t.Fatalf("ValidatedAll=%v: changed-only validation = %v", validatedAll, ok)
+		}
+		want := len(input.Entities)
+		if ok {
+			want = 1
+		}
+		if len(got.Entities) != want {
+			t.Fatalf("ValidatedAll=%v: validating %d entities, want %d", validatedAll, len(got.Entities), want)
+		}
+	}
+}
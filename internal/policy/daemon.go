@@ -19,11 +19,71 @@ import (
 type Daemon struct {
 	cmd            *exec.Cmd
 	stdin          io.WriteCloser
+	writer         *bufio.Writer
 	stdout         *bufio.Reader
+	framed         bool // commands go as frames-v1 (see daemon_frames.go)
 	validator      *validator.PolicyDaemonValidator
 	factsValidator *validator.FactsValidator
 }
 
+// DaemonRules are the rules vhdl_policyd maintains incrementally (its
+// rules() dataflow). Every other family still needs the batch engine: a
+// daemon result is only complete merged with a batch evaluation of
+// WithoutDaemonRules(input), see MergeDaemonResult.
+var DaemonRules = []string{
+	"entity_has_ports",
+	"architecture_has_entity",
+	"entity_without_arch",
+	"unresolved_dependency",
+	"process_label_missing",
+	"unlabeled_generate",
+	"many_signals",
+	"duplicate_signal_in_entity",
+	"duplicate_signal_name",
+	"wide_signal",
+	"many_instances",
+	"repeated_component_instantiation",
+}
+
+// WithoutDaemonRules returns input with DaemonRules switched off, so a
+// batch evaluation of it covers exactly the families the daemon does not.
+func WithoutDaemonRules(input Input) Input {
+	rules := make(map[string]string, len(input.LintConfig.Rules)+len(DaemonRules))
+	for rule, level := range input.LintConfig.Rules {
+		rules[rule] = level
+	}
+	for _, rule := range DaemonRules {
+		rules[rule] = "off"
+	}
+	input.LintConfig.Rules = rules
+	return input
+}
+
+// MergeDaemonResult combines the daemon's violations with batch, an
+// evaluation of WithoutDaemonRules(input). Missing checks and ambiguous
+// constructs come from batch only; the daemon reports none.
+func MergeDaemonResult(daemon, batch *Result) *Result {
+	merged := &Result{
+		Violations:          make([]Violation, 0, len(daemon.Violations)+len(batch.Violations)),
+		MissingChecks:       batch.MissingChecks,
+		AmbiguousConstructs: batch.AmbiguousConstructs,
+	}
+	merged.Violations = append(merged.Violations, daemon.Violations...)
+	merged.Violations = append(merged.Violations, batch.Violations...)
+	merged.Summary.TotalViolations = len(merged.Violations)
+	for _, v := range merged.Violations {
+		switch v.Severity {
+		case "error":
+			merged.Summary.Errors++
+		case "warning":
+			merged.Summary.Warnings++
+		case "info":
+			merged.Summary.Info++
+		}
+	}
+	return merged
+}
+
 type daemonCommand struct {
 	Kind    string       `json:"kind"`
 	Tables  facts.Tables `json:"tables,omitempty"`
@@ -31,16 +91,25 @@ type daemonCommand struct {
 	Removed facts.Tables `json:"removed,omitempty"`
 }
 
+type daemonHello struct {
+	Kind      string   `json:"kind"`
+	Protocols []string `json:"protocols"`
+}
+
 type daemonResponse struct {
 	Kind                string               `json:"kind"`
+	Protocol            string               `json:"protocol,omitempty"`
 	Summary             Summary              `json:"summary"`
 	Violations          []Violation          `json:"violations"`
 	MissingChecks       []MissingCheckTask   `json:"missing_checks,omitempty"`
 	AmbiguousConstructs []AmbiguousConstruct `json:"ambiguous_constructs,omitempty"`
+	Timings             []Timing             `json:"timings,omitempty"`
 	Message             string               `json:"message"`
 }
 
 // NewDaemon starts the vhdl_policyd process and prepares it for commands.
+// The framed binary protocol is used when the daemon supports it;
+// VHDL_POLICYD_PROTOCOL=json forces line-delimited JSON (for debugging).
 func NewDaemon(policyDir string) (*Daemon, error) {
 	bin, err := ensurePolicyDaemonBinary(policyDir)
 	if err != nil {
@@ -71,13 +140,43 @@ func NewDaemon(policyDir string) (*Daemon, error) {
 		return nil, fmt.Errorf("init daemon validator: %w", err)
 	}
 
-	return &Daemon{
+	d := &Daemon{
 		cmd:            cmd,
 		stdin:          stdin,
+		writer:         bufio.NewWriterSize(stdin, 1<<16),
 		stdout:         bufio.NewReader(stdout),
 		validator:      daemonValidator,
 		factsValidator: factsValidator,
-	}, nil
+	}
+	if os.Getenv("VHDL_POLICYD_PROTOCOL") != "json" {
+		if err := d.negotiate(); err != nil {
+			_ = d.Close()
+			return nil, err
+		}
+	}
+	return d, nil
+}
+
+// negotiate offers the framed protocol. Daemons that predate it answer the
+// hello with an error line, which leaves the session on JSON.
+func (d *Daemon) negotiate() error {
+	payload, err := json.Marshal(daemonHello{Kind: "hello", Protocols: []string{daemonFramesProtocol}})
+	if err != nil {
+		return fmt.Errorf("marshal daemon hello: %w", err)
+	}
+	if _, err := d.stdin.Write(append(payload, '\n')); err != nil {
+		return fmt.Errorf("write daemon hello: %w", err)
+	}
+	line, err := d.stdout.ReadString('\n')
+	if err != nil {
+		return fmt.Errorf("read daemon hello: %w", err)
+	}
+	var resp daemonResponse
+	if err := json.Unmarshal(bytes.TrimSpace([]byte(line)), &resp); err != nil {
+		return fmt.Errorf("parse daemon hello: %w", err)
+	}
+	d.framed = resp.Kind == "hello" && resp.Protocol == daemonFramesProtocol
+	return nil
 }
 
 // Init loads a full snapshot into the daemon and returns the current violations.
@@ -133,17 +232,24 @@ func (d *Daemon) send(cmd daemonCommand) (*Result, error) {
 		}
 	}
 
-	payload, err := json.Marshal(cmd)
-	if err != nil {
-		return nil, fmt.Errorf("marshal daemon command: %w", err)
-	}
-	if d.validator != nil {
-		if err := d.validator.ValidateCommandJSON(payload); err != nil {
-			return nil, fmt.Errorf("daemon command schema invalid: %w", err)
+	if d.framed {
+		// Tables were validated above; the frames carry nothing else
+		if err := writeCommandFrames(d.writer, cmd); err != nil {
+			return nil, err
+		}
+	} else {
+		payload, err := json.Marshal(cmd)
+		if err != nil {
+			return nil, fmt.Errorf("marshal daemon command: %w", err)
+		}
+		if d.validator != nil {
+			if err := d.validator.ValidateCommandJSON(payload); err != nil {
+				return nil, fmt.Errorf("daemon command schema invalid: %w", err)
+			}
+		}
+		if _, err := d.stdin.Write(append(payload, '\n')); err != nil {
+			return nil, fmt.Errorf("write daemon command: %w", err)
 		}
-	}
-	if _, err := d.stdin.Write(append(payload, '\n')); err != nil {
-		return nil, fmt.Errorf("write daemon command: %w", err)
 	}
 
 	line, err := d.stdout.ReadString('\n')
@@ -169,6 +275,7 @@ func (d *Daemon) send(cmd daemonCommand) (*Result, error) {
 		Summary:             resp.Summary,
 		MissingChecks:       resp.MissingChecks,
 		AmbiguousConstructs: resp.AmbiguousConstructs,
+		Timings:             resp.Timings,
 	}, nil
 }
 
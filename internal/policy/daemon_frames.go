@@ -0,0 +1,204 @@
+package policy
+
+import (
+	"bufio"
+	"encoding/binary"
+	"fmt"
+
+	"github.com/robert-at-pretension-io/vhdl-lint/internal/facts"
+)
+
+// Framed command protocol for vhdl_policyd ("frames-v1").
+//
+// The client offers it in a JSON hello line at startup; a daemon that
+// answers with the same protocol then reads commands as frames:
+//
+//	frame: u32 LE length of the rest | u8 frame type | body
+//	begin: u8 command (1 init, 2 delta, 3 snapshot)
+//	rows:  u8 sign (0 add, 1 remove) | u8 relation | uvarint count | rows
+//	end:   empty; the daemon evaluates and answers with one JSON line
+//
+// Strings are uvarint length + bytes and ints are zigzag varints. Only the
+// columns vhdl_policyd reads are sent, chunked so neither side ever holds a
+// whole snapshot in one buffer. Responses stay JSON lines. The row layouts
+// must match decode_rows in src/bin/vhdl_policyd.rs.
+const daemonFramesProtocol = "frames-v1"
+
+const (
+	frameBegin byte = 1
+	frameRows  byte = 2
+	frameEnd   byte = 3
+)
+
+const (
+	frameCommandInit     byte = 1
+	frameCommandDelta    byte = 2
+	frameCommandSnapshot byte = 3
+)
+
+const (
+	frameSignAdd    byte = 0
+	frameSignRemove byte = 1
+)
+
+// Relation ids in rows frames
+const (
+	frameRelEntities      byte = 1
+	frameRelArchitectures byte = 2
+	frameRelPorts         byte = 3
+	frameRelDependencies  byte = 4
+	frameRelSymbols       byte = 5
+	frameRelProcesses     byte = 6
+	frameRelSignals       byte = 7
+	frameRelInstances     byte = 8
+	frameRelGenerates     byte = 9
+)
+
+// framesRowsPerChunk bounds one rows frame
+const framesRowsPerChunk = 4096
+
+type frameWriter struct {
+	w   *bufio.Writer
+	buf []byte
+}
+
+// writeCommandFrames streams cmd to w as frames and flushes.
+func writeCommandFrames(w *bufio.Writer, cmd daemonCommand) error {
+	fw := &frameWriter{w: w}
+	var command byte
+	switch cmd.Kind {
+	case "init":
+		command = frameCommandInit
+	case "delta":
+		command = frameCommandDelta
+	case "snapshot":
+		command = frameCommandSnapshot
+	default:
+		return fmt.Errorf("unknown daemon command kind: %s", cmd.Kind)
+	}
+	if err := fw.frame(frameBegin, []byte{command}); err != nil {
+		return err
+	}
+	switch cmd.Kind {
+	case "init":
+		if err := fw.tables(frameSignAdd, cmd.Tables); err != nil {
+			return err
+		}
+	case "delta":
+		if err := fw.tables(frameSignAdd, cmd.Added); err != nil {
+			return err
+		}
+		if err := fw.tables(frameSignRemove, cmd.Removed); err != nil {
+			return err
+		}
+	}
+	if err := fw.frame(frameEnd, nil); err != nil {
+		return err
+	}
+	return w.Flush()
+}
+
+func (fw *frameWriter) frame(kind byte, body []byte) error {
+	var header [5]byte
+	binary.LittleEndian.PutUint32(header[:4], uint32(len(body)+1))
+	header[4] = kind
+	if _, err := fw.w.Write(header[:]); err != nil {
+		return fmt.Errorf("write daemon frame: %w", err)
+	}
+	if _, err := fw.w.Write(body); err != nil {
+		return fmt.Errorf("write daemon frame: %w", err)
+	}
+	return nil
+}
+
+func (fw *frameWriter) tables(sign byte, t facts.Tables) error {
+	if err := writeRows(fw, sign, frameRelEntities, t.Entities, func(b []byte, r *facts.EntityRow) []byte {
+		b = appendFrameString(b, r.Name)
+		b = appendFrameString(b, r.File)
+		return binary.AppendVarint(b, int64(r.Line))
+	}); err != nil {
+		return err
+	}
+	if err := writeRows(fw, sign, frameRelArchitectures, t.Architectures, func(b []byte, r *facts.ArchitectureRow) []byte {
+		b = appendFrameString(b, r.Name)
+		b = appendFrameString(b, r.EntityName)
+		b = appendFrameString(b, r.File)
+		return binary.AppendVarint(b, int64(r.Line))
+	}); err != nil {
+		return err
+	}
+	if err := writeRows(fw, sign, frameRelPorts, t.Ports, func(b []byte, r *facts.PortRow) []byte {
+		b = appendFrameString(b, r.Entity)
+		b = appendFrameString(b, r.Name)
+		b = appendFrameString(b, r.Direction)
+		b = appendFrameString(b, r.File)
+		return binary.AppendVarint(b, int64(r.Line))
+	}); err != nil {
+		return err
+	}
+	if err := writeRows(fw, sign, frameRelDependencies, t.Dependencies, func(b []byte, r *facts.DependencyRow) []byte {
+		b = appendFrameString(b, r.File)
+		b = appendFrameString(b, r.Target)
+		b = appendFrameString(b, r.Kind)
+		return binary.AppendVarint(b, int64(r.Line))
+	}); err != nil {
+		return err
+	}
+	if err := writeRows(fw, sign, frameRelSymbols, t.Symbols, func(b []byte, r *facts.SymbolRow) []byte {
+		return appendFrameString(b, r.Name)
+	}); err != nil {
+		return err
+	}
+	if err := writeRows(fw, sign, frameRelProcesses, t.Processes, func(b []byte, r *facts.ProcessRow) []byte {
+		b = appendFrameString(b, r.Label)
+		b = appendFrameString(b, r.File)
+		return binary.AppendVarint(b, int64(r.Line))
+	}); err != nil {
+		return err
+	}
+	if err := writeRows(fw, sign, frameRelSignals, t.Signals, func(b []byte, r *facts.SignalRow) []byte {
+		b = appendFrameString(b, r.Name)
+		b = appendFrameString(b, r.Type)
+		b = appendFrameString(b, r.Scope)
+		b = appendFrameString(b, r.File)
+		return binary.AppendVarint(b, int64(r.Line))
+	}); err != nil {
+		return err
+	}
+	if err := writeRows(fw, sign, frameRelInstances, t.Instances, func(b []byte, r *facts.InstanceRow) []byte {
+		b = appendFrameString(b, r.Target)
+		b = appendFrameString(b, r.InArch)
+		b = appendFrameString(b, r.File)
+		return binary.AppendVarint(b, int64(r.Line))
+	}); err != nil {
+		return err
+	}
+	return writeRows(fw, sign, frameRelGenerates, t.Generates, func(b []byte, r *facts.GenerateRow) []byte {
+		b = appendFrameString(b, r.Label)
+		b = appendFrameString(b, r.File)
+		return binary.AppendVarint(b, int64(r.Line))
+	})
+}
+
+// writeRows emits rows as one or more rows frames of at most
+// framesRowsPerChunk rows each.
+func writeRows[T any](fw *frameWriter, sign, relation byte, rows []T, enc func([]byte, *T) []byte) error {
+	for start := 0; start < len(rows); start += framesRowsPerChunk {
+		end := min(start+framesRowsPerChunk, len(rows))
+		b := append(fw.buf[:0], sign, relation)
+		b = binary.AppendUvarint(b, uint64(end-start))
+		for i := start; i < end; i++ {
+			b = enc(b, &rows[i])
+		}
+		fw.buf = b
+		if err := fw.frame(frameRows, b); err != nil {
+			return err
+		}
+	}
+	return nil
+}
+
+func appendFrameString(b []byte, s string) []byte {
+	b = binary.AppendUvarint(b, uint64(len(s)))
+	return append(b, s...)
+}
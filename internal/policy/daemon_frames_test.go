@@ -0,0 +1,53 @@
+package policy
+
+import (
+	"bufio"
+	"bytes"
+	"encoding/binary"
+	"testing"
+
+	"github.com/robert-at-pretension-io/vhdl-lint/internal/facts"
+)
+
+func TestWriteCommandFramesChunksRows(t *testing.T) {
+	tables := facts.Tables{}
+	for i := 0; i < framesRowsPerChunk+1; i++ {
+		tables.Symbols = append(tables.Symbols, facts.SymbolRow{Name: "work.s", Kind: "signal"})
+	}
+	tables.Entities = []facts.EntityRow{{Name: "top", File: "top.vhd", Line: 3}}
+
+	var out bytes.Buffer
+	if err := writeCommandFrames(bufio.NewWriter(&out), daemonCommand{Kind: "init", Tables: tables}); err != nil {
+		t.Fatalf("write frames: %v", err)
+	}
+
+	var kinds []byte
+	var symbolRows uint64
+	data := out.Bytes()
+	for len(data) > 0 {
+		if len(data) < 5 {
+			t.Fatalf("truncated frame header")
+		}
+		n := int(binary.LittleEndian.Uint32(data))
+		body := data[5 : 4+n]
+		kinds = append(kinds, data[4])
+		if data[4] == frameRows {
+			if body[0] != frameSignAdd {
+				t.Fatalf("expected add sign, got %d", body[0])
+			}
+			if body[1] == frameRelSymbols {
+				count, _ := binary.Uvarint(body[2:])
+				symbolRows += count
+			}
+		}
+		data = data[4+n:]
+	}
+
+	want := []byte{frameBegin, frameRows, frameRows, frameRows, frameEnd}
+	if !bytes.Equal(kinds, want) {
+		t.Fatalf("frame sequence = %v, want %v", kinds, want)
+	}
+	if symbolRows != framesRowsPerChunk+1 {
+		t.Fatalf("symbol rows = %d, want %d", symbolRows, framesRowsPerChunk+1)
+	}
+}
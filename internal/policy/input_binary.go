@@ -0,0 +1,341 @@
+package policy
+
+import (
+	"bufio"
+	"encoding/base64"
+	"encoding/binary"
+	"fmt"
+	"math"
+	"os"
+	"reflect"
+	"sort"
+	"strings"
+)
+
+// Binary handoff of policy.Input to vhdl_policy (VHDL_POLICY_INPUT=binary),
+// read by src/policy/binary_input.rs straight from a memory mapping:
+//
+//	header: "VLPOLIN\x00" | u32 version | u32 reserved | u64 string table offset
+//	values: tagged, in the shape encoding/json would have produced
+//	table:  uvarint count | (uvarint len | bytes)...
+//
+// Values mirror the JSON encoding (json tag names, omitempty, nil slices as
+// null), so the Rust side reads the same serde types with no schema of its
+// own. Every string, keys included, is interned in the table, which makes
+// repeated file paths and field names one uvarint each.
+const (
+	binaryInputMagic   = "VLPOLIN\x00"
+	binaryInputVersion = 1
+	binaryInputHeader  = 24
+)
+
+const (
+	binTagNull   byte = 0
+	binTagFalse  byte = 1
+	binTagTrue   byte = 2
+	binTagInt    byte = 3
+	binTagFloat  byte = 4
+	binTagString byte = 5
+	binTagArray  byte = 6
+	binTagMap    byte = 7
+)
+
+type binaryInputEncoder struct {
+	w       *bufio.Writer
+	written int64
+	err     error
+	strings map[string]uint64
+	table   []string
+	scratch [binary.MaxVarintLen64]byte
+}
+
+type binaryEncodeFn func(*binaryInputEncoder, reflect.Value)
+
+// inputEncoder is compiled at init, before any caller can use it.
+var inputEncoder = compileBinaryEncoder(reflect.TypeOf(Input{}), map[reflect.Type]*binaryEncodeFn{})
+
+// writeBinaryInputFile writes input to a new temp file (in /dev/shm when
+// available, so the handoff never touches disk) and returns its path. The
+// caller removes it.
+func writeBinaryInputFile(input Input) (string, error) {
+	dir := os.TempDir()
+	if info, err := os.Stat("/dev/shm"); err == nil && info.IsDir() {
+		dir = "/dev/shm"
+	}
+	f, err := os.CreateTemp(dir, "vhdl-policy-input-*.bin")
+	if err != nil {
+		return "", fmt.Errorf("create policy input: %w", err)
+	}
+	if err := encodeBinaryInput(f, input); err != nil {
+		_ = f.Close()
+		_ = os.Remove(f.Name())
+		return "", err
+	}
+	if err := f.Close(); err != nil {
+		_ = os.Remove(f.Name())
+		return "", fmt.Errorf("close policy input: %w", err)
+	}
+	return f.Name(), nil
+}
+
+func encodeBinaryInput(f *os.File, input Input) error {
+	e := &binaryInputEncoder{w: bufio.NewWriterSize(f, 1<<16), strings: make(map[string]uint64)}
+	e.write(make([]byte, binaryInputHeader)) // patched below
+	(*inputEncoder)(e, reflect.ValueOf(input))
+
+	tableOffset := e.written
+	e.uvarint(uint64(len(e.table)))
+	for _, s := range e.table {
+		e.uvarint(uint64(len(s)))
+		e.writeString(s)
+	}
+	if e.err == nil {
+		e.err = e.w.Flush()
+	}
+	if e.err != nil {
+		return fmt.Errorf("write policy input: %w", e.err)
+	}
+
+	header := make([]byte, 0, binaryInputHeader)
+	header = append(header, binaryInputMagic...)
+	header = binary.LittleEndian.AppendUint32(header, binaryInputVersion)
+	header = binary.LittleEndian.AppendUint32(header, 0)
+	header = binary.LittleEndian.AppendUint64(header, uint64(tableOffset))
+	if _, err := f.WriteAt(header, 0); err != nil {
+		return fmt.Errorf("write policy input header: %w", err)
+	}
+	return nil
+}
+
+func (e *binaryInputEncoder) write(b []byte) {
+	if e.err != nil {
+		return
+	}
+	n, err := e.w.Write(b)
+	e.written += int64(n)
+	e.err = err
+}
+
+func (e *binaryInputEncoder) writeString(s string) {
+	if e.err != nil {
+		return
+	}
+	n, err := e.w.WriteString(s)
+	e.written += int64(n)
+	e.err = err
+}
+
+func (e *binaryInputEncoder) tag(t byte) {
+	if e.err != nil {
+		return
+	}
+	e.err = e.w.WriteByte(t)
+	e.written++
+}
+
+func (e *binaryInputEncoder) uvarint(v uint64) {
+	e.write(binary.AppendUvarint(e.scratch[:0], v))
+}
+
+// key writes the table index of s (no tag; used for map keys).
+func (e *binaryInputEncoder) key(s string) {
+	id, ok := e.strings[s]
+	if !ok {
+		id = uint64(len(e.table))
+		e.strings[s] = id
+		e.table = append(e.table, s)
+	}
+	e.uvarint(id)
+}
+
+func (e *binaryInputEncoder) str(s string) {
+	e.tag(binTagString)
+	e.key(s)
+}
+
+func compileBinaryEncoder(t reflect.Type, seen map[reflect.Type]*binaryEncodeFn) *binaryEncodeFn {
+	if fn, ok := seen[t]; ok {
+		return fn
+	}
+	fn := new(binaryEncodeFn)
+	seen[t] = fn
+
+	switch t.Kind() {
+	case reflect.Bool:
+		*fn = func(e *binaryInputEncoder, v reflect.Value) {
+			if v.Bool() {
+				e.tag(binTagTrue)
+			} else {
+				e.tag(binTagFalse)
+			}
+		}
+
+	case reflect.Int, reflect.Int8, reflect.Int16, reflect.Int32, reflect.Int64:
+		*fn = func(e *binaryInputEncoder, v reflect.Value) {
+			e.tag(binTagInt)
+			e.write(binary.AppendVarint(e.scratch[:0], v.Int()))
+		}
+
+	case reflect.Uint, reflect.Uint8, reflect.Uint16, reflect.Uint32, reflect.Uint64:
+		*fn = func(e *binaryInputEncoder, v reflect.Value) {
+			e.tag(binTagInt)
+			e.write(binary.AppendVarint(e.scratch[:0], int64(v.Uint())))
+		}
+
+	case reflect.Float32, reflect.Float64:
+		*fn = func(e *binaryInputEncoder, v reflect.Value) {
+			e.tag(binTagFloat)
+			e.write(binary.LittleEndian.AppendUint64(e.scratch[:0], math.Float64bits(v.Float())))
+		}
+
+	case reflect.String:
+		*fn = func(e *binaryInputEncoder, v reflect.Value) { e.str(v.String()) }
+
+	case reflect.Slice, reflect.Array:
+		if t.Kind() == reflect.Slice && t.Elem().Kind() == reflect.Uint8 {
+			// encoding/json writes []byte as base64
+			*fn = func(e *binaryInputEncoder, v reflect.Value) {
+				if v.IsNil() {
+					e.tag(binTagNull)
+					return
+				}
+				e.str(base64.StdEncoding.EncodeToString(v.Bytes()))
+			}
+			break
+		}
+		elem := compileBinaryEncoder(t.Elem(), seen)
+		*fn = func(e *binaryInputEncoder, v reflect.Value) {
+			if v.Kind() == reflect.Slice && v.IsNil() {
+				e.tag(binTagNull)
+				return
+			}
+			n := v.Len()
+			e.tag(binTagArray)
+			e.uvarint(uint64(n))
+			for i := 0; i < n; i++ {
+				(*elem)(e, v.Index(i))
+			}
+		}
+
+	case reflect.Map:
+		if t.Key().Kind() != reflect.String {
+			panic(fmt.Sprintf("policy binary input: unsupported map key in %s", t))
+		}
+		elem := compileBinaryEncoder(t.Elem(), seen)
+		*fn = func(e *binaryInputEncoder, v reflect.Value) {
+			if v.IsNil() {
+				e.tag(binTagNull)
+				return
+			}
+			keys := v.MapKeys()
+			sort.Slice(keys, func(i, j int) bool { return keys[i].String() < keys[j].String() })
+			e.tag(binTagMap)
+			e.uvarint(uint64(len(keys)))
+			for _, k := range keys {
+				e.key(k.String())
+				(*elem)(e, v.MapIndex(k))
+			}
+		}
+
+	case reflect.Pointer:
+		elem := compileBinaryEncoder(t.Elem(), seen)
+		*fn = func(e *binaryInputEncoder, v reflect.Value) {
+			if v.IsNil() {
+				e.tag(binTagNull)
+				return
+			}
+			(*elem)(e, v.Elem())
+		}
+
+	case reflect.Interface:
+		*fn = func(e *binaryInputEncoder, v reflect.Value) {
+			if v.IsNil() {
+				e.tag(binTagNull)
+				return
+			}
+			inner := v.Elem()
+			(*compileBinaryEncoder(inner.Type(), map[reflect.Type]*binaryEncodeFn{}))(e, inner)
+		}
+
+	case reflect.Struct:
+		fields := binaryStructFields(t, nil)
+		encs := make([]*binaryEncodeFn, len(fields))
+		for i, f := range fields {
+			encs[i] = compileBinaryEncoder(t.FieldByIndex(f.index).Type, seen)
+		}
+		*fn = func(e *binaryInputEncoder, v reflect.Value) {
+			n := 0
+			for _, f := range fields {
+				if !f.omitEmpty || !isEmptyJSONValue(v.FieldByIndex(f.index)) {
+					n++
+				}
+			}
+			e.tag(binTagMap)
+			e.uvarint(uint64(n))
+			for i, f := range fields {
+				fv := v.FieldByIndex(f.index)
+				if f.omitEmpty && isEmptyJSONValue(fv) {
+					continue
+				}
+				e.key(f.name)
+				(*encs[i])(e, fv)
+			}
+		}
+
+	default:
+		panic(fmt.Sprintf("policy binary input: unsupported type %s", t))
+	}
+	return fn
+}
+
+// isEmptyJSONValue is encoding/json's omitempty test.
+func isEmptyJSONValue(v reflect.Value) bool {
+	switch v.Kind() {
+	case reflect.Array, reflect.Map, reflect.Slice, reflect.String:
+		return v.Len() == 0
+	case reflect.Bool,
+		reflect.Int, reflect.Int8, reflect.Int16, reflect.Int32, reflect.Int64,
+		reflect.Uint, reflect.Uint8, reflect.Uint16, reflect.Uint32, reflect.Uint64,
+		reflect.Float32, reflect.Float64,
+		reflect.Interface, reflect.Pointer:
+		return v.IsZero()
+	}
+	return false
+}
+
+type binaryField struct {
+	name      string
+	index     []int
+	omitEmpty bool
+}
+
+// binaryStructFields lists t's fields the way encoding/json names them,
+// inlining untagged embedded structs.
+func binaryStructFields(t reflect.Type, prefix []int) []binaryField {
+	var fields []binaryField
+	for i := 0; i < t.NumField(); i++ {
+		f := t.Field(i)
+		tag := f.Tag.Get("json")
+		if tag == "-" {
+			continue
+		}
+		index := append(append([]int(nil), prefix...), i)
+		if f.Anonymous && tag == "" && f.Type.Kind() == reflect.Struct {
+			fields = append(fields, binaryStructFields(f.Type, index)...)
+			continue
+		}
+		if !f.IsExported() {
+			continue
+		}
+		name, opts, _ := strings.Cut(tag, ",")
+		if name == "" {
+			name = f.Name
+		}
+		fields = append(fields, binaryField{
+			name:      name,
+			index:     index,
+			omitEmpty: strings.Contains(","+opts+",", ",omitempty,"),
+		})
+	}
+	return fields
+}
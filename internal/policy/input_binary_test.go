@@ -0,0 +1,123 @@
+package policy
+
+import (
+	"encoding/binary"
+	"encoding/json"
+	"math"
+	"os"
+	"reflect"
+	"testing"
+)
+
+func TestBinaryInputMatchesJSON(t *testing.T) {
+	input := Input{
+		Standard:  "2008",
+		FileCount: 2,
+		Entities: []Entity{{
+			Name:  "top",
+			File:  "top.vhd",
+			Line:  3,
+			Ports: []Port{{Name: "clk", Direction: "in", Type: "std_logic", Line: 4, InEntity: "top", Width: 1}},
+		}},
+		ConstantDecls: []ConstantDeclaration{{Name: "DEPTH", Type: "integer", File: "top.vhd", Line: -1}},
+		Constants:     []string{},
+	}
+
+	path, err := writeBinaryInputFile(input)
+	if err != nil {
+		t.Fatalf("write binary input: %v", err)
+	}
+	defer os.Remove(path)
+	data, err := os.ReadFile(path)
+	if err != nil {
+		t.Fatalf("read binary input: %v", err)
+	}
+	if string(data[:8]) != binaryInputMagic {
+		t.Fatalf("bad magic %q", data[:8])
+	}
+	tableOffset := binary.LittleEndian.Uint64(data[16:24])
+
+	d := &binaryInputReader{data: data, pos: int(tableOffset)}
+	d.strings = make([]string, d.uvarint())
+	for i := range d.strings {
+		n := int(d.uvarint())
+		d.strings[i] = string(d.data[d.pos : d.pos+n])
+		d.pos += n
+	}
+	d.pos = binaryInputHeader
+	got := d.value()
+	if d.pos != int(tableOffset) {
+		t.Fatalf("value ends at %d, table starts at %d", d.pos, tableOffset)
+	}
+
+	payload, err := json.Marshal(input)
+	if err != nil {
+		t.Fatalf("marshal: %v", err)
+	}
+	var want any
+	if err := json.Unmarshal(payload, &want); err != nil {
+		t.Fatalf("unmarshal: %v", err)
+	}
+	if !reflect.DeepEqual(got, want) {
+		t.Fatalf("binary input differs from JSON:\n got %v\nwant %v", got, want)
+	}
+
+	seen := map[string]bool{}
+	for _, s := range d.strings {
+		if seen[s] {
+			t.Fatalf("string %q interned twice", s)
+		}
+		seen[s] = true
+	}
+}
+
+// binaryInputReader decodes into the generic shape json.Unmarshal gives.
+type binaryInputReader struct {
+	data    []byte
+	pos     int
+	strings []string
+}
+
+func (d *binaryInputReader) uvarint() uint64 {
+	v, n := binary.Uvarint(d.data[d.pos:])
+	d.pos += n
+	return v
+}
+
+func (d *binaryInputReader) value() any {
+	tag := d.data[d.pos]
+	d.pos++
+	switch tag {
+	case binTagNull:
+		return nil
+	case binTagFalse:
+		return false
+	case binTagTrue:
+		return true
+	case binTagInt:
+		v, n := binary.Varint(d.data[d.pos:])
+		d.pos += n
+		return float64(v)
+	case binTagFloat:
+		v := math.Float64frombits(binary.LittleEndian.Uint64(d.data[d.pos:]))
+		d.pos += 8
+		return v
+	case binTagString:
+		return d.strings[d.uvarint()]
+	case binTagArray:
+		out := make([]any, d.uvarint())
+		for i := range out {
+			out[i] = d.value()
+		}
+		return out
+	case binTagMap:
+		n := int(d.uvarint())
+		out := make(map[string]any, n)
+		for i := 0; i < n; i++ {
+			key := d.strings[d.uvarint()]
+			out[key] = d.value()
+		}
+		return out
+	}
+	panic("unknown tag")
+}
@@ -15,6 +15,10 @@ import (
 // Engine evaluates Rust policy rules against VHDL facts
 type Engine struct {
 	binaryPath string
+
+	// Timings asks the engine for its per-rule-family spans
+	// (Result.Timings, VHDL_POLICY_TIMINGS=1 in the engine's environment)
+	Timings bool
 }
 
 // Violation represents a policy violation
@@ -32,6 +36,20 @@ type Result struct {
 	Summary             Summary              `json:"summary"`
 	MissingChecks       []MissingCheckTask   `json:"missing_checks,omitempty"`
 	AmbiguousConstructs []AmbiguousConstruct `json:"ambiguous_constructs,omitempty"`
+	// Spans of the evaluation, when requested (Engine.Timings) or reported
+	// by the daemon; not part of the lint result
+	Timings []Timing `json:"timings,omitempty"`
+}
+
+// Timing is one span of a policy evaluation: a rule family of the batch
+// engine, or a step of the daemon. StartMS is relative to the start of the
+// evaluation.
+type Timing struct {
+	Name       string  `json:"name"`
+	StartMS    float64 `json:"start_ms"`
+	DurationMS float64 `json:"duration_ms"`
+	Thread     int     `json:"thread"`
+	Count      int     `json:"count"` // violations produced
 }
 
 // Summary provides aggregate counts
@@ -587,13 +605,26 @@ func New(policyDir string) (*Engine, error) {
 // Evaluate runs the policies against the input data
 func (e *Engine) Evaluate(input Input) (*Result, error) {
 	ctx := context.Background()
-	payload, err := json.Marshal(input)
-	if err != nil {
-		return nil, fmt.Errorf("marshal input: %w", err)
+	var cmd *exec.Cmd
+	if policyBinaryInputEnabled() {
+		// Handed over as a file the binary maps, instead of piped JSON
+		path, err := writeBinaryInputFile(input)
+		if err != nil {
+			return nil, err
+		}
+		defer os.Remove(path)
+		cmd = exec.CommandContext(ctx, e.binaryPath, "--input-bin", path)
+	} else {
+		payload, err := json.Marshal(input)
+		if err != nil {
+			return nil, fmt.Errorf("marshal input: %w", err)
+		}
+		cmd = exec.CommandContext(ctx, e.binaryPath)
+		cmd.Stdin = bytes.NewReader(payload)
+	}
+	if e.Timings {
+		cmd.Env = append(os.Environ(), "VHDL_POLICY_TIMINGS=1")
 	}
-
-	cmd := exec.CommandContext(ctx, e.binaryPath)
-	cmd.Stdin = bytes.NewReader(payload)
 	var stdout bytes.Buffer
 	var stderr bytes.Buffer
 	cmd.Stdout = &stdout
@@ -688,6 +719,10 @@ func policyTimingEnabled() bool {
 	return val == "1" || val == "true" || val == "yes" || val == "on"
 }
 
+func policyBinaryInputEnabled() bool {
+	return strings.ToLower(strings.TrimSpace(os.Getenv("VHDL_POLICY_INPUT"))) == "binary"
+}
+
 func policyStreamEnabled() bool {
 	val := strings.ToLower(strings.TrimSpace(os.Getenv("VHDL_POLICY_STREAM")))
 	return val == "1" || val == "true" || val == "yes" || val == "on"
@@ -6,7 +6,10 @@ import (
 	"path/filepath"
 	"regexp"
 	"sort"
+	"strings"
 	"testing"
+
+	"github.com/robert-at-pretension-io/vhdl-lint/internal/policy"
 )
 
 func TestPolicyRuleManifestsCoverRustRules(t *testing.T) {
@@ -53,6 +56,35 @@ func TestPolicyRuleManifestsCoverRustRules(t *testing.T) {
 	}
 }
 
+// The batch engine skips DaemonRules in daemon mode, so the list must name
+// exactly the rules vhdl_policyd's dataflow computes.
+func TestDaemonRulesMatchPolicyd(t *testing.T) {
+	repoRoot := findRepoRoot(t)
+	data, err := os.ReadFile(filepath.Join(repoRoot, "src", "bin", "vhdl_policyd.rs"))
+	if err != nil {
+		t.Fatalf("read vhdl_policyd: %v", err)
+	}
+	src := string(data)
+	start := strings.Index(src, "\nfn rules<")
+	if start < 0 {
+		t.Fatalf("rules() not found in vhdl_policyd.rs")
+	}
+	body := src[start+1:]
+	if end := strings.Index(body, "\nfn "); end >= 0 {
+		body = body[:end]
+	}
+	var daemon []string
+	for _, match := range regexp.MustCompile(`rule:\s*"([a-z0-9_]+)"`).FindAllStringSubmatch(body, -1) {
+		daemon = append(daemon, match[1])
+	}
+	want := append([]string(nil), policy.DaemonRules...)
+	sort.Strings(daemon)
+	sort.Strings(want)
+	if strings.Join(daemon, ",") != strings.Join(want, ",") {
+		t.Fatalf("policy.DaemonRules = %v, vhdl_policyd rules() emits %v", want, daemon)
+	}
+}
+
 func collectRustPolicyRules(t *testing.T, repoRoot string) map[string]struct{} {
 	t.Helper()
 	root := filepath.Join(repoRoot, "src", "policy")
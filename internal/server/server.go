@@ -0,0 +1,481 @@
+// Package server implements `vhdl-lint serve`: a long-lived process that
+// keeps one resident Indexer per project root (kept syntax trees, CUE
+// validators, the policy daemon and its fact tables), watches the roots for
+// changes and answers lint requests over a unix socket.
+//
+// Protocol: one JSON Request per line, one JSON Response per line. A lint
+// request for a root that has not changed since its last run is answered
+// from the kept result; a change seen by the watcher re-lints the root in
+// the background, so the next request finds it fresh.
+package server
+
+import (
+	"bufio"
+	"crypto/sha256"
+	"encoding/hex"
+	"encoding/json"
+	"errors"
+	"fmt"
+	"io"
+	"net"
+	"os"
+	"path/filepath"
+	"sort"
+	"strings"
+	"sync"
+	"time"
+
+	"github.com/robert-at-pretension-io/vhdl-lint/internal/config"
+	"github.com/robert-at-pretension-io/vhdl-lint/internal/extractor"
+	"github.com/robert-at-pretension-io/vhdl-lint/internal/indexer"
+)
+
+// Request is one line sent to the server.
+type Request struct {
+	// Method is "lint", "status" or "shutdown"
+	Method string `json:"method"`
+	// Root selects the project for "lint" (default: the first served root)
+	Root string `json:"root,omitempty"`
+}
+
+// Response answers one Request.
+type Response struct {
+	OK    bool   `json:"ok"`
+	Error string `json:"error,omitempty"`
+	Root  string `json:"root,omitempty"`
+	// Cached is set when the result was kept from an earlier run
+	Cached bool                `json:"cached,omitempty"`
+	Result *indexer.LintResult `json:"result,omitempty"`
+	Roots  []RootStatus        `json:"roots,omitempty"`
+}
+
+// RootStatus describes one served root in a "status" response.
+type RootStatus struct {
+	Root    string `json:"root"`
+	Files   int    `json:"files"`
+	Dirty   bool   `json:"dirty"`
+	Runs    int    `json:"runs"`
+	LastRun string `json:"last_run,omitempty"`
+}
+
+// Options configures a Server.
+type Options struct {
+	// ConfigPath, when set, is loaded instead of config.Load(root)
+	ConfigPath string
+	// Interval between watch scans (default 500ms)
+	Interval time.Duration
+}
+
+// lintFunc lints one root and returns its result.
+type lintFunc func() (*indexer.LintResult, error)
+
+// Server serves lint requests for a fixed set of roots.
+type Server struct {
+	opts  Options
+	roots []*root
+
+	mu        sync.Mutex
+	listeners []net.Listener
+	closed    bool
+	done      chan struct{}
+}
+
+type root struct {
+	path string
+
+	// mu is held for a whole lint run, so requests wait for a run in
+	// progress instead of starting another
+	mu       sync.Mutex
+	lint     lintFunc
+	close    func() error
+	reload   func() error
+	stamps   map[string]fileStamp
+	dirty    bool
+	result   *indexer.LintResult
+	err      error
+	runs     int
+	lastRun  time.Duration
+	watching bool
+	// snapshot keeps directory listings between scans, so an unchanged
+	// directory costs a stat instead of a listing
+	snapshot *config.DirSnapshot
+}
+
+type fileStamp struct {
+	size    int64
+	modTime time.Time
+}
+
+// New creates a Server for roots with a resident Indexer each.
+func New(roots []string, opts Options) (*Server, error) {
+	return newServer(roots, opts, func(path string) (lintFunc, func() error, func() error, error) {
+		idx := indexer.New()
+		load := func() error {
+			var cfg *config.Config
+			var err error
+			if opts.ConfigPath != "" {
+				cfg, err = config.LoadFile(opts.ConfigPath)
+			} else {
+				cfg, err = config.Load(path)
+			}
+			if err != nil {
+				return fmt.Errorf("load config: %w", err)
+			}
+			idx.Config = cfg
+			return nil
+		}
+		if err := load(); err != nil {
+			return nil, nil, nil, err
+		}
+		idx.Resident = true
+		idx.Trees = extractor.NewTreeStore()
+		idx.JSONOutput = true
+		idx.Output = io.Discard
+		lint := func() (*indexer.LintResult, error) {
+			err := idx.Run(path)
+			return idx.LastResult, err
+		}
+		return lint, idx.Close, load, nil
+	})
+}
+
+func newServer(roots []string, opts Options, linter func(path string) (lintFunc, func() error, func() error, error)) (*Server, error) {
+	if len(roots) == 0 {
+		return nil, errors.New("no roots to serve")
+	}
+	if opts.Interval <= 0 {
+		opts.Interval = 500 * time.Millisecond
+	}
+	s := &Server{opts: opts, done: make(chan struct{})}
+	for _, path := range roots {
+		abs, err := filepath.Abs(path)
+		if err != nil {
+			return nil, fmt.Errorf("root %s: %w", path, err)
+		}
+		lint, closeFn, reload, err := linter(abs)
+		if err != nil {
+			_ = s.Close()
+			return nil, fmt.Errorf("root %s: %w", path, err)
+		}
+		s.roots = append(s.roots, &root{path: abs, lint: lint, close: closeFn, reload: reload, dirty: true, snapshot: config.NewDirSnapshot()})
+	}
+	return s, nil
+}
+
+// DefaultSocketPath is the socket `vhdl-lint serve` listens on for a set of
+// roots when none is given: one per set of absolute root paths, in the temp
+// dir. For a single root it is also the path the client dials for it.
+func DefaultSocketPath(rootPaths ...string) string {
+	abs := make([]string, 0, len(rootPaths))
+	for _, p := range rootPaths {
+		a, err := filepath.Abs(p)
+		if err != nil {
+			a = p
+		}
+		abs = append(abs, a)
+	}
+	sort.Strings(abs)
+	sum := sha256.Sum256([]byte(strings.Join(abs, "\n")))
+	return filepath.Join(os.TempDir(), "vhdl-lint-"+hex.EncodeToString(sum[:6])+".sock")
+}
+
+// LinkRootSockets points each root's DefaultSocketPath at socket, so a
+// client naming any one of the roots reaches the server for all of them.
+// It refuses a root another live server already answers for, and returns
+// the links it made, to be removed on shutdown.
+func LinkRootSockets(socket string, roots []string) ([]string, error) {
+	var links []string
+	for _, r := range roots {
+		link := DefaultSocketPath(r)
+		if link == socket {
+			continue
+		}
+		if conn, err := net.Dial("unix", link); err == nil {
+			_ = conn.Close()
+			removeAll(links)
+			return nil, fmt.Errorf("a server is already listening for %s on %s", r, link)
+		}
+		_ = os.Remove(link) // stale: its server died
+		if err := os.Symlink(socket, link); err != nil {
+			removeAll(links)
+			return nil, fmt.Errorf("link socket for %s: %w", r, err)
+		}
+		links = append(links, link)
+	}
+	return links, nil
+}
+
+func removeAll(paths []string) {
+	for _, p := range paths {
+		_ = os.Remove(p)
+	}
+}
+
+// Watch scans every root each Interval until Close, re-linting a root in the
+// background when its VHDL files or config changed. The first scan lints
+// every root.
+func (s *Server) Watch() {
+	for _, r := range s.roots {
+		go s.watch(r)
+	}
+}
+
+func (s *Server) watch(r *root) {
+	ticker := time.NewTicker(s.opts.Interval)
+	defer ticker.Stop()
+	for {
+		if s.poll(r) {
+			r.mu.Lock()
+			r.refreshLocked()
+			r.mu.Unlock()
+		}
+		select {
+		case <-s.done:
+			return
+		case <-ticker.C:
+		}
+	}
+}
+
+// poll rescans r and reports whether anything changed since the last scan.
+func (s *Server) poll(r *root) bool {
+	stamps, err := scanRoot(r.snapshot, r.path)
+	r.mu.Lock()
+	defer r.mu.Unlock()
+	if err != nil {
+		r.err = err
+		return false
+	}
+	if !r.watching {
+		// First scan: a baseline; the root is already dirty
+		r.watching = true
+		r.stamps = stamps
+		return true
+	}
+	changed := false
+	configChanged := false
+	for path, st := range stamps {
+		if old, ok := r.stamps[path]; !ok || old != st {
+			changed = true
+			configChanged = configChanged || isConfigFile(path)
+		}
+	}
+	for path := range r.stamps {
+		if _, ok := stamps[path]; !ok {
+			changed = true
+			configChanged = configChanged || isConfigFile(path)
+		}
+	}
+	r.stamps = stamps
+	if changed {
+		r.dirty = true
+		if configChanged && r.reload != nil {
+			if err := r.reload(); err != nil {
+				// Report the broken config until it is fixed; no stale run
+				r.result, r.err, r.dirty = nil, err, false
+				return false
+			}
+		}
+	}
+	return changed
+}
+
+// refreshLocked re-lints r if it is dirty. r.mu must be held.
+func (r *root) refreshLocked() {
+	if !r.dirty {
+		return
+	}
+	start := time.Now()
+	result, err := r.lint()
+	r.lastRun = time.Since(start)
+	r.runs++
+	r.result, r.err = result, err
+	r.dirty = false
+}
+
+// Serve answers requests on ln until Close or a shutdown request.
+func (s *Server) Serve(ln net.Listener) error {
+	s.mu.Lock()
+	if s.closed {
+		s.mu.Unlock()
+		_ = ln.Close()
+		return net.ErrClosed
+	}
+	s.listeners = append(s.listeners, ln)
+	s.mu.Unlock()
+	for {
+		conn, err := ln.Accept()
+		if err != nil {
+			select {
+			case <-s.done:
+				return nil
+			default:
+				return err
+			}
+		}
+		go s.handle(conn)
+	}
+}
+
+func (s *Server) handle(conn net.Conn) {
+	defer conn.Close()
+	scanner := bufio.NewScanner(conn)
+	enc := json.NewEncoder(conn)
+	for scanner.Scan() {
+		var req Request
+		var resp Response
+		if err := json.Unmarshal(scanner.Bytes(), &req); err != nil {
+			resp = Response{Error: fmt.Sprintf("bad request: %v", err)}
+		} else {
+			resp = s.answer(req)
+		}
+		if err := enc.Encode(resp); err != nil {
+			return
+		}
+		if req.Method == "shutdown" && resp.OK {
+			_ = s.Close()
+			return
+		}
+	}
+}
+
+func (s *Server) answer(req Request) Response {
+	switch req.Method {
+	case "lint":
+		r, err := s.root(req.Root)
+		if err != nil {
+			return Response{Error: err.Error()}
+		}
+		r.mu.Lock()
+		defer r.mu.Unlock()
+		cached := !r.dirty && r.result != nil
+		r.refreshLocked()
+		resp := Response{OK: r.err == nil, Root: r.path, Cached: cached, Result: r.result}
+		if r.err != nil {
+			resp.Error = r.err.Error()
+		}
+		return resp
+	case "status":
+		resp := Response{OK: true}
+		for _, r := range s.roots {
+			r.mu.Lock()
+			st := RootStatus{Root: r.path, Files: len(r.stamps), Dirty: r.dirty, Runs: r.runs}
+			if r.runs > 0 {
+				st.LastRun = r.lastRun.String()
+			}
+			r.mu.Unlock()
+			resp.Roots = append(resp.Roots, st)
+		}
+		return resp
+	case "shutdown":
+		return Response{OK: true}
+	default:
+		return Response{Error: fmt.Sprintf("unknown method: %q", req.Method)}
+	}
+}
+
+func (s *Server) root(path string) (*root, error) {
+	if path == "" {
+		return s.roots[0], nil
+	}
+	abs, err := filepath.Abs(path)
+	if err != nil {
+		return nil, err
+	}
+	for _, r := range s.roots {
+		if r.path == abs {
+			return r, nil
+		}
+	}
+	return nil, fmt.Errorf("root not served: %s", abs)
+}
+
+// Close stops the watchers and listeners and releases every root's
+// resident state.
+func (s *Server) Close() error {
+	s.mu.Lock()
+	if s.closed {
+		s.mu.Unlock()
+		return nil
+	}
+	s.closed = true
+	close(s.done)
+	listeners := s.listeners
+	s.mu.Unlock()
+
+	var errs []error
+	for _, ln := range listeners {
+		if err := ln.Close(); err != nil && !errors.Is(err, net.ErrClosed) {
+			errs = append(errs, err)
+		}
+	}
+	for _, r := range s.roots {
+		r.mu.Lock()
+		if r.close != nil {
+			if err := r.close(); err != nil {
+				errs = append(errs, fmt.Errorf("close %s: %w", r.path, err))
+			}
+			r.close = nil
+		}
+		r.mu.Unlock()
+	}
+	return errors.Join(errs...)
+}
+
+// Call sends one request to the server at socketPath and returns its answer.
+func Call(socketPath string, req Request) (*Response, error) {
+	conn, err := net.Dial("unix", socketPath)
+	if err != nil {
+		return nil, fmt.Errorf("connect %s: %w", socketPath, err)
+	}
+	defer conn.Close()
+	if err := json.NewEncoder(conn).Encode(req); err != nil {
+		return nil, fmt.Errorf("send request: %w", err)
+	}
+	var resp Response
+	if err := json.NewDecoder(bufio.NewReader(conn)).Decode(&resp); err != nil {
+		return nil, fmt.Errorf("read response: %w", err)
+	}
+	return &resp, nil
+}
+
+// scanRoot stamps every VHDL and config file under path, skipping hidden
+// directories (caches, VCS metadata). Directories come from snapshot when
+// unchanged; only the files are stat'ed every scan.
+func scanRoot(snapshot *config.DirSnapshot, path string) (map[string]fileStamp, error) {
+	l := config.NewLister(snapshot)
+	l.SkipHidden = true
+	files, err := l.Files(path)
+	if err != nil && files == nil {
+		return nil, err
+	}
+	// Other errors are directories that vanished while listing
+	stamps := make(map[string]fileStamp)
+	for _, p := range files {
+		ext := strings.ToLower(filepath.Ext(p))
+		if ext != ".vhd" && ext != ".vhdl" && !isConfigFile(p) {
+			continue
+		}
+		info, err := os.Lstat(p)
+		if err != nil {
+			continue
+		}
+		stamps[p] = fileStamp{size: info.Size(), modTime: info.ModTime()}
+	}
+	return stamps, nil
+}
+
+func isConfigFile(path string) bool {
+	name := filepath.Base(path)
+	return name == "vhdl_lint.json" || name == ".vhdl_lint.json"
+}
+
+// Roots returns the absolute paths being served, sorted.
+func (s *Server) Roots() []string {
+	paths := make([]string, 0, len(s.roots))
+	for _, r := range s.roots {
+		paths = append(paths, r.path)
+	}
+	sort.Strings(paths)
+	return paths
+}
@@ -0,0 +1,152 @@
+package server
+
+import (
+	"net"
+	"os"
+	"path/filepath"
+	"testing"
+	"time"
+
+	"github.com/robert-at-pretension-io/vhdl-lint/internal/config"
+	"github.com/robert-at-pretension-io/vhdl-lint/internal/indexer"
+)
+
+func TestServerCachesUntilRootChanges(t *testing.T) {
+	dir := t.TempDir()
+	vhd := filepath.Join(dir, "a.vhd")
+	if err := os.WriteFile(vhd, []byte("entity a is end;\n"), 0o600); err != nil {
+		t.Fatalf("write vhdl: %v", err)
+	}
+
+	runs := 0
+	s, err := newServer([]string{dir}, Options{Interval: time.Hour}, func(path string) (lintFunc, func() error, func() error, error) {
+		lint := func() (*indexer.LintResult, error) {
+			runs++
+			return &indexer.LintResult{Summary: indexer.ResultSummary{Info: runs}}, nil
+		}
+		return lint, nil, nil, nil
+	})
+	if err != nil {
+		t.Fatalf("new server: %v", err)
+	}
+	sock := filepath.Join(dir, "s.sock")
+	ln, err := net.Listen("unix", sock)
+	if err != nil {
+		t.Skipf("unix sockets unavailable: %v", err)
+	}
+	served := make(chan error, 1)
+	go func() { served <- s.Serve(ln) }()
+
+	lint := func() *Response {
+		t.Helper()
+		resp, err := Call(sock, Request{Method: "lint"})
+		if err != nil {
+			t.Fatalf("call: %v", err)
+		}
+		if !resp.OK || resp.Result == nil {
+			t.Fatalf("lint failed: %#v", resp)
+		}
+		return resp
+	}
+
+	s.poll(s.roots[0]) // baseline scan
+	if resp := lint(); resp.Cached || resp.Result.Summary.Info != 1 {
+		t.Fatalf("first lint should run: %#v", resp)
+	}
+	if resp := lint(); !resp.Cached || runs != 1 {
+		t.Fatalf("second lint should be cached, runs=%d: %#v", runs, resp)
+	}
+	if s.poll(s.roots[0]) {
+		t.Fatalf("poll without edits reported a change")
+	}
+
+	if err := os.WriteFile(vhd, []byte("entity a is\nend entity;\n"), 0o600); err != nil {
+		t.Fatalf("rewrite vhdl: %v", err)
+	}
+	if !s.poll(s.roots[0]) {
+		t.Fatalf("poll missed the edit")
+	}
+	if resp := lint(); resp.Cached || resp.Result.Summary.Info != 2 {
+		t.Fatalf("lint after an edit should rerun: %#v", resp)
+	}
+
+	if resp, err := Call(sock, Request{Method: "shutdown"}); err != nil || !resp.OK {
+		t.Fatalf("shutdown: %#v, %v", resp, err)
+	}
+	select {
+	case err := <-served:
+		if err != nil {
+			t.Fatalf("serve: %v", err)
+		}
+	case <-time.After(5 * time.Second):
+		t.Fatalf("server did not stop after shutdown")
+	}
+}
+
+func TestSocketCoversEveryRoot(t *testing.T) {
+	t.Setenv("TMPDIR", t.TempDir())
+	a, b := filepath.Join(os.TempDir(), "a"), filepath.Join(os.TempDir(), "b")
+	if DefaultSocketPath(a, b) != DefaultSocketPath(b, a) {
+		t.Fatalf("socket depends on root order")
+	}
+	if DefaultSocketPath(a, b) == DefaultSocketPath(a) {
+		t.Fatalf("a root set shares the socket of one of its roots")
+	}
+
+	sock := DefaultSocketPath(a, b)
+	ln, err := net.Listen("unix", sock)
+	if err != nil {
+		t.Skipf("unix sockets unavailable: %v", err)
+	}
+	defer ln.Close()
+	links, err := LinkRootSockets(sock, []string{a, b})
+	if err != nil {
+		t.Fatalf("link: %v", err)
+	}
+	defer removeAll(links)
+	if len(links) != 2 {
+		t.Fatalf("links = %q, want one per root", links)
+	}
+	go func() {
+		if conn, err := ln.Accept(); err == nil {
+			conn.Close()
+		}
+	}()
+	conn, err := net.Dial("unix", DefaultSocketPath(b))
+	if err != nil {
+		t.Fatalf("client for root b cannot reach the server: %v", err)
+	}
+	conn.Close()
+
+	if _, err := LinkRootSockets(DefaultSocketPath(b, "c"), []string{b, "c"}); err == nil {
+		t.Fatalf("a second server took over a served root")
+	}
+}
+
+func TestScanRootSkipsHiddenDirs(t *testing.T) {
+	dir := t.TempDir()
+	for _, f := range []string{"a.vhd", ".git/b.vhd", "notes.txt", "vhdl_lint.json"} {
+		path := filepath.Join(dir, f)
+		if err := os.MkdirAll(filepath.Dir(path), 0o755); err != nil {
+			t.Fatalf("mkdir: %v", err)
+		}
+		if err := os.WriteFile(path, []byte("--"), 0o600); err != nil {
+			t.Fatalf("write %s: %v", f, err)
+		}
+	}
+	stamps, err := scanRoot(config.NewDirSnapshot(), dir)
+	if err != nil {
+		t.Fatalf("scan: %v", err)
+	}
+	if len(stamps) != 2 {
+		t.Fatalf("stamps = %v, want a.vhd and vhdl_lint.json", stamps)
+	}
+	for _, f := range []string{"a.vhd", "vhdl_lint.json"} {
+		if _, ok := stamps[filepath.Join(dir, f)]; !ok {
+			t.Fatalf("%s not stamped", f)
+		}
+	}
+	if _, err := scanRoot(config.NewDirSnapshot(), filepath.Join(dir, "missing")); err == nil {
+		t.Fatalf("scan of a missing root did not fail")
+	}
+}
@@ -0,0 +1,252 @@
+// Package synth generates synthetic VHDL designs for benchmarks.
+//
+// A design is deterministic for its Params: Packages packages, and Entities
+// entities in a hierarchy Depth levels deep where each entity instantiates
+// Children entities of the next level. Every architecture has Processes
+// clocked processes, a for-generate nest GenerateNesting deep and uses
+// PackageFanIn of the packages. Each design unit is written to its own file,
+// so file count, fact rows and cross-file dependencies all scale with the
+// parameters.
+package synth
+
+import (
+	"fmt"
+	"os"
+	"path/filepath"
+	"strings"
+)
+
+// Params sizes a synthetic design. Zero Entities, Children or Processes take
+// the values of Default; the other fields may be zero.
+type Params struct {
+	Entities        int
+	Depth           int
+	Children        int
+	Processes       int
+	GenerateNesting int
+	Packages        int
+	PackageFanIn    int
+}
+
+// Presets used by the benchmarks (benches/policy.rs mirrors them).
+var (
+	Default = Params{Entities: 16, Depth: 3, Children: 2, Processes: 2, GenerateNesting: 2, Packages: 4, PackageFanIn: 2}
+	Small   = Default
+	Medium  = Params{Entities: 200, Depth: 6, Children: 2, Processes: 4, GenerateNesting: 2, Packages: 16, PackageFanIn: 4}
+	Large   = Params{Entities: 2000, Depth: 8, Children: 3, Processes: 6, GenerateNesting: 3, Packages: 64, PackageFanIn: 8}
+)
+
+func (p Params) withDefaults() Params {
+	if p.Entities <= 0 {
+		p.Entities = Default.Entities
+	}
+	if p.Depth < 0 {
+		p.Depth = 0
+	}
+	if p.Children <= 0 {
+		p.Children = Default.Children
+	}
+	if p.Processes <= 0 {
+		p.Processes = Default.Processes
+	}
+	if p.GenerateNesting < 0 {
+		p.GenerateNesting = 0
+	}
+	if p.Packages < 0 {
+		p.Packages = 0
+	}
+	if p.PackageFanIn > p.Packages {
+		p.PackageFanIn = p.Packages
+	}
+	return p
+}
+
+// Generate writes the design for p into dir and returns the files written,
+// packages first.
+func Generate(dir string, p Params) ([]string, error) {
+	p = p.withDefaults()
+	if err := os.MkdirAll(dir, 0o755); err != nil {
+		return nil, fmt.Errorf("synth dir: %w", err)
+	}
+	var files []string
+	write := func(name, src string) error {
+		path := filepath.Join(dir, name)
+		if err := os.WriteFile(path, []byte(src), 0o644); err != nil {
+			return fmt.Errorf("write %s: %w", name, err)
+		}
+		files = append(files, path)
+		return nil
+	}
+	for k := 0; k < p.Packages; k++ {
+		if err := write(fmt.Sprintf("pkg_%d.vhd", k), packageSource(k)); err != nil {
+			return nil, err
+		}
+	}
+	for i := 0; i < p.Entities; i++ {
+		if err := write(fmt.Sprintf("e_%d.vhd", i), entitySource(p, i)); err != nil {
+			return nil, err
+		}
+	}
+	return files, nil
+}
+
+// children returns the entities instantiated by entity i: level(i) is
+// i % (Depth+1), and the children are the next Children entities of the
+// next level.
+func (p Params) children(i int) []int {
+	levels := p.Depth + 1
+	if i%levels == p.Depth {
+		return nil
+	}
+	var out []int
+	for c := 0; c < p.Children; c++ {
+		j := i + 1 + c*levels
+		if j >= p.Entities {
+			break
+		}
+		out = append(out, j)
+	}
+	return out
+}
+
+// packages returns the packages entity i uses.
+func (p Params) packages(i int) []int {
+	if p.Packages == 0 {
+		return nil
+	}
+	var out []int
+	for m := 0; m < p.PackageFanIn; m++ {
+		out = append(out, (i+m*7)%p.Packages)
+	}
+	// Distinct, in use-clause order
+	seen := make(map[int]bool, len(out))
+	uniq := out[:0]
+	for _, k := range out {
+		if !seen[k] {
+			seen[k] = true
+			uniq = append(uniq, k)
+		}
+	}
+	return uniq
+}
+
+func packageSource(k int) string {
+	var b strings.Builder
+	fmt.Fprintf(&b, `library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+
+package pkg_%[1]d is
+  constant PKG_%[1]d_WIDTH : integer := 8;
+  type pkg_%[1]d_state_t is (P%[1]d_IDLE, P%[1]d_RUN, P%[1]d_DONE);
+  subtype pkg_%[1]d_word_t is std_logic_vector(PKG_%[1]d_WIDTH - 1 downto 0);
+  function pkg_%[1]d_inc(x : unsigned) return unsigned;
+end package pkg_%[1]d;
+
+package body pkg_%[1]d is
+  function pkg_%[1]d_inc(x : unsigned) return unsigned is
+  begin
+    return x + 1;
+  end function pkg_%[1]d_inc;
+end package body pkg_%[1]d;
+`, k)
+	return b.String()
+}
+
+func entitySource(p Params, i int) string {
+	children := p.children(i)
+	pkgs := p.packages(i)
+	genWidth := 1 << p.GenerateNesting
+
+	var b strings.Builder
+	b.WriteString("library ieee;\nuse ieee.std_logic_1164.all;\nuse ieee.numeric_std.all;\n")
+	for _, k := range pkgs {
+		fmt.Fprintf(&b, "use work.pkg_%d.all;\n", k)
+	}
+	fmt.Fprintf(&b, `
+entity e_%[1]d is
+  port (
+    clk  : in  std_logic;
+    rst  : in  std_logic;
+    din  : in  std_logic_vector(7 downto 0);
+    dout : out std_logic_vector(7 downto 0)
+  );
+end entity e_%[1]d;
+
+architecture rtl of e_%[1]d is
+`, i)
+	for m := 0; m < p.Processes; m++ {
+		fmt.Fprintf(&b, "  signal r_%d : std_logic_vector(7 downto 0);\n", m)
+	}
+	for c := range children {
+		fmt.Fprintf(&b, "  signal c_%d : std_logic_vector(7 downto 0);\n", c)
+	}
+	for _, k := range pkgs {
+		fmt.Fprintf(&b, "  signal cnt_%[1]d : unsigned(PKG_%[1]d_WIDTH - 1 downto 0);\n", k)
+	}
+	fmt.Fprintf(&b, "  signal gen_q : std_logic_vector(%d downto 0);\n", genWidth-1)
+	b.WriteString("begin\n")
+
+	for m := 0; m < p.Processes; m++ {
+		src := "din"
+		if m > 0 {
+			src = fmt.Sprintf("r_%d", m-1)
+		}
+		fmt.Fprintf(&b, `  p_%[1]d : process (clk)
+  begin
+    if rising_edge(clk) then
+      if rst = '1' then
+        r_%[1]d <= (others => '0');
+`, m)
+		if m == 0 {
+			for _, k := range pkgs {
+				fmt.Fprintf(&b, "        cnt_%d <= (others => '0');\n", k)
+			}
+		}
+		b.WriteString("      else\n")
+		fmt.Fprintf(&b, "        r_%d <= %s;\n", m, src)
+		if m == 0 {
+			for _, k := range pkgs {
+				fmt.Fprintf(&b, "        cnt_%[1]d <= pkg_%[1]d_inc(cnt_%[1]d);\n", k)
+			}
+		}
+		fmt.Fprintf(&b, `      end if;
+    end if;
+  end process p_%d;
+
+`, m)
+	}
+
+	last := fmt.Sprintf("r_%d", p.Processes-1)
+	for c, j := range children {
+		fmt.Fprintf(&b, `  u_%[1]d : entity work.e_%[2]d
+    port map (clk => clk, rst => rst, din => %[3]s, dout => c_%[1]d);
+
+`, c, j, last)
+	}
+
+	if p.GenerateNesting > 0 {
+		var index []string
+		for g := 0; g < p.GenerateNesting; g++ {
+			indent := strings.Repeat("  ", g+1)
+			fmt.Fprintf(&b, "%sg_%d : for i%d in 0 to 1 generate\n", indent, g, g)
+			index = append(index, fmt.Sprintf("%d*i%d", 1<<g, g))
+		}
+		indent := strings.Repeat("  ", p.GenerateNesting+1)
+		fmt.Fprintf(&b, "%sgen_q(%s) <= %s(0);\n", indent, strings.Join(index, " + "), last)
+		for g := p.GenerateNesting - 1; g >= 0; g-- {
+			indent := strings.Repeat("  ", g+1)
+			fmt.Fprintf(&b, "%send generate g_%d;\n", indent, g)
+		}
+		b.WriteString("\n")
+	} else {
+		fmt.Fprintf(&b, "  gen_q(0) <= %s(0);\n\n", last)
+	}
+
+	out := last
+	for c := range children {
+		out += fmt.Sprintf(" xor c_%d", c)
+	}
+	fmt.Fprintf(&b, "  dout <= %s;\nend architecture rtl;\n", out)
+	return b.String()
+}
@@ -0,0 +1,69 @@
+package synth
+
+import (
+	"os"
+	"path/filepath"
+	"reflect"
+	"strings"
+	"testing"
+)
+
+func TestGenerateIsDeterministic(t *testing.T) {
+	p := Params{Entities: 10, Depth: 2, Children: 2, Processes: 3, GenerateNesting: 2, Packages: 3, PackageFanIn: 2}
+	a, b := t.TempDir(), t.TempDir()
+	filesA, err := Generate(a, p)
+	if err != nil {
+		t.Fatalf("generate: %v", err)
+	}
+	filesB, err := Generate(b, p)
+	if err != nil {
+		t.Fatalf("generate: %v", err)
+	}
+	if len(filesA) != p.Packages+p.Entities || len(filesA) != len(filesB) {
+		t.Fatalf("got %d and %d files, want %d", len(filesA), len(filesB), p.Packages+p.Entities)
+	}
+	for i := range filesA {
+		srcA, _ := os.ReadFile(filesA[i])
+		srcB, _ := os.ReadFile(filesB[i])
+		if filepath.Base(filesA[i]) != filepath.Base(filesB[i]) || string(srcA) != string(srcB) {
+			t.Fatalf("%s differs between runs", filesA[i])
+		}
+	}
+}
+
+func TestGenerateShape(t *testing.T) {
+	p := Params{Entities: 7, Depth: 2, Children: 2, Processes: 2, GenerateNesting: 3, Packages: 2, PackageFanIn: 2}
+	dir := t.TempDir()
+	if _, err := Generate(dir, p); err != nil {
+		t.Fatalf("generate: %v", err)
+	}
+	// Levels are i % 3: e_0 -> e_1, e_4; e_1 -> e_2, e_5; e_2 is a leaf
+	for i, want := range map[int][]int{0: {1, 4}, 1: {2, 5}, 2: nil, 3: {4}, 5: nil} {
+		if got := p.withDefaults().children(i); !reflect.DeepEqual(got, want) {
+			t.Errorf("children(%d) = %v, want %v", i, got, want)
+		}
+	}
+
+	src, err := os.ReadFile(filepath.Join(dir, "e_0.vhd"))
+	if err != nil {
+		t.Fatalf("read e_0: %v", err)
+	}
+	text := string(src)
+	for _, want := range []string{
+		"use work.pkg_0.all;",
+		"use work.pkg_1.all;",
+		"u_0 : entity work.e_1",
+		"u_1 : entity work.e_4",
+		"p_1 : process (clk)",
+		"g_2 : for i2 in 0 to 1 generate",
+		"gen_q(1*i0 + 2*i1 + 4*i2) <= r_1(0);",
+		"dout <= r_1 xor c_0 xor c_1;",
+	} {
+		if !strings.Contains(text, want) {
+			t.Errorf("e_0.vhd lacks %q:\n%s", want, text)
+		}
+	}
+	if got, want := strings.Count(text, "generate"), 2*p.GenerateNesting; got != want {
+		t.Errorf("generate keywords = %d, want %d", got, want)
+	}
+}
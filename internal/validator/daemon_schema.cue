@@ -191,6 +191,15 @@ package daemon_schema
     info:             int & >=0
 }
 
+// One step of an evaluation; start_ms is relative to its start
+#Timing: {
+    name:        string & !=""
+    start_ms:    number & >=0
+    duration_ms: number & >=0
+    thread:      int & >=0
+    count:       int & >=0
+}
+
 #PolicyDaemonCommand: {
     kind: "init"
     tables: #FactTables
@@ -200,12 +209,20 @@ package daemon_schema
     removed: #FactTables
 } | {
     kind: "snapshot"
+} | {
+    // Protocol negotiation; the daemon answers with the chosen protocol
+    kind:      "hello"
+    protocols: [...string]
 }
 
 #PolicyDaemonResponse: {
     kind: "snapshot"
     summary:    #Summary
     violations: [...#Violation]
+    timings?:   [...#Timing]
+} | {
+    kind:     "hello"
+    protocol: "json" | "frames-v1"
 } | {
     kind:    "error"
     message: string & !=""
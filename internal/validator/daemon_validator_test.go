@@ -61,6 +61,9 @@ func TestPolicyDaemonValidator(t *testing.T) {
 			"info":             0,
 		},
 		"violations": []map[string]any{},
+		"timings": []map[string]any{
+			{"name": "step", "start_ms": 0.5, "duration_ms": 1.25, "thread": 0, "count": 0},
+		},
 	})
 	if err != nil {
 		t.Fatalf("marshal response: %v", err)
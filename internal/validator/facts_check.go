@@ -0,0 +1,283 @@
+package validator
+
+import (
+	"fmt"
+	"regexp"
+
+	"github.com/robert-at-pretension-io/vhdl-lint/internal/facts"
+)
+
+// =============================================================================
+// TYPED FACT TABLE CHECKS
+// =============================================================================
+//
+// checkTables is facts_schema.cue written out as Go: the same constraints on
+// the same fields, checked on the typed rows without encoding the tables to
+// JSON and unifying them with CUE. The schema stays the source of truth:
+// - TestCheckTablesFieldsMatchSchema fails when a #...Row definition and
+//   its row struct disagree on fields
+// - TestCheckTablesAgreesWithCUE runs valid and broken rows through both
+// - ValidateFast asks CUE again whenever the typed check fails, so errors
+//   are CUE's and a disagreement is reported instead of hidden
+//
+// When you change facts_schema.cue, change this file in the same commit.
+// =============================================================================
+
+var (
+	// #Identifier
+	identifierRe = regexp.MustCompile(`^(?:[a-zA-Z_][a-zA-Z0-9_]*|\\.+\\)$`)
+	// #QualifiedIdentifier (also covers #Identifier)
+	qualifiedIdentifierRe = regexp.MustCompile(`^(?:[a-zA-Z_][a-zA-Z0-9_]*|\\.+\\)(?:\.(?:[a-zA-Z_][a-zA-Z0-9_]*|\\.+\\))*$`)
+	// file: string & =~".+\\.(vhd|vhdl)$"
+	vhdlFileRe = regexp.MustCompile(`.+\.(vhd|vhdl)$`)
+)
+
+// tableCheck keeps the first failed constraint.
+type tableCheck struct {
+	table string
+	row   int
+	err   error
+}
+
+func (c *tableCheck) at(table string, row int) bool {
+	c.table, c.row = table, row
+	return c.err == nil
+}
+
+func (c *tableCheck) fail(field, constraint string, value interface{}) {
+	if c.err == nil {
+		c.err = fmt.Errorf("%s.%d.%s: %#v does not satisfy %s", c.table, c.row, field, value, constraint)
+	}
+}
+
+func (c *tableCheck) list(table string, isNil bool) {
+	if isNil && c.err == nil {
+		c.err = fmt.Errorf("%s: null is not a list", table)
+	}
+}
+
+func (c *tableCheck) identifier(field, s string) {
+	if !identifierRe.MatchString(s) {
+		c.fail(field, "#Identifier", s)
+	}
+}
+
+func (c *tableCheck) identifierOrEmpty(field, s string) {
+	if s != "" && !identifierRe.MatchString(s) {
+		c.fail(field, `#Identifier | ""`, s)
+	}
+}
+
+func (c *tableCheck) qualified(field, s string) {
+	if !qualifiedIdentifierRe.MatchString(s) {
+		c.fail(field, "#QualifiedIdentifier | #Identifier", s)
+	}
+}
+
+func (c *tableCheck) file(field, s string) {
+	if !vhdlFileRe.MatchString(s) {
+		c.fail(field, `=~".+\\.(vhd|vhdl)$"`, s)
+	}
+}
+
+func (c *tableCheck) nonEmpty(field, s string) {
+	if s == "" {
+		c.fail(field, `!=""`, s)
+	}
+}
+
+func (c *tableCheck) line(v int) {
+	if v < 1 {
+		c.fail("line", ">=1", v)
+	}
+}
+
+func (c *tableCheck) direction(s string) {
+	switch s {
+	case "in", "out", "inout", "buffer", "linkage", "":
+	default:
+		c.fail("direction", `"in" | "out" | "inout" | "buffer" | "linkage" | ""`, s)
+	}
+}
+
+// checkTables returns the first row that breaks facts_schema.cue's
+// #FactTables, or nil.
+func checkTables(t facts.Tables) error {
+	var c tableCheck
+	c.list("files", t.Files == nil)
+	c.list("entities", t.Entities == nil)
+	c.list("architectures", t.Architectures == nil)
+	c.list("packages", t.Packages == nil)
+	c.list("ports", t.Ports == nil)
+	c.list("signals", t.Signals == nil)
+	c.list("instances", t.Instances == nil)
+	c.list("dependencies", t.Dependencies == nil)
+	c.list("use_clauses", t.UseClauses == nil)
+	c.list("library_clauses", t.LibraryClauses == nil)
+	c.list("context_clauses", t.ContextClauses == nil)
+	c.list("processes", t.Processes == nil)
+	c.list("generates", t.Generates == nil)
+	c.list("types", t.Types == nil)
+	c.list("subtypes", t.Subtypes == nil)
+	c.list("functions", t.Functions == nil)
+	c.list("procedures", t.Procedures == nil)
+	c.list("constants", t.Constants == nil)
+	c.list("symbols", t.Symbols == nil)
+
+	for i, r := range t.Files {
+		if !c.at("files", i) {
+			break
+		}
+		c.file("path", r.Path)
+	}
+	for i, r := range t.Entities {
+		if !c.at("entities", i) {
+			break
+		}
+		c.identifier("name", r.Name)
+		c.file("file", r.File)
+		c.line(r.Line)
+	}
+	for i, r := range t.Architectures {
+		if !c.at("architectures", i) {
+			break
+		}
+		c.identifier("name", r.Name)
+		c.identifier("entity_name", r.EntityName)
+		c.file("file", r.File)
+		c.line(r.Line)
+	}
+	for i, r := range t.Packages {
+		if !c.at("packages", i) {
+			break
+		}
+		c.identifier("name", r.Name)
+		c.file("file", r.File)
+		c.line(r.Line)
+	}
+	for i, r := range t.Ports {
+		if !c.at("ports", i) {
+			break
+		}
+		c.identifier("entity", r.Entity)
+		c.identifier("name", r.Name)
+		c.direction(r.Direction)
+		c.nonEmpty("type", r.Type)
+		c.file("file", r.File)
+		c.line(r.Line)
+	}
+	for i, r := range t.Signals {
+		if !c.at("signals", i) {
+			break
+		}
+		c.identifier("name", r.Name)
+		c.nonEmpty("type", r.Type)
+		c.file("file", r.File)
+		c.line(r.Line)
+	}
+	for i, r := range t.Instances {
+		if !c.at("instances", i) {
+			break
+		}
+		c.identifier("name", r.Name)
+		c.qualified("target", r.Target)
+		c.file("file", r.File)
+		c.line(r.Line)
+	}
+	for i, r := range t.Dependencies {
+		if !c.at("dependencies", i) {
+			break
+		}
+		c.file("file", r.File)
+		c.nonEmpty("target", r.Target)
+		c.line(r.Line)
+	}
+	for i, r := range t.UseClauses {
+		if !c.at("use_clauses", i) {
+			break
+		}
+		c.file("file", r.File)
+		c.line(r.Line)
+	}
+	for i, r := range t.LibraryClauses {
+		if !c.at("library_clauses", i) {
+			break
+		}
+		c.file("file", r.File)
+		c.identifier("library", r.Library)
+		c.line(r.Line)
+	}
+	for i, r := range t.ContextClauses {
+		if !c.at("context_clauses", i) {
+			break
+		}
+		c.file("file", r.File)
+		c.nonEmpty("name", r.Name)
+		c.line(r.Line)
+	}
+	for i, r := range t.Processes {
+		if !c.at("processes", i) {
+			break
+		}
+		c.file("file", r.File)
+		c.line(r.Line)
+	}
+	for i, r := range t.Generates {
+		if !c.at("generates", i) {
+			break
+		}
+		c.file("file", r.File)
+		c.line(r.Line)
+	}
+	for i, r := range t.Types {
+		if !c.at("types", i) {
+			break
+		}
+		c.identifier("name", r.Name)
+		c.file("file", r.File)
+		c.line(r.Line)
+	}
+	for i, r := range t.Subtypes {
+		if !c.at("subtypes", i) {
+			break
+		}
+		c.identifier("name", r.Name)
+		c.nonEmpty("base_type", r.BaseType)
+		c.file("file", r.File)
+		c.line(r.Line)
+	}
+	for i, r := range t.Functions {
+		if !c.at("functions", i) {
+			break
+		}
+		c.identifierOrEmpty("name", r.Name)
+		c.file("file", r.File)
+		c.line(r.Line)
+	}
+	for i, r := range t.Procedures {
+		if !c.at("procedures", i) {
+			break
+		}
+		c.identifierOrEmpty("name", r.Name)
+		c.file("file", r.File)
+		c.line(r.Line)
+	}
+	for i, r := range t.Constants {
+		if !c.at("constants", i) {
+			break
+		}
+		c.identifier("name", r.Name)
+		c.nonEmpty("type", r.Type)
+		c.file("file", r.File)
+		c.line(r.Line)
+	}
+	for i, r := range t.Symbols {
+		if !c.at("symbols", i) {
+			break
+		}
+		c.qualified("name", r.Name)
+		c.file("file", r.File)
+		c.line(r.Line)
+	}
+	return c.err
+}
@@ -0,0 +1,149 @@
+package validator
+
+import (
+	"reflect"
+	"sort"
+	"strings"
+	"testing"
+
+	"cuelang.org/go/cue"
+
+	"github.com/robert-at-pretension-io/vhdl-lint/internal/facts"
+)
+
+func validFactTables() facts.Tables {
+	return facts.Tables{
+		Files:          []facts.FileRow{{Path: "a.vhd", Library: "work"}},
+		Entities:       []facts.EntityRow{{Name: "top", File: "a.vhd", Line: 1}},
+		Architectures:  []facts.ArchitectureRow{{Name: "rtl", EntityName: "top", File: "a.vhd", Line: 5}},
+		Packages:       []facts.PackageRow{{Name: "pkg", File: "a.vhd", Line: 9}},
+		Ports:          []facts.PortRow{{Entity: "top", Name: "clk", Direction: "in", Type: "std_logic", File: "a.vhd", Line: 2}},
+		Signals:        []facts.SignalRow{{Name: "s", Type: "std_logic", File: "a.vhd", Line: 6, Scope: "rtl"}},
+		Instances:      []facts.InstanceRow{{Name: "u0", Target: "work.child", File: "a.vhd", Line: 7, InArch: "rtl"}},
+		Dependencies:   []facts.DependencyRow{{File: "a.vhd", Target: "work.child", Kind: "instantiation", Line: 7}},
+		UseClauses:     []facts.UseClauseRow{{File: "a.vhd", Item: "ieee.std_logic_1164.all", Line: 1}},
+		LibraryClauses: []facts.LibraryClauseRow{{File: "a.vhd", Library: "ieee", Line: 1}},
+		ContextClauses: []facts.ContextClauseRow{{File: "a.vhd", Name: "work.ctx", Line: 1}},
+		Processes:      []facts.ProcessRow{{Label: "p", File: "a.vhd", Line: 8, InArch: "rtl", IsSequential: true}},
+		Generates:      []facts.GenerateRow{{Label: "g", Kind: "for", File: "a.vhd", Line: 8, InArch: "rtl"}},
+		Types:          []facts.TypeRow{{Name: "state_t", Kind: "enum", File: "a.vhd", Line: 10, InPackage: "pkg"}},
+		Subtypes:       []facts.SubtypeRow{{Name: "byte_t", BaseType: "std_logic_vector", File: "a.vhd", Line: 11, InPackage: "pkg"}},
+		Functions:      []facts.FunctionRow{{Name: "f", File: "a.vhd", Line: 12, InPackage: "pkg", IsPure: true}},
+		Procedures:     []facts.ProcedureRow{{Name: "", File: "a.vhd", Line: 13, InPackage: "pkg"}},
+		Constants:      []facts.ConstantRow{{Name: "W", Type: "integer", Value: "8", File: "a.vhd", Line: 14, InPackage: "pkg"}},
+		Symbols:        []facts.SymbolRow{{Name: "work.top", Kind: "entity", File: "a.vhd", Line: 1}},
+	}
+}
+
+func TestCheckTablesAgreesWithCUE(t *testing.T) {
+	v, err := NewFactsValidator()
+	if err != nil {
+		t.Fatalf("new facts validator: %v", err)
+	}
+
+	cases := []struct {
+		name   string
+		mutate func(*facts.Tables)
+	}{
+		{"valid", func(*facts.Tables) {}},
+		{"extended identifier", func(t *facts.Tables) { t.Entities[0].Name = `\my entity\` }},
+		{"null table", func(t *facts.Tables) { t.Symbols = nil }},
+		{"file extension", func(t *facts.Tables) { t.Files[0].Path = "a.txt" }},
+		{"row file extension", func(t *facts.Tables) { t.Signals[0].File = "a.v" }},
+		{"line zero", func(t *facts.Tables) { t.Entities[0].Line = 0 }},
+		{"bad identifier", func(t *facts.Tables) { t.Packages[0].Name = "1pkg" }},
+		{"bad entity name", func(t *facts.Tables) { t.Architectures[0].EntityName = "" }},
+		{"bad direction", func(t *facts.Tables) { t.Ports[0].Direction = "input" }},
+		{"empty direction", func(t *facts.Tables) { t.Ports[0].Direction = "" }},
+		{"empty port type", func(t *facts.Tables) { t.Ports[0].Type = "" }},
+		{"qualified target", func(t *facts.Tables) { t.Instances[0].Target = "work.a.b" }},
+		{"bad target", func(t *facts.Tables) { t.Instances[0].Target = "work..a" }},
+		{"empty dependency", func(t *facts.Tables) { t.Dependencies[0].Target = "" }},
+		{"free use item", func(t *facts.Tables) { t.UseClauses[0].Item = "not an identifier!" }},
+		{"bad library", func(t *facts.Tables) { t.LibraryClauses[0].Library = "ieee.std" }},
+		{"empty context", func(t *facts.Tables) { t.ContextClauses[0].Name = "" }},
+		{"empty base type", func(t *facts.Tables) { t.Subtypes[0].BaseType = "" }},
+		{"bad function name", func(t *facts.Tables) { t.Functions[0].Name = `"+"` }},
+		{"empty constant type", func(t *facts.Tables) { t.Constants[0].Type = "" }},
+		{"bad symbol", func(t *facts.Tables) { t.Symbols[0].Name = "work." }},
+	}
+	for _, tc := range cases {
+		tables := validFactTables()
+		tc.mutate(&tables)
+		fastErr := checkTables(tables)
+		cueErr := v.Validate(tables)
+		if (fastErr == nil) != (cueErr == nil) {
+			t.Errorf("%s: typed check says %v, CUE says %v", tc.name, fastErr, cueErr)
+		}
+		if err := v.ValidateFast(tables); (err == nil) != (cueErr == nil) {
+			t.Errorf("%s: ValidateFast says %v, CUE says %v", tc.name, err, cueErr)
+		}
+	}
+}
+
+// TestCheckTablesFieldsMatchSchema fails when facts_schema.cue gains, loses or
+// renames a field, so facts_check.go is revisited with it.
+func TestCheckTablesFieldsMatchSchema(t *testing.T) {
+	v, err := NewFactsValidator()
+	if err != nil {
+		t.Fatalf("new facts validator: %v", err)
+	}
+
+	rows := map[string]interface{}{
+		"files":           facts.FileRow{},
+		"entities":        facts.EntityRow{},
+		"architectures":   facts.ArchitectureRow{},
+		"packages":        facts.PackageRow{},
+		"ports":           facts.PortRow{},
+		"signals":         facts.SignalRow{},
+		"instances":       facts.InstanceRow{},
+		"dependencies":    facts.DependencyRow{},
+		"use_clauses":     facts.UseClauseRow{},
+		"library_clauses": facts.LibraryClauseRow{},
+		"context_clauses": facts.ContextClauseRow{},
+		"processes":       facts.ProcessRow{},
+		"generates":       facts.GenerateRow{},
+		"types":           facts.TypeRow{},
+		"subtypes":        facts.SubtypeRow{},
+		"functions":       facts.FunctionRow{},
+		"procedures":      facts.ProcedureRow{},
+		"constants":       facts.ConstantRow{},
+		"symbols":         facts.SymbolRow{},
+	}
+	if got, want := cueFields(t, v.tables), jsonFields(facts.Tables{}); !reflect.DeepEqual(got, want) {
+		t.Fatalf("#FactTables fields = %v, facts.Tables has %v", got, want)
+	}
+	for table, row := range rows {
+		elem := v.tables.LookupPath(cue.ParsePath(table)).LookupPath(cue.MakePath(cue.AnyIndex))
+		if elem.Err() != nil {
+			t.Fatalf("%s: element definition: %v", table, elem.Err())
+		}
+		if got, want := cueFields(t, elem), jsonFields(row); !reflect.DeepEqual(got, want) {
+			t.Errorf("%s: schema fields %v, row struct fields %v", table, got, want)
+		}
+	}
+}
+
+func cueFields(t *testing.T, v cue.Value) []string {
+	t.Helper()
+	it, err := v.Fields(cue.Optional(true))
+	if err != nil {
+		t.Fatalf("fields: %v", err)
+	}
+	var names []string
+	for it.Next() {
+		names = append(names, it.Selector().String())
+	}
+	sort.Strings(names)
+	return names
+}
+
+func jsonFields(row interface{}) []string {
+	typ := reflect.TypeOf(row)
+	names := make([]string, 0, typ.NumField())
+	for i := 0; i < typ.NumField(); i++ {
+		names = append(names, strings.Split(typ.Field(i).Tag.Get("json"), ",")[0])
+	}
+	sort.Strings(names)
+	return names
+}
@@ -18,6 +18,7 @@ package schema
     stats:        #Stats
     files:        [...#FileResult]
     parse_errors: [...#ParseError] | *[]
+    warnings:     [...string] | *[]
 }
 
 // Violation represents a policy violation found by the linter
@@ -28,13 +28,18 @@ package validator
 // =============================================================================
 
 import (
+	"crypto/sha256"
 	"embed"
+	"encoding/hex"
 	"encoding/json"
 	"fmt"
+	"sync"
 
 	"cuelang.org/go/cue"
 	"cuelang.org/go/cue/cuecontext"
 	"cuelang.org/go/cue/errors"
+
+	"github.com/robert-at-pretension-io/vhdl-lint/internal/facts"
 )
 
 //go:embed schema.cue
@@ -56,6 +61,9 @@ var daemonSchemaFS embed.FS
 type Validator struct {
 	ctx    *cue.Context
 	schema cue.Value
+	// Definitions looked up once in New
+	input cue.Value
+	tag   cue.Value
 }
 
 // New creates a new Validator with the embedded CUE schema
@@ -73,12 +81,40 @@ func New() (*Validator, error) {
 		return nil, fmt.Errorf("compiling schema: %w", schema.Err())
 	}
 
+	// Get the #Input and #VerificationTag definitions from the schema
+	inputDef := schema.LookupPath(cue.ParsePath("#Input"))
+	if inputDef.Err() != nil {
+		return nil, fmt.Errorf("looking up #Input definition: %w", inputDef.Err())
+	}
+	tagDef := schema.LookupPath(cue.ParsePath("#VerificationTag"))
+	if tagDef.Err() != nil {
+		return nil, fmt.Errorf("looking up #VerificationTag definition: %w", tagDef.Err())
+	}
+
 	return &Validator{
 		ctx:    ctx,
 		schema: schema,
+		input:  inputDef,
+		tag:    tagDef,
 	}, nil
 }
 
+var inputSchemaHash = sync.OnceValue(func() string {
+	schemaBytes, err := schemaFS.ReadFile("schema.cue")
+	if err != nil {
+		return ""
+	}
+	sum := sha256.Sum256(schemaBytes)
+	return hex.EncodeToString(sum[:])
+})
+
+// InputSchemaHash identifies the embedded schema.cue, so a caller that skips
+// re-validating data checked by an earlier run can tell whether that run
+// used the same contract.
+func InputSchemaHash() string {
+	return inputSchemaHash()
+}
+
 // Validate checks that the input data conforms to the CUE schema.
 // This enforces the contract between Go and the policy engine.
 // Returns nil if valid, or a detailed error explaining what failed.
@@ -95,14 +131,8 @@ func (v *Validator) Validate(data interface{}) error {
 		return fmt.Errorf("compiling data as CUE: %w", dataValue.Err())
 	}
 
-	// Get the #Input definition from the schema
-	inputDef := v.schema.LookupPath(cue.ParsePath("#Input"))
-	if inputDef.Err() != nil {
-		return fmt.Errorf("looking up #Input definition: %w", inputDef.Err())
-	}
-
 	// Unify the data with the schema (this is CUE's type checking)
-	unified := inputDef.Unify(dataValue)
+	unified := v.input.Unify(dataValue)
 	if err := unified.Validate(); err != nil {
 		return fmt.Errorf("schema validation failed: %w", err)
 	}
@@ -117,12 +147,7 @@ func (v *Validator) ValidateJSON(jsonBytes []byte) error {
 		return fmt.Errorf("compiling JSON as CUE: %w", dataValue.Err())
 	}
 
-	inputDef := v.schema.LookupPath(cue.ParsePath("#Input"))
-	if inputDef.Err() != nil {
-		return fmt.Errorf("looking up #Input definition: %w", inputDef.Err())
-	}
-
-	unified := inputDef.Unify(dataValue)
+	unified := v.input.Unify(dataValue)
 	if err := unified.Validate(); err != nil {
 		return fmt.Errorf("schema validation failed: %w", err)
 	}
@@ -141,12 +166,7 @@ func (v *Validator) ValidateVerificationTag(tag interface{}) error {
 		return fmt.Errorf("compiling tag as CUE: %w", dataValue.Err())
 	}
 
-	tagDef := v.schema.LookupPath(cue.ParsePath("#VerificationTag"))
-	if tagDef.Err() != nil {
-		return fmt.Errorf("looking up #VerificationTag definition: %w", tagDef.Err())
-	}
-
-	unified := tagDef.Unify(dataValue)
+	unified := v.tag.Unify(dataValue)
 	if err := unified.Validate(); err != nil {
 		return fmt.Errorf("tag schema validation failed: %w", err)
 	}
@@ -165,12 +185,7 @@ func (v *Validator) ValidationErrors(data interface{}) []string {
 		return []string{fmt.Sprintf("compile error: %v", dataValue.Err())}
 	}
 
-	inputDef := v.schema.LookupPath(cue.ParsePath("#Input"))
-	if inputDef.Err() != nil {
-		return []string{fmt.Sprintf("schema lookup error: %v", inputDef.Err())}
-	}
-
-	unified := inputDef.Unify(dataValue)
+	unified := v.input.Unify(dataValue)
 	err = unified.Validate()
 	if err == nil {
 		return nil
@@ -239,6 +254,7 @@ func (v *OutputValidator) Validate(data interface{}) error {
 type FactsValidator struct {
 	ctx    *cue.Context
 	schema cue.Value
+	tables cue.Value
 }
 
 // NewFactsValidator creates a validator for relational fact tables.
@@ -255,9 +271,15 @@ func NewFactsValidator() (*FactsValidator, error) {
 		return nil, fmt.Errorf("compiling facts schema: %w", schema.Err())
 	}
 
+	factsDef := schema.LookupPath(cue.ParsePath("#FactTables"))
+	if factsDef.Err() != nil {
+		return nil, fmt.Errorf("looking up #FactTables definition: %w", factsDef.Err())
+	}
+
 	return &FactsValidator{
 		ctx:    ctx,
 		schema: schema,
+		tables: factsDef,
 	}, nil
 }
 
@@ -273,12 +295,7 @@ func (v *FactsValidator) Validate(data interface{}) error {
 		return fmt.Errorf("compiling facts as CUE: %w", dataValue.Err())
 	}
 
-	factsDef := v.schema.LookupPath(cue.ParsePath("#FactTables"))
-	if factsDef.Err() != nil {
-		return fmt.Errorf("looking up #FactTables definition: %w", factsDef.Err())
-	}
-
-	unified := factsDef.Unify(dataValue)
+	unified := v.tables.Unify(dataValue)
 	if err := unified.Validate(); err != nil {
 		return fmt.Errorf("facts schema validation failed: %w", err)
 	}
@@ -286,6 +303,22 @@ func (v *FactsValidator) Validate(data interface{}) error {
 	return nil
 }
 
+// ValidateFast checks the tables with the typed checks of facts_check.go
+// instead of CUE. Tables that pass are accepted; tables that fail are
+// validated again by CUE so the error is the schema's own. If CUE accepts
+// what the typed checks rejected, the two have drifted apart: that is an
+// error too, never a silent pass.
+func (v *FactsValidator) ValidateFast(tables facts.Tables) error {
+	fastErr := checkTables(tables)
+	if fastErr == nil {
+		return nil
+	}
+	if err := v.Validate(tables); err != nil {
+		return err
+	}
+	return fmt.Errorf("typed facts check disagrees with facts_schema.cue (update facts_check.go): %w", fastErr)
+}
+
 // PolicyDaemonValidator validates vhdl_policyd command/response payloads.
 type PolicyDaemonValidator struct {
 	ctx    *cue.Context
@@ -1,32 +1,45 @@
 use std::error::Error;
 use std::fs::File;
-use std::io::{self, Read};
+use std::io::{self, BufWriter, Read, Write};
+use std::path::Path;
 
+use vhdl_compiler::policy::binary_input::{self, MappedFile};
 use vhdl_compiler::policy::engine;
 use vhdl_compiler::policy::input::Input;
 
 fn main() -> Result<(), Box<dyn Error>> {
     let args: Vec<String> = std::env::args().collect();
-    let input = if args.len() > 1 {
-        read_input_file(&args[1])?
-    } else {
-        read_input_stdin()?
+    let input = match args.get(1).map(String::as_str) {
+        Some("--input-bin") => {
+            let path = args.get(2).ok_or("--input-bin requires a path")?;
+            read_input_binary(path)?
+        }
+        Some(path) => read_input_file(path)?,
+        None => read_input_stdin()?,
     };
 
     let result = engine::evaluate(&input);
-    serde_json::to_writer_pretty(std::io::stdout(), &result)?;
+    let mut out = BufWriter::new(io::stdout().lock());
+    serde_json::to_writer(&mut out, &result)?;
+    out.flush()?;
     Ok(())
 }
 
+fn read_input_binary(path: &str) -> Result<Input, Box<dyn Error>> {
+    let mapped = MappedFile::open(Path::new(path))?;
+    let input: Input = binary_input::from_bytes(mapped.bytes())?;
+    Ok(input)
+}
+
 fn read_input_file(path: &str) -> Result<Input, Box<dyn Error>> {
     let file = File::open(path)?;
-    let input: Input = serde_json::from_reader(file)?;
+    let input: Input = serde_json::from_reader(io::BufReader::new(file))?;
     Ok(input)
 }
 
 fn read_input_stdin() -> Result<Input, Box<dyn Error>> {
-    let mut buf = String::new();
-    io::stdin().read_to_string(&mut buf)?;
-    let input: Input = serde_json::from_str(&buf)?;
+    let mut buf = Vec::new();
+    io::stdin().read_to_end(&mut buf)?;
+    let input: Input = serde_json::from_slice(&buf)?;
     Ok(input)
 }
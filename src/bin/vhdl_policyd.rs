@@ -1,12 +1,18 @@
-use std::cell::RefCell;
+use std::collections::hash_map::DefaultHasher;
 use std::collections::HashMap;
 use std::error::Error;
-use std::io::{self, BufRead, Write};
-use std::rc::Rc;
+use std::hash::{Hash, Hasher};
+use std::io::{self, BufRead, Read, Write};
+use std::sync::{mpsc, Arc, Mutex, OnceLock};
+use std::time::{Duration, Instant};
 
 use differential_dataflow::input::InputSession;
-use differential_dataflow::operators::{Consolidate, Join};
+use differential_dataflow::operators::arrange::ArrangeByKey;
+use differential_dataflow::operators::{Consolidate, Count, Join, JoinCore, Reduce};
+use differential_dataflow::Collection;
+use regex::Regex;
 use serde::{Deserialize, Serialize};
+use timely::dataflow::operators::Input as TimelyInput;
 
 #[derive(Debug, Deserialize, Default, Clone)]
 struct Tables {
@@ -20,6 +26,14 @@ struct Tables {
     dependencies: Vec<DependencyRow>,
     #[serde(default)]
     symbols: Vec<SymbolRow>,
+    #[serde(default)]
+    processes: Vec<ProcessRow>,
+    #[serde(default)]
+    signals: Vec<SignalRow>,
+    #[serde(default)]
+    instances: Vec<InstanceRow>,
+    #[serde(default)]
+    generates: Vec<GenerateRow>,
 }
 
 #[derive(Debug, Deserialize)]
@@ -31,8 +45,43 @@ struct Command {
     added: Tables,
     #[serde(default)]
     removed: Tables,
+    /// Offered protocols ("hello" only)
+    #[serde(default)]
+    protocols: Vec<String>,
 }
 
+/// What the stdin reader hands to the dataflow workers.
+enum Message {
+    /// A line-delimited JSON command
+    Command(Command),
+    /// Answer to "hello" with the protocol the reader switched to
+    Hello(&'static str),
+    /// One chunk of a framed command, applied with the given weight
+    Rows(Tables, isize),
+    /// End of a framed command: evaluate and respond
+    Evaluate,
+    /// Unparseable input; reported as an error response
+    Invalid(String),
+}
+
+/// Framed command protocol; see internal/policy/daemon_frames.go for the
+/// layout. Row layouts here must match the Go writer.
+const FRAMES_PROTOCOL: &str = "frames-v1";
+const FRAME_BEGIN: u8 = 1;
+const FRAME_ROWS: u8 = 2;
+const FRAME_END: u8 = 3;
+const REL_ENTITIES: u8 = 1;
+const REL_ARCHITECTURES: u8 = 2;
+const REL_PORTS: u8 = 3;
+const REL_DEPENDENCIES: u8 = 4;
+const REL_SYMBOLS: u8 = 5;
+const REL_PROCESSES: u8 = 6;
+const REL_SIGNALS: u8 = 7;
+const REL_INSTANCES: u8 = 8;
+const REL_GENERATES: u8 = 9;
+/// Upper bound on one frame, so a corrupt length cannot exhaust memory
+const MAX_FRAME_LEN: usize = 1 << 30;
+
 #[derive(Debug, Deserialize, Clone)]
 struct EntityRow {
     name: String,
@@ -70,6 +119,38 @@ struct SymbolRow {
     name: String,
 }
 
+#[derive(Debug, Deserialize, Clone)]
+struct ProcessRow {
+    label: String,
+    file: String,
+    line: i64,
+}
+
+#[derive(Debug, Deserialize, Clone)]
+struct SignalRow {
+    name: String,
+    #[serde(default, rename = "type")]
+    ty: String,
+    scope: String,
+    file: String,
+    line: i64,
+}
+
+#[derive(Debug, Deserialize, Clone)]
+struct InstanceRow {
+    target: String,
+    in_arch: String,
+    file: String,
+    line: i64,
+}
+
+#[derive(Debug, Deserialize, Clone)]
+struct GenerateRow {
+    label: String,
+    file: String,
+    line: i64,
+}
+
 #[derive(Debug, Clone, Eq, PartialEq, Hash)]
 struct ViolationKey {
     rule: String,
@@ -101,279 +182,859 @@ struct Response {
     kind: String,
     summary: Summary,
     violations: Vec<Violation>,
+    #[serde(skip_serializing_if = "Vec::is_empty")]
+    timings: Vec<Timing>,
+}
+
+/// One step of answering a command (apply its rows, drain the dataflow,
+/// build the response), relative to the command's first message. Same
+/// shape as the batch engine's Result::timings.
+#[derive(Debug, Serialize)]
+struct Timing {
+    name: &'static str,
+    start_ms: f64,
+    duration_ms: f64,
+    thread: usize,
+    count: usize,
+}
+
+impl Timing {
+    fn new(
+        name: &'static str,
+        origin: Instant,
+        start: Instant,
+        end: Instant,
+        count: usize,
+    ) -> Self {
+        Timing {
+            name,
+            start_ms: ms(start - origin),
+            duration_ms: ms(end - start),
+            thread: 0,
+            count,
+        }
+    }
+}
+
+fn ms(d: Duration) -> f64 {
+    d.as_secs_f64() * 1000.0
+}
+
+#[derive(Debug, Serialize)]
+struct ControlResponse<'a> {
+    kind: &'a str,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    protocol: Option<&'a str>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    message: Option<String>,
+}
+
+/// The daemon's input relations.
+struct Inputs {
+    /// Worker count and this worker's index, for row ownership
+    peers: usize,
+    index: usize,
+    entities: Session<(String, String, i64)>,
+    architectures: Session<(String, String, i64, String)>,
+    ports: Session<(String, String)>,
+    dependencies: Session<(String, String, i64, String)>,
+    symbols: Session<String>,
+    /// (label, file, line)
+    processes: Session<(String, String, i64)>,
+    /// (scope, name, file, line, vector width); untyped signals are not
+    /// fed, as the batch input leaves them out
+    signals: Session<(String, String, String, i64, usize)>,
+    /// (in_arch, file, line, target)
+    instances: Session<(String, String, i64, String)>,
+    /// (label, file, line)
+    generates: Session<(String, String, i64)>,
 }
 
 fn main() -> Result<(), Box<dyn Error>> {
-    let (tx, rx) = std::sync::mpsc::channel::<String>();
-    let rx = std::sync::Arc::new(std::sync::Mutex::new(rx));
+    let workers = policyd_workers();
+    let (tx, rx) = mpsc::channel::<Message>();
     std::thread::spawn(move || {
         let stdin = io::stdin();
-        for line in stdin.lock().lines() {
-            match line {
-                Ok(line) => {
-                    if tx.send(line).is_err() {
-                        break;
-                    }
-                }
-                Err(_) => break,
+        read_commands(&mut stdin.lock(), &tx);
+    });
+
+    // Every worker sees every message and feeds the rows it owns; only
+    // worker 0 writes to stdout.
+    let mut senders = Vec::with_capacity(workers);
+    let mut receivers = Vec::with_capacity(workers);
+    for _ in 0..workers {
+        let (sender, receiver) = mpsc::channel::<Arc<Message>>();
+        senders.push(sender);
+        receivers.push(Mutex::new(Some(receiver)));
+    }
+    std::thread::spawn(move || {
+        for msg in rx {
+            let msg = Arc::new(msg);
+            for sender in &senders {
+                let _ = sender.send(msg.clone());
             }
         }
     });
+    let receivers = Arc::new(receivers);
 
-    let mut epoch: u64 = 1;
+    // Inspect runs on whichever worker holds a violation; updates are
+    // tagged with their epoch so worker 0 folds in only finished ones.
+    let pending: Arc<Mutex<Vec<(ViolationKey, u64, isize)>>> = Arc::new(Mutex::new(Vec::new()));
 
-    timely::execute_directly(move |worker| {
-        let rx = rx.clone();
+    timely::execute(timely::Config::process(workers), move |worker| {
+        let rx = receivers[worker.index()]
+            .lock()
+            .expect("receiver mutex poisoned")
+            .take()
+            .expect("worker receiver already taken");
+        let leader = worker.index() == 0;
+        let mut epoch: u64 = 1;
         let mut stdout = io::BufWriter::new(io::stdout());
-        let mut entities: Session<(String, String, i64)> = InputSession::new();
-        let mut architectures: Session<(String, String, i64, String)> = InputSession::new();
-        let mut ports: Session<(String, String)> = InputSession::new();
-        let mut dependencies: Session<(String, String, i64, String)> = InputSession::new();
-        let mut symbols: Session<String> = InputSession::new();
+        let mut inputs = Inputs::new(worker.peers(), worker.index());
 
-        let violations_state: Rc<RefCell<HashMap<ViolationKey, isize>>> =
-            Rc::new(RefCell::new(HashMap::new()));
-        let violations_state_inner = violations_state.clone();
+        let mut violations: HashMap<ViolationKey, isize> = HashMap::new();
+        let pending_inner = pending.clone();
 
         let mut probe = timely::dataflow::operators::probe::Handle::new();
 
         worker.dataflow(|scope| {
-            let entity_rows = entities.to_collection(scope).map(|(name, file, line)| {
-                let name_clone = name.clone();
-                (name, (file, line, name_clone))
-            });
-            let arch_rows = architectures
-                .to_collection(scope)
-                .map(|(entity, file, line, name)| (entity, (file, line, name)));
-            let port_entities = ports
-                .to_collection(scope)
-                .map(|(entity, _name)| (entity, ()));
-            let dep_rows = dependencies
-                .to_collection(scope)
-                .map(|(target, file, line, kind)| {
-                    let target_clone = target.clone();
-                    (target, (file, line, kind, target_clone))
-                });
-            let sym_rows = symbols.to_collection(scope).map(|name| (name, ()));
-
-            let entity_ports = entity_rows.join_map(&port_entities, |entity, payload, _| {
-                (entity.clone(), payload.clone())
-            });
-            let entities_without_ports = entity_rows
-                .concat(&entity_ports.negate())
-                .consolidate()
-                .filter(|(_entity, (_file, _line, name))| !is_testbench_name(name))
-                .map(|(_entity, (file, line, name))| ViolationKey {
-                    rule: "entity_has_ports".to_string(),
-                    severity: "warning".to_string(),
-                    file,
-                    line,
-                    message: format!("Entity '{}' has no ports defined", name),
-                });
-
-            let arch_with_entity = arch_rows.join_map(&entity_rows, |entity, payload, _| {
-                (entity.clone(), payload.clone())
-            });
-            let orphan_arch = arch_rows
-                .concat(&arch_with_entity.negate())
-                .consolidate()
-                .map(|(entity, (file, line, name))| ViolationKey {
-                    rule: "architecture_has_entity".to_string(),
-                    severity: "error".to_string(),
-                    file,
-                    line,
-                    message: format!(
-                        "Architecture '{}' references undefined entity '{}'",
-                        name, entity
-                    ),
-                });
-
-            let entity_with_arch = entity_rows.join_map(&arch_rows, |entity, payload, _| {
-                (entity.clone(), payload.clone())
-            });
-            let entities_without_arch = entity_rows
-                .concat(&entity_with_arch.negate())
-                .consolidate()
-                .map(|(_entity, (file, line, name))| ViolationKey {
-                    rule: "entity_without_arch".to_string(),
-                    severity: "warning".to_string(),
-                    file,
-                    line,
-                    message: format!("Entity '{}' has no architecture defined", name),
-                });
-
-            let dep_symbols = dep_rows.join_map(&sym_rows, |target, payload, _| {
-                (target.clone(), payload.clone())
-            });
-            let unresolved = dep_rows
-                .filter(|(_target, (_file, _line, kind, _t))| kind == "instantiation")
-                .concat(&dep_symbols.negate())
-                .consolidate()
-                .map(|(_target, (file, line, _kind, dep_target))| ViolationKey {
-                    rule: "unresolved_dependency".to_string(),
-                    severity: "error".to_string(),
-                    file,
-                    line,
-                    message: format!("Unresolved dependency: '{}'", dep_target),
-                });
-
-            let all = entities_without_ports
-                .concat(&orphan_arch)
-                .concat(&entities_without_arch)
-                .concat(&unresolved);
-
-            all.inspect(move |(violation, _time, diff)| {
-                let mut map = violations_state_inner.borrow_mut();
-                let entry = map.entry(violation.clone()).or_insert(0);
-                *entry += diff;
-                if *entry == 0 {
-                    map.remove(violation);
-                }
-            })
-            .probe_with(&mut probe);
+            rules(scope, &mut inputs)
+                .inspect(move |(violation, time, diff)| {
+                    pending_inner.lock().expect("pending mutex poisoned").push((
+                        violation.clone(),
+                        *time,
+                        *diff,
+                    ));
+                })
+                .probe_with(&mut probe);
         });
 
-        loop {
-            let line = {
-                let guard = rx.lock().expect("rx mutex poisoned");
-                guard.recv()
-            };
-            let line = match line {
-                Ok(line) => line,
-                Err(_) => break,
-            };
-
-            if line.trim().is_empty() {
-                continue;
+        // First message of the command being answered (leader timings)
+        let mut command_start: Option<Instant> = None;
+        for msg in rx {
+            if matches!(
+                &*msg,
+                Message::Rows(..) | Message::Evaluate | Message::Command(_)
+            ) {
+                command_start.get_or_insert_with(Instant::now);
             }
-            let cmd: Command = match serde_json::from_str(&line) {
-                Ok(cmd) => cmd,
-                Err(err) => {
-                    let _ = writeln!(
-                        stdout,
-                        "{{\"kind\":\"error\",\"message\":\"invalid command: {}\"}}",
-                        err
-                    );
-                    let _ = stdout.flush();
+            match &*msg {
+                Message::Hello(protocol) => {
+                    if leader {
+                        write_control(&mut stdout, "hello", Some(*protocol), None);
+                    }
                     continue;
                 }
-            };
-
-            match cmd.kind.as_str() {
-                "init" => {
-                    apply_tables(
-                        &cmd.tables,
-                        &mut entities,
-                        &mut architectures,
-                        &mut ports,
-                        &mut dependencies,
-                        &mut symbols,
-                        1,
-                    );
-                }
-                "delta" => {
-                    apply_tables(
-                        &cmd.added,
-                        &mut entities,
-                        &mut architectures,
-                        &mut ports,
-                        &mut dependencies,
-                        &mut symbols,
-                        1,
-                    );
-                    apply_tables(
-                        &cmd.removed,
-                        &mut entities,
-                        &mut architectures,
-                        &mut ports,
-                        &mut dependencies,
-                        &mut symbols,
-                        -1,
-                    );
+                Message::Invalid(message) => {
+                    if leader {
+                        write_control(&mut stdout, "error", None, Some(message.clone()));
+                    }
+                    continue;
                 }
-                "snapshot" => {}
-                _ => {
-                    let _ = writeln!(
-                        stdout,
-                        "{{\"kind\":\"error\",\"message\":\"unknown command kind: {}\"}}",
-                        cmd.kind
-                    );
-                    let _ = stdout.flush();
+                Message::Rows(tables, weight) => {
+                    inputs.apply(tables, *weight);
                     continue;
                 }
+                Message::Evaluate => {}
+                Message::Command(cmd) => match cmd.kind.as_str() {
+                    "init" => inputs.apply(&cmd.tables, 1),
+                    "delta" => {
+                        inputs.apply(&cmd.added, 1);
+                        inputs.apply(&cmd.removed, -1);
+                    }
+                    "snapshot" => {}
+                    _ => {
+                        if leader {
+                            write_control(
+                                &mut stdout,
+                                "error",
+                                None,
+                                Some(format!("unknown command kind: {}", cmd.kind)),
+                            );
+                        }
+                        continue;
+                    }
+                },
             }
 
-            entities.advance_to(epoch);
-            architectures.advance_to(epoch);
-            ports.advance_to(epoch);
-            dependencies.advance_to(epoch);
-            symbols.advance_to(epoch);
-            entities.flush();
-            architectures.flush();
-            ports.flush();
-            dependencies.flush();
-            symbols.flush();
-
-            while probe.less_than(entities.time()) {
+            let origin = command_start.take().unwrap_or_else(Instant::now);
+            let applied = Instant::now();
+            inputs.advance_to(epoch);
+
+            // The probe frontier is global, so every worker steps until the
+            // whole epoch has drained.
+            while probe.less_than(inputs.entities.time()) {
                 worker.step();
             }
+            let stepped = Instant::now();
 
-            let response = build_response(&violations_state.borrow());
-            let payload = serde_json::to_string(&response).unwrap_or_else(|_| {
-                "{\"kind\":\"error\",\"message\":\"failed to serialize response\"}".to_string()
-            });
-            let _ = writeln!(stdout, "{}", payload);
-            let _ = stdout.flush();
+            if leader {
+                fold_pending(
+                    &mut violations,
+                    &mut pending.lock().expect("pending mutex poisoned"),
+                    epoch,
+                );
+                let mut response = build_response(&violations);
+                let built = Instant::now();
+                response.timings = vec![
+                    Timing::new("apply", origin, origin, applied, 0),
+                    Timing::new("step", origin, applied, stepped, 0),
+                    Timing::new("respond", origin, stepped, built, response.violations.len()),
+                ];
+                let payload = serde_json::to_string(&response).unwrap_or_else(|_| {
+                    "{\"kind\":\"error\",\"message\":\"failed to serialize response\"}".to_string()
+                });
+                let _ = writeln!(stdout, "{}", payload);
+                let _ = stdout.flush();
+            }
 
             epoch += 1;
         }
-    });
+    })?;
 
     Ok(())
 }
 
-fn apply_tables(
-    tables: &Tables,
-    entities: &mut Session<(String, String, i64)>,
-    architectures: &mut Session<(String, String, i64, String)>,
-    ports: &mut Session<(String, String)>,
-    dependencies: &mut Session<(String, String, i64, String)>,
-    symbols: &mut Session<String>,
-    weight: isize,
-) {
-    for ent in &tables.entities {
-        entities.update((ent.name.clone(), ent.file.clone(), ent.line), weight);
-    }
-    for arch in &tables.architectures {
-        architectures.update(
-            (
-                arch.entity_name.clone(),
-                arch.file.clone(),
-                arch.line,
-                arch.name.clone(),
+/// The daemon's rules over its input relations. Each keeps the batch
+/// rule's name, severity and message.
+fn rules<G>(scope: &mut G, inputs: &mut Inputs) -> Collection<G, ViolationKey>
+where
+    G: TimelyInput<Timestamp = u64>,
+{
+    let entity_rows = inputs
+        .entities
+        .to_collection(scope)
+        .map(|(name, file, line)| {
+            let name_clone = name.clone();
+            (name, (file, line, name_clone))
+        });
+    let arch_collection = inputs.architectures.to_collection(scope);
+    let arch_rows = arch_collection.map(|(entity, file, line, name)| (entity, (file, line, name)));
+    let port_entities = inputs
+        .ports
+        .to_collection(scope)
+        .map(|(entity, _name)| (entity, ()));
+    let dep_rows = inputs
+        .dependencies
+        .to_collection(scope)
+        .map(|(target, file, line, kind)| {
+            let target_clone = target.clone();
+            (target, (file, line, kind, target_clone))
+        });
+    let sym_rows = inputs.symbols.to_collection(scope).map(|name| (name, ()));
+    let process_rows = inputs.processes.to_collection(scope);
+    let signal_rows = inputs.signals.to_collection(scope);
+    let instance_rows = inputs.instances.to_collection(scope);
+    let generate_rows = inputs.generates.to_collection(scope);
+
+    // Entities and architectures feed several joins; each is
+    // arranged once and the arrangement shared.
+    let entities_by_name = entity_rows.arrange_by_key();
+    let archs_by_entity = arch_rows.arrange_by_key();
+
+    let entity_ports = entities_by_name
+        .join_core(&port_entities.arrange_by_key(), |entity, payload, _| {
+            Some((entity.clone(), payload.clone()))
+        });
+    let entities_without_ports = entity_rows
+        .concat(&entity_ports.negate())
+        .consolidate()
+        .filter(|(_entity, (_file, _line, name))| !is_testbench_name(name))
+        .map(|(_entity, (file, line, name))| ViolationKey {
+            rule: "entity_has_ports".to_string(),
+            severity: "warning".to_string(),
+            file,
+            line,
+            message: format!("Entity '{}' has no ports defined", name),
+        });
+
+    let arch_with_entity = archs_by_entity.join_core(&entities_by_name, |entity, payload, _| {
+        Some((entity.clone(), payload.clone()))
+    });
+    let orphan_arch = arch_rows
+        .concat(&arch_with_entity.negate())
+        .consolidate()
+        .map(|(entity, (file, line, name))| ViolationKey {
+            rule: "architecture_has_entity".to_string(),
+            severity: "error".to_string(),
+            file,
+            line,
+            message: format!(
+                "Architecture '{}' references undefined entity '{}'",
+                name, entity
+            ),
+        });
+
+    let entity_with_arch = entities_by_name.join_core(&archs_by_entity, |entity, payload, _| {
+        Some((entity.clone(), payload.clone()))
+    });
+    let entities_without_arch = entity_rows
+        .concat(&entity_with_arch.negate())
+        .consolidate()
+        .map(|(_entity, (file, line, name))| ViolationKey {
+            rule: "entity_without_arch".to_string(),
+            severity: "warning".to_string(),
+            file,
+            line,
+            message: format!("Entity '{}' has no architecture defined", name),
+        });
+
+    let dep_symbols = dep_rows.join_map(&sym_rows, |target, payload, _| {
+        (target.clone(), payload.clone())
+    });
+    let unresolved = dep_rows
+        .filter(|(_target, (_file, _line, kind, _t))| kind == "instantiation")
+        .concat(&dep_symbols.negate())
+        .consolidate()
+        .map(|(_target, (file, line, _kind, dep_target))| ViolationKey {
+            rule: "unresolved_dependency".to_string(),
+            severity: "error".to_string(),
+            file,
+            line,
+            message: format!("Unresolved dependency: '{}'", dep_target),
+        });
+
+    // style::process_label_missing
+    let unlabeled_processes = process_rows
+        .filter(|(label, _file, _line)| label.is_empty())
+        .map(|(_label, file, line)| ViolationKey {
+            rule: "process_label_missing".to_string(),
+            severity: "info".to_string(),
+            file,
+            line,
+            message: format!(
+                "Process at line {} has no label - add 'label: process' for debugging",
+                line
+            ),
+        });
+
+    // quality::unlabeled_generate
+    let unlabeled_generates = generate_rows
+        .filter(|(label, _file, _line)| label.is_empty())
+        .map(|(_label, file, line)| ViolationKey {
+            rule: "unlabeled_generate".to_string(),
+            severity: "warning".to_string(),
+            file,
+            line,
+            message: "Generate block without label - labels are required for generate blocks"
+                .to_string(),
+        });
+
+    // quality::many_signals
+    let signals_per_scope = signal_rows
+        .map(|(scope, _name, _file, _line, _width)| scope)
+        .count()
+        .arrange_by_key();
+    let many_signals = entities_by_name
+        .join_core(&signals_per_scope, |_entity, (file, line, name), count| {
+            if *count > MANY_SIGNALS {
+                Some((file.clone(), *line, name.clone(), *count))
+            } else {
+                None
+            }
+        })
+        .map(|(file, line, name, count)| ViolationKey {
+            rule: "many_signals".to_string(),
+            severity: "info".to_string(),
+            file,
+            line,
+            message: format!(
+                "Entity '{}' has {} signals - consider refactoring into sub-modules",
+                name, count
             ),
-            weight,
+        });
+
+    // quality::duplicate_signal_in_entity
+    let redeclared_signals = signal_rows
+        .map(|(scope, name, file, line, _width)| {
+            ((file, scope, name.to_ascii_lowercase()), (line, name))
+        })
+        .reduce(|_key, group, out| out.extend(redeclarations(group)))
+        .map(
+            |((file, _scope, _lower), (line, name, first_line))| ViolationKey {
+                rule: "duplicate_signal_in_entity".to_string(),
+                severity: "error".to_string(),
+                file,
+                line,
+                message: format!(
+                    "Signal '{}' declared multiple times in same scope (first at line {})",
+                    name, first_line
+                ),
+            },
         );
+
+    // signals::duplicate_signal_name
+    let clashing_signals = signal_rows
+        .filter(|(_scope, name, _file, _line, _width)| !is_common_signal_name(name))
+        .map(|(scope, name, file, line, _width)| {
+            (name.to_ascii_lowercase(), (file, line, name, scope))
+        })
+        .reduce(|_key, group, out| out.extend(signal_name_clashes(group)))
+        .map(|(_lower, (file, line, name, other_scope))| ViolationKey {
+            rule: "duplicate_signal_name".to_string(),
+            severity: "info".to_string(),
+            file,
+            line,
+            message: format!(
+                "Signal '{}' also exists in entity '{}' - verify intentional",
+                name, other_scope
+            ),
+        });
+
+    // signals::wide_signal
+    let wide_signals = signal_rows
+        .filter(|(_scope, _name, _file, _line, width)| *width > WIDE_SIGNAL_BITS)
+        .map(|(_scope, name, file, line, width)| ViolationKey {
+            rule: "wide_signal".to_string(),
+            severity: "info".to_string(),
+            file,
+            line,
+            message: format!(
+                "Signal '{}' is {} bits wide - consider if this width is necessary",
+                name, width
+            ),
+        });
+
+    // hierarchy::many_instances
+    let instances_per_arch = instance_rows
+        .map(|(in_arch, file, _line, _target)| (in_arch, file))
+        .count()
+        .arrange_by_key();
+    let many_instances = arch_collection
+        .map(|(_entity, file, line, name)| ((name, file), line))
+        .arrange_by_key()
+        .join_core(&instances_per_arch, |(name, file), line, count| {
+            if *count > MANY_INSTANCES {
+                Some((name.clone(), file.clone(), *line, *count))
+            } else {
+                None
+            }
+        })
+        .map(|(name, file, line, count)| ViolationKey {
+            rule: "many_instances".to_string(),
+            severity: "info".to_string(),
+            file,
+            line,
+            message: format!(
+                "Architecture '{}' has {} instances - consider hierarchical decomposition",
+                name, count
+            ),
+        });
+
+    // hierarchy::repeated_component_instantiation
+    let repeated_instances = instance_rows
+        .filter(|(_in_arch, _file, _line, target)| !target.is_empty())
+        .map(|(_in_arch, file, line, target)| {
+            ((file, target.to_ascii_lowercase()), (line, target))
+        })
+        .reduce(|_key, group, out| out.extend(repeated_instantiation(group)))
+        .map(|((file, _lower), (line, target, count))| ViolationKey {
+            rule: "repeated_component_instantiation".to_string(),
+            severity: "info".to_string(),
+            file,
+            line,
+            message: format!(
+                "Component '{}' instantiated {} times - consider generate statement or hierarchical design",
+                target, count
+            ),
+        });
+
+    entities_without_ports
+        .concat(&orphan_arch)
+        .concat(&entities_without_arch)
+        .concat(&unresolved)
+        .concat(&unlabeled_processes)
+        .concat(&unlabeled_generates)
+        .concat(&many_signals)
+        .concat(&redeclared_signals)
+        .concat(&clashing_signals)
+        .concat(&wide_signals)
+        .concat(&many_instances)
+        .concat(&repeated_instances)
+}
+
+/// VHDL_POLICYD_WORKERS sets the timely worker count (1 = single worker);
+/// defaults to every core.
+fn policyd_workers() -> usize {
+    if let Ok(val) = std::env::var("VHDL_POLICYD_WORKERS") {
+        if let Ok(n) = val.trim().parse::<usize>() {
+            if n > 0 {
+                return n;
+            }
+        }
     }
-    for port in &tables.ports {
-        ports.update((port.entity.clone(), port.name.clone()), weight);
+    std::thread::available_parallelism().map_or(1, |n| n.get())
+}
+
+/// Worker that feeds rows partitioned by `key` (a file path, or an entity or
+/// symbol name for relations without one). Stable for the process lifetime,
+/// so a removal always reaches the worker that saw the insertion.
+fn worker_for(key: &str, peers: usize) -> usize {
+    if peers <= 1 {
+        return 0;
     }
-    for dep in &tables.dependencies {
-        dependencies.update(
-            (
-                dep.target.clone(),
-                dep.file.clone(),
-                dep.line,
-                dep.kind.clone(),
-            ),
-            weight,
-        );
+    let mut hasher = DefaultHasher::new();
+    key.hash(&mut hasher);
+    (hasher.finish() % peers as u64) as usize
+}
+
+/// Moves violation updates from epochs before `epoch` into `violations`.
+/// Later updates (already flowing from a worker that read the next command)
+/// stay pending.
+fn fold_pending(
+    violations: &mut HashMap<ViolationKey, isize>,
+    pending: &mut Vec<(ViolationKey, u64, isize)>,
+    epoch: u64,
+) {
+    pending.retain(|(violation, time, diff)| {
+        if *time >= epoch {
+            return true;
+        }
+        let entry = violations.entry(violation.clone()).or_insert(0);
+        *entry += diff;
+        if *entry == 0 {
+            violations.remove(violation);
+        }
+        false
+    });
+}
+
+impl Inputs {
+    fn new(peers: usize, index: usize) -> Self {
+        Inputs {
+            peers,
+            index,
+            entities: InputSession::new(),
+            architectures: InputSession::new(),
+            ports: InputSession::new(),
+            dependencies: InputSession::new(),
+            symbols: InputSession::new(),
+            processes: InputSession::new(),
+            signals: InputSession::new(),
+            instances: InputSession::new(),
+            generates: InputSession::new(),
+        }
+    }
+
+    fn owns(&self, key: &str) -> bool {
+        worker_for(key, self.peers) == self.index
+    }
+
+    /// Feeds the rows of `tables` this worker owns.
+    fn apply(&mut self, tables: &Tables, weight: isize) {
+        for ent in &tables.entities {
+            if self.owns(&ent.file) {
+                self.entities
+                    .update((ent.name.clone(), ent.file.clone(), ent.line), weight);
+            }
+        }
+        for arch in &tables.architectures {
+            if self.owns(&arch.file) {
+                self.architectures.update(
+                    (
+                        arch.entity_name.clone(),
+                        arch.file.clone(),
+                        arch.line,
+                        arch.name.clone(),
+                    ),
+                    weight,
+                );
+            }
+        }
+        for port in &tables.ports {
+            if self.owns(&port.entity) {
+                self.ports
+                    .update((port.entity.clone(), port.name.clone()), weight);
+            }
+        }
+        for dep in &tables.dependencies {
+            if self.owns(&dep.file) {
+                self.dependencies.update(
+                    (
+                        dep.target.clone(),
+                        dep.file.clone(),
+                        dep.line,
+                        dep.kind.clone(),
+                    ),
+                    weight,
+                );
+            }
+        }
+        for sym in &tables.symbols {
+            if self.owns(&sym.name) {
+                self.symbols.update(sym.name.clone(), weight);
+            }
+        }
+        for proc in &tables.processes {
+            if self.owns(&proc.file) {
+                self.processes
+                    .update((proc.label.clone(), proc.file.clone(), proc.line), weight);
+            }
+        }
+        for sig in &tables.signals {
+            if self.owns(&sig.file) && !sig.ty.is_empty() {
+                self.signals.update(
+                    (
+                        sig.scope.clone(),
+                        sig.name.clone(),
+                        sig.file.clone(),
+                        sig.line,
+                        vector_width(&sig.ty),
+                    ),
+                    weight,
+                );
+            }
+        }
+        for inst in &tables.instances {
+            if self.owns(&inst.file) {
+                self.instances.update(
+                    (
+                        inst.in_arch.clone(),
+                        inst.file.clone(),
+                        inst.line,
+                        inst.target.clone(),
+                    ),
+                    weight,
+                );
+            }
+        }
+        for gen in &tables.generates {
+            if self.owns(&gen.file) {
+                self.generates
+                    .update((gen.label.clone(), gen.file.clone(), gen.line), weight);
+            }
+        }
     }
-    for sym in &tables.symbols {
-        symbols.update(sym.name.clone(), weight);
+
+    fn advance_to(&mut self, epoch: u64) {
+        self.entities.advance_to(epoch);
+        self.architectures.advance_to(epoch);
+        self.ports.advance_to(epoch);
+        self.dependencies.advance_to(epoch);
+        self.symbols.advance_to(epoch);
+        self.processes.advance_to(epoch);
+        self.signals.advance_to(epoch);
+        self.instances.advance_to(epoch);
+        self.generates.advance_to(epoch);
+        self.entities.flush();
+        self.architectures.flush();
+        self.ports.flush();
+        self.dependencies.flush();
+        self.symbols.flush();
+        self.processes.flush();
+        self.signals.flush();
+        self.instances.flush();
+        self.generates.flush();
     }
 }
 
+fn write_control(
+    stdout: &mut impl Write,
+    kind: &str,
+    protocol: Option<&str>,
+    message: Option<String>,
+) {
+    let response = ControlResponse {
+        kind,
+        protocol,
+        message,
+    };
+    let payload = serde_json::to_string(&response).unwrap_or_else(|_| {
+        "{\"kind\":\"error\",\"message\":\"failed to serialize response\"}".to_string()
+    });
+    let _ = writeln!(stdout, "{}", payload);
+    let _ = stdout.flush();
+}
+
+/// Reads commands from stdin: JSON lines until a hello switches the stream
+/// to frames. Stops at EOF or at the first malformed frame (the stream can
+/// no longer be resynchronised).
+fn read_commands(reader: &mut impl BufRead, tx: &mpsc::Sender<Message>) {
+    let mut framed = false;
+    loop {
+        let msg = if framed {
+            match read_frame(reader) {
+                Ok(None) => return,
+                Ok(Some((FRAME_BEGIN, _))) => continue,
+                Ok(Some((FRAME_ROWS, body))) => match decode_rows(&body) {
+                    Ok((tables, weight)) => Message::Rows(tables, weight),
+                    Err(err) => {
+                        let _ = tx.send(Message::Invalid(format!("invalid frame: {}", err)));
+                        return;
+                    }
+                },
+                Ok(Some((FRAME_END, _))) => Message::Evaluate,
+                Ok(Some((kind, _))) => {
+                    let _ = tx.send(Message::Invalid(format!("unknown frame type: {}", kind)));
+                    return;
+                }
+                Err(err) => {
+                    let _ = tx.send(Message::Invalid(format!("invalid frame: {}", err)));
+                    return;
+                }
+            }
+        } else {
+            let mut line = String::new();
+            match reader.read_line(&mut line) {
+                Ok(0) | Err(_) => return,
+                Ok(_) => {}
+            }
+            if line.trim().is_empty() {
+                continue;
+            }
+            match serde_json::from_str::<Command>(&line) {
+                Ok(cmd) if cmd.kind == "hello" => {
+                    if cmd.protocols.iter().any(|p| p == FRAMES_PROTOCOL) {
+                        framed = true;
+                        Message::Hello(FRAMES_PROTOCOL)
+                    } else {
+                        Message::Hello("json")
+                    }
+                }
+                Ok(cmd) => Message::Command(cmd),
+                Err(err) => Message::Invalid(format!("invalid command: {}", err)),
+            }
+        };
+        if tx.send(msg).is_err() {
+            return;
+        }
+    }
+}
+
+/// Reads one frame as (type, body); None on a clean EOF between frames.
+fn read_frame(reader: &mut impl Read) -> io::Result<Option<(u8, Vec<u8>)>> {
+    let mut header = [0u8; 4];
+    match reader.read_exact(&mut header) {
+        Ok(()) => {}
+        Err(err) if err.kind() == io::ErrorKind::UnexpectedEof => return Ok(None),
+        Err(err) => return Err(err),
+    }
+    let len = u32::from_le_bytes(header) as usize;
+    if len == 0 || len > MAX_FRAME_LEN {
+        return Err(io::Error::new(
+            io::ErrorKind::InvalidData,
+            format!("frame length {}", len),
+        ));
+    }
+    let mut frame = vec![0u8; len];
+    reader.read_exact(&mut frame)?;
+    let body = frame.split_off(1);
+    Ok(Some((frame[0], body)))
+}
+
+struct FrameCursor<'a> {
+    data: &'a [u8],
+    pos: usize,
+}
+
+impl<'a> FrameCursor<'a> {
+    fn byte(&mut self) -> Result<u8, String> {
+        let b = *self.data.get(self.pos).ok_or("truncated frame")?;
+        self.pos += 1;
+        Ok(b)
+    }
+
+    fn uvarint(&mut self) -> Result<u64, String> {
+        let mut value: u64 = 0;
+        for shift in (0..64).step_by(7) {
+            let b = self.byte()?;
+            value |= u64::from(b & 0x7f) << shift;
+            if b & 0x80 == 0 {
+                return Ok(value);
+            }
+        }
+        Err("varint overflow".to_string())
+    }
+
+    fn varint(&mut self) -> Result<i64, String> {
+        let u = self.uvarint()?;
+        Ok((u >> 1) as i64 ^ -((u & 1) as i64))
+    }
+
+    fn string(&mut self) -> Result<String, String> {
+        let len = self.uvarint()? as usize;
+        let end = self.pos.checked_add(len).ok_or("string length overflow")?;
+        let bytes = self.data.get(self.pos..end).ok_or("truncated string")?;
+        self.pos = end;
+        String::from_utf8(bytes.to_vec()).map_err(|err| err.to_string())
+    }
+}
+
+/// Decodes a rows frame body into the rows it adds (+1) or removes (-1).
+fn decode_rows(body: &[u8]) -> Result<(Tables, isize), String> {
+    let mut cur = FrameCursor { data: body, pos: 0 };
+    let weight = match cur.byte()? {
+        0 => 1,
+        1 => -1,
+        sign => return Err(format!("unknown sign {}", sign)),
+    };
+    let relation = cur.byte()?;
+    let count = cur.uvarint()? as usize;
+    if count > body.len() {
+        return Err(format!("row count {} exceeds frame", count));
+    }
+    let mut tables = Tables::default();
+    for _ in 0..count {
+        match relation {
+            REL_ENTITIES => tables.entities.push(EntityRow {
+                name: cur.string()?,
+                file: cur.string()?,
+                line: cur.varint()?,
+            }),
+            REL_ARCHITECTURES => tables.architectures.push(ArchitectureRow {
+                name: cur.string()?,
+                entity_name: cur.string()?,
+                file: cur.string()?,
+                line: cur.varint()?,
+            }),
+            REL_PORTS => tables.ports.push(PortRow {
+                entity: cur.string()?,
+                name: cur.string()?,
+                direction: cur.string()?,
+                file: cur.string()?,
+                line: cur.varint()?,
+            }),
+            REL_DEPENDENCIES => tables.dependencies.push(DependencyRow {
+                file: cur.string()?,
+                target: cur.string()?,
+                kind: cur.string()?,
+                line: cur.varint()?,
+            }),
+            REL_SYMBOLS => tables.symbols.push(SymbolRow {
+                name: cur.string()?,
+            }),
+            REL_PROCESSES => tables.processes.push(ProcessRow {
+                label: cur.string()?,
+                file: cur.string()?,
+                line: cur.varint()?,
+            }),
+            REL_SIGNALS => tables.signals.push(SignalRow {
+                name: cur.string()?,
+                ty: cur.string()?,
+                scope: cur.string()?,
+                file: cur.string()?,
+                line: cur.varint()?,
+            }),
+            REL_INSTANCES => tables.instances.push(InstanceRow {
+                target: cur.string()?,
+                in_arch: cur.string()?,
+                file: cur.string()?,
+                line: cur.varint()?,
+            }),
+            REL_GENERATES => tables.generates.push(GenerateRow {
+                label: cur.string()?,
+                file: cur.string()?,
+                line: cur.varint()?,
+            }),
+            other => return Err(format!("unknown relation {}", other)),
+        }
+    }
+    if cur.pos != body.len() {
+        return Err("trailing bytes in frame".to_string());
+    }
+    Ok((tables, weight))
+}
+
 fn build_response(violations: &HashMap<ViolationKey, isize>) -> Response {
     let mut list: Vec<Violation> = violations
         .iter()
@@ -403,7 +1064,108 @@ fn build_response(violations: &HashMap<ViolationKey, isize>) -> Response {
         kind: "snapshot".to_string(),
         summary,
         violations: list,
+        timings: Vec::new(),
+    }
+}
+
+/// Thresholds shared with the batch rules (quality::many_signals,
+/// signals::wide_signal, hierarchy::many_instances,
+/// hierarchy::repeated_component_instantiation).
+const MANY_SIGNALS: isize = 50;
+const WIDE_SIGNAL_BITS: usize = 128;
+const MANY_INSTANCES: isize = 20;
+const REPEATED_INSTANTIATIONS: isize = 5;
+
+/// Reduce body for duplicate_signal_in_entity: every declaration in one
+/// (file, scope, name) group after the first, with the first's line. Groups
+/// arrive sorted, so "first" is the lowest line.
+fn redeclarations(group: &[(&(i64, String), isize)]) -> Vec<((i64, String, i64), isize)> {
+    let Some(((first_line, _), _)) = group.first() else {
+        return Vec::new();
+    };
+    let mut out = Vec::new();
+    for (idx, ((line, name), weight)) in group.iter().enumerate() {
+        let copies = if idx == 0 { *weight - 1 } else { *weight };
+        if copies > 0 {
+            out.push(((*line, name.clone(), *first_line), copies));
+        }
+    }
+    out
+}
+
+/// Reduce body for duplicate_signal_name: for each pair of same-named
+/// signals in different scopes, one violation at the earlier of the two.
+fn signal_name_clashes(
+    group: &[(&(String, i64, String, String), isize)],
+) -> Vec<((String, i64, String, String), isize)> {
+    let mut out = Vec::new();
+    for (i, ((file, line, name, scope), w1)) in group.iter().enumerate() {
+        for ((_, _, _, other_scope), w2) in &group[i + 1..] {
+            if scope != other_scope {
+                out.push((
+                    (file.clone(), *line, name.clone(), other_scope.clone()),
+                    w1 * w2,
+                ));
+            }
+        }
+    }
+    out
+}
+
+/// Reduce body for repeated_component_instantiation: the first instance of
+/// a (file, target) group and the group size, if it is over the threshold.
+fn repeated_instantiation(
+    group: &[(&(i64, String), isize)],
+) -> Option<((i64, String, isize), isize)> {
+    let total: isize = group.iter().map(|(_, weight)| weight).sum();
+    if total <= REPEATED_INSTANTIATIONS {
+        return None;
     }
+    let ((line, target), _) = group.first()?;
+    Some(((*line, target.clone(), total), 1))
+}
+
+/// Same as policy::signals::extract_vector_width: the width of a
+/// "(N downto 0)" or "(0 to N)" range, else 0.
+fn vector_width(ty: &str) -> usize {
+    static RANGES: OnceLock<[Regex; 2]> = OnceLock::new();
+    let [downto, to] = RANGES.get_or_init(|| {
+        [
+            Regex::new(r"\(([0-9]+) downto 0\)").unwrap(),
+            Regex::new(r"\(0 to ([0-9]+)\)").unwrap(),
+        ]
+    });
+    let lower = ty.to_ascii_lowercase();
+    for re in [downto, to] {
+        if let Some(caps) = re.captures(&lower) {
+            if let Ok(val) = caps[1].parse::<usize>() {
+                return val + 1;
+            }
+        }
+    }
+    0
+}
+
+/// Same list as policy::helpers::is_common_signal_name
+fn is_common_signal_name(name: &str) -> bool {
+    matches!(
+        name.to_ascii_lowercase().as_str(),
+        "clk"
+            | "rst"
+            | "reset"
+            | "data"
+            | "addr"
+            | "we"
+            | "re"
+            | "en"
+            | "valid"
+            | "ready"
+            | "ack"
+            | "done"
+            | "start"
+            | "busy"
+            | "error"
+    )
 }
 
 fn is_testbench_name(name: &str) -> bool {
@@ -416,3 +1178,277 @@ fn is_testbench_name(name: &str) -> bool {
 }
 
 type Session<D> = InputSession<u64, D, isize>;
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn push_str(buf: &mut Vec<u8>, s: &str) {
+        buf.push(s.len() as u8);
+        buf.extend_from_slice(s.as_bytes());
+    }
+
+    fn frame(kind: u8, body: &[u8]) -> Vec<u8> {
+        let mut out = ((body.len() + 1) as u32).to_le_bytes().to_vec();
+        out.push(kind);
+        out.extend_from_slice(body);
+        out
+    }
+
+    #[test]
+    fn hello_switches_to_frames() {
+        let mut input = b"{\"kind\":\"hello\",\"protocols\":[\"frames-v1\"]}\n".to_vec();
+        input.extend(frame(FRAME_BEGIN, &[1]));
+        let mut rows = vec![1, REL_ENTITIES, 1];
+        push_str(&mut rows, "top");
+        push_str(&mut rows, "top.vhd");
+        rows.push(6); // zigzag 3
+        input.extend(frame(FRAME_ROWS, &rows));
+        input.extend(frame(FRAME_END, &[]));
+
+        let (tx, rx) = std::sync::mpsc::channel();
+        read_commands(&mut io::Cursor::new(input), &tx);
+        drop(tx);
+        let msgs: Vec<Message> = rx.into_iter().collect();
+        assert_eq!(msgs.len(), 3);
+        assert!(matches!(msgs[0], Message::Hello(FRAMES_PROTOCOL)));
+        match &msgs[1] {
+            Message::Rows(tables, weight) => {
+                assert_eq!(*weight, -1);
+                assert_eq!(tables.entities.len(), 1);
+                assert_eq!(tables.entities[0].name, "top");
+                assert_eq!(tables.entities[0].line, 3);
+            }
+            _ => panic!("expected rows"),
+        }
+        assert!(matches!(msgs[2], Message::Evaluate));
+    }
+
+    #[test]
+    fn truncated_rows_frame_is_rejected() {
+        let mut rows = vec![0, REL_SYMBOLS, 2];
+        push_str(&mut rows, "only_one");
+        assert!(decode_rows(&rows).is_err());
+    }
+
+    #[test]
+    fn decodes_new_relations() {
+        let mut rows = vec![0, REL_SIGNALS, 1];
+        push_str(&mut rows, "data_q");
+        push_str(&mut rows, "std_logic");
+        push_str(&mut rows, "core");
+        push_str(&mut rows, "core.vhd");
+        rows.push(14); // zigzag 7
+        let (tables, weight) = decode_rows(&rows).unwrap();
+        assert_eq!(weight, 1);
+        assert_eq!(tables.signals[0].ty, "std_logic");
+        assert_eq!(tables.signals[0].scope, "core");
+        assert_eq!(tables.signals[0].line, 7);
+    }
+
+    #[test]
+    fn reduce_bodies_match_batch_rules() {
+        let a = (3, "sig".to_string());
+        let b = (9, "SIG".to_string());
+        let dup = redeclarations(&[(&a, 1), (&b, 2)]);
+        assert_eq!(dup, vec![((9, "SIG".to_string(), 3), 2)]);
+
+        let s1 = (
+            "a.vhd".to_string(),
+            1,
+            "bus".to_string(),
+            "ent1".to_string(),
+        );
+        let s2 = (
+            "b.vhd".to_string(),
+            2,
+            "bus".to_string(),
+            "ent2".to_string(),
+        );
+        let s3 = (
+            "b.vhd".to_string(),
+            5,
+            "bus".to_string(),
+            "ent2".to_string(),
+        );
+        let clashes = signal_name_clashes(&[(&s1, 1), (&s2, 1), (&s3, 1)]);
+        assert_eq!(clashes.len(), 2);
+        assert!(clashes.iter().all(|((file, ..), _)| file == "a.vhd"));
+
+        let inst = (4, "Fifo".to_string());
+        assert!(repeated_instantiation(&[(&inst, 5)]).is_none());
+        assert_eq!(
+            repeated_instantiation(&[(&inst, 6)]),
+            Some(((4, "Fifo".to_string(), 6), 1))
+        );
+    }
+
+    /// Runs the daemon's rules over `tables` on one worker.
+    fn daemon_violations(tables: Tables) -> Vec<Violation> {
+        timely::execute_directly(move |worker| {
+            let mut inputs = Inputs::new(worker.peers(), worker.index());
+            let found = std::rc::Rc::new(std::cell::RefCell::new(Vec::new()));
+            let sink = found.clone();
+            let probe = worker.dataflow(|scope| {
+                rules(scope, &mut inputs)
+                    .inspect(move |(violation, _time, diff)| {
+                        sink.borrow_mut().push((violation.clone(), *diff))
+                    })
+                    .probe()
+            });
+            inputs.apply(&tables, 1);
+            inputs.advance_to(1);
+            while probe.less_than(inputs.entities.time()) {
+                worker.step();
+            }
+            let mut violations = HashMap::new();
+            for (violation, diff) in found.borrow().iter() {
+                *violations.entry(violation.clone()).or_insert(0) += diff;
+            }
+            build_response(&violations).violations
+        })
+    }
+
+    #[test]
+    fn rules_match_batch_engine() {
+        use vhdl_compiler::policy::{engine, input::Input};
+
+        // Rules fed by the processes, signals, instances and generates
+        // relations; the batch engine only reports them when enabled
+        const RULES: &[&str] = &[
+            "process_label_missing",
+            "unlabeled_generate",
+            "many_signals",
+            "duplicate_signal_in_entity",
+            "duplicate_signal_name",
+            "wide_signal",
+            "many_instances",
+            "repeated_component_instantiation",
+        ];
+        // (name, type, scope, file, line); the daemon gets b.vhd first
+        let signals = [
+            ("bus_q", "std_logic", "edge", "b.vhd", 5),
+            ("ghost", "", "edge", "b.vhd", 6),
+            ("clk", "std_logic", "edge", "b.vhd", 7),
+            ("bus_q", "std_logic", "core", "a.vhd", 7),
+            ("cnt", "unsigned(7 downto 0)", "core", "a.vhd", 8),
+            ("CNT", "unsigned(7 downto 0)", "core", "a.vhd", 9),
+            (
+                "wide",
+                "std_logic_vector(255 downto 0)",
+                "core",
+                "a.vhd",
+                10,
+            ),
+            ("ghost", "std_logic", "core", "a.vhd", 11),
+            ("clk", "std_logic", "core", "a.vhd", 12),
+        ];
+        let entities = serde_json::json!([
+            {"name": "edge", "file": "b.vhd", "line": 1},
+            {"name": "core", "file": "a.vhd", "line": 1},
+        ]);
+        let architectures = serde_json::json!([
+            {"name": "rtl", "entity_name": "edge", "file": "b.vhd", "line": 4},
+            {"name": "rtl", "entity_name": "core", "file": "a.vhd", "line": 4},
+        ]);
+        let processes = serde_json::json!([
+            {"label": "main", "file": "b.vhd", "line": 20},
+            {"label": "", "file": "a.vhd", "line": 20},
+        ]);
+        let generates = serde_json::json!([{"label": "", "file": "b.vhd", "line": 30}]);
+        let instances: Vec<_> = (40..46)
+            .map(|line| serde_json::json!({"target": "fifo", "in_arch": "rtl", "file": "a.vhd", "line": line}))
+            .collect();
+
+        let tables: Tables = serde_json::from_value(serde_json::json!({
+            "entities": entities,
+            "architectures": architectures,
+            "signals": signals
+                .iter()
+                .map(|(name, ty, scope, file, line)| serde_json::json!(
+                    {"name": name, "type": ty, "scope": scope, "file": file, "line": line}
+                ))
+                .collect::<Vec<_>>(),
+            "processes": processes,
+            "instances": instances,
+            "generates": generates,
+        }))
+        .unwrap();
+
+        // The batch input lists files in path order and leaves out
+        // untyped signals, as buildPolicyInput does
+        let mut batch_signals: Vec<_> = signals.iter().filter(|sig| !sig.1.is_empty()).collect();
+        batch_signals.sort_by_key(|sig| sig.3);
+        let enabled: serde_json::Map<_, _> = RULES
+            .iter()
+            .map(|rule| (rule.to_string(), serde_json::json!("on")))
+            .collect();
+        let input: Input = serde_json::from_value(serde_json::json!({
+            "entities": entities,
+            "architectures": architectures,
+            "signals": batch_signals
+                .iter()
+                .map(|(name, ty, scope, file, line)| serde_json::json!(
+                    {"name": name, "type": ty, "in_entity": scope, "file": file, "line": line}
+                ))
+                .collect::<Vec<_>>(),
+            "processes": processes,
+            "instances": instances,
+            "generates": generates,
+            "lint_config": {"rules": enabled},
+        }))
+        .unwrap();
+
+        let mut batch: Vec<_> = engine::evaluate(&input)
+            .violations
+            .into_iter()
+            .filter(|v| RULES.contains(&v.rule.as_str()))
+            .map(|v| (v.rule, v.file, v.line as i64, v.message))
+            .collect();
+        let mut daemon: Vec<_> = daemon_violations(tables)
+            .into_iter()
+            .filter(|v| RULES.contains(&v.rule.as_str()))
+            .map(|v| (v.rule, v.file, v.line, v.message))
+            .collect();
+        batch.sort();
+        daemon.sort();
+        assert_eq!(batch.len(), 6);
+        assert_eq!(daemon, batch);
+    }
+
+    #[test]
+    fn rows_partition_by_key() {
+        assert_eq!(worker_for("core.vhd", 1), 0);
+        let owner = worker_for("core.vhd", 4);
+        assert!(owner < 4);
+        assert_eq!(worker_for("core.vhd", 4), owner);
+    }
+
+    #[test]
+    fn fold_pending_keeps_later_epochs() {
+        let key = |line| ViolationKey {
+            rule: "r".to_string(),
+            severity: "info".to_string(),
+            file: "a.vhd".to_string(),
+            line,
+            message: String::new(),
+        };
+        let mut violations = HashMap::new();
+        violations.insert(key(1), 1);
+        let mut pending = vec![(key(1), 0, -1), (key(2), 0, 1), (key(3), 1, 1)];
+        fold_pending(&mut violations, &mut pending, 1);
+        assert_eq!(violations.len(), 1);
+        assert!(violations.contains_key(&key(2)));
+        assert_eq!(pending, vec![(key(3), 1, 1)]);
+    }
+
+    #[test]
+    fn json_commands_still_accepted() {
+        let input = b"{\"kind\":\"snapshot\"}\n".to_vec();
+        let (tx, rx) = std::sync::mpsc::channel();
+        read_commands(&mut io::Cursor::new(input), &tx);
+        drop(tx);
+        let msgs: Vec<Message> = rx.into_iter().collect();
+        assert!(matches!(&msgs[..], [Message::Command(cmd)] if cmd.kind == "snapshot"));
+    }
+}
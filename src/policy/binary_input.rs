@@ -0,0 +1,377 @@
+//! Binary policy input handoff, written by `internal/policy/input_binary.go`.
+//!
+//! ```text
+//! header: "VLPOLIN\0" | u32 version | u32 reserved | u64 string table offset
+//! values: tagged, in the shape encoding/json would have produced
+//! table:  uvarint count | (uvarint len | utf-8 bytes)...
+//! ```
+//!
+//! Values carry field names, so any serde type that reads the JSON input reads
+//! this too. Strings (keys included) are interned in the table and handed to
+//! serde as borrowed `&str` straight from the mapping; owned `String` fields
+//! copy each one once, and there is no intermediate document buffer.
+
+use std::fmt;
+use std::fs::File;
+use std::io;
+use std::path::Path;
+
+use serde::de::{self, DeserializeSeed, MapAccess, SeqAccess, Visitor};
+use serde::Deserialize;
+
+const MAGIC: &[u8; 8] = b"VLPOLIN\0";
+const VERSION: u32 = 1;
+const HEADER_LEN: usize = 24;
+
+const TAG_NULL: u8 = 0;
+const TAG_FALSE: u8 = 1;
+const TAG_TRUE: u8 = 2;
+const TAG_INT: u8 = 3;
+const TAG_FLOAT: u8 = 4;
+const TAG_STRING: u8 = 5;
+const TAG_ARRAY: u8 = 6;
+const TAG_MAP: u8 = 7;
+
+#[derive(Debug)]
+pub struct Error(String);
+
+impl fmt::Display for Error {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        write!(f, "binary policy input: {}", self.0)
+    }
+}
+
+impl std::error::Error for Error {}
+
+impl de::Error for Error {
+    fn custom<T: fmt::Display>(msg: T) -> Self {
+        Error(msg.to_string())
+    }
+}
+
+fn corrupt(what: &str) -> Error {
+    Error(what.to_string())
+}
+
+/// Deserializes a value from an encoded handoff file.
+pub fn from_bytes<'de, T: Deserialize<'de>>(data: &'de [u8]) -> Result<T, Error> {
+    if data.len() < HEADER_LEN || &data[..8] != MAGIC {
+        return Err(corrupt("bad header"));
+    }
+    let version = u32::from_le_bytes(data[8..12].try_into().unwrap());
+    if version != VERSION {
+        return Err(Error(format!("unsupported version {}", version)));
+    }
+    let table_offset = u64::from_le_bytes(data[16..24].try_into().unwrap()) as usize;
+    if table_offset < HEADER_LEN || table_offset > data.len() {
+        return Err(corrupt("string table offset out of range"));
+    }
+
+    let mut table = Deserializer {
+        data: &data[table_offset..],
+        pos: 0,
+        strings: Vec::new(),
+    };
+    let count = table.count()?;
+    let mut strings = Vec::with_capacity(count);
+    for _ in 0..count {
+        let len = table.count()?;
+        let bytes = &table.data[table.pos..table.pos + len];
+        table.pos += len;
+        strings.push(std::str::from_utf8(bytes).map_err(|err| Error(err.to_string()))?);
+    }
+
+    let mut de = Deserializer {
+        data: &data[HEADER_LEN..table_offset],
+        pos: 0,
+        strings,
+    };
+    let value = T::deserialize(&mut de)?;
+    if de.pos != de.data.len() {
+        return Err(corrupt("trailing bytes after value"));
+    }
+    Ok(value)
+}
+
+struct Deserializer<'de> {
+    data: &'de [u8],
+    pos: usize,
+    strings: Vec<&'de str>,
+}
+
+impl<'de> Deserializer<'de> {
+    fn byte(&mut self) -> Result<u8, Error> {
+        let b = *self
+            .data
+            .get(self.pos)
+            .ok_or_else(|| corrupt("truncated"))?;
+        self.pos += 1;
+        Ok(b)
+    }
+
+    fn uvarint(&mut self) -> Result<u64, Error> {
+        let mut value: u64 = 0;
+        for shift in (0..64).step_by(7) {
+            let b = self.byte()?;
+            value |= u64::from(b & 0x7f) << shift;
+            if b & 0x80 == 0 {
+                return Ok(value);
+            }
+        }
+        Err(corrupt("varint overflow"))
+    }
+
+    /// A length or element count; every element takes at least one byte.
+    fn count(&mut self) -> Result<usize, Error> {
+        let n = self.uvarint()?;
+        if n > (self.data.len() - self.pos) as u64 {
+            return Err(corrupt("count exceeds input"));
+        }
+        Ok(n as usize)
+    }
+
+    fn string(&mut self) -> Result<&'de str, Error> {
+        let id = self.uvarint()?;
+        self.strings
+            .get(id as usize)
+            .copied()
+            .ok_or_else(|| corrupt("string index out of range"))
+    }
+}
+
+impl<'de, 'a> de::Deserializer<'de> for &'a mut Deserializer<'de> {
+    type Error = Error;
+
+    fn deserialize_any<V: Visitor<'de>>(self, visitor: V) -> Result<V::Value, Error> {
+        match self.byte()? {
+            TAG_NULL => visitor.visit_unit(),
+            TAG_FALSE => visitor.visit_bool(false),
+            TAG_TRUE => visitor.visit_bool(true),
+            TAG_INT => {
+                let u = self.uvarint()?;
+                let v = (u >> 1) as i64 ^ -((u & 1) as i64);
+                if v >= 0 {
+                    visitor.visit_u64(v as u64)
+                } else {
+                    visitor.visit_i64(v)
+                }
+            }
+            TAG_FLOAT => {
+                let end = self.pos + 8;
+                let bytes = self
+                    .data
+                    .get(self.pos..end)
+                    .ok_or_else(|| corrupt("truncated float"))?;
+                self.pos = end;
+                visitor.visit_f64(f64::from_le_bytes(bytes.try_into().unwrap()))
+            }
+            TAG_STRING => visitor.visit_borrowed_str(self.string()?),
+            TAG_ARRAY => {
+                let remaining = self.count()?;
+                visitor.visit_seq(Elements {
+                    de: self,
+                    remaining,
+                })
+            }
+            TAG_MAP => {
+                let remaining = self.count()?;
+                visitor.visit_map(Elements {
+                    de: self,
+                    remaining,
+                })
+            }
+            tag => Err(Error(format!("unknown tag {}", tag))),
+        }
+    }
+
+    fn deserialize_option<V: Visitor<'de>>(self, visitor: V) -> Result<V::Value, Error> {
+        if self.data.get(self.pos) == Some(&TAG_NULL) {
+            self.pos += 1;
+            visitor.visit_none()
+        } else {
+            visitor.visit_some(self)
+        }
+    }
+
+    serde::forward_to_deserialize_any! {
+        bool i8 i16 i32 i64 i128 u8 u16 u32 u64 u128 f32 f64 char str string
+        bytes byte_buf unit unit_struct newtype_struct seq tuple tuple_struct
+        map struct enum identifier ignored_any
+    }
+}
+
+/// Elements of an array, or entries of a map (key: bare string index).
+struct Elements<'a, 'de> {
+    de: &'a mut Deserializer<'de>,
+    remaining: usize,
+}
+
+impl<'de, 'a> SeqAccess<'de> for Elements<'a, 'de> {
+    type Error = Error;
+
+    fn next_element_seed<T: DeserializeSeed<'de>>(
+        &mut self,
+        seed: T,
+    ) -> Result<Option<T::Value>, Error> {
+        if self.remaining == 0 {
+            return Ok(None);
+        }
+        self.remaining -= 1;
+        seed.deserialize(&mut *self.de).map(Some)
+    }
+
+    fn size_hint(&self) -> Option<usize> {
+        Some(self.remaining)
+    }
+}
+
+impl<'de, 'a> MapAccess<'de> for Elements<'a, 'de> {
+    type Error = Error;
+
+    fn next_key_seed<K: DeserializeSeed<'de>>(
+        &mut self,
+        seed: K,
+    ) -> Result<Option<K::Value>, Error> {
+        if self.remaining == 0 {
+            return Ok(None);
+        }
+        self.remaining -= 1;
+        let key = self.de.string()?;
+        seed.deserialize(de::value::BorrowedStrDeserializer::new(key))
+            .map(Some)
+    }
+
+    fn next_value_seed<V: DeserializeSeed<'de>>(&mut self, seed: V) -> Result<V::Value, Error> {
+        seed.deserialize(&mut *self.de)
+    }
+
+    fn size_hint(&self) -> Option<usize> {
+        Some(self.remaining)
+    }
+}
+
+/// A read-only view of a whole file: mapped on unix, read elsewhere.
+pub struct MappedFile {
+    #[cfg(unix)]
+    ptr: *mut libc::c_void,
+    #[cfg(unix)]
+    len: usize,
+    #[cfg(not(unix))]
+    data: Vec<u8>,
+}
+
+impl MappedFile {
+    #[cfg(unix)]
+    pub fn open(path: &Path) -> io::Result<MappedFile> {
+        use std::os::unix::io::AsRawFd;
+
+        let file = File::open(path)?;
+        let len = file.metadata()?.len() as usize;
+        if len == 0 {
+            return Ok(MappedFile {
+                ptr: std::ptr::null_mut(),
+                len: 0,
+            });
+        }
+        // SAFETY: a fresh read-only private mapping of a file we just opened;
+        // the pointer is only exposed as a slice tied to &self.
+        let ptr = unsafe {
+            libc::mmap(
+                std::ptr::null_mut(),
+                len,
+                libc::PROT_READ,
+                libc::MAP_PRIVATE,
+                file.as_raw_fd(),
+                0,
+            )
+        };
+        if ptr == libc::MAP_FAILED {
+            return Err(io::Error::last_os_error());
+        }
+        Ok(MappedFile { ptr, len })
+    }
+
+    #[cfg(not(unix))]
+    pub fn open(path: &Path) -> io::Result<MappedFile> {
+        let _ = File::open(path)?;
+        Ok(MappedFile {
+            data: std::fs::read(path)?,
+        })
+    }
+
+    #[cfg(unix)]
+    pub fn bytes(&self) -> &[u8] {
+        if self.len == 0 {
+            return &[];
+        }
+        // SAFETY: ptr/len describe a live mapping owned by self
+        unsafe { std::slice::from_raw_parts(self.ptr as *const u8, self.len) }
+    }
+
+    #[cfg(not(unix))]
+    pub fn bytes(&self) -> &[u8] {
+        &self.data
+    }
+}
+
+#[cfg(unix)]
+impl Drop for MappedFile {
+    fn drop(&mut self) {
+        if self.len != 0 {
+            // SAFETY: unmapping the mapping created in open
+            unsafe {
+                libc::munmap(self.ptr, self.len);
+            }
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::collections::HashMap;
+
+    #[derive(Debug, Deserialize, PartialEq)]
+    struct Row<'a> {
+        name: &'a str,
+        line: usize,
+        #[serde(default)]
+        tags: HashMap<String, String>,
+        #[serde(default)]
+        note: Option<String>,
+    }
+
+    fn encode(body: &[u8], strings: &[&str]) -> Vec<u8> {
+        let mut out = MAGIC.to_vec();
+        out.extend(VERSION.to_le_bytes());
+        out.extend(0u32.to_le_bytes());
+        out.extend(((HEADER_LEN + body.len()) as u64).to_le_bytes());
+        out.extend_from_slice(body);
+        out.push(strings.len() as u8);
+        for s in strings {
+            out.push(s.len() as u8);
+            out.extend_from_slice(s.as_bytes());
+        }
+        out
+    }
+
+    #[test]
+    fn decodes_borrowed_struct() {
+        // [{"name": "top", "line": 4, "extra": null, "note": null}]
+        let body = [
+            TAG_ARRAY, 1, TAG_MAP, 4, 0, TAG_STRING, 1, 2, TAG_INT, 8, 3, TAG_NULL, 4, TAG_NULL,
+        ];
+        let data = encode(&body, &["name", "top", "line", "extra", "note"]);
+        let rows: Vec<Row> = from_bytes(&data).unwrap();
+        assert_eq!(rows.len(), 1);
+        assert_eq!(rows[0].name, "top");
+        assert_eq!(rows[0].line, 4);
+        assert_eq!(rows[0].note, None);
+    }
+
+    #[test]
+    fn rejects_out_of_range_string() {
+        let data = encode(&[TAG_STRING, 9], &["x"]);
+        assert!(from_bytes::<String>(&data).is_err());
+    }
+}
@@ -1,4 +1,4 @@
-use crate::policy::input::Input;
+use crate::policy::input::{CDCCrossing, Input};
 use crate::policy::result::Violation;
 
 pub fn violations(input: &Input) -> Vec<Violation> {
@@ -9,10 +9,17 @@ pub fn violations(input: &Input) -> Vec<Violation> {
     out
 }
 
-fn cdc_unsync_single_bit(input: &Input) -> Vec<Violation> {
+/// Per-file crossings from the extractor, then those only the clock-domain
+/// graph sees (through instances and combinational logic).
+fn crossings(input: &Input) -> impl Iterator<Item = &CDCCrossing> {
     input
         .cdc_crossings
         .iter()
+        .chain(input.domains().crossings())
+}
+
+fn cdc_unsync_single_bit(input: &Input) -> Vec<Violation> {
+    crossings(input)
         .filter(|cdc| !cdc.is_synchronized && !cdc.is_multi_bit)
         .map(|cdc| Violation {
             rule: "cdc_unsync_single_bit".to_string(),
@@ -28,9 +35,7 @@ fn cdc_unsync_single_bit(input: &Input) -> Vec<Violation> {
 }
 
 fn cdc_unsync_multi_bit(input: &Input) -> Vec<Violation> {
-    input
-        .cdc_crossings
-        .iter()
+    crossings(input)
         .filter(|cdc| !cdc.is_synchronized && cdc.is_multi_bit)
         .map(|cdc| Violation {
             rule: "cdc_unsync_multi_bit".to_string(),
@@ -46,9 +51,7 @@ fn cdc_unsync_multi_bit(input: &Input) -> Vec<Violation> {
 }
 
 fn cdc_insufficient_sync(input: &Input) -> Vec<Violation> {
-    input
-        .cdc_crossings
-        .iter()
+    crossings(input)
         .filter(|cdc| cdc.is_synchronized && cdc.sync_stages < 2)
         .map(|cdc| Violation {
             rule: "cdc_insufficient_sync".to_string(),
@@ -107,9 +107,15 @@ fn case_in_combinational_process(input: &Input, cs: &crate::policy::input::CaseS
     if cs.in_process.is_empty() {
         return false;
     }
-    input.processes.iter().any(|proc| {
-        proc.label == cs.in_process && proc.in_arch == cs.in_arch && proc.is_combinational
-    })
+    input
+        .index()
+        .name(&cs.in_process)
+        .processes_labelled
+        .iter()
+        .map(|&i| &input.processes[i as usize])
+        .any(|proc| {
+            proc.label == cs.in_process && proc.in_arch == cs.in_arch && proc.is_combinational
+        })
 }
 
 fn entity_without_arch(input: &Input) -> Vec<Violation> {
@@ -237,10 +243,11 @@ fn base_entity_name(name: &str) -> String {
 }
 
 fn has_architecture(input: &Input, entity_name: &str) -> bool {
-    input
-        .architectures
-        .iter()
-        .any(|arch| arch.entity_name.eq_ignore_ascii_case(entity_name))
+    !input
+        .index()
+        .name(entity_name)
+        .architectures_of_entity
+        .is_empty()
 }
 
 #[cfg(test)]
@@ -0,0 +1,960 @@
+//! Clock-domain graph over the whole input, built once per evaluation
+//! (`Input::domains`) for the CDC and RDC rules.
+//!
+//! Each entity is a scope whose nodes are its signal and port names.
+//! Sequential processes label what they assign with their clock, and
+//! combinational processes, concurrent assignments and instance port maps
+//! carry labels from what is read to what is driven. A worklist propagates
+//! them to a fixpoint. A register that reads a node labelled with another
+//! clock is a crossing.
+//!
+//! Scopes are summarized bottom-up, once per entity: which labels reach
+//! each output port, and which clocks register each input port. At each
+//! instance, the summary is rewritten in the parent's terms: a child clock
+//! port becomes the actual clock it is bound to. So a crossing
+//! whose source register and destination register sit in different
+//! entities or files is found where the two domains meet.
+//!
+//! Crossings the extractor already reports per file (`Input::cdc_crossings`)
+//! are not repeated. `crossings()` holds the rest: those through instances
+//! and through combinational logic.
+//!
+//! Cost is bounded. A node keeps at most `MAX_LABELS` labels and is
+//! requeued only when its set grows. Processes and assignments reach their
+//! targets through one hop node each. Together that makes propagation
+//! linear in reads, writes and port associations. An entity instantiated
+//! under different clocks is summarized once, in terms of its own clock
+//! ports.
+
+use std::collections::{BTreeSet, HashMap, HashSet};
+
+use crate::policy::helpers;
+use crate::policy::input::{CDCCrossing, Input, Process};
+
+/// Labels kept per node; beyond this a node is saturated and stops growing
+/// (it still reports the crossings its first labels imply).
+const MAX_LABELS: usize = 8;
+
+/// Longest synchronizer chain followed after a crossing.
+const MAX_SYNC_STAGES: usize = 4;
+
+#[derive(Debug, Clone, Default)]
+pub struct ClockDomains {
+    crossings: Vec<CDCCrossing>,
+    /// Exact reset name -> (exact clock, last line) of processes using it
+    reset_clocks: HashMap<String, Vec<(String, usize)>>,
+    /// (file, exact clock) pairs with a sequential process that has a reset
+    reset_domains: HashSet<(String, String)>,
+    /// Lowercased clocks of the processes in each file
+    clocks_by_file: HashMap<String, BTreeSet<String>>,
+}
+
+impl ClockDomains {
+    pub fn build(input: &Input) -> ClockDomains {
+        let mut domains = ClockDomains::default();
+        for proc in &input.processes {
+            if proc.has_reset && !proc.reset_signal.is_empty() && !proc.clock_signal.is_empty() {
+                let clocks = domains
+                    .reset_clocks
+                    .entry(proc.reset_signal.clone())
+                    .or_default();
+                match clocks.iter_mut().find(|(c, _)| *c == proc.clock_signal) {
+                    Some((_, line)) => *line = (*line).max(proc.line),
+                    None => clocks.push((proc.clock_signal.clone(), proc.line)),
+                }
+            }
+            if proc.is_sequential && proc.has_reset && !proc.clock_signal.is_empty() {
+                domains
+                    .reset_domains
+                    .insert((proc.file.clone(), proc.clock_signal.clone()));
+            }
+            if !proc.clock_signal.is_empty() {
+                domains
+                    .clocks_by_file
+                    .entry(proc.file.clone())
+                    .or_default()
+                    .insert(proc.clock_signal.to_ascii_lowercase());
+            }
+        }
+        domains.crossings = Graph::new(input).crossings();
+        domains
+    }
+
+    /// Crossings through instances and combinational logic, in addition to
+    /// `Input::cdc_crossings`.
+    pub fn crossings(&self) -> &[CDCCrossing] {
+        &self.crossings
+    }
+
+    /// Distinct clocks of the processes reset by `reset` (exact name), each
+    /// with the last line of a process in that domain.
+    pub fn reset_clocks(&self, reset: &str) -> &[(String, usize)] {
+        self.reset_clocks.get(reset).map_or(&[], Vec::as_slice)
+    }
+
+    /// Whether a sequential process in `file` clocked by `clock` has a reset.
+    pub fn has_reset_in_domain(&self, file: &str, clock: &str) -> bool {
+        self.reset_domains
+            .contains(&(file.to_string(), clock.to_string()))
+    }
+
+    /// Lowercased clocks used in `file`, sorted.
+    pub fn clocks_in_file(&self, file: &str) -> Option<&BTreeSet<String>> {
+        self.clocks_by_file.get(file)
+    }
+}
+
+/// A node label: registered in a clock domain, or passed through unregistered
+/// from one of the scope's input ports.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, PartialOrd, Ord)]
+enum Label {
+    Clock(u32),
+    Input(u32),
+}
+
+/// Input port `port` of a scope is registered by `clock` in `proc`.
+#[derive(Debug, Clone, Copy)]
+struct Sample {
+    clock: u32,
+    proc: u32,
+}
+
+#[derive(Debug, Default)]
+struct Summary {
+    /// Output port node -> labels reaching it
+    outputs: Vec<(u32, Vec<Label>)>,
+    /// Input port node -> registers sampling it
+    samples: HashMap<u32, Vec<Sample>>,
+}
+
+/// Where a crossing is reported.
+struct Site<'s> {
+    file: &'s str,
+    line: usize,
+    in_arch: &'s str,
+}
+
+/// Rows of one entity, gathered from every architecture of it.
+#[derive(Debug, Default)]
+struct Scope {
+    name: String,
+    ports: HashMap<String, (bool, usize)>, // lowercased -> (is input, width)
+    processes: Vec<u32>,
+    concurrent: Vec<u32>,
+    instances: Vec<u32>,
+}
+
+struct Graph<'a> {
+    input: &'a Input,
+    scopes: Vec<Scope>,
+    scope_of_entity: HashMap<String, u32>,
+    /// (scope, lowercased name) -> clock id
+    clock_ids: HashMap<(u32, String), u32>,
+    clock_names: Vec<(u32, String)>,
+    summaries: Vec<Option<Summary>>,
+    /// Node names of summarized scopes, for reading their summaries
+    node_names: Vec<Vec<String>>,
+    visiting: Vec<bool>,
+    reported: HashSet<(String, usize, String)>,
+    out: Vec<CDCCrossing>,
+}
+
+impl<'a> Graph<'a> {
+    fn new(input: &'a Input) -> Graph<'a> {
+        let mut g = Graph {
+            input,
+            scopes: Vec::new(),
+            scope_of_entity: HashMap::new(),
+            clock_ids: HashMap::new(),
+            clock_names: Vec::new(),
+            summaries: Vec::new(),
+            node_names: Vec::new(),
+            visiting: Vec::new(),
+            reported: input
+                .cdc_crossings
+                .iter()
+                .map(|c| (c.file.clone(), c.line, c.signal.to_ascii_lowercase()))
+                .collect(),
+            out: Vec::new(),
+        };
+        for entity in &input.entities {
+            g.scope(&entity.name);
+        }
+        for port in &input.ports {
+            if let Some(&s) = g.scope_of_entity.get(&port.in_entity.to_ascii_lowercase()) {
+                let is_input = port.direction.eq_ignore_ascii_case("in");
+                g.scopes[s as usize]
+                    .ports
+                    .insert(port.name.to_ascii_lowercase(), (is_input, port.width));
+            }
+        }
+        // Architecture (file, name) -> scope of the entity it implements
+        let mut arch_scope: HashMap<(&str, String), u32> = HashMap::new();
+        for arch in &input.architectures {
+            if let Some(&s) = g
+                .scope_of_entity
+                .get(&arch.entity_name.to_ascii_lowercase())
+            {
+                arch_scope.insert((arch.file.as_str(), arch.name.to_ascii_lowercase()), s);
+            }
+        }
+        let lookup = |file: &str, in_arch: &str| {
+            arch_scope
+                .get(&(file, helpers::base_arch_name(in_arch).to_ascii_lowercase()))
+                .copied()
+        };
+        for (i, proc) in input.processes.iter().enumerate() {
+            if let Some(s) = lookup(&proc.file, &proc.in_arch) {
+                g.scopes[s as usize].processes.push(i as u32);
+            }
+        }
+        for (i, ca) in input.concurrent_assignments.iter().enumerate() {
+            if let Some(s) = lookup(&ca.file, &ca.in_arch) {
+                g.scopes[s as usize].concurrent.push(i as u32);
+            }
+        }
+        for (i, inst) in input.instances.iter().enumerate() {
+            if let Some(s) = lookup(&inst.file, &inst.in_arch) {
+                g.scopes[s as usize].instances.push(i as u32);
+            }
+        }
+        g.summaries = (0..g.scopes.len()).map(|_| None).collect();
+        g.node_names = vec![Vec::new(); g.scopes.len()];
+        g.visiting = vec![false; g.scopes.len()];
+        g
+    }
+
+    fn scope(&mut self, entity: &str) -> u32 {
+        let key = entity.to_ascii_lowercase();
+        if let Some(&s) = self.scope_of_entity.get(&key) {
+            return s;
+        }
+        let s = self.scopes.len() as u32;
+        self.scopes.push(Scope {
+            name: entity.to_string(),
+            ..Default::default()
+        });
+        self.scope_of_entity.insert(key, s);
+        s
+    }
+
+    fn clock(&mut self, scope: u32, name: &str) -> u32 {
+        let key = (scope, name.to_ascii_lowercase());
+        if let Some(&id) = self.clock_ids.get(&key) {
+            return id;
+        }
+        let id = self.clock_names.len() as u32;
+        self.clock_names.push((scope, name.to_string()));
+        self.clock_ids.insert(key, id);
+        id
+    }
+
+    fn crossings(mut self) -> Vec<CDCCrossing> {
+        for s in 0..self.scopes.len() as u32 {
+            self.summarize(s);
+        }
+        self.out
+    }
+
+    /// Clock `clock` of `child` in `parent`'s terms, through `port_map`:
+    /// a child clock port becomes the clock of its actual; unbound ports
+    /// have no clock.
+    fn rebind_clock(
+        &mut self,
+        parent: u32,
+        child: u32,
+        port_map: &HashMap<String, String>,
+        clock: u32,
+    ) -> Option<u32> {
+        let (scope, name) = self.clock_names[clock as usize].clone();
+        let lower = name.to_ascii_lowercase();
+        if scope != child || !self.scopes[child as usize].ports.contains_key(&lower) {
+            return Some(clock);
+        }
+        let actual = port_map.get(&lower)?;
+        Some(self.clock(parent, actual))
+    }
+
+    fn summarize(&mut self, s: u32) {
+        if self.summaries[s as usize].is_some() || self.visiting[s as usize] {
+            return;
+        }
+        self.visiting[s as usize] = true;
+        let input = self.input;
+
+        // Children first; a recursive instantiation is a black box
+        let mut children: Vec<(u32, u32, HashMap<String, String>)> = Vec::new();
+        for &i in &self.scopes[s as usize].instances.clone() {
+            let inst = &input.instances[i as usize];
+            let Some(&child) = self.scope_of_entity.get(&instance_entity(&inst.target)) else {
+                continue;
+            };
+            self.summarize(child);
+            if self.summaries[child as usize].is_none() {
+                continue;
+            }
+            let port_map = inst
+                .port_map
+                .iter()
+                .filter_map(|(formal, actual)| {
+                    signal_name(actual)
+                        .map(|a| (formal.to_ascii_lowercase(), a.to_ascii_lowercase()))
+                })
+                .collect();
+            children.push((i, child, port_map));
+        }
+
+        let mut nodes = Nodes::default();
+        let mut ports: Vec<(String, bool)> = self.scopes[s as usize]
+            .ports
+            .iter()
+            .map(|(name, &(is_input, _))| (name.clone(), is_input))
+            .collect();
+        ports.sort_unstable();
+        for (name, is_input) in &ports {
+            let n = nodes.id(name);
+            if *is_input {
+                nodes.seed(n, Label::Input(n));
+            }
+        }
+        let processes = self.scopes[s as usize].processes.clone();
+        for &p in &processes {
+            let proc = &input.processes[p as usize];
+            if proc.is_sequential && !proc.clock_signal.is_empty() {
+                let clock = self.clock(s, &proc.clock_signal);
+                for sig in &proc.assigned_signals {
+                    let n = nodes.id(sig);
+                    nodes.seed(n, Label::Clock(clock));
+                }
+            } else if !proc.is_sequential {
+                let hop = nodes.hop();
+                for sig in &proc.read_signals {
+                    let n = nodes.id(sig);
+                    nodes.edge(n, hop);
+                }
+                for sig in &proc.assigned_signals {
+                    let n = nodes.id(sig);
+                    nodes.edge(hop, n);
+                }
+            }
+        }
+        for &c in &self.scopes[s as usize].concurrent.clone() {
+            let ca = &input.concurrent_assignments[c as usize];
+            let target = nodes.id(&ca.target);
+            let hop = nodes.hop();
+            nodes.edge(hop, target);
+            for sig in &ca.read_signals {
+                let n = nodes.id(sig);
+                nodes.edge(n, hop);
+            }
+        }
+        for (_, child, port_map) in &children {
+            let outputs = self.summaries[*child as usize]
+                .as_ref()
+                .map(|sum| sum.outputs.clone())
+                .unwrap_or_default();
+            for (port, labels) in outputs {
+                let formal = self.child_port_name(*child, port);
+                let Some(actual) = port_map.get(&formal) else {
+                    continue;
+                };
+                let target = nodes.id(actual);
+                for label in labels {
+                    match label {
+                        Label::Clock(k) => {
+                            if let Some(k) = self.rebind_clock(s, *child, port_map, k) {
+                                nodes.seed(target, Label::Clock(k));
+                            }
+                        }
+                        Label::Input(d) => {
+                            let formal = self.child_port_name(*child, d);
+                            if let Some(source) = port_map.get(&formal) {
+                                let n = nodes.id(source);
+                                nodes.edge(n, target);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        nodes.propagate();
+
+        let mut summary = Summary::default();
+        for &p in &processes {
+            let proc = &input.processes[p as usize];
+            if !proc.is_sequential || proc.clock_signal.is_empty() {
+                continue;
+            }
+            let clock = self.clock(s, &proc.clock_signal);
+            for sig in data_reads(proc) {
+                let Some(n) = nodes.get(sig) else {
+                    continue;
+                };
+                for &label in nodes.labels(n) {
+                    match label {
+                        Label::Clock(k) if k != clock => {
+                            let site = Site {
+                                file: &proc.file,
+                                line: proc.line,
+                                in_arch: &proc.in_arch,
+                            };
+                            self.report(s, p, sig, (k, clock), site);
+                        }
+                        Label::Clock(_) => {}
+                        Label::Input(d) => add_sample(&mut summary, d, Sample { clock, proc: p }),
+                    }
+                }
+            }
+        }
+        for (inst_row, child, port_map) in &children {
+            let samples: Vec<(u32, Vec<Sample>)> = self.summaries[*child as usize]
+                .as_ref()
+                .map(|sum| sum.samples.iter().map(|(&d, v)| (d, v.clone())).collect())
+                .unwrap_or_default();
+            let inst = &input.instances[*inst_row as usize];
+            for (port, samples) in samples {
+                let formal = self.child_port_name(*child, port);
+                let Some(actual) = port_map.get(&formal) else {
+                    continue;
+                };
+                let Some(n) = nodes.get(actual) else {
+                    continue;
+                };
+                for sample in samples {
+                    let Some(clock) = self.rebind_clock(s, *child, port_map, sample.clock) else {
+                        continue;
+                    };
+                    for &label in nodes.labels(n) {
+                        match label {
+                            Label::Clock(k) if k != clock => {
+                                let site = Site {
+                                    file: &inst.file,
+                                    line: inst.line,
+                                    in_arch: &inst.in_arch,
+                                };
+                                self.report(s, sample.proc, actual, (k, clock), site);
+                            }
+                            Label::Clock(_) => {}
+                            Label::Input(d) => add_sample(
+                                &mut summary,
+                                d,
+                                Sample {
+                                    clock,
+                                    proc: sample.proc,
+                                },
+                            ),
+                        }
+                    }
+                }
+            }
+        }
+        for (name, is_input) in &ports {
+            if !is_input {
+                if let Some(n) = nodes.get(name) {
+                    summary.outputs.push((n, nodes.labels(n).to_vec()));
+                }
+            }
+        }
+        summary.outputs.sort_unstable_by_key(|(n, _)| *n);
+        self.node_names[s as usize] = nodes.names;
+        self.summaries[s as usize] = Some(summary);
+        self.visiting[s as usize] = false;
+    }
+
+    fn child_port_name(&self, child: u32, node: u32) -> String {
+        self.node_names[child as usize][node as usize].clone()
+    }
+
+    /// Records a crossing of `signal` from clock `source` to `dest` (both
+    /// as seen from `scope`), registered first by `dest_proc`.
+    fn report(
+        &mut self,
+        scope: u32,
+        dest_proc: u32,
+        signal: &str,
+        (source, dest): (u32, u32),
+        site: Site,
+    ) {
+        let Site {
+            file,
+            line,
+            in_arch,
+        } = site;
+        if !self
+            .reported
+            .insert((file.to_string(), line, signal.to_ascii_lowercase()))
+        {
+            return;
+        }
+        let input = self.input;
+        let proc = &input.processes[dest_proc as usize];
+        let stages = sync_stages(input, dest_proc);
+        self.out.push(CDCCrossing {
+            signal: signal.to_string(),
+            source_clock: self.clock_label(scope, source),
+            dest_clock: self.clock_label(scope, dest),
+            is_synchronized: stages > 0,
+            sync_stages: stages,
+            is_multi_bit: self.width(scope, signal, file) > 1,
+            source_proc: String::new(),
+            dest_proc: proc.label.clone(),
+            file: file.to_string(),
+            line,
+            in_arch: in_arch.to_string(),
+        });
+    }
+
+    /// A clock as seen from `scope`: its name there, or entity.name for a
+    /// clock generated inside an instance.
+    fn clock_label(&self, scope: u32, clock: u32) -> String {
+        let (owner, name) = &self.clock_names[clock as usize];
+        if *owner == scope {
+            name.clone()
+        } else {
+            format!("{}.{}", self.scopes[*owner as usize].name, name)
+        }
+    }
+
+    fn width(&self, scope: u32, signal: &str, file: &str) -> usize {
+        let from_signals = self
+            .input
+            .index()
+            .name(signal)
+            .signals
+            .iter()
+            .map(|&i| &self.input.signals[i as usize])
+            .filter(|sig| sig.file == file)
+            .map(|sig| sig.width)
+            .max()
+            .unwrap_or(0);
+        let from_port = self.scopes[scope as usize]
+            .ports
+            .get(&signal.to_ascii_lowercase())
+            .map_or(0, |&(_, width)| width);
+        from_signals.max(from_port)
+    }
+}
+
+/// Node table of the scope being summarized: names (and hop nodes) with
+/// their labels and successors.
+#[derive(Default)]
+struct Nodes {
+    ids: HashMap<String, u32>,
+    names: Vec<String>,
+    labels: Vec<Vec<Label>>,
+    succ: Vec<Vec<u32>>,
+    queue: Vec<u32>,
+}
+
+impl Nodes {
+    fn get(&self, name: &str) -> Option<u32> {
+        self.ids.get(&name.to_ascii_lowercase()).copied()
+    }
+
+    fn id(&mut self, name: &str) -> u32 {
+        let key = name.to_ascii_lowercase();
+        if let Some(&n) = self.ids.get(&key) {
+            return n;
+        }
+        let n = self.push(key.clone());
+        self.ids.insert(key, n);
+        n
+    }
+
+    /// An anonymous node joining the reads of one process or assignment to
+    /// its targets.
+    fn hop(&mut self) -> u32 {
+        self.push(String::new())
+    }
+
+    fn push(&mut self, name: String) -> u32 {
+        let n = self.names.len() as u32;
+        self.names.push(name);
+        self.labels.push(Vec::new());
+        self.succ.push(Vec::new());
+        n
+    }
+
+    fn edge(&mut self, from: u32, to: u32) {
+        if from != to {
+            self.succ[from as usize].push(to);
+        }
+    }
+
+    fn seed(&mut self, n: u32, label: Label) {
+        if insert_label(&mut self.labels[n as usize], label) {
+            self.queue.push(n);
+        }
+    }
+
+    fn labels(&self, n: u32) -> &[Label] {
+        &self.labels[n as usize]
+    }
+
+    fn propagate(&mut self) {
+        while let Some(n) = self.queue.pop() {
+            let labels = self.labels[n as usize].clone();
+            for i in 0..self.succ[n as usize].len() {
+                let m = self.succ[n as usize][i];
+                let mut grew = false;
+                for &label in &labels {
+                    grew |= insert_label(&mut self.labels[m as usize], label);
+                }
+                if grew {
+                    self.queue.push(m);
+                }
+            }
+        }
+    }
+}
+
+/// Records that input port `port` is registered by `sample`, keeping at most
+/// `MAX_LABELS` distinct samples per port.
+fn add_sample(summary: &mut Summary, port: u32, sample: Sample) {
+    let samples = summary.samples.entry(port).or_default();
+    if samples.len() < MAX_LABELS
+        && !samples
+            .iter()
+            .any(|s| s.clock == sample.clock && s.proc == sample.proc)
+    {
+        samples.push(sample);
+    }
+}
+
+/// Adds `label` to the sorted set unless present or full.
+fn insert_label(labels: &mut Vec<Label>, label: Label) -> bool {
+    match labels.binary_search(&label) {
+        Ok(_) => false,
+        Err(_) if labels.len() >= MAX_LABELS => false,
+        Err(pos) => {
+            labels.insert(pos, label);
+            true
+        }
+    }
+}
+
+/// Reads of a sequential process that carry data (not its clock, reset or
+/// edge functions).
+fn data_reads(proc: &Process) -> impl Iterator<Item = &str> {
+    proc.read_signals
+        .iter()
+        .map(String::as_str)
+        .filter(move |sig| {
+            !sig.eq_ignore_ascii_case(&proc.clock_signal)
+                && !sig.eq_ignore_ascii_case(&proc.reset_signal)
+                && !sig.eq_ignore_ascii_case("rising_edge")
+                && !sig.eq_ignore_ascii_case("falling_edge")
+        })
+}
+
+/// Registers in a chain starting at `proc`, each assigning one signal from
+/// one data read and feeding the next: the synchronizer stages behind a
+/// crossing (same shape as the extractor's per-file detection).
+fn sync_stages(input: &Input, proc: u32) -> usize {
+    let mut stages = 0;
+    let mut current = &input.processes[proc as usize];
+    while stages < MAX_SYNC_STAGES {
+        if !current.is_sequential
+            || current.assigned_signals.len() != 1
+            || data_reads(current).count() != 1
+        {
+            break;
+        }
+        stages += 1;
+        let assigned = &current.assigned_signals[0];
+        let next = input
+            .index()
+            .name(assigned)
+            .reading_processes
+            .iter()
+            .map(|&i| &input.processes[i as usize])
+            .find(|p| {
+                p.file == current.file
+                    && p.in_arch == current.in_arch
+                    && p.is_sequential
+                    && p.clock_signal.eq_ignore_ascii_case(&current.clock_signal)
+                    && !std::ptr::eq(*p, current)
+            });
+        match next {
+            Some(p) => current = p,
+            None => break,
+        }
+    }
+    stages
+}
+
+/// Entity named by an instance target: "work.core", "entity work.core(rtl)"
+/// and "core" all name core.
+fn instance_entity(target: &str) -> String {
+    let target = target.trim();
+    let target = target
+        .strip_prefix("entity ")
+        .or_else(|| target.strip_prefix("ENTITY "))
+        .unwrap_or(target);
+    let target = target.split('(').next().unwrap_or(target).trim();
+    target
+        .rsplit('.')
+        .next()
+        .unwrap_or(target)
+        .to_ascii_lowercase()
+}
+
+/// The signal an actual connects, if it is one: "data", "data(3)" and
+/// "data(7 downto 0)" connect data; literals, open and expressions do not.
+fn signal_name(actual: &str) -> Option<&str> {
+    let base = actual.split('(').next().unwrap_or(actual).trim();
+    let mut chars = base.chars();
+    let first = chars.next()?;
+    if !first.is_ascii_alphabetic() || !chars.all(|c| c.is_ascii_alphanumeric() || c == '_') {
+        return None;
+    }
+    if base.eq_ignore_ascii_case("open") {
+        return None;
+    }
+    Some(base)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::policy::input::{Architecture, Entity, Instance, Port};
+
+    fn entity(input: &mut Input, name: &str, file: &str, ports: &[(&str, &str)]) {
+        input.entities.push(Entity {
+            name: name.to_string(),
+            file: file.to_string(),
+            ..Default::default()
+        });
+        input.architectures.push(Architecture {
+            name: "rtl".to_string(),
+            entity_name: name.to_string(),
+            file: file.to_string(),
+            line: 1,
+        });
+        for (port, dir) in ports {
+            input.ports.push(Port {
+                name: port.to_string(),
+                direction: dir.to_string(),
+                in_entity: name.to_string(),
+                width: 1,
+                ..Default::default()
+            });
+        }
+    }
+
+    fn register(
+        input: &mut Input,
+        file: &str,
+        label: &str,
+        clock: &str,
+        reads: &[&str],
+        writes: &[&str],
+        line: usize,
+    ) {
+        input.processes.push(Process {
+            label: label.to_string(),
+            is_sequential: true,
+            clock_signal: clock.to_string(),
+            read_signals: reads.iter().map(|s| s.to_string()).collect(),
+            assigned_signals: writes.iter().map(|s| s.to_string()).collect(),
+            file: file.to_string(),
+            line,
+            in_arch: "rtl".to_string(),
+            ..Default::default()
+        });
+    }
+
+    fn instance(
+        input: &mut Input,
+        file: &str,
+        name: &str,
+        target: &str,
+        map: &[(&str, &str)],
+        line: usize,
+    ) {
+        input.instances.push(Instance {
+            name: name.to_string(),
+            target: target.to_string(),
+            port_map: map
+                .iter()
+                .map(|(f, a)| (f.to_string(), a.to_string()))
+                .collect(),
+            file: file.to_string(),
+            line,
+            in_arch: "rtl".to_string(),
+            ..Default::default()
+        });
+    }
+
+    /// top: u_src (clocked by clk_a) drives x; a clk_b register (not a
+    /// synchronizer: it also reads en) reads x.
+    fn output_crossing() -> Input {
+        let mut input = Input::default();
+        entity(
+            &mut input,
+            "src",
+            "src.vhd",
+            &[("clk", "in"), ("d", "in"), ("q", "out")],
+        );
+        register(
+            &mut input,
+            "src.vhd",
+            "p_q",
+            "clk",
+            &["clk", "d"],
+            &["q"],
+            5,
+        );
+        entity(
+            &mut input,
+            "top",
+            "top.vhd",
+            &[("clk_a", "in"), ("clk_b", "in"), ("din", "in")],
+        );
+        instance(
+            &mut input,
+            "top.vhd",
+            "u_src",
+            "work.src",
+            &[("clk", "clk_a"), ("d", "din"), ("q", "x")],
+            10,
+        );
+        register(
+            &mut input,
+            "top.vhd",
+            "p_y",
+            "clk_b",
+            &["clk_b", "x", "en"],
+            &["y"],
+            20,
+        );
+        input
+    }
+
+    #[test]
+    fn crossing_through_instance_output() {
+        let input = output_crossing();
+        let crossings = ClockDomains::build(&input).crossings;
+        assert_eq!(crossings.len(), 1, "{:?}", crossings);
+        let c = &crossings[0];
+        assert_eq!(
+            (c.signal.as_str(), c.file.as_str(), c.line),
+            ("x", "top.vhd", 20)
+        );
+        assert_eq!(
+            (c.source_clock.as_str(), c.dest_clock.as_str()),
+            ("clk_a", "clk_b")
+        );
+        assert!(!c.is_synchronized);
+    }
+
+    #[test]
+    fn no_crossing_when_instance_shares_the_clock() {
+        let mut input = output_crossing();
+        input.instances[0]
+            .port_map
+            .insert("clk".to_string(), "clk_b".to_string());
+        assert!(ClockDomains::build(&input).crossings.is_empty());
+    }
+
+    #[test]
+    fn crossing_into_instance_input() {
+        let mut input = Input::default();
+        entity(
+            &mut input,
+            "sink",
+            "sink.vhd",
+            &[("clk", "in"), ("d", "in"), ("q", "out")],
+        );
+        register(
+            &mut input,
+            "sink.vhd",
+            "p_meta",
+            "clk",
+            &["clk", "d"],
+            &["meta"],
+            5,
+        );
+        register(
+            &mut input,
+            "sink.vhd",
+            "p_sync",
+            "clk",
+            &["clk", "meta"],
+            &["q"],
+            8,
+        );
+        entity(
+            &mut input,
+            "top",
+            "top.vhd",
+            &[("clk_a", "in"), ("clk_b", "in")],
+        );
+        register(
+            &mut input,
+            "top.vhd",
+            "p_x",
+            "clk_a",
+            &["clk_a", "a"],
+            &["x"],
+            3,
+        );
+        // Combinational hop: buffered x reaches the instance
+        input
+            .concurrent_assignments
+            .push(crate::policy::input::ConcurrentAssignment {
+                target: "x_buf".to_string(),
+                read_signals: vec!["x".to_string()],
+                file: "top.vhd".to_string(),
+                in_arch: "rtl".to_string(),
+                ..Default::default()
+            });
+        instance(
+            &mut input,
+            "top.vhd",
+            "u_sink",
+            "entity work.sink(rtl)",
+            &[("clk", "clk_b"), ("d", "x_buf")],
+            12,
+        );
+
+        let crossings = ClockDomains::build(&input).crossings;
+        assert_eq!(crossings.len(), 1, "{:?}", crossings);
+        let c = &crossings[0];
+        assert_eq!(
+            (c.signal.as_str(), c.file.as_str(), c.line),
+            ("x_buf", "top.vhd", 12)
+        );
+        assert_eq!(c.dest_proc, "p_meta");
+        assert_eq!(c.sync_stages, 2);
+    }
+
+    #[test]
+    fn extractor_crossings_are_not_repeated() {
+        let mut input = Input::default();
+        entity(
+            &mut input,
+            "top",
+            "top.vhd",
+            &[("clk_a", "in"), ("clk_b", "in")],
+        );
+        register(&mut input, "top.vhd", "p_x", "clk_a", &["clk_a"], &["x"], 3);
+        register(
+            &mut input,
+            "top.vhd",
+            "p_y",
+            "clk_b",
+            &["clk_b", "x"],
+            &["y"],
+            7,
+        );
+        assert_eq!(ClockDomains::build(&input).crossings.len(), 1);
+        input.cdc_crossings.push(CDCCrossing {
+            signal: "x".to_string(),
+            file: "top.vhd".to_string(),
+            line: 7,
+            ..Default::default()
+        });
+        assert!(ClockDomains::build(&input).crossings.is_empty());
+    }
+}
@@ -0,0 +1,222 @@
+//! Instance hierarchy over the whole input, elaborated once per evaluation
+//! (`Input::elaboration`) for the hierarchy rules.
+//!
+//! Each distinct instantiated target (lowercased, e.g. `work.fifo`) is one
+//! module: the entities it binds to and, per entity, the ports the rules
+//! check. It is resolved once and shared by every instance of it, so an IP
+//! instantiated hundreds of times costs one entity lookup, not one scan of
+//! all entities per instance.
+//!
+//! Port widths arrive from the extractor already resolved; a width that
+//! depends on a generic is 0 and never checked. A module's interface is
+//! therefore the same under every generic map, and modules are keyed by
+//! target alone. Like `index`, the elaboration is derived from the input
+//! it is built over, so an entity whose facts changed is re-elaborated on
+//! the next evaluation with nothing to invalidate by hand.
+
+use std::collections::HashMap;
+
+use crate::policy::helpers;
+use crate::policy::input::Input;
+
+/// A target's resolution to one entity.
+#[derive(Debug, Clone, Default)]
+pub struct Binding {
+    /// Position in `Input::entities`
+    pub entity: u32,
+    /// Positions in the entity's `ports` of inputs with no default that are
+    /// neither clocks nor resets: each instance must connect them
+    pub required_inputs: Vec<u32>,
+    /// Positions in the entity's `ports` with a known width
+    pub sized_ports: Vec<u32>,
+}
+
+/// One instantiated target and the entities it binds to, in input order.
+#[derive(Debug, Clone, Default)]
+pub struct Module {
+    pub bindings: Vec<Binding>,
+}
+
+#[derive(Debug, Clone, Default)]
+pub struct Elaboration {
+    modules: Vec<Module>,
+    /// `Input::instances` position -> module
+    instance_module: Vec<u32>,
+    /// Instances per file and exact `in_arch`
+    instance_counts: HashMap<String, HashMap<String, usize>>,
+}
+
+impl Elaboration {
+    pub fn build(input: &Input) -> Elaboration {
+        let mut elab = Elaboration {
+            instance_module: Vec::with_capacity(input.instances.len()),
+            ..Default::default()
+        };
+        let mut by_target: HashMap<String, u32> = HashMap::new();
+        for inst in &input.instances {
+            let target = inst.target.to_ascii_lowercase();
+            let id = match by_target.get(&target) {
+                Some(&id) => id,
+                None => {
+                    let id = elab.modules.len() as u32;
+                    elab.modules.push(resolve(input, &target));
+                    by_target.insert(target, id);
+                    id
+                }
+            };
+            elab.instance_module.push(id);
+            *elab
+                .instance_counts
+                .entry(inst.file.clone())
+                .or_default()
+                .entry(inst.in_arch.clone())
+                .or_default() += 1;
+        }
+        elab
+    }
+
+    /// The module instance `i` (position in `Input::instances`) elaborates to.
+    pub fn module_of(&self, i: usize) -> &Module {
+        &self.modules[self.instance_module[i] as usize]
+    }
+
+    /// Distinct instantiated targets
+    pub fn module_count(&self) -> usize {
+        self.modules.len()
+    }
+
+    /// Instances in `file` whose `in_arch` is exactly `arch`
+    pub fn instances_in(&self, file: &str, arch: &str) -> usize {
+        self.instance_counts
+            .get(file)
+            .and_then(|archs| archs.get(arch))
+            .copied()
+            .unwrap_or(0)
+    }
+}
+
+/// Entities `target` (lowercased) names: `ent` or `lib.ent`. Entity names
+/// carry no dots, so the candidates are the entities named like the last
+/// segment.
+fn resolve(input: &Input, target: &str) -> Module {
+    let last = target.rsplit('.').next().unwrap_or(target);
+    let mut module = Module::default();
+    for &e in &input.index().name(last).entities {
+        let entity = &input.entities[e as usize];
+        if !target_matches_entity(target, &entity.name.to_ascii_lowercase()) {
+            continue;
+        }
+        let mut binding = Binding {
+            entity: e,
+            ..Default::default()
+        };
+        for (pos, port) in entity.ports.iter().enumerate() {
+            if port.direction == "in"
+                && port.default.trim().is_empty()
+                && !helpers::is_clock_name(&port.name)
+                && !helpers::is_reset_name(&port.name)
+            {
+                binding.required_inputs.push(pos as u32);
+            }
+            if port.width != 0 {
+                binding.sized_ports.push(pos as u32);
+            }
+        }
+        module.bindings.push(binding);
+    }
+    module
+}
+
+fn target_matches_entity(target: &str, entity_name: &str) -> bool {
+    target == entity_name || target.ends_with(&format!(".{}", entity_name))
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::policy::input::{Entity, Instance, Port};
+
+    fn instance(name: &str, target: &str, arch: &str) -> Instance {
+        Instance {
+            name: name.to_string(),
+            target: target.to_string(),
+            file: "top.vhd".to_string(),
+            in_arch: arch.to_string(),
+            ..Default::default()
+        }
+    }
+
+    #[test]
+    fn instances_of_one_target_share_a_module() {
+        let mut input = Input::default();
+        input.entities.push(Entity {
+            name: "Fifo".to_string(),
+            ports: vec![
+                Port {
+                    name: "clk".to_string(),
+                    direction: "in".to_string(),
+                    ..Default::default()
+                },
+                Port {
+                    name: "din".to_string(),
+                    direction: "in".to_string(),
+                    width: 8,
+                    ..Default::default()
+                },
+                Port {
+                    name: "dout".to_string(),
+                    direction: "out".to_string(),
+                    width: 8,
+                    ..Default::default()
+                },
+            ],
+            ..Default::default()
+        });
+        for i in 0..100 {
+            input
+                .instances
+                .push(instance(&format!("u{}", i), "work.fifo", "rtl"));
+        }
+        input.instances.push(instance("u_x", "FIFO", "rtl.g0"));
+        input.instances.push(instance("u_y", "work.other", "rtl"));
+
+        let elab = Elaboration::build(&input);
+        assert_eq!(elab.module_count(), 3);
+        let module = elab.module_of(0);
+        assert!(std::ptr::eq(module, elab.module_of(99)));
+        assert_eq!(module.bindings.len(), 1);
+        assert_eq!(module.bindings[0].required_inputs, vec![1]);
+        assert_eq!(module.bindings[0].sized_ports, vec![1, 2]);
+        assert_eq!(elab.module_of(100).bindings.len(), 1);
+        assert!(elab.module_of(101).bindings.is_empty());
+        assert_eq!(elab.instances_in("top.vhd", "rtl"), 101);
+        assert_eq!(elab.instances_in("top.vhd", "rtl.g0"), 1);
+        assert_eq!(elab.instances_in("other.vhd", "rtl"), 0);
+    }
+
+    #[test]
+    fn target_binds_every_entity_of_that_name() {
+        let mut input = Input::default();
+        for file in ["a.vhd", "b.vhd"] {
+            input.entities.push(Entity {
+                name: "child".to_string(),
+                file: file.to_string(),
+                ..Default::default()
+            });
+        }
+        input.entities.push(Entity {
+            name: "child_x".to_string(),
+            ..Default::default()
+        });
+        input.instances.push(instance("u1", "lib.child", "rtl"));
+
+        let elab = Elaboration::build(&input);
+        let entities: Vec<u32> = elab
+            .module_of(0)
+            .bindings
+            .iter()
+            .map(|b| b.entity)
+            .collect();
+        assert_eq!(entities, vec![0, 1]);
+    }
+}
@@ -15,7 +15,9 @@ use crate::policy::power;
 use crate::policy::processes;
 use crate::policy::quality;
 use crate::policy::rdc;
-use crate::policy::result::{AmbiguousConstruct, MissingCheckTask, Result, Summary, Violation};
+use crate::policy::result::{
+    AmbiguousConstruct, MissingCheckTask, Result, Summary, Timing, Violation,
+};
 use crate::policy::security;
 use crate::policy::sensitivity;
 use crate::policy::sequential;
@@ -26,339 +28,367 @@ use crate::policy::synthesis;
 use crate::policy::testbench;
 use crate::policy::types;
 use crate::policy::verification;
+use std::sync::atomic::{AtomicUsize, Ordering};
+use std::sync::Mutex;
+use std::thread;
 use std::time::{Duration, Instant};
 
+/// Rule families in the order their output is merged. Every family reads the
+/// input only, so they run concurrently; merging in this order keeps the
+/// result identical to evaluating them one after another.
+const FAMILIES: &[Family] = &[
+    Family {
+        name: "core",
+        run: FamilyRun::Rules(core::violations),
+    },
+    Family {
+        name: "verification",
+        run: FamilyRun::Verification,
+    },
+    Family {
+        name: "cdc",
+        run: FamilyRun::Rules(cdc::violations),
+    },
+    Family {
+        name: "combinational",
+        run: FamilyRun::Rules(combinational::violations),
+    },
+    Family {
+        name: "clocks_resets",
+        run: FamilyRun::Rules(clocks_resets::violations),
+    },
+    Family {
+        name: "clocks_resets_optional",
+        run: FamilyRun::Rules(clocks_resets::optional_violations),
+    },
+    Family {
+        name: "fsm",
+        run: FamilyRun::Rules(fsm::violations),
+    },
+    Family {
+        name: "fsm_optional",
+        run: FamilyRun::Rules(fsm::optional_violations),
+    },
+    Family {
+        name: "configurations",
+        run: FamilyRun::Rules(configurations::violations),
+    },
+    Family {
+        name: "hierarchy",
+        run: FamilyRun::Rules(hierarchy::violations),
+    },
+    Family {
+        name: "instances",
+        run: FamilyRun::Rules(instances::violations),
+    },
+    Family {
+        name: "latch",
+        run: FamilyRun::Rules(latch::violations),
+    },
+    Family {
+        name: "naming",
+        run: FamilyRun::Rules(naming::violations),
+    },
+    Family {
+        name: "naming_optional",
+        run: FamilyRun::Rules(naming::optional_violations),
+    },
+    Family {
+        name: "ports",
+        run: FamilyRun::Rules(ports::violations),
+    },
+    Family {
+        name: "ports_optional",
+        run: FamilyRun::Rules(ports::optional_violations),
+    },
+    Family {
+        name: "processes",
+        run: FamilyRun::Rules(processes::violations),
+    },
+    Family {
+        name: "power",
+        run: FamilyRun::Rules(power::violations),
+    },
+    Family {
+        name: "quality",
+        run: FamilyRun::Rules(quality::violations),
+    },
+    Family {
+        name: "quality_optional",
+        run: FamilyRun::Rules(quality::optional_violations),
+    },
+    Family {
+        name: "rdc",
+        run: FamilyRun::Rules(rdc::violations),
+    },
+    Family {
+        name: "security",
+        run: FamilyRun::Rules(security::violations),
+    },
+    Family {
+        name: "sensitivity",
+        run: FamilyRun::Rules(sensitivity::violations),
+    },
+    Family {
+        name: "sequential",
+        run: FamilyRun::Rules(sequential::violations),
+    },
+    Family {
+        name: "signals",
+        run: FamilyRun::Rules(signals::violations),
+    },
+    Family {
+        name: "style",
+        run: FamilyRun::Rules(style::violations),
+    },
+    Family {
+        name: "style_optional",
+        run: FamilyRun::Rules(style::optional_violations),
+    },
+    Family {
+        name: "subprograms",
+        run: FamilyRun::Rules(subprograms::violations),
+    },
+    Family {
+        name: "synthesis",
+        run: FamilyRun::Rules(synthesis::violations),
+    },
+    Family {
+        name: "testbench",
+        run: FamilyRun::Rules(testbench::violations),
+    },
+    Family {
+        name: "testbench_optional",
+        run: FamilyRun::Rules(testbench::optional_violations),
+    },
+    Family {
+        name: "types",
+        run: FamilyRun::Rules(types::violations),
+    },
+    Family {
+        name: "types_optional",
+        run: FamilyRun::Rules(types::optional_violations),
+    },
+    Family {
+        name: "combinational_optional",
+        run: FamilyRun::Rules(combinational::optional_violations),
+    },
+    Family {
+        name: "hierarchy_optional",
+        run: FamilyRun::Rules(hierarchy::optional_violations),
+    },
+    Family {
+        name: "latch_optional",
+        run: FamilyRun::Rules(latch::optional_violations),
+    },
+    Family {
+        name: "power_optional",
+        run: FamilyRun::Rules(power::optional_violations),
+    },
+    Family {
+        name: "rdc_optional",
+        run: FamilyRun::Rules(rdc::optional_violations),
+    },
+    Family {
+        name: "security_optional",
+        run: FamilyRun::Rules(security::optional_violations),
+    },
+    Family {
+        name: "sensitivity_optional",
+        run: FamilyRun::Rules(sensitivity::optional_violations),
+    },
+    Family {
+        name: "sequential_optional",
+        run: FamilyRun::Rules(sequential::optional_violations),
+    },
+    Family {
+        name: "signals_optional",
+        run: FamilyRun::Rules(signals::optional_violations),
+    },
+    Family {
+        name: "synthesis_optional",
+        run: FamilyRun::Rules(synthesis::optional_violations),
+    },
+];
+
+struct Family {
+    name: &'static str,
+    run: FamilyRun,
+}
+
+enum FamilyRun {
+    Rules(fn(&Input) -> Vec<Violation>),
+    /// Also produces missing checks and ambiguous constructs
+    Verification,
+}
+
+#[derive(Default)]
+struct FamilyOutput {
+    violations: Vec<Violation>,
+    missing_checks: Vec<MissingCheckTask>,
+    ambiguous_constructs: Vec<AmbiguousConstruct>,
+}
+
+/// Worker threads get the main thread's usual stack; some rules recurse
+/// through the design hierarchy.
+const WORKER_STACK_SIZE: usize = 8 << 20;
+
+/// VHDL_POLICY_TRACE_TIMING prints per-family timings to stderr;
+/// VHDL_POLICY_TIMINGS returns them as Result::timings.
 pub fn evaluate(input: &Input) -> Result {
-    let timing_enabled = is_timing_enabled();
+    evaluate_timed(
+        input,
+        env_flag("VHDL_POLICY_TRACE_TIMING"),
+        env_flag("VHDL_POLICY_TIMINGS"),
+    )
+}
+
+fn evaluate_timed(input: &Input, trace: bool, spans: bool) -> Result {
     let total_start = Instant::now();
+    let timer = (trace || spans).then_some(Timer {
+        origin: total_start,
+        trace,
+    });
+    if trace {
+        eprintln!("=== Policy Timing (live) ===");
+    }
+    // Built up front so workers share them instead of queueing on first use
+    input.index();
+    let index_duration = total_start.elapsed();
+    input.domains();
+    let domains_duration = total_start.elapsed() - index_duration;
+    input.elaboration();
+    let elaboration_duration = total_start.elapsed() - index_duration - domains_duration;
     let mut timings: Vec<TimingEntry> = Vec::new();
     let mut raw = Vec::new();
-    if timing_enabled {
-        eprintln!("=== Policy Timing (live) ===");
+    let mut missing_checks = Vec::new();
+    let mut ambiguous_constructs = Vec::new();
+    for (output, timing) in run_families(input, timer.as_ref(), policy_threads()) {
+        raw.extend(output.violations);
+        missing_checks.extend(output.missing_checks);
+        ambiguous_constructs.extend(output.ambiguous_constructs);
+        timings.extend(timing);
     }
-    raw.extend(collect_timed(
-        "core",
-        input,
-        timing_enabled,
-        &mut timings,
-        core::violations,
-    ));
-    let verification_analysis = if timing_enabled {
-        let start = Instant::now();
-        let analysis = verification::analyze(input);
-        let elapsed = start.elapsed();
-        timings.push(TimingEntry {
-            name: "verification",
-            duration: elapsed,
-            count: analysis.violations.len(),
-        });
-        analysis
-    } else {
-        verification::analyze(input)
-    };
-    raw.extend(verification_analysis.violations);
-    let missing_checks = verification_analysis.missing_checks;
-    let ambiguous_constructs = verification_analysis.ambiguous_constructs;
-    raw.extend(collect_timed(
-        "cdc",
-        input,
-        timing_enabled,
-        &mut timings,
-        cdc::violations,
-    ));
-    raw.extend(collect_timed(
-        "combinational",
-        input,
-        timing_enabled,
-        &mut timings,
-        combinational::violations,
-    ));
-    raw.extend(collect_timed(
-        "clocks_resets",
-        input,
-        timing_enabled,
-        &mut timings,
-        clocks_resets::violations,
-    ));
-    raw.extend(collect_timed(
-        "clocks_resets_optional",
-        input,
-        timing_enabled,
-        &mut timings,
-        clocks_resets::optional_violations,
-    ));
-    raw.extend(collect_timed(
-        "fsm",
-        input,
-        timing_enabled,
-        &mut timings,
-        fsm::violations,
-    ));
-    raw.extend(collect_timed(
-        "fsm_optional",
-        input,
-        timing_enabled,
-        &mut timings,
-        fsm::optional_violations,
-    ));
-    raw.extend(collect_timed(
-        "configurations",
-        input,
-        timing_enabled,
-        &mut timings,
-        configurations::violations,
-    ));
-    raw.extend(collect_timed(
-        "hierarchy",
-        input,
-        timing_enabled,
-        &mut timings,
-        hierarchy::violations,
-    ));
-    raw.extend(collect_timed(
-        "instances",
-        input,
-        timing_enabled,
-        &mut timings,
-        instances::violations,
-    ));
-    raw.extend(collect_timed(
-        "latch",
-        input,
-        timing_enabled,
-        &mut timings,
-        latch::violations,
-    ));
-    raw.extend(collect_timed(
-        "naming",
-        input,
-        timing_enabled,
-        &mut timings,
-        naming::violations,
-    ));
-    raw.extend(collect_timed(
-        "naming_optional",
-        input,
-        timing_enabled,
-        &mut timings,
-        naming::optional_violations,
-    ));
-    raw.extend(collect_timed(
-        "ports",
-        input,
-        timing_enabled,
-        &mut timings,
-        ports::violations,
-    ));
-    raw.extend(collect_timed(
-        "ports_optional",
-        input,
-        timing_enabled,
-        &mut timings,
-        ports::optional_violations,
-    ));
-    raw.extend(collect_timed(
-        "processes",
-        input,
-        timing_enabled,
-        &mut timings,
-        processes::violations,
-    ));
-    raw.extend(collect_timed(
-        "power",
-        input,
-        timing_enabled,
-        &mut timings,
-        power::violations,
-    ));
-    raw.extend(collect_timed(
-        "quality",
-        input,
-        timing_enabled,
-        &mut timings,
-        quality::violations,
-    ));
-    raw.extend(collect_timed(
-        "quality_optional",
-        input,
-        timing_enabled,
-        &mut timings,
-        quality::optional_violations,
-    ));
-    raw.extend(collect_timed(
-        "rdc",
-        input,
-        timing_enabled,
-        &mut timings,
-        rdc::violations,
-    ));
-    raw.extend(collect_timed(
-        "security",
-        input,
-        timing_enabled,
-        &mut timings,
-        security::violations,
-    ));
-    raw.extend(collect_timed(
-        "sensitivity",
-        input,
-        timing_enabled,
-        &mut timings,
-        sensitivity::violations,
-    ));
-    raw.extend(collect_timed(
-        "sequential",
-        input,
-        timing_enabled,
-        &mut timings,
-        sequential::violations,
-    ));
-    raw.extend(collect_timed(
-        "signals",
-        input,
-        timing_enabled,
-        &mut timings,
-        signals::violations,
-    ));
-    raw.extend(collect_timed(
-        "style",
-        input,
-        timing_enabled,
-        &mut timings,
-        style::violations,
-    ));
-    raw.extend(collect_timed(
-        "style_optional",
-        input,
-        timing_enabled,
-        &mut timings,
-        style::optional_violations,
-    ));
-    raw.extend(collect_timed(
-        "subprograms",
-        input,
-        timing_enabled,
-        &mut timings,
-        subprograms::violations,
-    ));
-    raw.extend(collect_timed(
-        "synthesis",
-        input,
-        timing_enabled,
-        &mut timings,
-        synthesis::violations,
-    ));
-    raw.extend(collect_timed(
-        "testbench",
-        input,
-        timing_enabled,
-        &mut timings,
-        testbench::violations,
-    ));
-    raw.extend(collect_timed(
-        "testbench_optional",
-        input,
-        timing_enabled,
-        &mut timings,
-        testbench::optional_violations,
-    ));
-    raw.extend(collect_timed(
-        "types",
-        input,
-        timing_enabled,
-        &mut timings,
-        types::violations,
-    ));
-    raw.extend(collect_timed(
-        "types_optional",
-        input,
-        timing_enabled,
-        &mut timings,
-        types::optional_violations,
-    ));
-
-    raw.extend(collect_timed(
-        "combinational_optional",
-        input,
-        timing_enabled,
-        &mut timings,
-        combinational::optional_violations,
-    ));
-    raw.extend(collect_timed(
-        "hierarchy_optional",
-        input,
-        timing_enabled,
-        &mut timings,
-        hierarchy::optional_violations,
-    ));
-    raw.extend(collect_timed(
-        "latch_optional",
-        input,
-        timing_enabled,
-        &mut timings,
-        latch::optional_violations,
-    ));
-    raw.extend(collect_timed(
-        "power_optional",
-        input,
-        timing_enabled,
-        &mut timings,
-        power::optional_violations,
-    ));
-    raw.extend(collect_timed(
-        "rdc_optional",
-        input,
-        timing_enabled,
-        &mut timings,
-        rdc::optional_violations,
-    ));
-    raw.extend(collect_timed(
-        "security_optional",
-        input,
-        timing_enabled,
-        &mut timings,
-        security::optional_violations,
-    ));
-    raw.extend(collect_timed(
-        "sensitivity_optional",
-        input,
-        timing_enabled,
-        &mut timings,
-        sensitivity::optional_violations,
-    ));
-    raw.extend(collect_timed(
-        "sequential_optional",
-        input,
-        timing_enabled,
-        &mut timings,
-        sequential::optional_violations,
-    ));
-    raw.extend(collect_timed(
-        "signals_optional",
-        input,
-        timing_enabled,
-        &mut timings,
-        signals::optional_violations,
-    ));
-    raw.extend(collect_timed(
-        "synthesis_optional",
-        input,
-        timing_enabled,
-        &mut timings,
-        synthesis::optional_violations,
-    ));
 
+    let filter_start = total_start.elapsed();
     let filtered = filter_violations(input, raw);
     let filtered_missing_checks = filter_missing_checks(input, missing_checks);
     let filtered_ambiguous = filter_ambiguous_constructs(input, ambiguous_constructs);
-    if timing_enabled {
-        emit_timings(&timings, total_start.elapsed(), filtered.len());
+    let total = total_start.elapsed();
+    if trace {
+        emit_timings(&timings, total, filtered.len());
+    }
+    let mut spans_out = Vec::new();
+    if spans {
+        spans_out.push(span("evaluate", Duration::ZERO, total, 0, filtered.len()));
+        spans_out.push(span("index", Duration::ZERO, index_duration, 0, 0));
+        spans_out.push(span("domains", index_duration, domains_duration, 0, 0));
+        spans_out.push(span(
+            "elaboration",
+            index_duration + domains_duration,
+            elaboration_duration,
+            0,
+            0,
+        ));
+        for entry in &timings {
+            spans_out.push(span(
+                entry.name,
+                entry.start,
+                entry.duration,
+                entry.thread,
+                entry.count,
+            ));
+        }
+        spans_out.push(span("filter", filter_start, total - filter_start, 0, 0));
     }
     Result {
         summary: summarize(&filtered),
         violations: filtered,
         missing_checks: filtered_missing_checks,
         ambiguous_constructs: filtered_ambiguous,
+        timings: spans_out,
+    }
+}
+
+fn span(name: &str, start: Duration, duration: Duration, thread: usize, count: usize) -> Timing {
+    Timing {
+        name: name.to_string(),
+        start_ms: start.as_secs_f64() * 1000.0,
+        duration_ms: duration.as_secs_f64() * 1000.0,
+        thread,
+        count,
+    }
+}
+
+/// Runs every family on up to `threads` workers and returns their outputs in
+/// FAMILIES order. Idle
+/// workers claim the next unstarted family, so a slow family does not hold
+/// up the rest of the queue behind it.
+fn run_families(
+    input: &Input,
+    timer: Option<&Timer>,
+    threads: usize,
+) -> Vec<(FamilyOutput, Option<TimingEntry>)> {
+    let workers = threads.min(FAMILIES.len());
+    if workers <= 1 {
+        return FAMILIES
+            .iter()
+            .map(|family| collect_timed(family, input, timer, 0))
+            .collect();
+    }
+
+    let next = AtomicUsize::new(0);
+    let slots: Vec<Mutex<Option<(FamilyOutput, Option<TimingEntry>)>>> =
+        FAMILIES.iter().map(|_| Mutex::new(None)).collect();
+    thread::scope(|scope| {
+        for worker in 0..workers {
+            let (next, slots) = (&next, &slots);
+            thread::Builder::new()
+                .name("vhdl-policy".to_string())
+                .stack_size(WORKER_STACK_SIZE)
+                .spawn_scoped(scope, move || loop {
+                    let i = next.fetch_add(1, Ordering::Relaxed);
+                    let Some(family) = FAMILIES.get(i) else {
+                        break;
+                    };
+                    let out = collect_timed(family, input, timer, worker);
+                    *slots[i].lock().unwrap() = Some(out);
+                })
+                .expect("spawn policy worker");
+        }
+    });
+    slots
+        .into_iter()
+        .map(|slot| slot.into_inner().unwrap().expect("family evaluated"))
+        .collect()
+}
+
+/// VHDL_POLICY_THREADS caps the pool (1 = serial); defaults to every core.
+fn policy_threads() -> usize {
+    if let Ok(val) = std::env::var("VHDL_POLICY_THREADS") {
+        if let Ok(n) = val.trim().parse::<usize>() {
+            if n > 0 {
+                return n;
+            }
+        }
+    }
+    thread::available_parallelism().map_or(1, |n| n.get())
+}
+
+fn run_family(family: &Family, input: &Input) -> FamilyOutput {
+    match family.run {
+        FamilyRun::Rules(f) => FamilyOutput {
+            violations: f(input),
+            ..Default::default()
+        },
+        FamilyRun::Verification => {
+            let analysis = verification::analyze(input);
+            FamilyOutput {
+                violations: analysis.violations,
+                missing_checks: analysis.missing_checks,
+                ambiguous_constructs: analysis.ambiguous_constructs,
+            }
+        }
     }
 }
 
@@ -400,10 +430,7 @@ fn is_valid_severity(sev: &str) -> bool {
     matches!(sev, "error" | "warning" | "info")
 }
 
-fn filter_missing_checks(
-    input: &Input,
-    tasks: Vec<MissingCheckTask>,
-) -> Vec<MissingCheckTask> {
+fn filter_missing_checks(input: &Input, tasks: Vec<MissingCheckTask>) -> Vec<MissingCheckTask> {
     if helpers::rule_is_disabled(input, "missing_verification_check") {
         return Vec::new();
     }
@@ -426,41 +453,51 @@ fn filter_ambiguous_constructs(
         .collect()
 }
 
+/// Times an evaluation's families; `trace` also prints them live.
+struct Timer {
+    origin: Instant,
+    trace: bool,
+}
+
 struct TimingEntry {
     name: &'static str,
+    /// Since Timer::origin
+    start: Duration,
     duration: Duration,
     count: usize,
+    thread: usize,
 }
 
-fn collect_timed<F>(
-    name: &'static str,
+fn collect_timed(
+    family: &Family,
     input: &Input,
-    enabled: bool,
-    timings: &mut Vec<TimingEntry>,
-    f: F,
-) -> Vec<Violation>
-where
-    F: FnOnce(&Input) -> Vec<Violation>,
-{
-    if !enabled {
-        return f(input);
+    timer: Option<&Timer>,
+    thread: usize,
+) -> (FamilyOutput, Option<TimingEntry>) {
+    let Some(timer) = timer else {
+        return (run_family(family, input), None);
+    };
+    if timer.trace {
+        eprintln!("  [start] {}", family.name);
     }
-    eprintln!("  [start] {}", name);
     let start = Instant::now();
-    let out = f(input);
+    let out = run_family(family, input);
     let entry = TimingEntry {
-        name,
+        name: family.name,
+        start: start - timer.origin,
         duration: start.elapsed(),
-        count: out.len(),
+        count: out.violations.len(),
+        thread,
     };
-    eprintln!(
-        "  [done ] {:<24} {:>6} {}",
-        entry.name,
-        entry.count,
-        format_duration(entry.duration)
-    );
-    timings.push(entry);
-    out
+    if timer.trace {
+        eprintln!(
+            "  [done ] {:<24} {:>6} {}",
+            entry.name,
+            entry.count,
+            format_duration(entry.duration)
+        );
+    }
+    (out, Some(entry))
 }
 
 fn emit_timings(timings: &[TimingEntry], total: Duration, total_count: usize) {
@@ -490,8 +527,8 @@ fn format_duration(duration: Duration) -> String {
     }
 }
 
-fn is_timing_enabled() -> bool {
-    match std::env::var("VHDL_POLICY_TRACE_TIMING") {
+fn env_flag(name: &str) -> bool {
+    match std::env::var(name) {
         Ok(val) => {
             let v = val.to_ascii_lowercase();
             v == "1" || v == "true" || v == "yes" || v == "on"
@@ -597,4 +634,52 @@ mod tests {
         assert_eq!(result.violations.len(), 1);
         assert_eq!(result.violations[0].severity, "error");
     }
+
+    #[test]
+    fn parallel_families_merge_in_serial_order() {
+        let mut input = Input::default();
+        for (i, name) in ["core", "fifo", "uart_tb"].iter().enumerate() {
+            input.entities.push(Entity {
+                name: name.to_string(),
+                file: format!("{}.vhd", name),
+                line: i + 1,
+                ..Default::default()
+            });
+            input.signals.push(Signal {
+                name: format!("{}_unused", name),
+                in_entity: name.to_string(),
+                ..Default::default()
+            });
+        }
+        let collect = |threads| {
+            run_families(&input, None, threads)
+                .into_iter()
+                .flat_map(|(out, _)| out.violations)
+                .map(|v| serde_json::to_string(&v).unwrap())
+                .collect::<Vec<_>>()
+        };
+        let serial = collect(1);
+        assert!(!serial.is_empty());
+        assert_eq!(collect(8), serial);
+    }
+
+    #[test]
+    fn timings_cover_every_family_within_evaluate() {
+        let input = Input::default();
+        assert!(evaluate_timed(&input, false, false).timings.is_empty());
+
+        let result = evaluate_timed(&input, false, true);
+        let total = &result.timings[0];
+        assert_eq!(total.name, "evaluate");
+        for family in FAMILIES {
+            assert!(
+                result.timings.iter().any(|t| t.name == family.name),
+                "no span for {}",
+                family.name
+            );
+        }
+        for t in &result.timings {
+            assert!(t.start_ms + t.duration_ms <= total.duration_ms + 1e-6);
+        }
+    }
 }
@@ -197,15 +197,17 @@ fn state_in_choices(state: &str, choices: &[String]) -> bool {
 }
 
 fn state_ever_assigned(input: &Input, sig_name: &str, state_literal: &str) -> bool {
-    input.processes.iter().any(|proc| {
-        proc.assigned_signals
-            .iter()
-            .any(|assigned| assigned.eq_ignore_ascii_case(sig_name))
-            && proc
+    input
+        .index()
+        .name(sig_name)
+        .assigning_processes
+        .iter()
+        .any(|&i| {
+            input.processes[i as usize]
                 .read_signals
                 .iter()
                 .any(|read| read.eq_ignore_ascii_case(state_literal))
-    })
+        })
 }
 
 #[cfg(test)]
@@ -79,10 +79,7 @@ pub fn is_standard_arch_name(name: &str) -> bool {
 }
 
 pub fn is_shared_variable(input: &Input, name: &str) -> bool {
-    input
-        .shared_variables
-        .iter()
-        .any(|v| v.eq_ignore_ascii_case(name))
+    input.index().name(name).is_shared_variable()
 }
 
 pub fn is_resolved_type(type_str: &str) -> bool {
@@ -94,14 +91,15 @@ pub fn is_resolved_type(type_str: &str) -> bool {
 }
 
 pub fn is_resolved_signal(input: &Input, name: &str) -> bool {
-    input
+    let named = input.index().name(name);
+    named
         .signals
         .iter()
-        .any(|sig| sig.name.eq_ignore_ascii_case(name) && is_resolved_type(&sig.r#type))
-        || input
+        .any(|&i| is_resolved_type(&input.signals[i as usize].r#type))
+        || named
             .ports
             .iter()
-            .any(|port| port.name.eq_ignore_ascii_case(name) && is_resolved_type(&port.r#type))
+            .any(|&i| is_resolved_type(&input.ports[i as usize].r#type))
 }
 
 pub fn is_unresolved_scalar_type(t: &str) -> bool {
@@ -124,10 +122,7 @@ pub fn single_file_mode(input: &Input) -> bool {
 }
 
 pub fn entity_exists(input: &Input, name: &str) -> bool {
-    input
-        .entities
-        .iter()
-        .any(|entity| entity.name.eq_ignore_ascii_case(name))
+    !input.index().name(name).entities.is_empty()
 }
 
 pub fn base_arch_name(in_arch: &str) -> String {
@@ -137,17 +132,15 @@ pub fn base_arch_name(in_arch: &str) -> String {
 pub fn arch_missing_entity_for_context(input: &Input, in_arch: &str) -> bool {
     let base = base_arch_name(in_arch);
     input
+        .index()
+        .name(&base)
         .architectures
         .iter()
-        .filter(|arch| arch.name.eq_ignore_ascii_case(&base))
-        .any(|arch| !entity_exists(input, &arch.entity_name))
+        .any(|&i| !entity_exists(input, &input.architectures[i as usize].entity_name))
 }
 
 pub fn file_has_use_clause(input: &Input, file: &str) -> bool {
-    input
-        .dependencies
-        .iter()
-        .any(|dep| dep.kind == "use" && dep.source == file)
+    input.index().file_has_use_clause(file)
 }
 
 pub fn base_type_name(t: &str) -> String {
@@ -159,8 +152,9 @@ pub fn base_type_name(t: &str) -> String {
 
 pub fn is_named_composite_type(input: &Input, t: &str) -> bool {
     let base = base_type_name(t);
-    input.types.iter().any(|td| {
-        td.name.eq_ignore_ascii_case(&base) && (td.kind == "record" || td.kind == "array")
+    input.index().name(&base).types.iter().any(|&i| {
+        let td = &input.types[i as usize];
+        td.kind == "record" || td.kind == "array"
     })
 }
 
@@ -174,13 +168,15 @@ pub fn is_composite_type(input: &Input, t: &str) -> bool {
 }
 
 pub fn is_composite_identifier(input: &Input, name: &str) -> bool {
-    input
+    let named = input.index().name(name);
+    named
         .signals
         .iter()
-        .any(|sig| sig.name.eq_ignore_ascii_case(name) && is_composite_type(input, &sig.r#type))
-        || input.ports.iter().any(|port| {
-            port.name.eq_ignore_ascii_case(name) && is_composite_type(input, &port.r#type)
-        })
+        .any(|&i| is_composite_type(input, &input.signals[i as usize].r#type))
+        || named
+            .ports
+            .iter()
+            .any(|&i| is_composite_type(input, &input.ports[i as usize].r#type))
 }
 
 pub fn is_common_signal_name(name: &str) -> bool {
@@ -246,11 +242,7 @@ pub fn is_skip_name(input: &Input, name: &str) -> bool {
     ) {
         return true;
     }
-    if input
-        .generates
-        .iter()
-        .any(|gen| !gen.loop_var.is_empty() && gen.loop_var.eq_ignore_ascii_case(name))
-    {
+    if input.index().name(name).is_generate_loop_var() {
         return true;
     }
     if matches!(
@@ -401,23 +393,20 @@ pub fn is_skip_name(input: &Input, name: &str) -> bool {
 }
 
 pub fn process_in_testbench(input: &Input, proc: &Process) -> bool {
-    input.architectures.iter().any(|arch| {
-        arch.name.eq_ignore_ascii_case(&proc.in_arch) && is_testbench_name(&arch.entity_name)
-    })
+    input
+        .index()
+        .name(&proc.in_arch)
+        .architectures
+        .iter()
+        .any(|&i| is_testbench_name(&input.architectures[i as usize].entity_name))
 }
 
 pub fn concurrent_in_testbench(input: &Input, ca: &ConcurrentAssignment) -> bool {
-    input
-        .entities
-        .iter()
-        .any(|entity| entity.file == ca.file && is_testbench_name(&entity.name))
+    input.index().is_testbench_file(&ca.file)
 }
 
 pub fn file_in_testbench(input: &Input, file: &str) -> bool {
-    input
-        .entities
-        .iter()
-        .any(|entity| entity.file == file && is_testbench_name(&entity.name))
+    input.index().is_testbench_file(file)
 }
 
 pub fn has_all_sensitivity(sens_list: &[String]) -> bool {
@@ -471,14 +460,11 @@ pub fn is_state_name(name: &str) -> bool {
 }
 
 pub fn is_enum_literal(input: &Input, name: &str) -> bool {
-    input
-        .enum_literals
-        .iter()
-        .any(|lit| lit.eq_ignore_ascii_case(name))
+    input.index().name(name).is_enum_literal()
 }
 
 pub fn is_constant(input: &Input, name: &str) -> bool {
-    input.constants.iter().any(|c| c.eq_ignore_ascii_case(name))
+    input.index().name(name).is_constant()
 }
 
 pub fn is_actual_signal(input: &Input, name: &str) -> bool {
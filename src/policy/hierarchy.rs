@@ -1,7 +1,7 @@
 use regex::Regex;
 
 use crate::policy::helpers;
-use crate::policy::input::{Association, Entity, Input, Instance};
+use crate::policy::input::{Association, Input, Instance};
 use crate::policy::result::Violation;
 
 pub fn violations(input: &Input) -> Vec<Violation> {
@@ -124,15 +124,12 @@ fn repeated_component_instantiation(input: &Input) -> Vec<Violation> {
 }
 
 fn many_instances(input: &Input) -> Vec<Violation> {
+    let elab = input.elaboration();
     input
         .architectures
         .iter()
         .filter_map(|arch| {
-            let count = input
-                .instances
-                .iter()
-                .filter(|inst| inst.in_arch == arch.name && inst.file == arch.file)
-                .count();
+            let count = elab.instances_in(&arch.file, &arch.name);
             if count > 20 {
                 Some(Violation {
                     rule: "many_instances".to_string(),
@@ -201,29 +198,19 @@ fn open_port_connection(input: &Input) -> Vec<Violation> {
 }
 
 fn floating_instance_input(input: &Input) -> Vec<Violation> {
+    let elab = input.elaboration();
     let mut out = Vec::new();
-    for inst in &input.instances {
+    for (i, inst) in input.instances.iter().enumerate() {
         if helpers::file_in_testbench(input, &inst.file) {
             continue;
         }
-        let target_lower = inst.target.to_ascii_lowercase();
-        for entity in &input.entities {
-            if !target_matches_entity(&target_lower, &entity.name.to_ascii_lowercase()) {
-                continue;
-            }
-            for port in &entity.ports {
-                if port.direction != "in" {
-                    continue;
-                }
-                if !port.default.trim().is_empty() {
-                    continue;
-                }
+        for binding in &elab.module_of(i).bindings {
+            let entity = &input.entities[binding.entity as usize];
+            for &pos in &binding.required_inputs {
+                let port = &entity.ports[pos as usize];
                 if port_connected_in_instance(inst, &port.name) {
                     continue;
                 }
-                if helpers::is_clock_name(&port.name) || helpers::is_reset_name(&port.name) {
-                    continue;
-                }
                 out.push(Violation {
                     rule: "floating_instance_input".to_string(),
                     severity: "error".to_string(),
@@ -240,10 +227,6 @@ fn floating_instance_input(input: &Input) -> Vec<Violation> {
     out
 }
 
-fn target_matches_entity(target: &str, entity_name: &str) -> bool {
-    target == entity_name || target.ends_with(&format!(".{}", entity_name))
-}
-
 fn port_connected_in_instance(inst: &Instance, port_name: &str) -> bool {
     inst.port_map
         .keys()
@@ -251,18 +234,14 @@ fn port_connected_in_instance(inst: &Instance, port_name: &str) -> bool {
 }
 
 fn port_width_mismatch(input: &Input) -> Vec<Violation> {
+    let elab = input.elaboration();
     let mut out = Vec::new();
-    for inst in &input.instances {
-        let target_lower = inst.target.to_ascii_lowercase();
-        for entity in &input.entities {
-            if !target_matches_entity(&target_lower, &entity.name.to_ascii_lowercase()) {
-                continue;
-            }
-            for port in &entity.ports {
-                if port.width == 0 {
-                    continue;
-                }
-                let actual_signal = get_port_connection(inst, entity, &port.name);
+    for (i, inst) in input.instances.iter().enumerate() {
+        for binding in &elab.module_of(i).bindings {
+            let entity = &input.entities[binding.entity as usize];
+            for &pos in &binding.sized_ports {
+                let port = &entity.ports[pos as usize];
+                let actual_signal = get_port_connection(inst, pos as usize, &port.name);
                 if actual_signal.is_empty() || actual_signal.eq_ignore_ascii_case("open") {
                     continue;
                 }
@@ -288,7 +267,8 @@ fn port_width_mismatch(input: &Input) -> Vec<Violation> {
     out
 }
 
-fn get_port_connection(inst: &Instance, entity: &Entity, port_name: &str) -> String {
+/// Actual connected to `port_name`, the entity's port at `position`.
+fn get_port_connection(inst: &Instance, position: usize, port_name: &str) -> String {
     // Prefer association elements (captures slices/indexing)
     for assoc in &inst.associations {
         if assoc.kind != "port" || assoc.is_positional {
@@ -300,15 +280,9 @@ fn get_port_connection(inst: &Instance, entity: &Entity, port_name: &str) -> Str
     }
 
     // Positional associations: map by entity port order
-    if let Some(pos) = entity
-        .ports
-        .iter()
-        .position(|p| p.name.eq_ignore_ascii_case(port_name))
-    {
-        for assoc in &inst.associations {
-            if assoc.kind == "port" && assoc.is_positional && assoc.position_index == pos {
-                return association_actual(assoc);
-            }
+    for assoc in &inst.associations {
+        if assoc.kind == "port" && assoc.is_positional && assoc.position_index == position {
+            return association_actual(assoc);
         }
     }
 
@@ -356,41 +330,29 @@ fn get_actual_width(input: &Input, actual: &str, scope_arch: &str) -> usize {
 }
 
 fn get_signal_width(input: &Input, signal_name: &str, scope_arch: &str) -> usize {
-    let mut widths = Vec::new();
+    let postings = input.index().name(signal_name);
+    let signals = postings.signals.iter().map(|&i| &input.signals[i as usize]);
+    let ports = postings.ports.iter().map(|&i| &input.ports[i as usize]);
     if !scope_arch.is_empty() {
-        for sig in &input.signals {
-            if sig.in_entity.eq_ignore_ascii_case(scope_arch)
-                && sig.name.eq_ignore_ascii_case(signal_name)
-            {
-                widths.push(sig.width);
-            }
-        }
-        if let Some(entity_name) = arch_entity_name(input, scope_arch) {
-            for port in &input.ports {
-                if port.in_entity.eq_ignore_ascii_case(&entity_name)
-                    && port.name.eq_ignore_ascii_case(signal_name)
-                {
-                    widths.push(port.width);
-                }
-            }
-        }
-        if !widths.is_empty() {
-            return widths.into_iter().max().unwrap_or(0);
-        }
-        return 0;
+        let entity_name = arch_entity_name(input, scope_arch);
+        let signal_widths = signals
+            .filter(|sig| sig.in_entity.eq_ignore_ascii_case(scope_arch))
+            .map(|sig| sig.width);
+        let port_widths = ports
+            .filter(|port| {
+                entity_name
+                    .as_ref()
+                    .is_some_and(|name| port.in_entity.eq_ignore_ascii_case(name))
+            })
+            .map(|port| port.width);
+        return signal_widths.chain(port_widths).max().unwrap_or(0);
     }
 
-    for sig in &input.signals {
-        if sig.name.eq_ignore_ascii_case(signal_name) {
-            widths.push(sig.width);
-        }
-    }
-    for port in &input.ports {
-        if port.name.eq_ignore_ascii_case(signal_name) {
-            widths.push(port.width);
-        }
-    }
-    widths.into_iter().max().unwrap_or(0)
+    signals
+        .map(|sig| sig.width)
+        .chain(ports.map(|port| port.width))
+        .max()
+        .unwrap_or(0)
 }
 
 fn association_actual(assoc: &Association) -> String {
@@ -420,12 +382,9 @@ fn base_name(actual: &str) -> &str {
     actual[..end].trim()
 }
 
-fn arch_entity_name(input: &Input, arch_name: &str) -> Option<String> {
-    input
-        .architectures
-        .iter()
-        .find(|arch| arch.name.eq_ignore_ascii_case(arch_name))
-        .map(|arch| arch.entity_name.clone())
+fn arch_entity_name<'a>(input: &'a Input, arch_name: &str) -> Option<&'a str> {
+    let first = *input.index().name(arch_name).architectures.first()?;
+    Some(input.architectures[first as usize].entity_name.as_str())
 }
 
 fn indexed_width(actual: &str, base_width: usize) -> Option<usize> {
@@ -463,7 +422,7 @@ fn indexed_width(actual: &str, base_width: usize) -> Option<usize> {
 #[cfg(test)]
 mod tests {
     use super::*;
-    use crate::policy::input::{Association, Entity, Input, Instance, Port, Signal};
+    use crate::policy::input::{Architecture, Association, Entity, Input, Instance, Port, Signal};
 
     #[test]
     fn sparse_port_map_flags() {
@@ -593,4 +552,51 @@ mod tests {
         let v = port_width_mismatch(&input);
         assert!(v.is_empty());
     }
+
+    #[test]
+    fn port_width_mismatch_flags_each_instance_in_scope() {
+        let mut input = Input::default();
+        let mut entity = Entity::default();
+        entity.name = "child".to_string();
+        entity.ports.push(Port {
+            name: "d".to_string(),
+            direction: "in".to_string(),
+            width: 8,
+            ..Default::default()
+        });
+        input.entities.push(entity);
+        input.architectures.push(Architecture {
+            name: "rtl".to_string(),
+            entity_name: "top".to_string(),
+            ..Default::default()
+        });
+        // Top-level port, seen through the architecture's entity
+        input.ports.push(Port {
+            name: "bus_i".to_string(),
+            in_entity: "top".to_string(),
+            width: 4,
+            ..Default::default()
+        });
+        // Same name in another scope must not count
+        input.signals.push(Signal {
+            name: "bus_i".to_string(),
+            in_entity: "other".to_string(),
+            width: 8,
+            ..Default::default()
+        });
+        for name in ["u1", "u2", "u3"] {
+            let mut inst = Instance::default();
+            inst.name = name.to_string();
+            inst.target = "work.child".to_string();
+            inst.file = "top.vhd".to_string();
+            inst.in_arch = "RTL".to_string();
+            inst.port_map.insert("d".to_string(), "bus_i".to_string());
+            input.instances.push(inst);
+        }
+
+        let v = port_width_mismatch(&input);
+        assert_eq!(v.len(), 3);
+        assert!(v[0].message.contains("(4 bits)"));
+        assert_eq!(input.elaboration().module_count(), 1);
+    }
 }
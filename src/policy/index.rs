@@ -0,0 +1,307 @@
+//! Lookup tables over `Input`, built once per evaluation (`Input::index`) so
+//! rules answer "which X is named N" without rescanning the flat vectors.
+//!
+//! Names are matched case-insensitively (ASCII, like `eq_ignore_ascii_case`
+//! everywhere in the rules), interned to a `NameId`, and mapped to posting
+//! lists of row positions in input order.
+
+use std::collections::{HashMap, HashSet};
+
+use crate::policy::input::Input;
+
+pub type NameId = u32;
+
+/// Rows that mention one lowercased name, as positions into `Input` vectors.
+#[derive(Debug, Clone, Default)]
+pub struct NamePostings {
+    /// `entities` by name
+    pub entities: Vec<u32>,
+    /// `architectures` by architecture name
+    pub architectures: Vec<u32>,
+    /// `architectures` by the entity they implement
+    pub architectures_of_entity: Vec<u32>,
+    pub signals: Vec<u32>,
+    pub ports: Vec<u32>,
+    pub types: Vec<u32>,
+    /// `instances` by instantiated target
+    pub instances_of: Vec<u32>,
+    /// `instances` with a port map actual equal to the name
+    pub instance_actuals: Vec<u32>,
+    /// `processes` by label (exact labels still need comparing)
+    pub processes_labelled: Vec<u32>,
+    pub assigning_processes: Vec<u32>,
+    pub reading_processes: Vec<u32>,
+    pub sensitive_processes: Vec<u32>,
+    pub concurrent_targets: Vec<u32>,
+    pub concurrent_readers: Vec<u32>,
+    flags: u8,
+}
+
+const FLAG_ENUM_LITERAL: u8 = 1 << 0;
+const FLAG_CONSTANT: u8 = 1 << 1;
+const FLAG_SHARED_VARIABLE: u8 = 1 << 2;
+const FLAG_GENERATE_LOOP_VAR: u8 = 1 << 3;
+/// Declared as anything `signals::is_declared_identifier` accepts
+const FLAG_DECLARED: u8 = 1 << 4;
+
+impl NamePostings {
+    pub fn is_enum_literal(&self) -> bool {
+        self.flags & FLAG_ENUM_LITERAL != 0
+    }
+
+    pub fn is_constant(&self) -> bool {
+        self.flags & FLAG_CONSTANT != 0
+    }
+
+    pub fn is_shared_variable(&self) -> bool {
+        self.flags & FLAG_SHARED_VARIABLE != 0
+    }
+
+    pub fn is_generate_loop_var(&self) -> bool {
+        self.flags & FLAG_GENERATE_LOOP_VAR != 0
+    }
+
+    pub fn is_declared(&self) -> bool {
+        self.flags & FLAG_DECLARED != 0
+    }
+}
+
+static EMPTY_POSTINGS: NamePostings = NamePostings {
+    entities: Vec::new(),
+    architectures: Vec::new(),
+    architectures_of_entity: Vec::new(),
+    signals: Vec::new(),
+    ports: Vec::new(),
+    types: Vec::new(),
+    instances_of: Vec::new(),
+    instance_actuals: Vec::new(),
+    processes_labelled: Vec::new(),
+    assigning_processes: Vec::new(),
+    reading_processes: Vec::new(),
+    sensitive_processes: Vec::new(),
+    concurrent_targets: Vec::new(),
+    concurrent_readers: Vec::new(),
+    flags: 0,
+};
+
+#[derive(Debug, Clone, Default)]
+pub struct InputIndex {
+    names: HashMap<String, NameId>,
+    postings: Vec<NamePostings>,
+    entities_by_file: HashMap<String, Vec<u32>>,
+    testbench_files: HashSet<String>,
+    use_clause_files: HashSet<String>,
+    dependencies_by_source: HashMap<String, Vec<u32>>,
+}
+
+impl InputIndex {
+    pub fn build(input: &Input) -> InputIndex {
+        let mut b = Builder::default();
+        for (i, entity) in input.entities.iter().enumerate() {
+            b.at(&entity.name).entities.push(i as u32);
+            b.index
+                .entities_by_file
+                .entry(entity.file.clone())
+                .or_default()
+                .push(i as u32);
+            if crate::policy::helpers::is_testbench_name(&entity.name) {
+                b.index.testbench_files.insert(entity.file.clone());
+            }
+            for generic in &entity.generics {
+                b.flag(&generic.name, FLAG_DECLARED);
+            }
+        }
+        for (i, arch) in input.architectures.iter().enumerate() {
+            b.at(&arch.name).architectures.push(i as u32);
+            b.at(&arch.entity_name)
+                .architectures_of_entity
+                .push(i as u32);
+        }
+        for comp in &input.components {
+            for generic in &comp.generics {
+                b.flag(&generic.name, FLAG_DECLARED);
+            }
+        }
+        for (i, sig) in input.signals.iter().enumerate() {
+            b.at(&sig.name).signals.push(i as u32);
+            b.flag(&sig.name, FLAG_DECLARED);
+        }
+        for (i, port) in input.ports.iter().enumerate() {
+            b.at(&port.name).ports.push(i as u32);
+            b.flag(&port.name, FLAG_DECLARED);
+        }
+        for (i, td) in input.types.iter().enumerate() {
+            b.at(&td.name).types.push(i as u32);
+            b.flag(&td.name, FLAG_DECLARED);
+        }
+        for st in &input.subtypes {
+            b.flag(&st.name, FLAG_DECLARED);
+        }
+        for func in &input.functions {
+            b.flag(&func.name, FLAG_DECLARED);
+        }
+        for proc in &input.procedures {
+            b.flag(&proc.name, FLAG_DECLARED);
+        }
+        for lit in &input.enum_literals {
+            b.flag(lit, FLAG_ENUM_LITERAL | FLAG_DECLARED);
+        }
+        for c in &input.constants {
+            b.flag(c, FLAG_CONSTANT | FLAG_DECLARED);
+        }
+        for v in &input.shared_variables {
+            b.flag(v, FLAG_SHARED_VARIABLE | FLAG_DECLARED);
+        }
+        for gen in &input.generates {
+            if !gen.loop_var.is_empty() {
+                b.flag(&gen.loop_var, FLAG_GENERATE_LOOP_VAR);
+            }
+        }
+        for (i, inst) in input.instances.iter().enumerate() {
+            b.at(&inst.target).instances_of.push(i as u32);
+            for actual in inst.port_map.values() {
+                push_once(&mut b.at(actual).instance_actuals, i);
+            }
+        }
+        for (i, proc) in input.processes.iter().enumerate() {
+            b.at(&proc.label).processes_labelled.push(i as u32);
+            for sig in &proc.assigned_signals {
+                push_once(&mut b.at(sig).assigning_processes, i);
+            }
+            for sig in &proc.read_signals {
+                push_once(&mut b.at(sig).reading_processes, i);
+            }
+            for sig in &proc.sensitivity_list {
+                push_once(&mut b.at(sig).sensitive_processes, i);
+            }
+            for var in &proc.variables {
+                b.flag(&var.name, FLAG_DECLARED);
+            }
+        }
+        for (i, ca) in input.concurrent_assignments.iter().enumerate() {
+            b.at(&ca.target).concurrent_targets.push(i as u32);
+            for sig in &ca.read_signals {
+                push_once(&mut b.at(sig).concurrent_readers, i);
+            }
+        }
+        for (i, dep) in input.dependencies.iter().enumerate() {
+            b.index
+                .dependencies_by_source
+                .entry(dep.source.clone())
+                .or_default()
+                .push(i as u32);
+            if dep.kind == "use" {
+                b.index.use_clause_files.insert(dep.source.clone());
+            }
+        }
+        b.index
+    }
+
+    /// Interned id of `name`, if any row mentions it.
+    pub fn name_id(&self, name: &str) -> Option<NameId> {
+        if name.bytes().any(|c| c.is_ascii_uppercase()) {
+            self.names.get(&name.to_ascii_lowercase()).copied()
+        } else {
+            self.names.get(name).copied()
+        }
+    }
+
+    /// Rows mentioning `name` (case-insensitive); empty when none do.
+    pub fn name(&self, name: &str) -> &NamePostings {
+        match self.name_id(name) {
+            Some(id) => &self.postings[id as usize],
+            None => &EMPTY_POSTINGS,
+        }
+    }
+
+    pub fn postings(&self, id: NameId) -> &NamePostings {
+        &self.postings[id as usize]
+    }
+
+    /// `entities` declared in `file` (exact path)
+    pub fn entities_in_file(&self, file: &str) -> &[u32] {
+        self.entities_by_file.get(file).map_or(&[], Vec::as_slice)
+    }
+
+    /// Whether `file` declares an entity with a testbench name
+    pub fn is_testbench_file(&self, file: &str) -> bool {
+        self.testbench_files.contains(file)
+    }
+
+    pub fn file_has_use_clause(&self, file: &str) -> bool {
+        self.use_clause_files.contains(file)
+    }
+
+    /// `dependencies` whose source is `file`
+    pub fn dependencies_from(&self, file: &str) -> &[u32] {
+        self.dependencies_by_source
+            .get(file)
+            .map_or(&[], Vec::as_slice)
+    }
+}
+
+/// Appends row `i` unless it was the last one added (a row listing the same
+/// name twice is one posting).
+fn push_once(list: &mut Vec<u32>, i: usize) {
+    if list.last() != Some(&(i as u32)) {
+        list.push(i as u32);
+    }
+}
+
+#[derive(Default)]
+struct Builder {
+    index: InputIndex,
+}
+
+impl Builder {
+    fn at(&mut self, name: &str) -> &mut NamePostings {
+        let key = name.to_ascii_lowercase();
+        let next = self.index.postings.len() as NameId;
+        let id = *self.index.names.entry(key).or_insert(next);
+        if id == next {
+            self.index.postings.push(NamePostings::default());
+        }
+        &mut self.index.postings[id as usize]
+    }
+
+    fn flag(&mut self, name: &str, flag: u8) {
+        self.at(name).flags |= flag;
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::policy::input::{Architecture, Entity, Process};
+
+    #[test]
+    fn postings_are_case_insensitive_and_ordered() {
+        let mut input = Input::default();
+        input.entities.push(Entity {
+            name: "Core".to_string(),
+            file: "core.vhd".to_string(),
+            ..Default::default()
+        });
+        input.architectures.push(Architecture {
+            name: "rtl".to_string(),
+            entity_name: "CORE".to_string(),
+            ..Default::default()
+        });
+        for label in ["p0", "p1"] {
+            input.processes.push(Process {
+                label: label.to_string(),
+                assigned_signals: vec!["Q".to_string(), "q".to_string()],
+                ..Default::default()
+            });
+        }
+        input.constants.push("WIDTH".to_string());
+
+        let index = InputIndex::build(&input);
+        assert_eq!(index.name("core").entities, vec![0]);
+        assert_eq!(index.name("core").architectures_of_entity, vec![0]);
+        assert_eq!(index.name("Q").assigning_processes, vec![0, 1]);
+        assert!(index.name("width").is_constant());
+        assert!(index.name("missing").entities.is_empty());
+        assert_eq!(index.entities_in_file("core.vhd"), &[0]);
+    }
+}
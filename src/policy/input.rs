@@ -1,7 +1,12 @@
 use std::collections::HashMap;
+use std::sync::OnceLock;
 
 use serde::Deserialize;
 
+use crate::policy::domains::ClockDomains;
+use crate::policy::elaboration::Elaboration;
+use crate::policy::index::InputIndex;
+
 #[derive(Debug, Clone, Deserialize, Default)]
 pub struct Input {
     #[serde(default)]
@@ -86,6 +91,32 @@ pub struct Input {
     pub lint_config: LintConfig,
     #[serde(default)]
     pub third_party_files: Vec<String>,
+    /// Built on first `index()` call; the input must not change after that.
+    #[serde(skip)]
+    pub(crate) index: OnceLock<InputIndex>,
+    /// Built on first `domains()` call, like `index`.
+    #[serde(skip)]
+    pub(crate) domains: OnceLock<ClockDomains>,
+    /// Built on first `elaboration()` call, like `index`.
+    #[serde(skip)]
+    pub(crate) elaboration: OnceLock<Elaboration>,
+}
+
+impl Input {
+    /// Name and file lookup tables over this input, shared by every rule.
+    pub fn index(&self) -> &InputIndex {
+        self.index.get_or_init(|| InputIndex::build(self))
+    }
+
+    /// Clock-domain graph over this input, shared by the CDC and RDC rules.
+    pub fn domains(&self) -> &ClockDomains {
+        self.domains.get_or_init(|| ClockDomains::build(self))
+    }
+
+    /// Instance targets resolved to entities, shared by the hierarchy rules.
+    pub fn elaboration(&self) -> &Elaboration {
+        self.elaboration.get_or_init(|| Elaboration::build(self))
+    }
 }
 
 #[derive(Debug, Clone, Deserialize, Default)]
@@ -1,12 +1,16 @@
+pub mod binary_input;
 pub mod cdc;
 pub mod clocks_resets;
 pub mod combinational;
 pub mod configurations;
 pub mod core;
+pub mod domains;
+pub mod elaboration;
 pub mod engine;
 pub mod fsm;
 pub mod helpers;
 pub mod hierarchy;
+pub mod index;
 pub mod input;
 pub mod instances;
 pub mod latch;
@@ -123,20 +123,11 @@ fn inout_as_input(input: &Input) -> Vec<Violation> {
 
 fn port_is_read(input: &Input, port_name: &str) -> bool {
     let port_lower = port_name.to_ascii_lowercase();
-    input.processes.iter().any(|proc| {
-        proc.read_signals
-            .iter()
-            .any(|sig| sig.eq_ignore_ascii_case(&port_lower))
-            || proc
-                .sensitivity_list
-                .iter()
-                .any(|sig| sig.eq_ignore_ascii_case(&port_lower))
-    }) || instance_reads_port(&input.instances, &port_lower)
-        || input.concurrent_assignments.iter().any(|ca| {
-            ca.read_signals
-                .iter()
-                .any(|sig| sig.eq_ignore_ascii_case(&port_lower))
-        })
+    let named = input.index().name(&port_lower);
+    !named.reading_processes.is_empty()
+        || !named.sensitive_processes.is_empty()
+        || instance_reads_port(&input.instances, &port_lower)
+        || !named.concurrent_readers.is_empty()
 }
 
 fn instance_reads_port(instances: &[Instance], port_lower: &str) -> bool {
@@ -148,34 +139,27 @@ fn instance_reads_port(instances: &[Instance], port_lower: &str) -> bool {
 }
 
 fn port_is_assigned(input: &Input, port_name: &str) -> bool {
-    let port_lower = port_name.to_ascii_lowercase();
-    input.processes.iter().any(|proc| {
-        proc.assigned_signals
-            .iter()
-            .any(|sig| sig.eq_ignore_ascii_case(&port_lower))
-    }) || input.instances.iter().any(|inst| {
-        inst.port_map
-            .values()
-            .any(|formal| formal.eq_ignore_ascii_case(&port_lower))
-    }) || input
-        .concurrent_assignments
-        .iter()
-        .any(|ca| ca.target.eq_ignore_ascii_case(&port_lower))
+    let named = input.index().name(port_name);
+    !named.assigning_processes.is_empty()
+        || !named.instance_actuals.is_empty()
+        || !named.concurrent_targets.is_empty()
 }
 
 fn entity_has_architecture(input: &Input, entity_name: &str) -> bool {
-    input
-        .architectures
-        .iter()
-        .any(|arch| arch.entity_name.eq_ignore_ascii_case(entity_name))
+    !input
+        .index()
+        .name(entity_name)
+        .architectures_of_entity
+        .is_empty()
 }
 
 fn entity_file(input: &Input, entity_name: &str) -> Option<String> {
     input
+        .index()
+        .name(entity_name)
         .entities
-        .iter()
-        .find(|entity| entity.name.eq_ignore_ascii_case(entity_name))
-        .map(|entity| entity.file.clone())
+        .first()
+        .map(|&i| input.entities[i as usize].file.clone())
 }
 
 fn is_legacy_standard(input: &Input) -> bool {
@@ -109,7 +109,14 @@ fn combinational_multiplier(input: &Input) -> Vec<Violation> {
         if op.operator != "*" {
             continue;
         }
-        if let Some(proc) = input.processes.iter().find(|p| p.label == op.in_process) {
+        let proc = input
+            .index()
+            .name(&op.in_process)
+            .processes_labelled
+            .iter()
+            .map(|&i| &input.processes[i as usize])
+            .find(|p| p.label == op.in_process);
+        if let Some(proc) = proc {
             if proc.is_combinational {
                 out.push(Violation {
                     rule: "combinational_multiplier".to_string(),
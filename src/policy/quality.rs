@@ -38,7 +38,7 @@ fn very_long_file(input: &Input) -> Vec<Violation> {
     files.sort();
     files.dedup();
     for file in files {
-        let entities_in_file = input.entities.iter().filter(|e| e.file == file).count();
+        let entities_in_file = input.index().entities_in_file(file).len();
         let archs_in_file = input
             .architectures
             .iter()
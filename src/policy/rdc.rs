@@ -45,18 +45,20 @@ fn async_reset_unsynchronized(input: &Input) -> Vec<Violation> {
 }
 
 fn has_reset_synchronizer(input: &Input, reset_sig: &str, clock_sig: &str) -> bool {
-    input.processes.iter().any(|proc| {
-        proc.is_sequential
-            && proc.clock_signal == clock_sig
-            && proc
-                .read_signals
-                .iter()
-                .any(|sig| sig.eq_ignore_ascii_case(reset_sig))
-            && proc
-                .assigned_signals
-                .iter()
-                .any(|assigned| is_sync_name(assigned, reset_sig))
-    })
+    input
+        .index()
+        .name(reset_sig)
+        .reading_processes
+        .iter()
+        .map(|&i| &input.processes[i as usize])
+        .any(|proc| {
+            proc.is_sequential
+                && proc.clock_signal == clock_sig
+                && proc
+                    .assigned_signals
+                    .iter()
+                    .any(|assigned| is_sync_name(assigned, reset_sig))
+        })
 }
 
 fn is_sync_name(assigned: &str, reset_sig: &str) -> bool {
@@ -72,23 +74,16 @@ fn is_sync_name(assigned: &str, reset_sig: &str) -> bool {
     lower_assigned.contains("sync") && helpers::is_reset_name(assigned)
 }
 
+/// One violation per process and other clock domain that uses its reset
+/// in a later process.
 fn reset_crosses_domains(input: &Input) -> Vec<Violation> {
     let mut out = Vec::new();
     for proc1 in &input.processes {
-        if !proc1.has_reset || proc1.reset_signal.is_empty() {
+        if !proc1.has_reset || proc1.reset_signal.is_empty() || proc1.clock_signal.is_empty() {
             continue;
         }
-        for proc2 in &input.processes {
-            if !proc2.has_reset || proc2.reset_signal != proc1.reset_signal {
-                continue;
-            }
-            if proc1.clock_signal.is_empty()
-                || proc2.clock_signal.is_empty()
-                || proc1.clock_signal == proc2.clock_signal
-            {
-                continue;
-            }
-            if proc1.line >= proc2.line {
+        for (clock2, last_line) in input.domains().reset_clocks(&proc1.reset_signal) {
+            if *clock2 == proc1.clock_signal || proc1.line >= *last_line {
                 continue;
             }
             out.push(Violation {
@@ -98,7 +93,7 @@ fn reset_crosses_domains(input: &Input) -> Vec<Violation> {
                 line: proc1.line,
                 message: format!(
                     "Reset '{}' used in multiple clock domains ('{}' and '{}') - each domain needs synchronized reset",
-                    proc1.reset_signal, proc1.clock_signal, proc2.clock_signal
+                    proc1.reset_signal, proc1.clock_signal, clock2
                 ),
             });
         }
@@ -107,37 +102,23 @@ fn reset_crosses_domains(input: &Input) -> Vec<Violation> {
 }
 
 fn partial_reset_domain(input: &Input) -> Vec<Violation> {
-    let mut out = Vec::new();
-    for proc1 in &input.processes {
-        if !proc1.is_sequential || !proc1.has_reset || proc1.clock_signal.is_empty() {
-            continue;
-        }
-        for proc2 in &input.processes {
-            if !proc2.is_sequential || proc2.has_reset {
-                continue;
-            }
-            if proc2.clock_signal != proc1.clock_signal {
-                continue;
-            }
-            if proc2.file != proc1.file {
-                continue;
-            }
-            if proc2.assigned_signals.is_empty() {
-                continue;
-            }
-            out.push(Violation {
-                rule: "partial_reset_domain".to_string(),
-                severity: "warning".to_string(),
-                file: proc2.file.clone(),
-                line: proc2.line,
-                message: format!(
-                    "Process '{}' in clock domain '{}' has no reset, but other processes in same domain do - potential state inconsistency",
-                    proc2.label, proc2.clock_signal
-                ),
-            });
-        }
-    }
-    out
+    input
+        .processes
+        .iter()
+        .filter(|proc| proc.is_sequential && !proc.has_reset && !proc.clock_signal.is_empty())
+        .filter(|proc| !proc.assigned_signals.is_empty())
+        .filter(|proc| input.domains().has_reset_in_domain(&proc.file, &proc.clock_signal))
+        .map(|proc| Violation {
+            rule: "partial_reset_domain".to_string(),
+            severity: "warning".to_string(),
+            file: proc.file.clone(),
+            line: proc.line,
+            message: format!(
+                "Process '{}' in clock domain '{}' has no reset, but other processes in same domain do - potential state inconsistency",
+                proc.label, proc.clock_signal
+            ),
+        })
+        .collect()
 }
 
 fn combinational_reset_gen(input: &Input) -> Vec<Violation> {
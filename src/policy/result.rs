@@ -53,4 +53,21 @@ pub struct Result {
     pub missing_checks: Vec<MissingCheckTask>,
     #[serde(default)]
     pub ambiguous_constructs: Vec<AmbiguousConstruct>,
+    /// Evaluation spans, only when VHDL_POLICY_TIMINGS is set
+    #[serde(skip_serializing_if = "Vec::is_empty")]
+    pub timings: Vec<Timing>,
+}
+
+/// One span of an evaluation (a rule family, input indexing, filtering or
+/// the whole evaluation), relative to the start of the evaluation. The Go
+/// timing recorder places these inside its policy stage.
+#[derive(Debug, Clone, Serialize)]
+pub struct Timing {
+    pub name: String,
+    pub start_ms: f64,
+    pub duration_ms: f64,
+    /// Worker that ran the span (0 when serial)
+    pub thread: usize,
+    /// Violations the span produced
+    pub count: usize,
 }
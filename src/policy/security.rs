@@ -68,9 +68,13 @@ fn trigger_drives_output(input: &Input) -> Vec<Violation> {
     for comp in input.comparisons.iter().filter(|c| {
         c.is_literal && c.literal_bits > 8 && c.operator == "=" && !c.result_drives.is_empty()
     }) {
-        if input.ports.iter().any(|port| {
-            port.name.eq_ignore_ascii_case(&comp.result_drives) && port.direction == "out"
-        }) {
+        if input
+            .index()
+            .name(&comp.result_drives)
+            .ports
+            .iter()
+            .any(|&i| input.ports[i as usize].direction == "out")
+        {
             out.push(Violation {
                 rule: "trigger_drives_output".to_string(),
                 severity: "error".to_string(),
@@ -130,7 +130,19 @@ fn mixed_edge_clocking(input: &Input) -> Vec<Violation> {
 fn signal_in_seq_and_comb(input: &Input) -> Vec<Violation> {
     let mut out = Vec::new();
     for proc_seq in input.processes.iter().filter(|p| p.is_sequential) {
-        for proc_comb in input.processes.iter().filter(|p| p.is_combinational) {
+        // Only processes that assign one of the same names can match
+        let mut candidates: Vec<u32> = proc_seq
+            .assigned_signals
+            .iter()
+            .flat_map(|sig| input.index().name(sig).assigning_processes.iter().copied())
+            .collect();
+        candidates.sort_unstable();
+        candidates.dedup();
+        for proc_comb in candidates
+            .iter()
+            .map(|&i| &input.processes[i as usize])
+            .filter(|p| p.is_combinational)
+        {
             if proc_seq.file != proc_comb.file {
                 continue;
             }
@@ -24,55 +24,7 @@ pub fn optional_violations(input: &Input) -> Vec<Violation> {
 }
 
 pub fn is_declared_identifier(input: &Input, name: &str) -> bool {
-    input
-        .signals
-        .iter()
-        .any(|sig| sig.name.eq_ignore_ascii_case(name))
-        || input
-            .ports
-            .iter()
-            .any(|port| port.name.eq_ignore_ascii_case(name))
-        || input.constants.iter().any(|c| c.eq_ignore_ascii_case(name))
-        || input
-            .enum_literals
-            .iter()
-            .any(|lit| lit.eq_ignore_ascii_case(name))
-        || input
-            .types
-            .iter()
-            .any(|t| t.name.eq_ignore_ascii_case(name))
-        || input
-            .subtypes
-            .iter()
-            .any(|st| st.name.eq_ignore_ascii_case(name))
-        || input
-            .functions
-            .iter()
-            .any(|func| func.name.eq_ignore_ascii_case(name))
-        || input
-            .procedures
-            .iter()
-            .any(|proc| proc.name.eq_ignore_ascii_case(name))
-        || input
-            .shared_variables
-            .iter()
-            .any(|v| v.eq_ignore_ascii_case(name))
-        || input.processes.iter().any(|proc| {
-            proc.variables
-                .iter()
-                .any(|var| var.name.eq_ignore_ascii_case(name))
-        })
-        || input.entities.iter().any(|entity| {
-            entity
-                .generics
-                .iter()
-                .any(|gen| gen.name.eq_ignore_ascii_case(name))
-        })
-        || input.components.iter().any(|comp| {
-            comp.generics
-                .iter()
-                .any(|gen| gen.name.eq_ignore_ascii_case(name))
-        })
+    input.index().name(name).is_declared()
 }
 
 pub fn is_actual_signal(input: &Input, name: &str) -> bool {
@@ -82,14 +34,11 @@ pub fn is_actual_signal(input: &Input, name: &str) -> bool {
 }
 
 fn is_enum_literal(input: &Input, name: &str) -> bool {
-    input
-        .enum_literals
-        .iter()
-        .any(|lit| lit.eq_ignore_ascii_case(name))
+    helpers::is_enum_literal(input, name)
 }
 
 fn is_constant(input: &Input, name: &str) -> bool {
-    input.constants.iter().any(|c| c.eq_ignore_ascii_case(name))
+    helpers::is_constant(input, name)
 }
 
 fn skip_undeclared_read(
@@ -416,13 +365,12 @@ fn count_drivers_in_entity(
     sig_file: &str,
 ) -> usize {
     let mut proc_count = 0;
-    for proc in &input.processes {
+    for &i in &input.index().name(sig_name).assigning_processes {
+        let proc = &input.processes[i as usize];
         if !sig_assigned_in_process(input, sig_name, proc) {
             continue;
         }
-        if let Some(arch) = input
-            .architectures
-            .iter()
+        if let Some(arch) = arch_named(input, &proc.in_arch)
             .find(|arch| arch.name == proc.in_arch && arch.file == proc.file)
         {
             if arch_matches_entity(arch, entity_name) && arch.file == sig_file {
@@ -430,12 +378,18 @@ fn count_drivers_in_entity(
             }
         }
     }
-    let non_gen_drivers = input
-        .concurrent_assignments
-        .iter()
-        .filter(|ca| ca.target.eq_ignore_ascii_case(sig_name) && !ca.in_generate)
+    let targets = || {
+        input
+            .index()
+            .name(sig_name)
+            .concurrent_targets
+            .iter()
+            .map(|&i| &input.concurrent_assignments[i as usize])
+    };
+    let non_gen_drivers = targets()
+        .filter(|ca| !ca.in_generate)
         .filter(|ca| {
-            input.architectures.iter().any(|arch| {
+            arch_named(input, &ca.in_arch).any(|arch| {
                 arch.name == ca.in_arch
                     && arch_matches_entity(arch, entity_name)
                     && arch.file == ca.file
@@ -444,12 +398,8 @@ fn count_drivers_in_entity(
         })
         .count();
     let mut gen_labels: Vec<String> = Vec::new();
-    for ca in input
-        .concurrent_assignments
-        .iter()
-        .filter(|ca| ca.target.eq_ignore_ascii_case(sig_name) && ca.in_generate)
-    {
-        if !input.architectures.iter().any(|arch| {
+    for ca in targets().filter(|ca| ca.in_generate) {
+        if !arch_named(input, &ca.in_arch).any(|arch| {
             arch.name == ca.in_arch
                 && arch_matches_entity(arch, entity_name)
                 && arch.file == ca.file
@@ -474,12 +424,19 @@ fn arch_matches_entity(arch: &Architecture, entity_or_arch: &str) -> bool {
             .eq_ignore_ascii_case(&helpers::base_arch_name(entity_or_arch))
 }
 
+/// Architectures named `name`, ignoring case, in input order.
+fn arch_named<'a>(input: &'a Input, name: &str) -> impl Iterator<Item = &'a Architecture> + 'a {
+    input
+        .index()
+        .name(name)
+        .architectures
+        .iter()
+        .map(|&i| &input.architectures[i as usize])
+}
+
 fn signal_in_testbench(input: &Input, sig: &Signal) -> bool {
-    input.architectures.iter().any(|arch| {
-        arch.name
-            .eq_ignore_ascii_case(&helpers::base_arch_name(&sig.in_entity))
-            && helpers::is_testbench_name(&arch.entity_name)
-    })
+    arch_named(input, &helpers::base_arch_name(&sig.in_entity))
+        .any(|arch| helpers::is_testbench_name(&arch.entity_name))
 }
 
 fn sig_assigned_in_process(input: &Input, sig_name: &str, proc: &Process) -> bool {
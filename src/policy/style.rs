@@ -62,7 +62,12 @@ fn multiple_entities_per_file(input: &Input) -> Vec<Violation> {
     files.dedup();
 
     for file in files {
-        let entities: Vec<_> = input.entities.iter().filter(|e| e.file == file).collect();
+        let entities: Vec<_> = input
+            .index()
+            .entities_in_file(file)
+            .iter()
+            .map(|&i| &input.entities[i as usize])
+            .collect();
         if entities.len() > 1 {
             if let Some(first) = entities.first() {
                 violations.push(Violation {
@@ -26,14 +26,11 @@ pub fn optional_violations(input: &Input) -> Vec<Violation> {
 fn multiple_clock_domains(input: &Input) -> Vec<Violation> {
     let mut out = Vec::new();
     for arch in &input.architectures {
-        let clocks: std::collections::HashSet<String> = input
-            .processes
-            .iter()
-            .filter(|p| p.file == arch.file && !p.clock_signal.is_empty())
-            .map(|p| p.clock_signal.to_ascii_lowercase())
-            .collect();
+        let Some(clocks) = input.domains().clocks_in_file(&arch.file) else {
+            continue;
+        };
         if clocks.len() > 1 {
-            let clock_list: Vec<String> = clocks.into_iter().collect();
+            let clock_list: Vec<&String> = clocks.iter().collect();
             out.push(Violation {
                 rule: "multiple_clock_domains".to_string(),
                 severity: "warning".to_string(),
@@ -52,7 +49,19 @@ fn multiple_clock_domains(input: &Input) -> Vec<Violation> {
 fn signal_crosses_clock_domain(input: &Input) -> Vec<Violation> {
     let mut out = Vec::new();
     for proc1 in input.processes.iter().filter(|p| p.is_sequential) {
-        for proc2 in input.processes.iter().filter(|p| p.is_sequential) {
+        // Only processes reading one of proc1's outputs can match
+        let mut candidates: Vec<u32> = proc1
+            .assigned_signals
+            .iter()
+            .flat_map(|sig| input.index().name(sig).reading_processes.iter().copied())
+            .collect();
+        candidates.sort_unstable();
+        candidates.dedup();
+        for proc2 in candidates
+            .iter()
+            .map(|&i| &input.processes[i as usize])
+            .filter(|p| p.is_sequential)
+        {
             if proc1.clock_signal.is_empty()
                 || proc2.clock_signal.is_empty()
                 || proc1.clock_signal.eq_ignore_ascii_case(&proc2.clock_signal)
@@ -301,32 +310,26 @@ fn unregistered_output(input: &Input) -> Vec<Violation> {
 }
 
 fn output_driven_by_sequential(input: &Input, port_name: &str) -> bool {
-    input.processes.iter().any(|proc| {
-        proc.is_sequential
-            && proc
-                .assigned_signals
-                .iter()
-                .any(|sig| sig.eq_ignore_ascii_case(port_name))
-    })
+    input
+        .index()
+        .name(port_name)
+        .assigning_processes
+        .iter()
+        .any(|&i| input.processes[i as usize].is_sequential)
 }
 
 fn output_is_driven(input: &Input, port_name: &str) -> bool {
-    input.processes.iter().any(|proc| {
-        proc.assigned_signals
-            .iter()
-            .any(|sig| sig.eq_ignore_ascii_case(port_name))
-    }) || input
-        .concurrent_assignments
-        .iter()
-        .any(|ca| ca.target.eq_ignore_ascii_case(port_name))
+    let named = input.index().name(port_name);
+    !named.assigning_processes.is_empty() || !named.concurrent_targets.is_empty()
 }
 
 fn get_entity_file(input: &Input, entity_name: &str) -> String {
     input
+        .index()
+        .name(entity_name)
         .entities
-        .iter()
-        .find(|entity| entity.name.eq_ignore_ascii_case(entity_name))
-        .map(|entity| entity.file.clone())
+        .first()
+        .map(|&i| input.entities[i as usize].file.clone())
         .unwrap_or_else(|| "unknown".to_string())
 }
 
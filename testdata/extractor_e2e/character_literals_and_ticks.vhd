@@ -0,0 +1,27 @@
+library ieee;
+use ieee.std_logic_1164.all;
+
+entity tick_demo is
+  port (
+    clk : in std_logic;
+    a   : in std_logic_vector(3 downto 0);
+    y   : out std_logic_vector(3 downto 0)
+  );
+end entity;
+
+architecture rtl of tick_demo is
+  type tri_t is ('0', '1', 'Z', ''');
+  constant SCALE : integer := 2#1010#E2;
+  signal s : std_logic_vector(3 downto 0);
+begin
+  p_tick : process(clk)
+  begin
+    if clk'event and clk = '1' then
+      if a'length = 4 then
+        s <= a;
+      end if;
+    end if;
+  end process;
+
+  y <= s;
+end architecture;
@@ -31,9 +31,10 @@ def bar(value, total, width=40):
     return "#" * max(n, 0)
 
 
-def render_report(events, top_files=15):
+def render_report(events, top_files=15, top_rules=15):
     stage_events = [e for e in events if e.get("kind") == "stage"]
     file_events = [e for e in events if e.get("kind") == "file"]
+    rule_events = [e for e in events if e.get("kind") == "rule"]
     if not events:
         return "No timing events found."
 
@@ -74,10 +75,23 @@ def render_report(events, top_files=15):
         top = sorted(file_events, key=lambda e: e.get("duration_ms", 0), reverse=True)[:top_files]
         for e in top:
             status = f" ({e['status']})" if e.get("status") else ""
+            parse = ""
+            if e.get("nodes"):
+                parse = f" [parse {fmt_ms(e.get('parse_ms', 0))}, {e['nodes']} nodes, {e.get('errors', 0)} errors]"
             lines.append(
-                f"- {e['file']}{status}: {fmt_ms(e['duration_ms'])} {bar(e['duration_ms'], total_ms)}"
+                f"- {e['file']}{status}: {fmt_ms(e['duration_ms'])}{parse} {bar(e['duration_ms'], total_ms)}"
             )
 
+        broken = sorted(
+            (e for e in file_events if e.get("errors")), key=lambda e: e["errors"], reverse=True
+        )[:top_files]
+        if broken:
+            lines.append("")
+            lines.append("## Files With Parse Errors")
+            lines.append("")
+            for e in broken:
+                lines.append(f"- {e['file']}: {e['errors']} ERROR/MISSING nodes of {e.get('nodes', 0)}")
+
         phase_totals = defaultdict(float)
         for e in file_events:
             phase_totals[e.get("phase", "unknown")] += e.get("duration_ms", 0.0)
@@ -88,6 +102,17 @@ def render_report(events, top_files=15):
             for phase, total in sorted(phase_totals.items(), key=lambda x: x[1], reverse=True):
                 lines.append(f"- {phase}: {fmt_ms(total)}")
 
+    if rule_events:
+        lines.append("")
+        lines.append("## Slowest Policy Rules")
+        lines.append("")
+        top = sorted(rule_events, key=lambda e: e.get("duration_ms", 0), reverse=True)[:top_rules]
+        for e in top:
+            lines.append(
+                f"- {e['name']} (thread {e.get('thread', 0)}, {e.get('count', 0)} violations): "
+                f"{fmt_ms(e['duration_ms'])} {bar(e['duration_ms'], total_ms)}"
+            )
+
     return "\n".join(lines)
 
 
@@ -95,11 +120,12 @@ def main():
     parser = argparse.ArgumentParser(description="Summarize vhdl-lint timing JSONL")
     parser.add_argument("path", help="Path to timing.jsonl")
     parser.add_argument("--top-files", type=int, default=15, help="Number of slow files to show")
+    parser.add_argument("--top-rules", type=int, default=15, help="Number of slow policy rules to show")
     parser.add_argument("--out", help="Write report to file instead of stdout")
     args = parser.parse_args()
 
     events = read_events(args.path)
-    report = render_report(events, top_files=args.top_files)
+    report = render_report(events, top_files=args.top_files, top_rules=args.top_rules)
 
     if args.out:
         with open(args.out, "w", encoding="utf-8") as f:
@@ -43,13 +43,17 @@ def to_trace_events(events):
         status = ev.get("status", "")
         file = ev.get("file", "")
         name = phase
+        key = f"{kind}:{phase}"
         if kind == "file":
             base = os.path.basename(file)
             name = f"{phase}:{base}"
+            key = f"{phase} worker {ev.get('thread', 0)}"
+        elif kind == "rule":
+            name = ev.get("name", phase)
+            key = f"{phase} thread {ev.get('thread', 0)}"
         if status:
             name = f"{name} ({status})"
 
-        key = f"{kind}:{phase}"
         tid = tid_for(key)
         trace.append(
             {
@@ -65,6 +69,9 @@ def to_trace_events(events):
                     "phase": phase,
                     "file": file,
                     "status": status,
+                    "nodes": ev.get("nodes", 0),
+                    "errors": ev.get("errors", 0),
+                    "count": ev.get("count", 0),
                 },
             }
         )
@@ -0,0 +1,474 @@
+/**
+ * External Scanner Microbenchmark
+ * ===============================
+ *
+ * Drives tree_sitter_vhdl_external_scanner_scan() directly with a fake
+ * TSLexer so scanner.c can be measured without the generated parser or the
+ * Go/Rust pipeline around it.
+ *
+ * HOW IT WORKS:
+ * -------------
+ * 1. Load every .vhd/.vhdl file under the given paths (plus an optional
+ *    synthetic netlist full of large X"..." init vectors, see -g).
+ * 2. Walk each buffer token by token, the way Tree-sitter would, and record
+ *    every token start. If the scanner matches there, skip past the literal;
+ *    otherwise skip one comment, string, word or punctuation character.
+ * 3. Replay the recorded positions for -n iterations with all external
+ *    symbols valid, timing whole passes rather than single calls.
+ * 4. Report ns/call, ns/token, tokens/sec and how often the scan reached
+ *    the base-letter check and then gave up.
+ *
+ * The scanner is compiled with TREE_SITTER_VHDL_SCANNER_STATS so it counts
+ * its own early rejects; those counters cost a few ns per call, so compare
+ * numbers from this harness only with other runs of this harness.
+ *
+ * USAGE:
+ *   ./bench/scanner_bench.sh                       # testdata/ + synthetic netlist
+ *   ./bench/scanner_bench.sh -n 50 path/to/rtl     # custom corpus, 50 iterations
+ *   ./bench/scanner_bench.sh -g 0 path/to/netlist  # disable synthetic corpus
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#ifndef TREE_SITTER_VHDL_SCANNER_STATS
+#define TREE_SITTER_VHDL_SCANNER_STATS 1
+#endif
+
+#include "../src/scanner.c"
+
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <time.h>
+
+// ---------------------------------------------------------------------------
+// Corpus
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    char *data;
+    size_t len;
+} Buffer;
+
+typedef struct {
+    Buffer *items;
+    size_t count;
+    size_t cap;
+    size_t bytes;
+} Corpus;
+
+static void corpus_push(Corpus *corpus, char *data, size_t len) {
+    if (corpus->count == corpus->cap) {
+        corpus->cap = corpus->cap ? corpus->cap * 2 : 64;
+        corpus->items = realloc(corpus->items, corpus->cap * sizeof(Buffer));
+        if (corpus->items == NULL) {
+            fprintf(stderr, "scanner_bench: out of memory\n");
+            exit(1);
+        }
+    }
+    corpus->items[corpus->count].data = data;
+    corpus->items[corpus->count].len = len;
+    corpus->count++;
+    corpus->bytes += len;
+}
+
+static bool has_vhdl_extension(const char *path) {
+    const char *dot = strrchr(path, '.');
+    if (dot == NULL) {
+        return false;
+    }
+    return strcmp(dot, ".vhd") == 0 || strcmp(dot, ".vhdl") == 0 ||
+           strcmp(dot, ".VHD") == 0 || strcmp(dot, ".VHDL") == 0;
+}
+
+static void load_file(Corpus *corpus, const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        fprintf(stderr, "scanner_bench: cannot open %s\n", path);
+        return;
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (size <= 0) {
+        fclose(f);
+        return;
+    }
+    char *data = malloc((size_t)size);
+    if (data == NULL || fread(data, 1, (size_t)size, f) != (size_t)size) {
+        fprintf(stderr, "scanner_bench: cannot read %s\n", path);
+        free(data);
+        fclose(f);
+        return;
+    }
+    fclose(f);
+    corpus_push(corpus, data, (size_t)size);
+}
+
+static void load_path(Corpus *corpus, const char *path, bool explicit_file) {
+    struct stat st;
+    if (stat(path, &st) != 0) {
+        fprintf(stderr, "scanner_bench: no such path %s\n", path);
+        return;
+    }
+    if (S_ISREG(st.st_mode)) {
+        if (explicit_file || has_vhdl_extension(path)) {
+            load_file(corpus, path);
+        }
+        return;
+    }
+    if (!S_ISDIR(st.st_mode)) {
+        return;
+    }
+    DIR *dir = opendir(path);
+    if (dir == NULL) {
+        return;
+    }
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (entry->d_name[0] == '.') {
+            continue;
+        }
+        size_t n = strlen(path) + strlen(entry->d_name) + 2;
+        char *child = malloc(n);
+        snprintf(child, n, "%s/%s", path, entry->d_name);
+        load_path(corpus, child, false);
+        free(child);
+    }
+    closedir(dir);
+}
+
+/**
+ * Synthetic gate-level netlist: block RAM instances, each with a
+ * wide X"..." INIT generic. This is the shape that makes the scanner hot in
+ * vendor netlists and is missing from testdata/.
+ */
+static void add_synthetic_netlist(Corpus *corpus, size_t instances) {
+    if (instances == 0) {
+        return;
+    }
+    static const char hex[] = "0123456789ABCDEF";
+    size_t cap = instances * 1024 + 256;
+    char *data = malloc(cap);
+    size_t len = 0;
+    unsigned seed = 12345;
+
+    len += (size_t)snprintf(data + len, cap - len,
+        "library ieee;\nuse ieee.std_logic_1164.all;\n"
+        "entity synth_netlist is\n  port (clk : in std_logic);\nend entity;\n"
+        "architecture netlist of synth_netlist is\nbegin\n");
+    for (size_t i = 0; i < instances; i++) {
+        len += (size_t)snprintf(data + len, cap - len,
+            "  ram_%zu : RAMB36E1\n    generic map (\n      INIT_00 => X\"", i);
+        for (int d = 0; d < 256; d++) {
+            seed = seed * 1103515245u + 12345u;
+            data[len++] = hex[(seed >> 16) & 0xF];
+        }
+        len += (size_t)snprintf(data + len, cap - len,
+            "\",\n      SIZE => 16#FF_FF#,\n      MODE => 8UX\"A5\",\n"
+            "      READ_WIDTH_A => 36, WRITE_MODE_A => \"WRITE_FIRST\")\n"
+            "    port map (CLKARDCLK => clk, ADDRARDADDR => addr_%zu(15 downto 0),\n"
+            "      DOADO => dout_%zu, ENARDEN => en_%zu);\n", i, i, i);
+    }
+    len += (size_t)snprintf(data + len, cap - len, "end architecture;\n");
+    corpus_push(corpus, data, len);
+}
+
+// ---------------------------------------------------------------------------
+// Fake lexer
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    TSLexer base;         // Must be first: the scanner only sees TSLexer *
+    const char *data;
+    size_t len;
+    size_t pos;           // Byte offset of lookahead
+    size_t next;          // Byte offset after lookahead
+    size_t line_start;
+    size_t marked_end;
+    uint64_t advances;
+} BenchLexer;
+
+static int32_t decode_utf8(const char *data, size_t len, size_t pos, size_t *next) {
+    const unsigned char *s = (const unsigned char *)data + pos;
+    size_t left = len - pos;
+    if (s[0] < 0x80 || left < 2) {
+        *next = pos + 1;
+        return s[0];
+    }
+    if ((s[0] & 0xE0) == 0xC0) {
+        *next = pos + 2;
+        return ((s[0] & 0x1F) << 6) | (s[1] & 0x3F);
+    }
+    if ((s[0] & 0xF0) == 0xE0 && left >= 3) {
+        *next = pos + 3;
+        return ((s[0] & 0x0F) << 12) | ((s[1] & 0x3F) << 6) | (s[2] & 0x3F);
+    }
+    if ((s[0] & 0xF8) == 0xF0 && left >= 4) {
+        *next = pos + 4;
+        return ((s[0] & 0x07) << 18) | ((s[1] & 0x3F) << 12) |
+               ((s[2] & 0x3F) << 6) | (s[3] & 0x3F);
+    }
+    *next = pos + 1;
+    return s[0];
+}
+
+static void bench_lexer_seek(BenchLexer *lex, size_t pos) {
+    lex->pos = pos;
+    if (pos >= lex->len) {
+        lex->next = lex->len;
+        lex->base.lookahead = 0;
+        return;
+    }
+    lex->base.lookahead = decode_utf8(lex->data, lex->len, pos, &lex->next);
+}
+
+static void bench_advance(TSLexer *self, bool skip) {
+    BenchLexer *lex = (BenchLexer *)self;
+    lex->advances++;
+    if (lex->pos >= lex->len) {
+        return;
+    }
+    if (self->lookahead == '\n') {
+        lex->line_start = lex->next;
+    }
+    bench_lexer_seek(lex, lex->next);
+    (void)skip;
+}
+
+static void bench_mark_end(TSLexer *self) {
+    BenchLexer *lex = (BenchLexer *)self;
+    lex->marked_end = lex->pos;
+}
+
+static uint32_t bench_get_column(TSLexer *self) {
+    BenchLexer *lex = (BenchLexer *)self;
+    return (uint32_t)(lex->pos - lex->line_start);
+}
+
+static bool bench_is_at_included_range_start(const TSLexer *self) {
+    (void)self;
+    return false;
+}
+
+static bool bench_eof(const TSLexer *self) {
+    const BenchLexer *lex = (const BenchLexer *)self;
+    return lex->pos >= lex->len;
+}
+
+static void bench_lexer_init(BenchLexer *lex, const Buffer *buf) {
+    memset(lex, 0, sizeof(*lex));
+    lex->base.advance = bench_advance;
+    lex->base.mark_end = bench_mark_end;
+    lex->base.get_column = bench_get_column;
+    lex->base.is_at_included_range_start = bench_is_at_included_range_start;
+    lex->base.eof = bench_eof;
+    lex->data = buf->data;
+    lex->len = buf->len;
+    bench_lexer_seek(lex, 0);
+}
+
+// ---------------------------------------------------------------------------
+// Driver
+// ---------------------------------------------------------------------------
+
+static bool is_word_byte(unsigned char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+           (c >= '0' && c <= '9') || c == '_' || c >= 0x80;
+}
+
+/**
+ * Skip one non-scanner token starting at pos. Comments and strings are
+ * skipped whole so the scanner is not called inside them, matching what the
+ * generated lexer does.
+ */
+static size_t skip_token(const char *data, size_t len, size_t pos) {
+    unsigned char c = (unsigned char)data[pos];
+    if (c == '-' && pos + 1 < len && data[pos + 1] == '-') {
+        while (pos < len && data[pos] != '\n') {
+            pos++;
+        }
+        return pos;
+    }
+    if (c == '/' && pos + 1 < len && data[pos + 1] == '*') {
+        pos += 2;
+        while (pos + 1 < len && !(data[pos] == '*' && data[pos + 1] == '/')) {
+            pos++;
+        }
+        return pos + 2 < len ? pos + 2 : len;
+    }
+    if (c == '"') {
+        pos++;
+        while (pos < len && data[pos] != '"' && data[pos] != '\n') {
+            pos++;
+        }
+        return pos < len ? pos + 1 : len;
+    }
+    if (is_word_byte(c)) {
+        while (pos < len && is_word_byte((unsigned char)data[pos])) {
+            pos++;
+        }
+        return pos;
+    }
+    return pos + 1;
+}
+
+typedef struct {
+    uint64_t calls;
+    uint64_t tokens;
+    uint64_t advances;
+    uint64_t ns;
+} RunTotals;
+
+typedef struct {
+    size_t *items;
+    size_t count;
+    size_t cap;
+} Positions;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * Tokenize a buffer once and record every position where the parser would
+ * consult the external scanner. Timed iterations then replay only those
+ * calls, so the driver's own skipping is not part of the measurement.
+ */
+static void collect_positions(void *scanner, const Buffer *buf, const bool *valid, Positions *out) {
+    BenchLexer lex;
+    bench_lexer_init(&lex, buf);
+    size_t pos = 0;
+    while (pos < buf->len) {
+        unsigned char c = (unsigned char)buf->data[pos];
+        if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+            pos++;
+            continue;
+        }
+        if (out->count == out->cap) {
+            out->cap = out->cap ? out->cap * 2 : 1024;
+            out->items = realloc(out->items, out->cap * sizeof(size_t));
+            if (out->items == NULL) {
+                fprintf(stderr, "scanner_bench: out of memory\n");
+                exit(1);
+            }
+        }
+        out->items[out->count++] = pos;
+        bench_lexer_seek(&lex, pos);
+        lex.marked_end = pos;
+        if (tree_sitter_vhdl_external_scanner_scan(scanner, &lex.base, valid) && lex.marked_end > pos) {
+            pos = lex.marked_end;
+        } else {
+            pos = skip_token(buf->data, buf->len, pos);
+        }
+    }
+}
+
+static void replay_buffer(void *scanner, const Buffer *buf, const Positions *positions,
+                          const bool *valid, RunTotals *totals) {
+    BenchLexer lex;
+    bench_lexer_init(&lex, buf);
+    uint64_t tokens = 0;
+    uint64_t start = now_ns();
+    for (size_t i = 0; i < positions->count; i++) {
+        bench_lexer_seek(&lex, positions->items[i]);
+        if (tree_sitter_vhdl_external_scanner_scan(scanner, &lex.base, valid)) {
+            tokens++;
+        }
+    }
+    totals->ns += now_ns() - start;
+    totals->calls += positions->count;
+    totals->tokens += tokens;
+    totals->advances += lex.advances;
+}
+
+static void usage(const char *argv0) {
+    fprintf(stderr,
+        "usage: %s [-n iterations] [-g synthetic_instances] [path ...]\n"
+        "  -n N   repeat the corpus N times (default 20)\n"
+        "  -g N   add a synthetic netlist with N X\"...\" init vectors (default 2000, 0 = off)\n",
+        argv0);
+}
+
+int main(int argc, char **argv) {
+    int iterations = 20;
+    long synthetic = 2000;
+    Corpus corpus = {0};
+    int paths = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            iterations = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-g") == 0 && i + 1 < argc) {
+            synthetic = atol(argv[++i]);
+        } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            usage(argv[0]);
+            return 0;
+        } else {
+            load_path(&corpus, argv[i], true);
+            paths++;
+        }
+    }
+    if (paths == 0) {
+        load_path(&corpus, "../testdata", false);
+    }
+    if (synthetic > 0) {
+        add_synthetic_netlist(&corpus, (size_t)synthetic);
+    }
+    if (corpus.count == 0 || iterations <= 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    // Every external symbol valid: the worst case, and what Tree-sitter
+    // passes during error recovery.
+    bool valid[256];
+    memset(valid, 1, sizeof(valid));
+
+    void *scanner = tree_sitter_vhdl_external_scanner_create();
+    Positions *positions = calloc(corpus.count, sizeof(Positions));
+    for (size_t f = 0; f < corpus.count; f++) {
+        collect_positions(scanner, &corpus.items[f], valid, &positions[f]);
+    }
+
+    RunTotals totals = {0};
+    memset(&vhdl_scanner_stats, 0, sizeof(vhdl_scanner_stats));
+    for (int it = 0; it < iterations; it++) {
+        for (size_t f = 0; f < corpus.count; f++) {
+            replay_buffer(scanner, &corpus.items[f], &positions[f], valid, &totals);
+        }
+    }
+    tree_sitter_vhdl_external_scanner_destroy(scanner);
+
+    double calls = (double)totals.calls;
+    double tokens = (double)totals.tokens;
+    double secs = (double)totals.ns / 1e9;
+    printf("corpus:            %zu buffers, %.2f MiB, %d iterations\n",
+           corpus.count, (double)corpus.bytes / (1024.0 * 1024.0), iterations);
+    printf("scan calls:        %llu\n", (unsigned long long)totals.calls);
+    printf("tokens matched:    %llu\n", (unsigned long long)totals.tokens);
+    printf("advances:          %llu (%.2f per call)\n",
+           (unsigned long long)totals.advances, calls > 0 ? (double)totals.advances / calls : 0.0);
+    printf("ns/call:           %.2f\n", calls > 0 ? (double)totals.ns / calls : 0.0);
+    printf("ns/token:          %.2f\n", tokens > 0 ? (double)totals.ns / tokens : 0.0);
+    printf("tokens/sec:        %.0f\n", secs > 0 ? tokens / secs : 0.0);
+    printf("calls/sec:         %.0f\n", secs > 0 ? calls / secs : 0.0);
+    printf("fast rejects:      %llu (%.1f%% of calls)\n",
+           (unsigned long long)vhdl_scanner_stats.fast_rejects,
+           calls > 0 ? 100.0 * (double)vhdl_scanner_stats.fast_rejects / calls : 0.0);
+    printf("alpha checks:      %llu\n", (unsigned long long)vhdl_scanner_stats.alpha_checks);
+    printf("alpha give-ups:    %llu (%.1f%% of calls)\n",
+           (unsigned long long)vhdl_scanner_stats.alpha_rejects,
+           calls > 0 ? 100.0 * (double)vhdl_scanner_stats.alpha_rejects / calls : 0.0);
+
+    for (size_t f = 0; f < corpus.count; f++) {
+        free(corpus.items[f].data);
+        free(positions[f].items);
+    }
+    free(positions);
+    free(corpus.items);
+    return 0;
+}
@@ -0,0 +1,28 @@
+#!/bin/bash
+# =============================================================================
+# External scanner microbenchmark
+# =============================================================================
+#
+# Builds bench/scanner_bench.c against src/scanner.c and runs it.
+#
+# USAGE:
+#   ./bench/scanner_bench.sh                         # testdata/ + synthetic netlist
+#   ./bench/scanner_bench.sh -n 50 ../external_tests # custom corpus
+#   ./bench/scanner_bench.sh -g 0 path/to/netlist.vhd
+#
+# REQUIRES: src/tree_sitter/parser.h (run `npx tree-sitter generate` once).
+# =============================================================================
+set -e
+
+cd "$(dirname "$0")/.."
+
+if [[ ! -f src/tree_sitter/parser.h ]]; then
+    echo "src/tree_sitter/parser.h not found; run 'npx tree-sitter generate' first" >&2
+    exit 1
+fi
+
+CC="${CC:-cc}"
+OUT="${SCANNER_BENCH_BIN:-bench/scanner_bench}"
+
+"$CC" -O2 -std=c11 -Isrc -o "$OUT" bench/scanner_bench.c
+"$OUT" "$@"
@@ -156,10 +156,21 @@ module.exports = grammar({
   //
   // External scanners (written in C) run BEFORE the normal lexer, giving us
   // first crack at recognizing these tokens. See src/scanner.c for details.
+  //
+  // Based literals (16#FF#) and character literals ('0') live here too: as
+  // regexes they overlapped with number and with the attribute tick (a'range),
+  // and the scanner can settle both from the current parse state instead.
+  // ORDER MATTERS: must match enum TokenType in src/scanner.c.
   // ===========================================================================
   externals: $ => [
     $.bit_string_literal,          // X"...", B"...", O"..." - handled by scanner.c
     $.invalid_bit_string_literal,  // invalid base prefixes (scanner.c)
+    $.based_literal,               // 16#FF_FF#, 2#1010#E4, 8:777: (scanner.c)
+    $.character_literal,           // '0', 'Z', ''' - tick-aware (scanner.c)
+    $.comment,                     // -- to end of line (scanner.c)
+    $.block_comment,               // VHDL-2008 /* ... */ (scanner.c)
+    $.translate_off_pragma,        // -- synthesis translate_off (scanner.c)
+    $.translate_on_pragma,         // -- synthesis translate_on (scanner.c)
   ],
 
   // ===========================================================================
@@ -180,6 +191,8 @@ module.exports = grammar({
     /\s+/,        // Whitespace: spaces, tabs, newlines
     $.comment,    // VHDL line comments can appear anywhere
     $.block_comment,  // VHDL-2008: block comments /* ... */
+    $.translate_off_pragma,  // -- synthesis translate_off (and pragma/synopsys/... variants)
+    $.translate_on_pragma,   // -- synthesis translate_on
     $.protect_directive,  // VHDL-2008: `protect ... (encrypted wrappers)
   ],
 
@@ -425,16 +438,13 @@ module.exports = grammar({
     // -------------------------------------------------------------------------
     // VHDL comments start with -- and continue to end of line.
     //
-    // token() is crucial here! It combines the sequence into a SINGLE token.
-    // Without token(), Tree-sitter would allow whitespace between '--' and
-    // the comment text, which is wrong.
-    //
-    // seq('--', /.*/) means: match '--' followed by any characters until newline.
-    // The /.*/ regex matches everything except newline (. doesn't match \n).
+    // comment, block_comment and the translate_off/on pragmas are declared in
+    // externals and handled by src/scanner.c: vendor files are often mostly
+    // comments, and the scanner consumes each one in a single call instead of
+    // running the lexer DFA per character. Pragma lines such as
+    //   -- synthesis translate_off
+    // come back as translate_off_pragma / translate_on_pragma nodes.
     // -------------------------------------------------------------------------
-    comment: $ => token(seq('--', /[^\r\n]*/)),
-    // VHDL-2008: Block comments /* ... */ (can span multiple lines)
-    block_comment: $ => token(seq('/*', /[^*]*\*+([^/*][^*]*\*+)*/, '/')),
     // VHDL-2008: `protect directives (treat as skippable preproc lines)
     protect_directive: $ => token(seq('`protect', /[^\r\n]*/)),
     identifier: $ => token(choice(
@@ -796,8 +806,7 @@ module.exports = grammar({
 
     _enumeration_literal: $ => choice(
       $.identifier,
-      /'[^']'/,  // Character literal: 'a', '0', etc.
-      /'''/      // Apostrophe character: '''
+      $.character_literal  // 'a', '0', ''' (from external scanner)
     ),
 
     // -------------------------------------------------------------------------
@@ -1056,7 +1065,7 @@ module.exports = grammar({
     default_value: $ => $._expression,
 
     number: _ => /[0-9][0-9_]*(\.[0-9][0-9_]*)?/,  // Integer or floating point (underscores allowed)
-    based_literal: _ => /(?:[0-9][0-9_]*#[0-9a-fA-F_]+(\.[0-9a-fA-F_]+)?#([eE][+-]?[0-9_]+)?|[0-9][0-9_]*:[0-9a-fA-F_]+(\.[0-9a-fA-F_]+)?:([eE][+-]?[0-9_]+)?)/,
+    // based_literal is declared in externals and handled by src/scanner.c
     physical_literal: $ => seq(
       $.number,
       $.identifier
@@ -2721,15 +2730,13 @@ module.exports = grammar({
       $._name
     ),
 
-    // Character literal as explicit rule
-    character_literal: _ => /'[^']'/,
+    // character_literal is declared in externals and handled by src/scanner.c
+    // ('x' for any graphic character, including ''' for the apostrophe)
 
     // Literals (character, string, bit string)
-    // Character literal: 'x' (single char) or ''' (apostrophe)
-    // Bit string literals handled by external scanner (src/scanner.c)
+    // Character and bit string literals handled by external scanner (src/scanner.c)
     _literal: $ => prec(10, choice(
-      $.character_literal,    // Single character: 'a', '0', ' ', etc.
-      /'''/,                  // Apostrophe character: '''
+      $.character_literal,    // Single character: 'a', '0', ' ', ''', etc.
       $._string_literal       // Includes quoted, percent-delimited, and bit strings
     )),
 
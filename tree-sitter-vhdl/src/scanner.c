@@ -2,8 +2,12 @@
  * External Scanner for VHDL Tree-sitter Grammar
  * ==============================================
  *
- * This file handles tokenization that can't be expressed cleanly in grammar.js.
- * The main use case: bit string literals like X"DEADBEEF", B"1010", O"777"
+ * This file handles tokenization that can't be expressed cleanly in grammar.js:
+ *   - bit string literals like X"DEADBEEF", B"1010", O"777", 12UX"ABC"
+ *   - based literals like 16#FF_FF#, 2#1010#E4, 8:777: (replacement form)
+ *   - character literals like '0', 'Z', ''' (disambiguated from the tick)
+ *   - comments (-- line and VHDL-2008 block comments), with synthesis
+ *     translate_off/on directives returned as their own token types
  *
  * WHY WE NEED THIS:
  * -----------------
@@ -14,25 +18,67 @@
  * External scanners run BEFORE the normal lexer, giving us first crack at the input.
  * We use this to recognize bit string literals before "X" gets grabbed as identifier.
  *
+ * Based and character literals used to be regexes in grammar.js. A based literal
+ * shares its leading digits with number and sized bit strings, and a character
+ * literal shares its opening ' with the attribute tick (a'range vs '0'). As
+ * regexes they forced the generated lexer to carry both interpretations and the
+ * parser to fork on them; here one scan decides, using valid_symbols as the
+ * "what can come next" context: after a name the parser only accepts the tick,
+ * so CHARACTER_LITERAL is not valid and we return false without consuming.
+ *
+ * No scanner state is kept for this. Tree-sitter restores scanner state from the
+ * last *external* token before each scan, so a "previous token was a name" bit
+ * could only be maintained if identifiers were external too; valid_symbols
+ * already carries that information for free.
+ *
+ * Comments are extras and dominate vendor IP files (license headers, generated
+ * docs). Each comment is consumed in one scan call with a tight loop, and the
+ * first few bytes are classified so "-- synthesis translate_off" style
+ * directives surface as translate_off_pragma / translate_on_pragma nodes the
+ * extractor can act on without re-reading comment text.
+ *
  * HOW IT WORKS:
  * -------------
- * 1. Grammar declares external tokens: externals: $ => [$.bit_string_literal]
+ * 1. Grammar declares external tokens: externals: $ => [$.bit_string_literal, ...]
  * 2. Tree-sitter calls tree_sitter_vhdl_external_scanner_scan() for each token
- * 3. We check if current position starts with X", B", O" (case-insensitive)
+ * 3. We check if current position starts a literal we own (X", 16#, 'c')
  * 4. If yes, we consume the entire literal and return true
  * 5. If no, we return false and Tree-sitter uses normal lexer
+ *    (a plain number such as 42 or 3.14 is left to the normal lexer)
  */
 
 #include "tree_sitter/parser.h"
-#include <wctype.h>
 #include <string.h>
 
 // Token types we handle - must match order in grammar.js externals array
 enum TokenType {
     BIT_STRING_LITERAL,
     INVALID_BIT_STRING_LITERAL,
+    BASED_LITERAL,
+    CHARACTER_LITERAL,
+    COMMENT,
+    BLOCK_COMMENT,
+    TRANSLATE_OFF_PRAGMA,
+    TRANSLATE_ON_PRAGMA,
 };
 
+/**
+ * Optional scan counters, compiled in only by bench/scanner_bench.c.
+ * fast_rejects counts scans turned away by the first-lookahead pre-check;
+ * alpha_checks counts scans that got as far as the base-letter check;
+ * alpha_rejects counts those that then returned false without a token.
+ */
+#ifdef TREE_SITTER_VHDL_SCANNER_STATS
+static struct {
+    unsigned long long fast_rejects;
+    unsigned long long alpha_checks;
+    unsigned long long alpha_rejects;
+} vhdl_scanner_stats;
+#define SCANNER_STAT(field) (vhdl_scanner_stats.field++)
+#else
+#define SCANNER_STAT(field) ((void)0)
+#endif
+
 /**
  * Create scanner state (called once per parser instance)
  */
@@ -49,6 +95,11 @@ void tree_sitter_vhdl_external_scanner_destroy(void *payload) {
 
 /**
  * Serialize scanner state (for incremental parsing)
+ *
+ * The scanner is deliberately stateless: every external token is decided
+ * from the lookahead alone, so an empty snapshot is exact and reparsing
+ * against an edited tree (Extractor.Trees) reuses tokens safely. Any state
+ * added later must round-trip through serialize/deserialize.
  */
 unsigned tree_sitter_vhdl_external_scanner_serialize(void *payload, char *buffer) {
     return 0;  // No state to serialize
@@ -62,46 +113,264 @@ void tree_sitter_vhdl_external_scanner_deserialize(void *payload, const char *bu
 }
 
 /**
- * Check if character is a valid hex digit
+ * Character classes for the bytes a bit string prefix can contain.
+ *
+ * One table lookup replaces the old is_*_digit()/iswalpha() chains. Only
+ * ASCII is classified: VHDL base specifiers and signedness letters are
+ * ASCII, and iswalpha() in the "C" locale Tree-sitter runs under rejects
+ * everything above 0x7F anyway.
+ */
+enum CharClass {
+    CC_DIGIT      = 1 << 0,  // 0-9
+    CC_UNDERSCORE = 1 << 1,  // _ (allowed inside sizes and digits)
+    CC_ALPHA      = 1 << 2,  // A-Z a-z
+    CC_BASE       = 1 << 3,  // B O X D (either case)
+    CC_SIGN       = 1 << 4,  // S U (either case)
+    CC_SPACE      = 1 << 5,  // space, tab, CR, LF
+    CC_DELIMITER  = 1 << 6,  // " and %
+    CC_HEX        = 1 << 7,  // 0-9 A-F a-f (extended digits of based literals)
+};
+
+#define CC_D (CC_DIGIT | CC_HEX)
+#define CC_L CC_ALPHA
+#define CC_H (CC_ALPHA | CC_HEX)
+#define CC_B (CC_ALPHA | CC_BASE)
+#define CC_X (CC_ALPHA | CC_BASE | CC_HEX)
+#define CC_S (CC_ALPHA | CC_SIGN)
+
+static const uint8_t CHAR_CLASS[256] = {
+    [' '] = CC_SPACE, ['\t'] = CC_SPACE, ['\n'] = CC_SPACE, ['\r'] = CC_SPACE,
+    ['"'] = CC_DELIMITER, ['%'] = CC_DELIMITER,
+    ['_'] = CC_UNDERSCORE,
+    ['0'] = CC_D, ['1'] = CC_D, ['2'] = CC_D, ['3'] = CC_D, ['4'] = CC_D,
+    ['5'] = CC_D, ['6'] = CC_D, ['7'] = CC_D, ['8'] = CC_D, ['9'] = CC_D,
+    ['A'] = CC_H, ['B'] = CC_X, ['C'] = CC_H, ['D'] = CC_X, ['E'] = CC_H, ['F'] = CC_H,
+    ['G'] = CC_L, ['H'] = CC_L, ['I'] = CC_L, ['J'] = CC_L, ['K'] = CC_L, ['L'] = CC_L,
+    ['M'] = CC_L, ['N'] = CC_L, ['O'] = CC_B, ['P'] = CC_L, ['Q'] = CC_L, ['R'] = CC_L,
+    ['S'] = CC_S, ['T'] = CC_L, ['U'] = CC_S, ['V'] = CC_L, ['W'] = CC_L, ['X'] = CC_B,
+    ['Y'] = CC_L, ['Z'] = CC_L,
+    ['a'] = CC_H, ['b'] = CC_X, ['c'] = CC_H, ['d'] = CC_X, ['e'] = CC_H, ['f'] = CC_H,
+    ['g'] = CC_L, ['h'] = CC_L, ['i'] = CC_L, ['j'] = CC_L, ['k'] = CC_L, ['l'] = CC_L,
+    ['m'] = CC_L, ['n'] = CC_L, ['o'] = CC_B, ['p'] = CC_L, ['q'] = CC_L, ['r'] = CC_L,
+    ['s'] = CC_S, ['t'] = CC_L, ['u'] = CC_S, ['v'] = CC_L, ['w'] = CC_L, ['x'] = CC_B,
+    ['y'] = CC_L, ['z'] = CC_L,
+};
+
+#undef CC_D
+#undef CC_L
+#undef CC_H
+#undef CC_B
+#undef CC_X
+#undef CC_S
+
+static inline uint8_t char_class(int32_t c) {
+    return (c >= 0 && c < 256) ? CHAR_CLASS[c] : 0;
+}
+
+static inline bool has_class(int32_t c, uint8_t mask) {
+    return (char_class(c) & mask) != 0;
+}
+
+/**
+ * Character literal: '<graphic character>', including ''' for the apostrophe.
+ * Called with the opening ' as lookahead.
  */
-static bool is_hex_digit(int32_t c) {
-    return (c >= '0' && c <= '9') ||
-           (c >= 'a' && c <= 'f') ||
-           (c >= 'A' && c <= 'F') ||
-           c == '_';  // VHDL allows underscores in literals
+static bool scan_character_literal(TSLexer *lexer) {
+    lexer->advance(lexer, false);  // opening '
+
+    int32_t c = lexer->lookahead;
+    if (c == 0 || c == '\n' || c == '\r') {
+        return false;
+    }
+    lexer->advance(lexer, false);
+
+    if (lexer->lookahead != '\'') {
+        return false;  // a'range, a'(...): a tick, not a literal
+    }
+    lexer->advance(lexer, false);
+    lexer->mark_end(lexer);
+    lexer->result_symbol = CHARACTER_LITERAL;
+    return true;
 }
 
 /**
- * Check if character is a valid binary digit
+ * Based literal after its base: #digits[.digits]#[exponent], where # may also
+ * be the replacement character ':'. Called with the first delimiter as
+ * lookahead; the base digits have already been consumed.
  */
-static bool is_binary_digit(int32_t c) {
-    return c == '0' || c == '1' || c == '_';
+static bool scan_based_literal(TSLexer *lexer) {
+    int32_t delimiter = lexer->lookahead;
+    lexer->advance(lexer, false);
+
+    if (!has_class(lexer->lookahead, CC_HEX | CC_UNDERSCORE)) {
+        return false;  // e.g. "x(0):=" - not a literal
+    }
+    while (has_class(lexer->lookahead, CC_HEX | CC_UNDERSCORE)) {
+        lexer->advance(lexer, false);
+    }
+    if (lexer->lookahead == '.') {
+        lexer->advance(lexer, false);
+        if (!has_class(lexer->lookahead, CC_HEX | CC_UNDERSCORE)) {
+            return false;
+        }
+        while (has_class(lexer->lookahead, CC_HEX | CC_UNDERSCORE)) {
+            lexer->advance(lexer, false);
+        }
+    }
+    if (lexer->lookahead != delimiter) {
+        return false;
+    }
+    lexer->advance(lexer, false);
+    lexer->mark_end(lexer);
+
+    // Optional exponent: only part of the token if digits follow
+    if (lexer->lookahead == 'e' || lexer->lookahead == 'E') {
+        lexer->advance(lexer, false);
+        if (lexer->lookahead == '+' || lexer->lookahead == '-') {
+            lexer->advance(lexer, false);
+        }
+        if (has_class(lexer->lookahead, CC_DIGIT | CC_UNDERSCORE)) {
+            while (has_class(lexer->lookahead, CC_DIGIT | CC_UNDERSCORE)) {
+                lexer->advance(lexer, false);
+            }
+            lexer->mark_end(lexer);
+        }
+    }
+
+    lexer->result_symbol = BASED_LITERAL;
+    return true;
 }
 
 /**
- * Check if character is a valid octal digit
+ * Tool prefixes that introduce a translate_off/translate_on directive:
+ *   -- synthesis translate_off    -- pragma translate_on
+ *   -- synopsys translate_off     -- rtl_synthesis off
+ */
+static const char *const PRAGMA_PREFIXES[] = {
+    "synthesis", "synopsys", "pragma", "xilinx", "altera", "exemplar", "cadence",
+};
+
+#define PRAGMA_PEEK 48  // Directive words always fit in the first few bytes
+
+/**
+ * Match a lowercase word at *pos in text, followed by a non-identifier
+ * character; advances *pos past the word on success.
  */
-static bool is_octal_digit(int32_t c) {
-    return (c >= '0' && c <= '7') || c == '_';
+static bool match_word(const char *text, unsigned len, unsigned *pos, const char *word) {
+    unsigned n = (unsigned)strlen(word);
+    if (*pos + n > len || memcmp(text + *pos, word, n) != 0) {
+        return false;
+    }
+    if (*pos + n < len && has_class((unsigned char)text[*pos + n], CC_ALPHA | CC_DIGIT | CC_UNDERSCORE)) {
+        return false;
+    }
+    *pos += n;
+    return true;
+}
+
+static void skip_blanks(const char *text, unsigned len, unsigned *pos) {
+    while (*pos < len && (text[*pos] == ' ' || text[*pos] == '\t')) {
+        (*pos)++;
+    }
 }
 
 /**
- * Check if character is a valid decimal digit
+ * Classify the first bytes of a line comment body (lowercased, after "--").
+ * Returns TRANSLATE_OFF_PRAGMA, TRANSLATE_ON_PRAGMA or COMMENT.
  */
-static bool is_decimal_digit(int32_t c) {
-    return (c >= '0' && c <= '9') || c == '_';
+static enum TokenType classify_line_comment(const char *text, unsigned len) {
+    unsigned pos = 0;
+    skip_blanks(text, len, &pos);
+
+    if (match_word(text, len, &pos, "rtl_synthesis")) {
+        skip_blanks(text, len, &pos);
+        if (match_word(text, len, &pos, "off")) {
+            return TRANSLATE_OFF_PRAGMA;
+        }
+        if (match_word(text, len, &pos, "on")) {
+            return TRANSLATE_ON_PRAGMA;
+        }
+        return COMMENT;
+    }
+    for (unsigned i = 0; i < sizeof(PRAGMA_PREFIXES) / sizeof(PRAGMA_PREFIXES[0]); i++) {
+        unsigned word_pos = pos;
+        if (!match_word(text, len, &word_pos, PRAGMA_PREFIXES[i])) {
+            continue;
+        }
+        skip_blanks(text, len, &word_pos);
+        if (match_word(text, len, &word_pos, "translate_off")) {
+            return TRANSLATE_OFF_PRAGMA;
+        }
+        if (match_word(text, len, &word_pos, "translate_on")) {
+            return TRANSLATE_ON_PRAGMA;
+        }
+        return COMMENT;
+    }
+    return COMMENT;
 }
 
-static bool is_base_specifier(int32_t c) {
-    return c == 'B' || c == 'b' ||
-           c == 'O' || c == 'o' ||
-           c == 'X' || c == 'x' ||
-           c == 'D' || c == 'd';
+/**
+ * Line comment: "--" to end of line, consumed in a single scan. The first
+ * PRAGMA_PEEK bytes are kept so translate_off/translate_on directives can be
+ * returned as their own token types.
+ * Called with the first '-' as lookahead.
+ */
+static bool scan_line_comment(TSLexer *lexer, const bool *valid_symbols) {
+    lexer->advance(lexer, false);
+    if (lexer->lookahead != '-') {
+        return false;  // minus operator
+    }
+    lexer->advance(lexer, false);
+
+    char peek[PRAGMA_PEEK] = {0};
+    unsigned peek_len = 0;
+    while (lexer->lookahead != '\n' && lexer->lookahead != '\r' && lexer->lookahead != 0) {
+        if (peek_len < PRAGMA_PEEK) {
+            int32_t c = lexer->lookahead;
+            peek[peek_len++] = (char)((c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : (c < 0x80 ? c : '?'));
+        }
+        lexer->advance(lexer, false);
+    }
+    lexer->mark_end(lexer);
+
+    enum TokenType kind = classify_line_comment(peek, peek_len);
+    if (kind != COMMENT && !valid_symbols[kind]) {
+        kind = COMMENT;
+    }
+    if (!valid_symbols[kind]) {
+        return false;
+    }
+    lexer->result_symbol = kind;
+    return true;
 }
 
-static bool is_signedness(int32_t c) {
-    return c == 'S' || c == 's' ||
-           c == 'U' || c == 'u';
+/**
+ * VHDL-2008 block comment: from slash-star to the first star-slash (no nesting).
+ * Called with '/' as lookahead.
+ */
+static bool scan_block_comment(TSLexer *lexer) {
+    lexer->advance(lexer, false);
+    if (lexer->lookahead != '*') {
+        return false;  // division or /=
+    }
+    lexer->advance(lexer, false);
+
+    for (;;) {
+        if (lexer->lookahead == 0) {
+            return false;  // unterminated
+        }
+        if (lexer->lookahead == '*') {
+            lexer->advance(lexer, false);
+            if (lexer->lookahead == '/') {
+                lexer->advance(lexer, false);
+                lexer->mark_end(lexer);
+                lexer->result_symbol = BLOCK_COMMENT;
+                return true;
+            }
+            continue;
+        }
+        lexer->advance(lexer, false);
+    }
 }
 
 /**
@@ -117,98 +386,110 @@ bool tree_sitter_vhdl_external_scanner_scan(
     TSLexer *lexer,
     const bool *valid_symbols
 ) {
-    // Only try to match if a bit-string token is valid at this position
-    if (!valid_symbols[BIT_STRING_LITERAL] && !valid_symbols[INVALID_BIT_STRING_LITERAL]) {
+    bool want_bit_string = valid_symbols[BIT_STRING_LITERAL] ||
+                           valid_symbols[INVALID_BIT_STRING_LITERAL];
+    bool want_based = valid_symbols[BASED_LITERAL];
+    bool want_character = valid_symbols[CHARACTER_LITERAL];
+    bool want_comment = valid_symbols[COMMENT] ||
+                        valid_symbols[TRANSLATE_OFF_PRAGMA] ||
+                        valid_symbols[TRANSLATE_ON_PRAGMA];
+    bool want_block_comment = valid_symbols[BLOCK_COMMENT];
+
+    // Only try to match if one of our tokens is valid at this position
+    if (!want_bit_string && !want_based && !want_character &&
+        !want_comment && !want_block_comment) {
         return false;
     }
 
     // Skip whitespace (Tree-sitter extras handle this, but be safe)
-    while (lexer->lookahead == ' ' || lexer->lookahead == '\t' ||
-           lexer->lookahead == '\n' || lexer->lookahead == '\r') {
+    while (has_class(lexer->lookahead, CC_SPACE)) {
         lexer->advance(lexer, true);  // true = skip
     }
 
-    // Check for bit string prefix with optional size and signedness
-    int32_t prefix = lexer->lookahead;
-    bool (*digit_check)(int32_t) = NULL;
-    bool saw_size = false;
-    bool saw_sign = false;
+    // Comments: "-" and "/" never start a literal, so these are final
+    if (lexer->lookahead == '-') {
+        return want_comment && scan_line_comment(lexer, valid_symbols);
+    }
+    if (lexer->lookahead == '/') {
+        return want_block_comment && scan_block_comment(lexer);
+    }
+
+    // Character literal vs tick: only reachable where the parser accepts a
+    // character literal, i.e. never directly after a name.
+    if (lexer->lookahead == '\'') {
+        return want_character && scan_character_literal(lexer);
+    }
+
+    // Prefix shape: [size][s|u]<base>"..." for valid literals. Invalid
+    // literals may use any one or two letters before the delimiter.
+    bool allow_invalid = valid_symbols[INVALID_BIT_STRING_LITERAL];
+
+    // Constant-time pre-check: a literal can only start with a digit (size
+    // or base) or a letter. When only valid bit strings are wanted, the
+    // letter must be a base specifier or signedness letter. Identifiers,
+    // operators and punctuation are rejected here without a single advance().
+    uint8_t start_mask = 0;
+    if (want_bit_string) {
+        start_mask |= allow_invalid
+            ? (CC_DIGIT | CC_ALPHA)
+            : (CC_DIGIT | CC_BASE | CC_SIGN);
+    }
+    if (want_based) {
+        start_mask |= CC_DIGIT;
+    }
+    if (!has_class(lexer->lookahead, start_mask)) {
+        SCANNER_STAT(fast_rejects);
+        return false;
+    }
 
-    if (prefix >= '0' && prefix <= '9') {
-        // Sized bit string literal: <size>[s|u]<base>"..."
-        while (is_decimal_digit(lexer->lookahead)) {
+    if (has_class(lexer->lookahead, CC_DIGIT)) {
+        // Size of a bit string (8UX"...") or base of a based literal (16#...#)
+        while (has_class(lexer->lookahead, CC_DIGIT | CC_UNDERSCORE)) {
             lexer->advance(lexer, false);
         }
-        saw_size = true;
-        if (lexer->lookahead == 's' || lexer->lookahead == 'S' ||
-            lexer->lookahead == 'u' || lexer->lookahead == 'U') {
-            lexer->advance(lexer, false);
-            saw_sign = true;
+        if (lexer->lookahead == '#' || lexer->lookahead == ':') {
+            return want_based && scan_based_literal(lexer);
         }
-        prefix = lexer->lookahead;
-    } else if (lexer->lookahead == 's' || lexer->lookahead == 'S' ||
-               lexer->lookahead == 'u' || lexer->lookahead == 'U') {
-        // Unsized signedness prefix: sX"..." or uB"..."
+        if (!want_bit_string) {
+            return false;  // plain number: the normal lexer owns it
+        }
+    }
+    if (has_class(lexer->lookahead, CC_SIGN)) {
+        // Signedness prefix: 8SX"..." or uB"..."
         lexer->advance(lexer, false);
-        saw_sign = true;
-        prefix = lexer->lookahead;
     }
 
-    if (!iswalpha(prefix)) {
+    // First prefix letter. Every valid literal has its base specifier here,
+    // so without the invalid token there is no point advancing past
+    // anything else.
+    int32_t prefix = lexer->lookahead;
+    SCANNER_STAT(alpha_checks);
+    if (!has_class(prefix, allow_invalid ? CC_ALPHA : CC_BASE)) {
+        SCANNER_STAT(alpha_rejects);
         return false;
     }
-
-    // Consume the first prefix letter
     lexer->advance(lexer, false);
 
-    int32_t prefix2 = 0;
-    if (iswalpha(lexer->lookahead)) {
-        prefix2 = lexer->lookahead;
+    // A second letter can only form an invalid literal (e.g. XY"..."),
+    // so look at it only when that token is wanted.
+    bool valid = has_class(prefix, CC_BASE);
+    if (!has_class(lexer->lookahead, CC_DELIMITER)) {
+        if (!allow_invalid || !has_class(lexer->lookahead, CC_ALPHA)) {
+            SCANNER_STAT(alpha_rejects);
+            return false;
+        }
         lexer->advance(lexer, false);
+        valid = false;
     }
 
     // Must be followed by opening quote or percent delimiter
     int32_t delimiter = lexer->lookahead;
     if (delimiter != '"' && delimiter != '%') {
+        SCANNER_STAT(alpha_rejects);
         return false;  // Not a bit string literal, let normal lexer handle
     }
 
-    bool valid = false;
-    int32_t base = 0;
-
-    if (saw_sign) {
-        // Signedness already consumed: next must be a single base letter
-        if (is_base_specifier(prefix) && prefix2 == 0) {
-            valid = true;
-            base = prefix;
-        }
-    } else {
-        if (prefix2 == 0) {
-            if (is_base_specifier(prefix)) {
-                valid = true;
-                base = prefix;
-            }
-        } else if (!saw_size && is_signedness(prefix) && is_base_specifier(prefix2)) {
-            // Unsized signedness prefix: sX"..." or uB"..."
-            valid = true;
-            base = prefix2;
-        }
-    }
-
-    if (valid) {
-        if (!valid_symbols[BIT_STRING_LITERAL]) {
-            return false;
-        }
-        if (base == 'X' || base == 'x') {
-            digit_check = is_hex_digit;
-        } else if (base == 'B' || base == 'b') {
-            digit_check = is_binary_digit;
-        } else if (base == 'O' || base == 'o') {
-            digit_check = is_octal_digit;
-        } else if (base == 'D' || base == 'd') {
-            digit_check = is_decimal_digit;
-        }
-    } else if (!valid_symbols[INVALID_BIT_STRING_LITERAL]) {
+    if (valid ? !valid_symbols[BIT_STRING_LITERAL] : !allow_invalid) {
         return false;
     }
 
@@ -219,12 +500,9 @@ bool tree_sitter_vhdl_external_scanner_scan(
     // Consume the opening delimiter
     lexer->advance(lexer, false);
 
-    // Consume digits until closing delimiter
+    // Consume digits until closing delimiter. Digits that are invalid for
+    // the base are still consumed so error recovery sees one token.
     while (lexer->lookahead != delimiter && lexer->lookahead != 0) {
-        if (digit_check != NULL && !digit_check(lexer->lookahead)) {
-            // Invalid digit for this base - still consume to closing quote
-            // This allows for better error recovery
-        }
         lexer->advance(lexer, false);
     }
 